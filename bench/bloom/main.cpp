@@ -0,0 +1,141 @@
+// GPU time of the learnopengl::PostProcess stages at 720p, 1080p and 1440p: mip chain bloom against the full resolution gaussian
+// bloom of the LearnOpenGL chapter (10 passes), histogram auto exposure and tone mapping, with the bytes of the bloom targets.
+// The scene is an HDR image uploaded once: a dim gradient with small very bright spots. The adapted luminance read back from
+// the GPU is checked against the log average luminance computed on the CPU (the 254 histogram bins round it by up to 2%).
+// Needs an OpenGL context, LEARNOPENGL_HEADLESS=1 renders without display.
+
+#include <learnopengl/window.hpp>
+#include <learnopengl/frameprofiler.hpp>
+#include <learnopengl/postprocess.hpp>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <vector>
+
+int main(int argc, char** argv)
+{
+    auto* window = learnopengl::createWindow();
+    if(!window)
+        return -1;
+
+    glfwSwapInterval(0);
+
+    using Bloom = learnopengl::PostProcess::Bloom;
+    using PostProcess = learnopengl::PostProcess;
+
+    learnopengl::FrameProfiler profiler;
+    // Mean GPU time of a scope over frames, negative without the scope
+    const auto scopeMs = [&](const char* name)
+    {
+        const auto statistics = profiler.scopeStatistics(name, learnopengl::FrameProfiler::Metric::Gpu);
+        return statistics.count ? statistics.mean : -1.;
+    };
+    const auto measure = [&](PostProcess& postProcess)
+    {
+        constexpr int Frames = 30;
+        profiler.clearHistory();
+        for(int frame = 0; frame < Frames; ++frame)
+        {
+            profiler.beginFrame();
+            postProcess.apply(learnopengl::defaultFramebuffer(), 1.f / 60.f, &profiler);
+            profiler.endFrame();
+        }
+        // Resolve the last frames
+        glFinish();
+        for(int frame = 0; frame < 4; ++frame)
+        {
+            profiler.beginFrame();
+            profiler.endFrame();
+        }
+    };
+    const auto cell = [](int width, double ms)
+    {
+        std::ostringstream stream;
+        if(ms < 0.)
+            stream << std::setw(width) << "-";
+        else
+            stream << std::setw(width) << std::fixed << std::setprecision(3) << ms;
+        return stream.str();
+    };
+
+    std::cout << std::setw(11) << "resolution" << std::setw(10) << "bloom" << std::setw(13) << "targets (KiB)" << std::setw(12)
+              << "bloom (ms)" << std::setw(15) << "exposure (ms)" << std::setw(19) << "tone mapping (ms)" << std::setw(14)
+              << "luminance gpu" << std::setw(14) << "luminance cpu" << std::endl;
+
+    const int resolutions[][2] = {{1280, 720}, {1920, 1080}, {2560, 1440}};
+    for(const auto& resolution: resolutions)
+    {
+        const int width = resolution[0];
+        const int height = resolution[1];
+
+        // Gradient from 0.02 to 0.5 and 4x4 spots of luminance 20 to 100 over about 1% of the pixels
+        std::mt19937 random(42);
+        std::uniform_real_distribution<float> unit(0.f, 1.f);
+        std::vector<glm::vec4> image(std::size_t(width) * std::size_t(height));
+        for(int y = 0; y < height; ++y)
+        {
+            for(int x = 0; x < width; ++x)
+            {
+                const float gradient = 0.02f + 0.48f * float(x + y) / float(width + height);
+                image[std::size_t(y) * std::size_t(width) + std::size_t(x)] = glm::vec4(gradient, gradient * 0.9f, gradient * 0.8f, 1.f);
+            }
+        }
+        const std::size_t spotCount = image.size() / 1'600;
+        for(std::size_t spot = 0; spot < spotCount; ++spot)
+        {
+            const int spotX = int(unit(random) * float(width - 4));
+            const int spotY = int(unit(random) * float(height - 4));
+            const glm::vec4 color(glm::vec3(20.f + 80.f * unit(random)) * glm::vec3(unit(random), unit(random), 1.f), 1.f);
+            for(int y = spotY; y < spotY + 4; ++y)
+            {
+                for(int x = spotX; x < spotX + 4; ++x) image[std::size_t(y) * std::size_t(width) + std::size_t(x)] = color;
+            }
+        }
+
+        PostProcess::Settings settings;
+        PostProcess postProcess(width, height, settings);
+        glBindTexture(GL_TEXTURE_2D, postProcess.sceneTexture());
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGBA, GL_FLOAT, image.data());
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        // Log average of the luminance in the histogram range, darker pixels left out as by the histogram
+        double logSum = 0.;
+        std::size_t counted = 0;
+        for(const auto& color: image)
+        {
+            const float luminance = glm::dot(glm::vec3(color), glm::vec3(0.2126f, 0.7152f, 0.0722f));
+            if(luminance < 1e-5f)
+                continue;
+            logSum += std::clamp(std::log2(double(luminance)), double(settings.minLogLuminance), double(settings.maxLogLuminance));
+            ++counted;
+        }
+        const double cpuLuminance = std::exp2(logSum / double(std::max<std::size_t>(counted, 1)));
+
+        for(const auto bloom: {Bloom::MipChain, Bloom::Gaussian})
+        {
+            postProcess.setBloom(bloom);
+            measure(postProcess);
+            const bool autoExposure = PostProcess::autoExposureSupported();
+
+            std::cout << std::setw(6) << width << "x" << std::setw(4) << std::left << height << std::right << std::setw(10)
+                      << (bloom == Bloom::MipChain ? "mip chain" : "gaussian") << std::setw(13) << postProcess.bloomBytes() / 1024
+                      << cell(12, scopeMs(PostProcess::BloomScope)) << cell(15, scopeMs(PostProcess::ExposureScope))
+                      << cell(19, scopeMs(PostProcess::ToneMappingScope)) << std::fixed << std::setprecision(4) << std::setw(14)
+                      << (autoExposure ? postProcess.readAdaptedLuminance() : 0.f) << std::setw(14) << cpuLuminance << std::endl;
+        }
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, learnopengl::defaultFramebuffer());
+    glfwTerminate();
+
+    return 0;
+}
@@ -0,0 +1,121 @@
+// CPU light binning of learnopengl::LightClusterGrid for 1k to 10k lights in the volume of the 2.lighting/6.3.multiple_lights_clustered scene,
+// over 1 thread and the whole pool, with the lights a fragment evaluates compared to looping over every light.
+// Lights outside the frustum (ClusteredLighting culls them before binning) are counted with the time to cull them.
+// Binning is checked conservative: every light reaching a random point is in the list of the point cluster.
+
+#include <learnopengl/camera.hpp>
+#include <learnopengl/lightclustergrid.hpp>
+#include <learnopengl/threadpool.hpp>
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+template<typename Function>
+double measureMs(int iterations, Function&& function)
+{
+    const auto start = Clock::now();
+    for(int i = 0; i < iterations; ++i) function();
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count() / iterations;
+}
+
+// Lights reaching random points inside the view frustum missing from the point cluster
+std::size_t missingLights(const learnopengl::Camera& camera,
+    const learnopengl::LightClusterGrid& grid,
+    const std::vector<glm::vec4>& lights)
+{
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> ndc(-1.f, 1.f);
+    std::uniform_real_distribution<float> distance(camera.near(), 40.f);
+    const auto& settings = grid.settings();
+    const auto inverseView = glm::inverse(camera.viewMatrix());
+    const auto& projection = camera.projectionMatrix();
+
+    std::size_t missing = 0;
+    for(int sample = 0; sample < 2000; ++sample)
+    {
+        // Cluster of the point as the shader finds it
+        const float x = ndc(random);
+        const float y = ndc(random);
+        const float depth = distance(random);
+        const glm::vec3 viewPoint(x * depth / projection[0][0], y * depth / projection[1][1], -depth);
+        const auto point = glm::vec3(inverseView * glm::vec4(viewPoint, 1.f));
+
+        const auto sliceDepth = std::floor(std::log(depth) * grid.sliceScale() + grid.sliceBias());
+        const auto slice = std::uint32_t(std::clamp(sliceDepth, 0.f, float(settings.sliceCount - 1)));
+        const auto tileX = std::min(std::uint32_t((x + 1.f) * 0.5f * float(settings.tileCountX)), settings.tileCountX - 1);
+        const auto tileY = std::min(std::uint32_t((y + 1.f) * 0.5f * float(settings.tileCountY)), settings.tileCountY - 1);
+        const auto& cluster = grid.clusters()[grid.clusterIndex(tileX, tileY, slice)];
+        const auto begin = grid.indices().begin() + cluster.offset;
+        const auto end = begin + cluster.count;
+
+        for(std::uint32_t light = 0; light < lights.size(); ++light)
+        {
+            if(glm::distance(glm::vec3(lights[light]), point) < lights[light].w && !std::binary_search(begin, end, light))
+                ++missing;
+        }
+    }
+    return missing;
+}
+
+int main(int argc, char** argv)
+{
+    const glm::vec3 sceneMin(-15.f, -3.f, -25.f);
+    const glm::vec3 sceneMax(15.f, 6.f, 5.f);
+    const auto sceneSize = sceneMax - sceneMin;
+
+    learnopengl::Camera camera;
+    camera.setFovDegrees(70.f);
+    camera.setAspect(16.f / 9.f);
+    camera.setPose({glm::vec3(0.f, 1.f, 6.f), glm::vec3(0.f, 0.f, -8.f), 70.f});
+
+    learnopengl::LightClusterGrid grid;
+    learnopengl::ThreadPool singleThread(1);
+    auto& pool = learnopengl::ThreadPool::global();
+
+    const auto& settings = grid.settings();
+    std::cout << "Clusters " << settings.tileCountX << "x" << settings.tileCountY << "x" << settings.sliceCount << ", "
+              << pool.threadCount() << " threads" << std::endl;
+    std::cout << std::setw(8) << "lights" << std::setw(8) << "range" << std::setw(10) << "visible" << std::setw(16) << "1 thread (ms)"
+              << std::setw(14) << "pool (ms)" << std::setw(14) << "lights/lit" << std::setw(10) << "max" << std::setw(12) << "indices"
+              << std::setw(10) << "missing" << std::setw(10) << "culled" << std::setw(12) << "cull (ms)" << std::endl;
+
+    for(const std::size_t count: {1'000u, 2'000u, 5'000u, 10'000u})
+    {
+        // Same light density as the demo: about 32 lights reach each point
+        const float range = std::cbrt(32.f * sceneSize.x * sceneSize.y * sceneSize.z / (float(count) * 4.f / 3.f * glm::pi<float>()));
+        std::mt19937 random(42);
+        std::uniform_real_distribution<float> unit(0.f, 1.f);
+        std::vector<glm::vec4> lights(count);
+        for(auto& light: lights) light = glm::vec4(sceneMin + sceneSize * glm::vec3(unit(random), unit(random), unit(random)), range);
+
+        const auto singleMs = measureMs(50, [&]() { grid.bin(camera, lights, singleThread); });
+        const auto poolMs = measureMs(50, [&]() { grid.bin(camera, lights, pool); });
+
+        std::size_t culled = 0;
+        const auto cullMs = measureMs(50,
+            [&]()
+            {
+                culled = 0;
+                for(const auto& light: lights) culled += !camera.frustum().intersects(learnopengl::BoundingSphere{glm::vec3(light), light.w});
+            });
+
+        const auto& stats = grid.stats();
+        const auto perCluster = stats.activeClusterCount ? double(stats.indexCount) / double(stats.activeClusterCount) : 0.;
+        std::cout << std::setw(8) << count << std::fixed << std::setprecision(2) << std::setw(8) << range << std::setw(10)
+                  << stats.visibleLightCount << std::setprecision(3) << std::setw(16) << singleMs << std::setw(14) << poolMs
+                  << std::setprecision(1) << std::setw(14) << perCluster << std::setw(10) << stats.maxLightsPerCluster << std::setw(12)
+                  << stats.indexCount << std::setw(10) << missingLights(camera, grid, lights) << std::setw(10) << culled << std::setprecision(3)
+                  << std::setw(12) << cullMs << std::endl;
+    }
+
+    return 0;
+}
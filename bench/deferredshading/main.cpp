@@ -0,0 +1,211 @@
+// GPU time of the deferred shading passes for 256 to 16k point lights at 720p, 1080p and 1440p, in the scene of
+// 5.advanced_lighting/8.2.deferred_shading_volumes (about 16 lights reach each point): learnopengl::DeferredLighting full screen pass
+// over every light, light volumes, light volumes after the stencil pass and the tiled compute shader (OpenGL 4.3), whose tile
+// light counts are checked against the LightTileGrid CPU reference (rare float rounding differences on borderline lights aside).
+// Geometry pass time and geometry buffer bytes per pixel are reported alongside.
+// Needs an OpenGL context, LEARNOPENGL_HEADLESS=1 renders without display.
+
+#include <learnopengl/window.hpp>
+#include <learnopengl/shader.hpp>
+#include <learnopengl/camera.hpp>
+#include <learnopengl/frameprofiler.hpp>
+#include <learnopengl/pointlight.hpp>
+#include <learnopengl/lightrange.hpp>
+#include <learnopengl/gbuffer.hpp>
+#include <learnopengl/deferredlighting.hpp>
+#include <learnopengl/lighttilegrid.hpp>
+#include <learnopengl/mesh.hpp>
+#include <learnopengl/instancedmesh.hpp>
+#include <learnopengl/primitives.hpp>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <tuple>
+#include <vector>
+
+int main(int argc, char** argv)
+{
+    auto* window = learnopengl::createWindow();
+    if(!window)
+        return -1;
+
+    glfwSwapInterval(0);
+    glEnable(GL_DEPTH_TEST);
+
+    // Flat white surfaces: texture fetches would only add the same cost to every configuration
+    auto geometryShader = learnopengl::Shader("resources/shaders/instanced.vs", "resources/shaders/gbufferflat.fs");
+
+    const auto cube = learnopengl::createCube();
+    const learnopengl::Mesh cubeMesh(cube.vertices, cube.indices, {});
+    learnopengl::InstancedMesh boxes(cubeMesh);
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> unit(0.f, 1.f);
+    for(int x = -5; x <= 5; ++x)
+    {
+        for(int z = -10; z <= 0; ++z)
+        {
+            glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(2.5f * float(x), -2.f, 2.5f * float(z)));
+            boxes.add(glm::rotate(model, unit(random) * 6.28f, glm::normalize(glm::vec3(0.1f, 1.f, 0.2f))));
+        }
+    }
+    boxes.add(glm::scale(glm::translate(glm::mat4(1.f), glm::vec3(0.f, -3.f, -12.5f)), glm::vec3(40.f, 1.f, 40.f)));
+    boxes.upload();
+
+    learnopengl::Camera camera;
+    camera.setFovDegrees(70.f);
+    camera.setCameraPos(glm::vec3(0.f, 2.f, 6.f));
+    camera.setCameraFront(glm::normalize(glm::vec3(0.f, -0.3f, -1.f)));
+
+    learnopengl::DirectionLight directionLight;
+    directionLight.setAmbient(glm::vec3(0.01f));
+    directionLight.setDiffuse(glm::vec3(0.05f));
+    directionLight.setDirection(glm::vec3(-0.2f, -1.0f, -0.3f));
+
+    using Mode = learnopengl::DeferredLighting::Mode;
+    std::vector<std::unique_ptr<learnopengl::DeferredLighting>> lightings;
+    std::vector<Mode> modes = {Mode::FullScreen, Mode::Volumes, Mode::StencilVolumes};
+    if(learnopengl::DeferredLighting::tiledSupported())
+        modes.push_back(Mode::Tiled);
+    for(const auto mode: modes)
+    {
+        learnopengl::DeferredLighting::Settings settings;
+        settings.mode = mode;
+        lightings.push_back(std::make_unique<learnopengl::DeferredLighting>(settings));
+        lightings.back()->setDirectionLight(directionLight);
+    }
+
+    const glm::vec3 sceneMin(-15.f, -2.5f, -27.f);
+    const glm::vec3 sceneMax(15.f, 1.f, 2.f);
+    const auto sceneSize = sceneMax - sceneMin;
+
+    learnopengl::FrameProfiler profiler;
+    learnopengl::LightTileGrid tileGrid;
+    // Mean GPU time of a scope over frames
+    const auto measure = [&](auto&& renderFrame)
+    {
+        constexpr int Frames = 30;
+        profiler.clearHistory();
+        for(int frame = 0; frame < Frames; ++frame)
+        {
+            profiler.beginFrame();
+            renderFrame();
+            profiler.endFrame();
+        }
+        // Resolve the last frames
+        glFinish();
+        for(int frame = 0; frame < 4; ++frame)
+        {
+            profiler.beginFrame();
+            profiler.endFrame();
+        }
+        return std::pair{profiler.scopeStatistics("geometry", learnopengl::FrameProfiler::Metric::Gpu).mean,
+            profiler.scopeStatistics("lighting", learnopengl::FrameProfiler::Metric::Gpu).mean};
+    };
+
+    std::cout << std::setw(11) << "resolution" << std::setw(8) << "lights" << std::setw(9) << "visible" << std::setw(5) << "B/px"
+              << std::setw(15) << "geometry (ms)" << std::setw(17) << "full screen (ms)" << std::setw(14) << "volumes (ms)" << std::setw(14)
+              << "stencil (ms)" << std::setw(12) << "tiled (ms)" << std::setw(13) << "tile errors" << std::endl;
+
+    const int resolutions[][2] = {{1280, 720}, {1920, 1080}, {2560, 1440}};
+    for(const auto& resolution: resolutions)
+    {
+        learnopengl::GBuffer gbuffer(resolution[0], resolution[1]);
+        camera.setAspect(float(resolution[0]) / float(resolution[1]));
+
+        for(const std::size_t count: {256u, 1'024u, 4'096u, 16'384u})
+        {
+            const float range = std::cbrt(16.f * sceneSize.x * sceneSize.y * sceneSize.z / (float(count) * 4.f / 3.f * glm::pi<float>()));
+            std::mt19937 lightRandom(7);
+            for(auto& lighting: lightings) lighting->clear();
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                learnopengl::PointLight light;
+                light.setPosition(sceneMin + sceneSize * glm::vec3(unit(lightRandom), unit(lightRandom), unit(lightRandom)));
+                light.setAmbient(glm::vec3(0.f));
+                light.setDiffuse(glm::vec3(unit(lightRandom), unit(lightRandom), 1.f));
+                light.setAttenuation(1.f, 0.f, (1.f / learnopengl::LightRangeThreshold - 1.f) / (range * range));
+                for(auto& lighting: lightings) lighting->add(light);
+            }
+
+            // GPU time of the geometry pass and of the lighting passes of each mode, negative when skipped
+            double geometryMs = -1.;
+            double lightingMs[4] = {-1., -1., -1., -1.};
+            std::size_t visibleCount = 0;
+            // Tiles whose light count differs between the compute shader and LightTileGrid
+            std::size_t tileErrors = 0;
+            for(std::size_t mode = 0; mode < lightings.size(); ++mode)
+            {
+                auto& lighting = *lightings[mode];
+                lighting.update(camera);
+                visibleCount = lighting.stats().lightCount;
+
+                // Every light on every pixel gets too slow past a few thousands
+                if(lighting.settings().mode == Mode::FullScreen && count > 4'096u)
+                    continue;
+
+                std::tie(geometryMs, lightingMs[mode]) = measure(
+                    [&]()
+                    {
+                        {
+                            learnopengl::FrameProfiler::ScopeGuard scope(profiler, "geometry");
+                            gbuffer.beginGeometryPass();
+                            geometryShader.use();
+                            geometryShader.setMat4("view", glm::value_ptr(camera.viewMatrix()));
+                            geometryShader.setMat4("projection", glm::value_ptr(camera.projectionMatrix()));
+                            gbuffer.setEncoding(geometryShader);
+                            boxes.draw(geometryShader);
+                        }
+                        learnopengl::FrameProfiler::ScopeGuard scope(profiler, "lighting");
+                        gbuffer.beginLightingPass();
+                        lighting.draw(gbuffer, camera);
+                    });
+
+                if(lighting.settings().mode == Mode::Tiled)
+                {
+                    std::vector<float> depth(std::size_t(gbuffer.width()) * std::size_t(gbuffer.height()));
+                    glBindFramebuffer(GL_READ_FRAMEBUFFER, gbuffer.framebuffer());
+                    glReadPixels(0, 0, gbuffer.width(), gbuffer.height(), GL_DEPTH_COMPONENT, GL_FLOAT, depth.data());
+                    GLfloat clearDepth = 1.f;
+                    glGetFloatv(GL_DEPTH_CLEAR_VALUE, &clearDepth);
+
+                    tileGrid.cull(camera, gbuffer.width(), gbuffer.height(), depth, clearDepth, lighting.lights().visibleBounds());
+                    const auto counts = lighting.readTileLightCounts();
+                    tileErrors = counts.size() == tileGrid.tiles().size() ? 0 : counts.size() + tileGrid.tiles().size();
+                    for(std::size_t tile = 0; tile < std::min(counts.size(), tileGrid.tiles().size()); ++tile)
+                        tileErrors += counts[tile] != tileGrid.tiles()[tile].count;
+                }
+            }
+
+            const auto cell = [](int width, double ms)
+            {
+                std::ostringstream stream;
+                if(ms < 0.)
+                    stream << std::setw(width) << "-";
+                else
+                    stream << std::setw(width) << std::fixed << std::setprecision(3) << ms;
+                return stream.str();
+            };
+            std::cout << std::setw(6) << resolution[0] << "x" << std::setw(4) << std::left << resolution[1] << std::right << std::setw(8)
+                      << count << std::setw(9) << visibleCount << std::setw(5) << gbuffer.geometryBytesPerPixel() << cell(15, geometryMs)
+                      << cell(17, lightingMs[0]) << cell(14, lightingMs[1]) << cell(14, lightingMs[2]) << cell(12, lightingMs[3])
+                      << std::setw(13) << tileErrors << std::endl;
+        }
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, learnopengl::defaultFramebuffer());
+    glfwTerminate();
+
+    return 0;
+}
@@ -0,0 +1,100 @@
+// Depth precision across distances, computed on the CPU with the float math of the pipeline:
+// smallest distance step changing the stored depth, for standard and reverse-Z projections and 24-bit or float depth buffers
+
+#include <learnopengl/camera.hpp>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+struct DepthSetup
+{
+    std::string name;
+    glm::mat4 projection;
+    // glClipControl zero to one instead of [-1, 1] clip depth
+    bool zeroToOne = false;
+    // 24-bit normalized integer depth buffer, 32-bit float otherwise
+    bool fixedPoint = false;
+};
+
+// Stored depth of a point at distance in front of the camera, empty when clipped
+std::optional<double> storedDepth(const DepthSetup& setup, float distance)
+{
+    const auto clip = setup.projection * glm::vec4(0.f, 0.f, -distance, 1.f);
+    const float ndc = clip.z / clip.w;
+    const float window = setup.zeroToOne ? ndc : ndc * 0.5f + 0.5f;
+    if(window < 0.f || window > 1.f)
+        return std::nullopt;
+
+    if(setup.fixedPoint)
+        return std::round(double(window) * double((1u << 24) - 1));
+    return double(window);
+}
+
+// Smallest step after distance giving another stored depth, by bisection
+std::optional<double> resolution(const DepthSetup& setup, float distance)
+{
+    const auto depth = storedDepth(setup, distance);
+    if(!depth)
+        return std::nullopt;
+
+    double low = 0.;
+    double high = distance;
+    const auto next = storedDepth(setup, float(distance + high));
+    if(next && *next == *depth)
+        return std::nullopt;
+
+    for(int i = 0; i < 64; ++i)
+    {
+        const auto middle = (low + high) / 2.;
+        const auto middleDepth = storedDepth(setup, float(distance + middle));
+        if(middleDepth && *middleDepth == *depth)
+            low = middle;
+        else
+            high = middle;
+    }
+    return high;
+}
+
+int main(int argc, char** argv)
+{
+    const float fov = glm::radians(45.f);
+    const float near = 0.1f;
+
+    const std::vector<DepthSetup> setups = {
+        {"standard far 100 D24", glm::perspective(fov, 1.f, near, 100.f), false, true},
+        {"standard far 1e4 D24", glm::perspective(fov, 1.f, near, 10000.f), false, true},
+        {"standard far 1e4 D32F", glm::perspective(fov, 1.f, near, 10000.f), false, false},
+        {"reverse-Z inf D24", learnopengl::reverseZInfinitePerspective(fov, 1.f, near), true, true},
+        {"reverse-Z inf D32F [-1,1]", learnopengl::reverseZInfinitePerspective(fov, 1.f, near), false, false},
+        {"reverse-Z inf D32F [0,1]", learnopengl::reverseZInfinitePerspective(fov, 1.f, near), true, false},
+    };
+
+    std::cout << "Smallest distance step (world units) changing the stored depth, near " << near << std::endl;
+    std::cout << std::setw(12) << "distance";
+    for(const auto& setup: setups) std::cout << std::setw(28) << setup.name;
+    std::cout << std::endl;
+
+    for(const float distance: {0.5f, 1.f, 10.f, 100.f, 1000.f, 10000.f, 100000.f})
+    {
+        std::cout << std::setw(12) << distance;
+        for(const auto& setup: setups)
+        {
+            const auto step = resolution(setup, distance);
+            if(step)
+                std::cout << std::setw(28) << std::scientific << std::setprecision(2) << *step << std::defaultfloat;
+            else
+                std::cout << std::setw(28) << "clipped";
+        }
+        std::cout << std::endl;
+    }
+
+    return 0;
+}
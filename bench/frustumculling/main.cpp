@@ -0,0 +1,117 @@
+// CPU frustum culling throughput of learnopengl::Frustum: scalar vs SIMD kernel, SoA vs min/max boxes, and scaling over a ThreadPool
+
+#include <learnopengl/camera.hpp>
+#include <learnopengl/frustum.hpp>
+#include <learnopengl/threadpool.hpp>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <span>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+template<typename Function>
+double measureMs(int iterations, Function&& function)
+{
+    const auto start = Clock::now();
+    for(int i = 0; i < iterations; ++i) function();
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count() / iterations;
+}
+
+int main(int argc, char** argv)
+{
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> position(-100.f, 100.f);
+    std::uniform_real_distribution<float> size(0.1f, 2.f);
+
+    learnopengl::Camera camera;
+    camera.setFovDegrees(70.f);
+    camera.setAspect(16.f / 9.f);
+    const auto& frustum = camera.frustum();
+
+    // The kernel is chosen by the flags the library was built with, not the ones of this benchmark
+    switch(learnopengl::Frustum::simdWidth())
+    {
+    case 8: std::cout << "SIMD kernel: AVX, 8 boxes at a time" << std::endl; break;
+    case 4: std::cout << "SIMD kernel: SSE, 4 boxes at a time (configure with LEARNOPENGL_AVX2=ON for AVX)" << std::endl; break;
+    default: std::cout << "SIMD kernel: none, 1 box at a time" << std::endl; break;
+    }
+
+    std::cout << std::setw(10) << "boxes" << std::setw(10) << "visible" << std::setw(16) << "scalar (ms)" << std::setw(16) << "simd (ms)"
+              << std::setw(16) << "min/max (ms)" << std::setw(20) << "scalar (Mbox/s)" << std::setw(20) << "simd (Mbox/s)" << std::endl;
+
+    std::vector<learnopengl::AABB> lastBoxes;
+
+    for(const std::size_t count: {1'000u, 100'000u, 1'000'000u})
+    {
+        std::vector<learnopengl::AABB> boxes;
+        learnopengl::AABBArray boxArray;
+        boxes.reserve(count);
+        boxArray.reserve(count);
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            const glm::vec3 center(position(random), position(random), position(random));
+            const glm::vec3 extent(size(random), size(random), size(random));
+            boxes.push_back({center - extent, center + extent});
+            boxArray.push_back(boxes.back());
+        }
+
+        std::vector<std::uint8_t> visibleScalar(count);
+        std::vector<std::uint8_t> visibleSimd(count);
+        std::vector<std::uint8_t> visibleMinMax(count);
+        const int iterations = count >= 1'000'000u ? 20 : 200;
+
+        std::size_t visibleCount = 0;
+        const auto scalarMs = measureMs(iterations, [&]() { visibleCount = frustum.cullScalar(boxArray, visibleScalar.data()); });
+        const auto simdMs = measureMs(iterations, [&]() { camera.cull(boxArray, visibleSimd.data()); });
+        const auto minMaxMs = measureMs(iterations, [&]() { camera.cull(boxes, visibleMinMax); });
+
+        if(visibleScalar != visibleSimd || visibleScalar != visibleMinMax)
+            std::cerr << "SIMD and scalar culling results differ for " << count << " boxes" << std::endl;
+
+        std::cout << std::setw(10) << count << std::setw(10) << visibleCount << std::fixed << std::setprecision(3) << std::setw(16)
+                  << scalarMs << std::setw(16) << simdMs << std::setw(16) << minMaxMs << std::setprecision(1) << std::setw(20)
+                  << double(count) / scalarMs / 1000. << std::setw(20) << double(count) / simdMs / 1000. << std::endl;
+
+        lastBoxes = std::move(boxes);
+    }
+
+    // Same frustum, min/max boxes of the last run split in chunks over the pool threads
+    std::cout << std::endl
+              << std::setw(10) << "threads" << std::setw(16) << "min/max (ms)" << std::setw(20) << "min/max (Mbox/s)" << std::setw(12) << "speedup"
+              << std::endl;
+
+    const std::span<const learnopengl::AABB> boxes(lastBoxes);
+    std::vector<std::uint8_t> visible(boxes.size());
+    constexpr std::size_t GrainSize = 16384;
+    double singleThreadMs = 0.;
+    const auto maxThreads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    for(std::size_t threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        learnopengl::ThreadPool pool(threads);
+        const auto ms = measureMs(20,
+            [&]()
+            {
+                pool.parallelFor(boxes.size(),
+                    GrainSize,
+                    [&](std::size_t begin, std::size_t end)
+                    { frustum.cull(boxes.subspan(begin, end - begin), std::span<std::uint8_t>(visible).subspan(begin, end - begin)); });
+            });
+        if(threads == 1)
+            singleThreadMs = ms;
+
+        std::cout << std::setw(10) << threads << std::fixed << std::setprecision(3) << std::setw(16) << ms << std::setprecision(1) << std::setw(20)
+                  << double(boxes.size()) / ms / 1000. << std::setw(12) << singleThreadMs / ms << std::endl;
+    }
+
+    return 0;
+}
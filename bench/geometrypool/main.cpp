@@ -0,0 +1,85 @@
+// GeometryPool buffer count, fragmentation and vertex array binds per frame
+
+#include <learnopengl/window.hpp>
+#include <learnopengl/shader.hpp>
+#include <learnopengl/model.hpp>
+#include <learnopengl/geometrypool.hpp>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/glm.hpp>
+
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+void printStats(const char* label, const learnopengl::GeometryPool::Stats& stats)
+{
+    std::cout << std::setw(24) << std::left << label << std::right << " buffers: " << std::setw(3) << stats.bufferCount
+              << " vertices: " << std::setw(9) << stats.vertexUsed << "/" << std::setw(9) << stats.vertexCapacity
+              << " indices: " << std::setw(9) << stats.indexUsed << "/" << std::setw(9) << stats.indexCapacity << std::fixed
+              << std::setprecision(3) << " fragmentation (v/i): " << stats.vertexFragmentation << "/" << stats.indexFragmentation
+              << " vao binds: " << stats.vertexArrayBinds << " draws: " << stats.drawCalls << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    auto* window = learnopengl::createWindow();
+    if(!window)
+        return -1;
+
+    auto shaderProgram = learnopengl::Shader("resources/shaders/gridfloor.vs", "resources/shaders/gridfloor.fs");
+
+    // Both models share one pool
+    learnopengl::GeometryPool geometryPool;
+    {
+        learnopengl::Model zelda("resources/objects/zelda/scene.gltf", false, &geometryPool);
+        learnopengl::Model ibm("resources/objects/ibm3278/scene.gltf", false, &geometryPool);
+
+        geometryPool.resetFrameStats();
+        zelda.draw(shaderProgram);
+        ibm.draw(shaderProgram);
+        glFinish();
+        printStats("models, one frame", geometryPool.stats());
+    }
+
+    // Allocation churn: random meshes, release every other one, then compact
+    std::mt19937 random(42);
+    std::uniform_int_distribution<std::size_t> vertexCount(100, 20'000);
+    std::vector<std::unique_ptr<learnopengl::Mesh>> meshes;
+    for(int i = 0; i < 200; ++i)
+    {
+        const auto count = vertexCount(random);
+        std::vector<learnopengl::Mesh::Vertex> vertices(count);
+        std::vector<std::uint32_t> indices(count * 3);
+        for(std::size_t j = 0; j < indices.size(); ++j) indices[j] = std::uint32_t(j % count);
+        meshes.push_back(std::make_unique<learnopengl::Mesh>(vertices, indices, std::vector<learnopengl::Texture>(), &geometryPool));
+    }
+    printStats("200 meshes", geometryPool.stats());
+
+    for(std::size_t i = 0; i < meshes.size(); i += 2) meshes[i].reset();
+    printStats("100 meshes released", geometryPool.stats());
+
+    geometryPool.defragment();
+    printStats("defragmented", geometryPool.stats());
+
+    geometryPool.resetFrameStats();
+    geometryPool.beginBatch();
+    for(const auto& mesh: meshes)
+    {
+        if(mesh)
+            mesh->draw(shaderProgram);
+    }
+    geometryPool.endBatch();
+    glFinish();
+    printStats("100 meshes, one frame", geometryPool.stats());
+
+    meshes.clear();
+
+    glfwTerminate();
+
+    return 0;
+}
@@ -0,0 +1,126 @@
+// CPU frame time of 10k and 100k cubes: one draw per cube vs InstancedMesh, and normal matrices scalar vs SIMD
+
+#include <learnopengl/window.hpp>
+#include <learnopengl/shader.hpp>
+#include <learnopengl/mesh.hpp>
+#include <learnopengl/instancedmesh.hpp>
+#include <learnopengl/primitives.hpp>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/matrix_inverse.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+// Only the CPU side is timed, glFinish keeps frames from piling up in the driver
+template<typename Function>
+double measureMs(int frames, Function&& function)
+{
+    double total = 0.;
+    for(int i = 0; i < frames; ++i)
+    {
+        const auto start = Clock::now();
+        function();
+        total += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        glFinish();
+    }
+    return total / frames;
+}
+
+int main(int argc, char** argv)
+{
+    auto* window = learnopengl::createWindow();
+    if(!window)
+        return -1;
+
+    glfwSwapInterval(0);
+    glEnable(GL_DEPTH_TEST);
+
+    auto meshShader = learnopengl::Shader("resources/shaders/mesh.vs", "resources/shaders/mesh.fs");
+    auto instancedShader = learnopengl::Shader("resources/shaders/instanced.vs", "resources/shaders/mesh.fs");
+
+    const auto view = glm::lookAt(glm::vec3(0.f, 0.f, 150.f), glm::vec3(0.f), glm::vec3(0.f, 1.f, 0.f));
+    const auto projection = glm::perspective(glm::radians(70.f), 4.f / 3.f, 0.1f, 500.f);
+    for(const auto* shader: {&meshShader, &instancedShader})
+    {
+        shader->use();
+        shader->setMat4("view", glm::value_ptr(view));
+        shader->setMat4("projection", glm::value_ptr(projection));
+    }
+
+    const auto cube = learnopengl::createCube();
+    const learnopengl::Mesh cubeMesh(cube.vertices,
+        cube.indices,
+        {learnopengl::Texture("resources/textures/container2.png", {.name = "texture_diffuse"})});
+
+    std::cout << std::setw(10) << "instances" << std::setw(16) << "per draw (ms)" << std::setw(16) << "instanced (ms)" << std::setw(20)
+              << "normal scalar (ms)" << std::setw(18) << "normal simd (ms)" << std::endl;
+
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> position(-100.f, 100.f);
+    std::uniform_real_distribution<float> angle(0.f, 6.28f);
+    std::uniform_real_distribution<float> scale(0.5f, 2.f);
+
+    for(const std::size_t count: {10'000u, 100'000u})
+    {
+        std::vector<glm::mat4> models(count);
+        for(auto& model: models)
+        {
+            model = glm::translate(glm::mat4(1.f), {position(random), position(random), position(random)});
+            model = glm::rotate(model, angle(random), glm::normalize(glm::vec3(0.1f, 0.3f, 0.4f)));
+            model = glm::scale(model, glm::vec3(scale(random), scale(random), scale(random)));
+        }
+
+        const int frames = count >= 100'000u ? 20 : 100;
+
+        // As the demos did: matrices uniforms and one draw per cube
+        const auto perDrawMs = measureMs(frames,
+            [&]()
+            {
+                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+                for(const auto& model: models)
+                {
+                    meshShader.use();
+                    meshShader.setMat4("model", glm::value_ptr(model));
+                    const glm::mat3 normalModelMatrix = glm::inverseTranspose(glm::mat3(model));
+                    meshShader.setMat3("normalModelMatrix", glm::value_ptr(normalModelMatrix));
+                    cubeMesh.draw(meshShader);
+                }
+            });
+
+        // Instances collected, normal matrices computed and uploaded every frame as for moving objects
+        learnopengl::InstancedMesh instances(cubeMesh);
+        instances.reserve(count);
+        const auto instancedMs = measureMs(frames,
+            [&]()
+            {
+                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+                instances.clear();
+                for(const auto& model: models) instances.add(model);
+                instances.upload();
+                instances.draw(instancedShader);
+            });
+
+        std::vector<glm::mat3> scalarNormals(count);
+        std::vector<glm::mat3> simdNormals(count);
+        const auto scalarMs = measureMs(frames, [&]() { learnopengl::computeNormalMatricesScalar(models.data(), scalarNormals.data(), count); });
+        const auto simdMs = measureMs(frames, [&]() { learnopengl::computeNormalMatrices(models.data(), simdNormals.data(), count); });
+
+        std::cout << std::setw(10) << count << std::fixed << std::setprecision(3) << std::setw(16) << perDrawMs << std::setw(16)
+                  << instancedMs << std::setw(20) << scalarMs << std::setw(18) << simdMs << std::endl;
+    }
+
+    glfwTerminate();
+
+    return 0;
+}
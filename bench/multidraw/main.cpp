@@ -0,0 +1,165 @@
+// CPU submission time of thousands of meshes: one draw per mesh vs MultiDrawBatch (glMultiDrawElementsIndirect)
+
+#include <learnopengl/window.hpp>
+#include <learnopengl/shader.hpp>
+#include <learnopengl/mesh.hpp>
+#include <learnopengl/geometrypool.hpp>
+#include <learnopengl/multidrawbatch.hpp>
+#include <learnopengl/primitives.hpp>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/matrix_inverse.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+// Only the submission is timed, glFinish keeps frames from piling up in the driver
+template<typename Function>
+double measureMs(int frames, Function&& function)
+{
+    double total = 0.;
+    for(int i = 0; i < frames; ++i)
+    {
+        const auto start = Clock::now();
+        function();
+        total += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        glFinish();
+    }
+    return total / frames;
+}
+
+int main(int argc, char** argv)
+{
+    auto* window = learnopengl::createWindow();
+    if(!window)
+        return -1;
+
+    if(!learnopengl::MultiDrawBatch::supported())
+    {
+        std::cerr << "glMultiDrawElementsIndirect needs OpenGL 4.3" << std::endl;
+        glfwTerminate();
+        return -1;
+    }
+
+    glfwSwapInterval(0);
+    glEnable(GL_DEPTH_TEST);
+
+    auto meshShader = learnopengl::Shader("resources/shaders/mesh.vs", "resources/shaders/mesh.fs");
+    auto multiDrawShader = learnopengl::Shader("resources/shaders/multidraw.vs", "resources/shaders/mesh.fs");
+
+    const std::vector<learnopengl::Texture> materials = {
+        learnopengl::Texture("resources/textures/container.jpg", {.name = "texture_diffuse"}),
+        learnopengl::Texture("resources/textures/container2.png", {.name = "texture_diffuse"}),
+        learnopengl::Texture("resources/textures/awesomeface.png", {.name = "texture_diffuse"}),
+        learnopengl::Texture("resources/textures/matrix.jpg", {.name = "texture_diffuse"}),
+    };
+
+    const auto view = glm::lookAt(glm::vec3(0.f, 0.f, 60.f), glm::vec3(0.f), glm::vec3(0.f, 1.f, 0.f));
+    const auto projection = glm::perspective(glm::radians(70.f), 4.f / 3.f, 0.1f, 200.f);
+    for(const auto* shader: {&meshShader, &multiDrawShader})
+    {
+        shader->use();
+        shader->setMat4("view", glm::value_ptr(view));
+        shader->setMat4("projection", glm::value_ptr(projection));
+    }
+
+    std::cout << std::setw(8) << "meshes" << std::setw(18) << "per mesh (ms)" << std::setw(18) << "mdi dynamic (ms)" << std::setw(18)
+              << "mdi static (ms)" << std::setw(12) << "mdi calls" << std::endl;
+
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> position(-40.f, 40.f);
+    std::uniform_real_distribution<float> angle(0.f, 6.28f);
+
+    // Each mesh is its own pool allocation, as for a model with thousands of small meshes
+    const auto cube = learnopengl::createCube();
+
+    for(const std::size_t count: {1'000u, 4'000u, 16'000u})
+    {
+        learnopengl::GeometryPool pool;
+        std::vector<std::unique_ptr<learnopengl::Mesh>> meshes;
+        std::vector<glm::mat4> models;
+        std::vector<std::uint32_t> meshMaterials;
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            const auto material = std::uint32_t(i % materials.size());
+            meshes.push_back(std::make_unique<learnopengl::Mesh>(cube.vertices,
+                cube.indices,
+                std::vector<learnopengl::Texture>{materials[material]},
+                &pool));
+            meshMaterials.push_back(material);
+            models.push_back(glm::rotate(glm::translate(glm::mat4(1.f), {position(random), position(random), position(random)}),
+                angle(random),
+                glm::vec3(0.f, 1.f, 0.f)));
+        }
+
+        const int frames = 100;
+
+        // Same work as Model::draw: matrices uniforms, textures and one draw per mesh
+        const auto perMeshMs = measureMs(frames,
+            [&]()
+            {
+                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+                meshShader.use();
+                pool.beginBatch();
+                for(std::size_t i = 0; i < count; ++i)
+                {
+                    meshShader.setMat4("model", glm::value_ptr(models[i]));
+                    const glm::mat3 normalModelMatrix = glm::inverseTranspose(glm::mat3(models[i]));
+                    meshShader.setMat3("normalModelMatrix", glm::value_ptr(normalModelMatrix));
+                    meshes[i]->draw(meshShader);
+                }
+                pool.endBatch();
+            });
+
+        const auto bindMaterial = [&](std::uint32_t material)
+        {
+            materials[material].use(0);
+            multiDrawShader.setInt("material.texture_diffuse1", 0);
+        };
+
+        // Commands and per draw data rebuilt every frame
+        learnopengl::MultiDrawBatch dynamicBatch(pool, learnopengl::MultiDrawBatch::Usage::Dynamic);
+        const auto dynamicMs = measureMs(frames,
+            [&]()
+            {
+                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+                multiDrawShader.use();
+                dynamicBatch.clear();
+                for(std::size_t i = 0; i < count; ++i) dynamicBatch.add(meshes[i]->geometryHandle(), models[i], meshMaterials[i]);
+                dynamicBatch.upload();
+                dynamicBatch.resetFrameStats();
+                dynamicBatch.draw(bindMaterial);
+            });
+
+        // Commands uploaded once
+        learnopengl::MultiDrawBatch staticBatch(pool, learnopengl::MultiDrawBatch::Usage::Static);
+        for(std::size_t i = 0; i < count; ++i) staticBatch.add(meshes[i]->geometryHandle(), models[i], meshMaterials[i]);
+        staticBatch.upload();
+        const auto staticMs = measureMs(frames,
+            [&]()
+            {
+                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+                multiDrawShader.use();
+                staticBatch.resetFrameStats();
+                staticBatch.draw(bindMaterial);
+            });
+
+        std::cout << std::setw(8) << count << std::fixed << std::setprecision(3) << std::setw(18) << perMeshMs << std::setw(18) << dynamicMs
+                  << std::setw(18) << staticMs << std::setw(12) << staticBatch.stats().multiDrawCalls << std::endl;
+    }
+
+    glfwTerminate();
+
+    return 0;
+}
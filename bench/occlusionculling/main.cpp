@@ -0,0 +1,142 @@
+// CPU occlusion culling with learnopengl::OcclusionBuffer, without OpenGL: occluder rasterization scalar vs SIMD (same depth expected),
+// pyramid build, and box test throughput with the number of frustum survivors hidden behind the occluders
+
+#include <learnopengl/camera.hpp>
+#include <learnopengl/frustum.hpp>
+#include <learnopengl/occlusionbuffer.hpp>
+#include <learnopengl/primitives.hpp>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+template<typename Function>
+double measureMs(int iterations, Function&& function)
+{
+    const auto start = Clock::now();
+    for(int i = 0; i < iterations; ++i) function();
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count() / iterations;
+}
+
+int main(int argc, char** argv)
+{
+    std::mt19937 random(42);
+
+    // Street level view over a city block grid: buildings are the occluders
+    learnopengl::Camera camera;
+    camera.setFovDegrees(70.f);
+    camera.setAspect(16.f / 9.f);
+    camera.setCameraPos(glm::vec3(0.f, 1.7f, 0.f));
+    camera.setCameraFront(glm::vec3(0.f, 0.f, -1.f));
+    const auto viewProjection = camera.projectionMatrix() * camera.viewMatrix();
+
+    const auto cube = learnopengl::createCube();
+    std::uniform_real_distribution<float> width(6.f, 14.f);
+    std::uniform_real_distribution<float> height(5.f, 30.f);
+    std::vector<glm::mat4> buildings;
+    for(int row = 0; row < 10; ++row)
+    {
+        for(int column = 0; column < 10; ++column)
+        {
+            const float buildingHeight = height(random);
+            const glm::vec3 center(float(column) * 20.f - 90.f, buildingHeight * 0.5f, -10.f - float(row) * 20.f);
+            const glm::vec3 scale(width(random), buildingHeight, width(random));
+            buildings.push_back(glm::scale(glm::translate(glm::mat4(1.f), center), scale));
+        }
+    }
+
+    learnopengl::OcclusionBuffer simdBuffer;
+    learnopengl::OcclusionBuffer scalarBuffer;
+    const auto* positions = &cube.vertices[0].position;
+    const auto stride = sizeof(learnopengl::Mesh::Vertex);
+    const auto rasterize = [&](learnopengl::OcclusionBuffer& buffer, bool simd)
+    {
+        buffer.clear(viewProjection, camera.near());
+        for(const auto& model: buildings)
+        {
+            if(simd)
+                buffer.rasterize(model, positions, stride, cube.vertices.size(), cube.indices);
+            else
+                buffer.rasterizeScalar(model, positions, stride, cube.vertices.size(), cube.indices);
+        }
+    };
+
+    const int iterations = 200;
+    const auto scalarMs = measureMs(iterations, [&]() { rasterize(scalarBuffer, false); });
+    const auto simdMs = measureMs(iterations, [&]() { rasterize(simdBuffer, true); });
+    const auto finishMs = measureMs(iterations, [&]() { simdBuffer.finish(); });
+    scalarBuffer.finish();
+
+    // Same arithmetic in both paths, only contracted multiply adds may differ
+    const auto scalarDepth = scalarBuffer.depth();
+    const auto simdDepth = simdBuffer.depth();
+    std::size_t mismatchCount = 0;
+    std::size_t coveredCount = 0;
+    for(std::size_t i = 0; i < simdDepth.size(); ++i)
+    {
+        if(std::abs(scalarDepth[i] - simdDepth[i]) > 1e-5f * std::max(scalarDepth[i], 1e-3f))
+            ++mismatchCount;
+        if(simdDepth[i] > 0.f)
+            ++coveredCount;
+    }
+
+    const auto& stats = simdBuffer.stats();
+    std::cout << "occlusion buffer " << simdBuffer.width() << "x" << simdBuffer.height() << ", " << simdBuffer.levelCount() << " levels, "
+              << buildings.size() << " occluders, " << stats.triangleCount << " triangles (" << stats.rasterizedCount << " rasterized), "
+              << std::fixed << std::setprecision(1) << 100. * double(coveredCount) / double(simdDepth.size()) << "% covered" << std::endl;
+    std::cout << std::setprecision(3) << "rasterize scalar " << scalarMs << " ms, simd " << simdMs << " ms (x" << std::setprecision(2)
+              << scalarMs / simdMs << std::setprecision(3) << "), finish " << finishMs << " ms" << std::endl;
+    if(mismatchCount)
+        std::cerr << "SIMD and scalar rasterization differ in " << mismatchCount << " pixels" << std::endl;
+
+    std::cout << std::endl
+              << std::setw(10) << "boxes" << std::setw(12) << "in frustum" << std::setw(12) << "occluded" << std::setw(16) << "frustum (ms)"
+              << std::setw(18) << "occlusion (ms)" << std::setw(20) << "occlusion (Mbox/s)" << std::endl;
+
+    // Objects of the street and the blocks, from pebbles to cars
+    std::uniform_real_distribution<float> x(-100.f, 100.f);
+    std::uniform_real_distribution<float> y(0.f, 10.f);
+    std::uniform_real_distribution<float> z(-200.f, 0.f);
+    std::uniform_real_distribution<float> size(0.2f, 2.f);
+    for(const std::size_t count: {1'000u, 100'000u, 1'000'000u})
+    {
+        learnopengl::AABBArray boxes;
+        boxes.reserve(count);
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            const glm::vec3 center(x(random), y(random), z(random));
+            const glm::vec3 extent(size(random), size(random), size(random));
+            boxes.push_back({center - extent, center + extent});
+        }
+
+        std::vector<std::uint8_t> inFrustum(count);
+        std::vector<std::uint8_t> visible(count);
+        const int boxIterations = count >= 1'000'000u ? 5 : 50;
+
+        std::size_t inFrustumCount = 0;
+        std::size_t occludedCount = 0;
+        const auto frustumMs = measureMs(boxIterations, [&]() { inFrustumCount = camera.cull(boxes, inFrustum.data()); });
+        const auto occlusionMs = measureMs(boxIterations,
+            [&]()
+            {
+                visible = inFrustum;
+                occludedCount = simdBuffer.cull(boxes, visible.data());
+            });
+
+        std::cout << std::setw(10) << count << std::setw(12) << inFrustumCount << std::setw(12) << occludedCount << std::fixed
+                  << std::setprecision(3) << std::setw(16) << frustumMs << std::setw(18) << occlusionMs << std::setprecision(1)
+                  << std::setw(20) << double(inFrustumCount) / occlusionMs / 1000. << std::endl;
+    }
+
+    return 0;
+}
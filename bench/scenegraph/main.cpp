@@ -0,0 +1,102 @@
+// World transform update throughput of learnopengl::SceneGraph
+
+#include <learnopengl/scenegraph.hpp>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+using Clock = std::chrono::steady_clock;
+
+void addChildren(learnopengl::SceneGraph& sceneGraph,
+    learnopengl::SceneGraph::NodeIndex parent,
+    int depth,
+    std::size_t nodeCount,
+    std::mt19937& random)
+{
+    std::uniform_real_distribution<float> offset(-1.f, 1.f);
+    std::uniform_int_distribution<int> branch(1, 8);
+
+    const int children = depth < 12 ? branch(random) : 0;
+    for(int i = 0; i < children && sceneGraph.size() < nodeCount; ++i)
+    {
+        auto local = glm::translate(glm::mat4(1.f), glm::vec3(offset(random), offset(random), offset(random)));
+        local = glm::rotate(local, offset(random), glm::vec3(0.f, 1.f, 0.f));
+        // Depth first insertion keep subtrees contiguous
+        addChildren(sceneGraph, sceneGraph.addNode(parent, local), depth + 1, nodeCount, random);
+    }
+}
+
+void buildScene(learnopengl::SceneGraph& sceneGraph, std::size_t nodeCount, std::mt19937& random)
+{
+    sceneGraph.clear();
+    sceneGraph.reserve(nodeCount);
+
+    // Forest of random trees until the node count is reached
+    while(sceneGraph.size() < nodeCount)
+        addChildren(sceneGraph, sceneGraph.addNode(learnopengl::SceneGraph::InvalidNode), 0, nodeCount, random);
+
+    sceneGraph.updateWorldMatrices();
+}
+
+// Return the average duration in nanoseconds of one updateWorldMatrices call after touching dirtyCount random nodes
+double measure(learnopengl::SceneGraph& sceneGraph, std::size_t dirtyCount, int iterations, std::mt19937& random, std::size_t& updated)
+{
+    std::uniform_int_distribution<learnopengl::SceneGraph::NodeIndex> node(0, learnopengl::SceneGraph::NodeIndex(sceneGraph.size() - 1));
+
+    double totalNs = 0;
+    updated = 0;
+    for(int i = 0; i < iterations; ++i)
+    {
+        if(dirtyCount >= sceneGraph.size())
+        {
+            sceneGraph.setLocalMatrix(0, sceneGraph.localMatrix(0));
+        }
+        else
+        {
+            for(std::size_t j = 0; j < dirtyCount; ++j)
+            {
+                const auto n = node(random);
+                sceneGraph.setLocalMatrix(n, sceneGraph.localMatrix(n));
+            }
+        }
+
+        const auto start = Clock::now();
+        updated += sceneGraph.updateWorldMatrices();
+        totalNs += double(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+    }
+    updated /= std::size_t(iterations);
+    return totalNs / iterations;
+}
+
+int main(int argc, char** argv)
+{
+    std::mt19937 random(42);
+    learnopengl::SceneGraph sceneGraph;
+
+    std::cout << std::setw(10) << "nodes" << std::setw(12) << "dirty" << std::setw(12) << "updated" << std::setw(14) << "time (us)"
+              << std::setw(18) << "Mnodes/s" << std::endl;
+
+    for(const std::size_t nodeCount: {10'000u, 100'000u, 1'000'000u})
+    {
+        buildScene(sceneGraph, nodeCount, random);
+        const int iterations = nodeCount >= 1'000'000u ? 10 : 100;
+
+        // From the root (full update), to a few touched nodes (incremental update)
+        for(const std::size_t dirtyCount: {nodeCount, nodeCount / 100, std::size_t(10)})
+        {
+            std::size_t updated = 0;
+            const auto ns = measure(sceneGraph, dirtyCount, iterations, random, updated);
+            std::cout << std::setw(10) << nodeCount << std::setw(12) << (dirtyCount >= nodeCount ? std::string("root") : std::to_string(dirtyCount))
+                      << std::setw(12) << updated << std::setw(14) << std::fixed << std::setprecision(1) << ns / 1000.0 << std::setw(18)
+                      << std::setprecision(2) << (ns > 0 ? double(nodeCount) / ns * 1000.0 : 0.0) << std::endl;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,182 @@
+// Quality against cost of learnopengl::AmbientOcclusion at full, half and quarter resolution, with and without temporal
+// accumulation, at 1080p in a room of boxes and spheres: GPU time of each pass, and error of the full resolution result against a
+// reference computed at full resolution with 64 samples accumulated over 256 frames (mean absolute error and pixels off by more
+// than 0.1, mostly along edges). Temporal configurations are measured once accumulated over the 30 frames of the run, the
+// camera being still. Needs an OpenGL context, LEARNOPENGL_HEADLESS=1 renders without display.
+
+#include <learnopengl/window.hpp>
+#include <learnopengl/shader.hpp>
+#include <learnopengl/camera.hpp>
+#include <learnopengl/frameprofiler.hpp>
+#include <learnopengl/gbuffer.hpp>
+#include <learnopengl/ambientocclusion.hpp>
+#include <learnopengl/mesh.hpp>
+#include <learnopengl/instancedmesh.hpp>
+#include <learnopengl/primitives.hpp>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+int main(int argc, char** argv)
+{
+    auto* window = learnopengl::createWindow();
+    if(!window)
+        return -1;
+
+    glfwSwapInterval(0);
+    glEnable(GL_DEPTH_TEST);
+
+    auto geometryShader = learnopengl::Shader("resources/shaders/instanced.vs", "resources/shaders/gbufferflat.fs");
+
+    // Room with stacked boxes and spheres, as 5.advanced_lighting/9.ssao
+    const auto cube = learnopengl::createCube();
+    const learnopengl::Mesh cubeMesh(cube.vertices, cube.indices, {});
+    const auto sphere = learnopengl::createSphere(48, 24);
+    const learnopengl::Mesh sphereMesh(sphere.vertices, sphere.indices, {});
+    learnopengl::InstancedMesh boxes(cubeMesh);
+    boxes.add(glm::scale(glm::translate(glm::mat4(1.f), glm::vec3(0.f, -0.5f, 0.f)), glm::vec3(16.f, 1.f, 16.f)));
+    boxes.add(glm::scale(glm::translate(glm::mat4(1.f), glm::vec3(0.f, 4.f, -8.5f)), glm::vec3(16.f, 10.f, 1.f)));
+    boxes.add(glm::scale(glm::translate(glm::mat4(1.f), glm::vec3(-8.5f, 4.f, 0.f)), glm::vec3(1.f, 10.f, 16.f)));
+    boxes.add(glm::scale(glm::translate(glm::mat4(1.f), glm::vec3(8.5f, 4.f, 0.f)), glm::vec3(1.f, 10.f, 16.f)));
+    for(int x = -3; x <= 3; ++x)
+    {
+        for(int y = 0; y < 4 - std::abs(x) / 2; ++y)
+        {
+            const glm::vec3 position(1.1f * float(x), 0.5f + float(y), -7.4f + 0.15f * float(y % 2));
+            boxes.add(glm::rotate(glm::translate(glm::mat4(1.f), position), glm::radians(7.f * float(x + y)), glm::vec3(0.f, 1.f, 0.f)));
+        }
+    }
+    boxes.upload();
+    learnopengl::InstancedMesh spheres(sphereMesh);
+    for(int i = 0; i < 5; ++i)
+    {
+        const float radius = 0.4f + 0.2f * float(i);
+        spheres.add(glm::scale(glm::translate(glm::mat4(1.f), glm::vec3(-4.f + 2.f * float(i), radius, -1.f - 0.5f * float(i % 2))),
+            glm::vec3(radius)));
+    }
+    spheres.upload();
+
+    constexpr int Width = 1920;
+    constexpr int Height = 1080;
+    learnopengl::Camera camera;
+    camera.setFovDegrees(60.f);
+    camera.setAspect(float(Width) / float(Height));
+    camera.setCameraPos(glm::vec3(0.f, 3.f, 7.f));
+    camera.setCameraFront(glm::normalize(glm::vec3(0.f, -0.3f, -1.f)));
+
+    learnopengl::GBuffer gbuffer(Width, Height);
+    gbuffer.beginGeometryPass();
+    geometryShader.use();
+    geometryShader.setMat4("view", glm::value_ptr(camera.viewMatrix()));
+    geometryShader.setMat4("projection", glm::value_ptr(camera.projectionMatrix()));
+    gbuffer.setEncoding(geometryShader);
+    boxes.draw(geometryShader);
+    spheres.draw(geometryShader);
+    glDisable(GL_STENCIL_TEST);
+
+    const auto readOcclusion = [](const learnopengl::AmbientOcclusion& ambientOcclusion)
+    {
+        std::vector<std::uint8_t> pixels(std::size_t(ambientOcclusion.width()) * std::size_t(ambientOcclusion.height()));
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glBindTexture(GL_TEXTURE_2D, ambientOcclusion.texture());
+        glGetTexImage(GL_TEXTURE_2D, 0, GL_RED, GL_UNSIGNED_BYTE, pixels.data());
+        glBindTexture(GL_TEXTURE_2D, 0);
+        return pixels;
+    };
+
+    learnopengl::AmbientOcclusion::Settings referenceSettings;
+    referenceSettings.resolution = learnopengl::AmbientOcclusion::Resolution::Full;
+    referenceSettings.sampleCount = learnopengl::AmbientOcclusion::MaxSampleCount;
+    referenceSettings.temporalBlend = 1.f / 64.f;
+    learnopengl::AmbientOcclusion referenceOcclusion(Width, Height, referenceSettings);
+    for(int frame = 0; frame < 256; ++frame) referenceOcclusion.compute(gbuffer, camera);
+    const auto reference = readOcclusion(referenceOcclusion);
+
+    learnopengl::FrameProfiler profiler;
+    const auto scopeMs = [&](const char* name)
+    {
+        const auto statistics = profiler.scopeStatistics(name, learnopengl::FrameProfiler::Metric::Gpu);
+        return statistics.count ? statistics.mean : -1.;
+    };
+    const auto cell = [](int width, double value, int precision)
+    {
+        std::ostringstream stream;
+        if(value < 0.)
+            stream << std::setw(width) << "-";
+        else
+            stream << std::setw(width) << std::fixed << std::setprecision(precision) << value;
+        return stream.str();
+    };
+
+    std::cout << std::setw(11) << "resolution" << std::setw(10) << "reduced" << std::setw(10) << "temporal" << std::setw(17)
+              << "downsample (ms)" << std::setw(11) << "ssao (ms)" << std::setw(15) << "temporal (ms)" << std::setw(15) << "upsample (ms)"
+              << std::setw(12) << "total (ms)" << std::setw(12) << "mean error" << std::setw(12) << "error>0.1" << std::endl;
+
+    using Resolution = learnopengl::AmbientOcclusion::Resolution;
+    for(const auto resolution: {Resolution::Full, Resolution::Half, Resolution::Quarter})
+    {
+        for(const bool temporal: {false, true})
+        {
+            learnopengl::AmbientOcclusion::Settings settings;
+            settings.resolution = resolution;
+            settings.temporal = temporal;
+            learnopengl::AmbientOcclusion ambientOcclusion(Width, Height, settings);
+
+            constexpr int Frames = 30;
+            profiler.clearHistory();
+            for(int frame = 0; frame < Frames; ++frame)
+            {
+                profiler.beginFrame();
+                ambientOcclusion.compute(gbuffer, camera, &profiler);
+                profiler.endFrame();
+            }
+            // Resolve the last frames
+            glFinish();
+            for(int frame = 0; frame < 4; ++frame)
+            {
+                profiler.beginFrame();
+                profiler.endFrame();
+            }
+
+            const auto occlusion = readOcclusion(ambientOcclusion);
+            double errorSum = 0.;
+            std::size_t largeErrors = 0;
+            for(std::size_t i = 0; i < occlusion.size(); ++i)
+            {
+                const double error = std::abs(double(occlusion[i]) - double(reference[i])) / 255.;
+                errorSum += error;
+                largeErrors += error > 0.1;
+            }
+
+            const double downsampleMs = scopeMs(learnopengl::AmbientOcclusion::DownsampleScope);
+            const double occlusionMs = scopeMs(learnopengl::AmbientOcclusion::OcclusionScope);
+            const double temporalMs = scopeMs(learnopengl::AmbientOcclusion::TemporalScope);
+            const double upsampleMs = scopeMs(learnopengl::AmbientOcclusion::UpsampleScope);
+            const double totalMs = downsampleMs + occlusionMs + std::max(temporalMs, 0.) + upsampleMs;
+            std::ostringstream reduced;
+            reduced << ambientOcclusion.reducedWidth() << "x" << ambientOcclusion.reducedHeight();
+            std::cout << std::setw(6) << Width << "x" << std::setw(4) << std::left << Height << std::right << std::setw(10) << reduced.str()
+                      << std::setw(10) << (temporal ? "on" : "off") << cell(17, downsampleMs, 3) << cell(11, occlusionMs, 3)
+                      << cell(15, temporalMs, 3) << cell(15, upsampleMs, 3) << cell(12, totalMs, 3)
+                      << cell(12, errorSum / double(occlusion.size()), 4)
+                      << cell(11, 100. * double(largeErrors) / double(occlusion.size()), 2) << "%" << std::endl;
+        }
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, learnopengl::defaultFramebuffer());
+    glfwTerminate();
+
+    return 0;
+}
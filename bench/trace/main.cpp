@@ -0,0 +1,60 @@
+// Cost of a trace scope: tracing disabled at runtime, enabled on one thread and on several threads at once.
+// With an argument, the recorded events are written to that path as a Chrome trace.
+
+#include <learnopengl/trace.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int ScopeCount = 1'000'000;
+
+// Nanoseconds per scope, nested two levels as in instrumented code
+double measureScopes(int scopes)
+{
+    const auto start = Clock::now();
+    for(int i = 0; i < scopes / 2; ++i)
+    {
+        const learnopengl::TraceScope outer("outer");
+        const learnopengl::TraceScope inner("inner");
+    }
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / double(scopes);
+}
+
+int main(int argc, char** argv)
+{
+    std::cout << std::fixed << std::setprecision(2);
+
+    learnopengl::setTracingEnabled(false);
+    measureScopes(ScopeCount);
+    std::cout << "disabled        " << std::setw(8) << measureScopes(ScopeCount) << " ns/scope" << std::endl;
+
+    learnopengl::setTracingEnabled(true);
+    std::cout << "enabled         " << std::setw(8) << measureScopes(ScopeCount) << " ns/scope" << std::endl;
+
+    const auto threadCount = std::max(2u, std::thread::hardware_concurrency());
+    std::vector<double> threadNs(threadCount);
+    std::vector<std::thread> threads;
+    for(unsigned i = 0; i < threadCount; ++i) threads.emplace_back([&, i]() { threadNs[i] = measureScopes(ScopeCount); });
+    for(auto& thread: threads) thread.join();
+
+    double total = 0.;
+    for(const auto ns: threadNs) total += ns;
+    std::cout << "enabled " << std::setw(2) << threadCount << " threads" << std::setw(8) << total / double(threadCount) << " ns/scope"
+              << std::endl;
+
+#ifndef LEARNOPENGL_TRACING
+    std::cout << "LEARNOPENGL_TRACE_SCOPE is compiled out (LEARNOPENGL_TRACING=OFF): 0 ns/scope in instrumented code" << std::endl;
+#endif
+
+    learnopengl::setTracingEnabled(false);
+    if(argc > 1 && learnopengl::writeChromeTrace(argv[1]))
+        std::cout << "Trace written to " << argv[1] << std::endl;
+
+    return 0;
+}
@@ -7,7 +7,12 @@ FetchContent_Declare(
 )
 set(GLAD_PROFILE "core" CACHE STRING "OpenGL profile")
 set(GLAD_API "gl=" CACHE STRING "API type/version pairs, like \"gl=3.2,gles=\", no version means latest")
-set(GLAD_GENERATOR "c" CACHE STRING "Language to generate the binding for")
+if(LEARNOPENGL_GL_CALL_COUNTERS)
+  # Debug loader calls a callback after every OpenGL call, used by learnopengl::Benchmark to count draws and state changes
+  set(GLAD_GENERATOR "c-debug" CACHE STRING "Language to generate the binding for" FORCE)
+else()
+  set(GLAD_GENERATOR "c" CACHE STRING "Language to generate the binding for" FORCE)
+endif()
 
 FetchContent_MakeAvailable(glad)
 
@@ -0,0 +1,321 @@
+#include <learnopengl/ambientocclusion.hpp>
+#include <learnopengl/camera.hpp>
+#include <learnopengl/depthstate.hpp>
+#include <learnopengl/frameprofiler.hpp>
+#include <learnopengl/gbuffer.hpp>
+#include <learnopengl/shader.hpp>
+
+#include <glad/glad.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <algorithm>
+#include <random>
+#include <string>
+
+namespace learnopengl {
+
+namespace {
+
+int divisor(AmbientOcclusion::Resolution resolution)
+{
+    switch(resolution)
+    {
+    case AmbientOcclusion::Resolution::Full: return 1;
+    case AmbientOcclusion::Resolution::Half: return 2;
+    case AmbientOcclusion::Resolution::Quarter: return 4;
+    default: return 1;
+    }
+}
+
+std::uint32_t createTexture(GLenum internalFormat, GLenum format, GLenum type, int width, int height, GLenum filter)
+{
+    std::uint32_t texture = 0;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GLint(internalFormat), width, height, 0, format, type, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GLint(filter));
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GLint(filter));
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return texture;
+}
+
+std::uint32_t createFramebuffer(std::uint32_t colorTexture)
+{
+    std::uint32_t framebuffer = 0;
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, colorTexture, 0);
+    return framebuffer;
+}
+
+void bindTexture(const Shader& shader, const char* sampler, std::uint32_t unit, std::uint32_t texture)
+{
+    glActiveTexture(GL_TEXTURE0 + unit);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    shader.setInt(sampler, int(unit));
+}
+
+}
+
+AmbientOcclusion::AmbientOcclusion(int width, int height) : AmbientOcclusion(width, height, Settings{}) {}
+
+AmbientOcclusion::AmbientOcclusion(int width, int height, const Settings& settings) :
+    _settings(settings), _width(std::max(width, 1)), _height(std::max(height, 1))
+{
+    _downsampleShader = std::make_unique<Shader>("resources/shaders/deferredfullscreen.vs", "resources/shaders/ssaodownsample.fs");
+    _occlusionShader = std::make_unique<Shader>("resources/shaders/deferredfullscreen.vs", "resources/shaders/ssao.fs");
+    _temporalShader = std::make_unique<Shader>("resources/shaders/deferredfullscreen.vs", "resources/shaders/ssaotemporal.fs");
+    _upsampleShader = std::make_unique<Shader>("resources/shaders/deferredfullscreen.vs", "resources/shaders/ssaoupsample.fs");
+    glGenVertexArrays(1, &_fullScreenVao);
+
+    generateKernel();
+    allocate();
+}
+
+AmbientOcclusion::~AmbientOcclusion()
+{
+    release();
+    glDeleteVertexArrays(1, &_fullScreenVao);
+}
+
+void AmbientOcclusion::resize(int width, int height)
+{
+    width = std::max(width, 1);
+    height = std::max(height, 1);
+    if(width == _width && height == _height)
+        return;
+    release();
+    _width = width;
+    _height = height;
+    allocate();
+}
+
+void AmbientOcclusion::setSettings(const Settings& settings)
+{
+    const bool reallocate = settings.resolution != _settings.resolution;
+    const bool regenerate = settings.sampleCount != _settings.sampleCount;
+    _settings = settings;
+    if(reallocate)
+    {
+        release();
+        allocate();
+    }
+    if(regenerate)
+        generateKernel();
+}
+
+void AmbientOcclusion::allocate()
+{
+    const int reduction = divisor(_settings.resolution);
+    _reducedWidth = std::max((_width + reduction - 1) / reduction, 1);
+    _reducedHeight = std::max((_height + reduction - 1) / reduction, 1);
+
+    GLint previousFramebuffer = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
+
+    for(auto& reduced: _reduced)
+    {
+        reduced.depthTexture = createTexture(GL_R32F, GL_RED, GL_FLOAT, _reducedWidth, _reducedHeight, GL_NEAREST);
+        reduced.normalTexture = createTexture(GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, _reducedWidth, _reducedHeight, GL_NEAREST);
+        reduced.framebuffer = createFramebuffer(reduced.depthTexture);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, reduced.normalTexture, 0);
+        const GLenum drawBuffers[] = {GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1};
+        glDrawBuffers(2, drawBuffers);
+    }
+
+    // 16 bits keep small blend weights of the history from rounding away
+    _occlusion.texture = createTexture(GL_R16F, GL_RED, GL_HALF_FLOAT, _reducedWidth, _reducedHeight, GL_NEAREST);
+    _occlusion.framebuffer = createFramebuffer(_occlusion.texture);
+    for(auto& history: _history)
+    {
+        history.texture = createTexture(GL_R16F, GL_RED, GL_HALF_FLOAT, _reducedWidth, _reducedHeight, GL_LINEAR);
+        history.framebuffer = createFramebuffer(history.texture);
+    }
+
+    _resultTexture = createTexture(GL_R8, GL_RED, GL_UNSIGNED_BYTE, _width, _height, GL_NEAREST);
+    _resultFramebuffer = createFramebuffer(_resultTexture);
+    glBindFramebuffer(GL_FRAMEBUFFER, GLuint(previousFramebuffer));
+    _historyValid = false;
+}
+
+void AmbientOcclusion::release()
+{
+    for(auto& reduced: _reduced)
+    {
+        glDeleteFramebuffers(1, &reduced.framebuffer);
+        const std::uint32_t textures[] = {reduced.depthTexture, reduced.normalTexture};
+        glDeleteTextures(2, textures);
+        reduced = {};
+    }
+    for(auto* target: {&_occlusion, &_history[0], &_history[1]})
+    {
+        glDeleteFramebuffers(1, &target->framebuffer);
+        glDeleteTextures(1, &target->texture);
+        *target = {};
+    }
+    glDeleteFramebuffers(1, &_resultFramebuffer);
+    glDeleteTextures(1, &_resultTexture);
+    _resultFramebuffer = 0;
+    _resultTexture = 0;
+}
+
+void AmbientOcclusion::generateKernel()
+{
+    // Hemisphere around +z, samples gathered near the center as in the LearnOpenGL chapter
+    const auto sampleCount = std::clamp<std::uint32_t>(_settings.sampleCount, 1, MaxSampleCount);
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> unit(0.f, 1.f);
+    _kernel.resize(sampleCount);
+    for(std::uint32_t i = 0; i < sampleCount; ++i)
+    {
+        const glm::vec3 direction = glm::normalize(glm::vec3(unit(random) * 2.f - 1.f, unit(random) * 2.f - 1.f, unit(random)));
+        const float scale = float(i) / float(sampleCount);
+        _kernel[i] = direction * unit(random) * glm::mix(0.1f, 1.f, scale * scale);
+    }
+
+    _occlusionShader->use();
+    for(std::uint32_t i = 0; i < sampleCount; ++i)
+        _occlusionShader->setVec3("samples[" + std::to_string(i) + "]", _kernel[i].x, _kernel[i].y, _kernel[i].z);
+    _occlusionShader->setInt("sampleCount", int(sampleCount));
+}
+
+void AmbientOcclusion::compute(const GBuffer& gbuffer, const Camera& camera, FrameProfiler* profiler)
+{
+    computeFrom(gbuffer.depthStencilTexture(), &gbuffer, camera, profiler);
+}
+
+void AmbientOcclusion::compute(std::uint32_t depthTexture, const Camera& camera, FrameProfiler* profiler)
+{
+    computeFrom(depthTexture, nullptr, camera, profiler);
+}
+
+void AmbientOcclusion::computeFrom(std::uint32_t depthTexture, const GBuffer* gbuffer, const Camera& camera, FrameProfiler* profiler)
+{
+    GLint framebuffer = 0;
+    GLint viewport[4];
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &framebuffer);
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    const bool depthTest = glIsEnabled(GL_DEPTH_TEST);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_BLEND);
+    glBindVertexArray(_fullScreenVao);
+
+    const auto& view = camera.viewMatrix();
+    const auto& projection = camera.projectionMatrix();
+    const auto inverseProjection = glm::inverse(projection);
+    const bool zeroToOne = zeroToOneClipDepth();
+    const int reduction = divisor(_settings.resolution);
+
+    // Each frame writes the other reduced target and history, the previous ones are read by the temporal pass
+    const auto previous = _current;
+    _current = 1 - _current;
+    const auto& reduced = _reduced[_current];
+
+    const auto setDepthUniforms = [&](const Shader& shader)
+    {
+        shader.setMat4("inverseProjection", glm::value_ptr(inverseProjection));
+        shader.setVec2("depthToNdc", zeroToOne ? 1.f : 2.f, zeroToOne ? 0.f : -1.f);
+        shader.setBool("reverseZ", camera.reverseZ());
+        shader.setVec2("projectionScale", projection[0][0], projection[1][1]);
+    };
+
+    // Linear depth and view normals at the reduced resolution
+    if(profiler)
+        profiler->beginScope(DownsampleScope);
+    glBindFramebuffer(GL_FRAMEBUFFER, reduced.framebuffer);
+    glViewport(0, 0, _reducedWidth, _reducedHeight);
+    _downsampleShader->use();
+    setDepthUniforms(*_downsampleShader);
+    bindTexture(*_downsampleShader, "sourceDepth", 0, depthTexture);
+    bindTexture(*_downsampleShader, "sourceNormal", 1, gbuffer ? gbuffer->normalTexture() : 0);
+    if(gbuffer)
+        gbuffer->setEncoding(*_downsampleShader);
+    _downsampleShader->setBool("reconstructNormals", gbuffer == nullptr);
+    _downsampleShader->setInt("divisor", reduction);
+    const glm::mat3 viewNormalMatrix(view);
+    _downsampleShader->setMat3("viewNormalMatrix", glm::value_ptr(viewNormalMatrix));
+    drawFullScreen();
+    if(profiler)
+        profiler->endScope();
+
+    if(profiler)
+        profiler->beginScope(OcclusionScope);
+    glBindFramebuffer(GL_FRAMEBUFFER, _occlusion.framebuffer);
+    _occlusionShader->use();
+    setDepthUniforms(*_occlusionShader);
+    bindTexture(*_occlusionShader, "reducedDepth", 0, reduced.depthTexture);
+    bindTexture(*_occlusionShader, "reducedNormal", 1, reduced.normalTexture);
+    _occlusionShader->setFloat("radius", _settings.radius);
+    _occlusionShader->setFloat("bias", _settings.bias);
+    _occlusionShader->setFloat("power", _settings.power);
+    // A still noise without history
+    _occlusionShader->setInt("frameIndex", _settings.temporal ? int(_frameIndex % 64) : 0);
+    drawFullScreen();
+    if(profiler)
+        profiler->endScope();
+
+    auto occlusionTexture = _occlusion.texture;
+    if(_settings.temporal)
+    {
+        if(profiler)
+            profiler->beginScope(TemporalScope);
+        glBindFramebuffer(GL_FRAMEBUFFER, _history[_current].framebuffer);
+        _temporalShader->use();
+        setDepthUniforms(*_temporalShader);
+        bindTexture(*_temporalShader, "currentOcclusion", 0, _occlusion.texture);
+        bindTexture(*_temporalShader, "currentDepth", 1, reduced.depthTexture);
+        bindTexture(*_temporalShader, "history", 2, _history[previous].texture);
+        bindTexture(*_temporalShader, "historyDepth", 3, _reduced[previous].depthTexture);
+        // View space of this frame to clip space of the previous one
+        const auto reprojection = _previousViewProjection * glm::inverse(view);
+        _temporalShader->setMat4("reprojection", glm::value_ptr(reprojection));
+        _temporalShader->setBool("historyValid", _historyValid);
+        _temporalShader->setFloat("blend", _settings.temporalBlend);
+        drawFullScreen();
+        if(profiler)
+            profiler->endScope();
+        occlusionTexture = _history[_current].texture;
+    }
+    _historyValid = _settings.temporal;
+
+    if(profiler)
+        profiler->beginScope(UpsampleScope);
+    glBindFramebuffer(GL_FRAMEBUFFER, _resultFramebuffer);
+    glViewport(0, 0, _width, _height);
+    _upsampleShader->use();
+    setDepthUniforms(*_upsampleShader);
+    bindTexture(*_upsampleShader, "sourceDepth", 0, depthTexture);
+    bindTexture(*_upsampleShader, "reducedOcclusion", 1, occlusionTexture);
+    bindTexture(*_upsampleShader, "reducedDepth", 2, reduced.depthTexture);
+    _upsampleShader->setInt("divisor", reduction);
+    drawFullScreen();
+    if(profiler)
+        profiler->endScope();
+
+    _previousViewProjection = projection * view;
+    ++_frameIndex;
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindVertexArray(0);
+    glBindFramebuffer(GL_FRAMEBUFFER, GLuint(framebuffer));
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+    if(depthTest)
+        glEnable(GL_DEPTH_TEST);
+}
+
+void AmbientOcclusion::bind(const Shader& shader, std::uint32_t unit) const
+{
+    bindTexture(shader, "ambientOcclusion", unit, _resultTexture);
+    glActiveTexture(GL_TEXTURE0);
+    shader.setBool("ambientOcclusionEnabled", true);
+}
+
+void AmbientOcclusion::unbind(const Shader& shader) { shader.setBool("ambientOcclusionEnabled", false); }
+
+void AmbientOcclusion::drawFullScreen() const { glDrawArrays(GL_TRIANGLES, 0, 3); }
+
+}
@@ -0,0 +1,150 @@
+#ifndef __LEARNOPENGL_AMBIENT_OCCLUSION_HPP__
+#define __LEARNOPENGL_AMBIENT_OCCLUSION_HPP__
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace learnopengl {
+
+class Camera;
+class FrameProfiler;
+class GBuffer;
+class Shader;
+
+// Screen space ambient occlusion at full, half or quarter resolution. Depth (and the normals of a GBuffer, or normals
+// reconstructed from depth for a forward depth prepass) is first reduced to linear depth and view space normals, keeping the
+// nearest or farthest depth of each footprint in a checkerboard so both sides of edges survive. A hemisphere kernel is
+// rotated per pixel by interleaved gradient noise, offset every frame, then accumulated over frames with reprojection and a
+// depth test against the history. A depth-aware bilateral upsample writes the full resolution R8 result, which lighting
+// shaders read with resources/shaders/ambientocclusion.glsl.
+class AmbientOcclusion
+{
+public:
+    enum class Resolution
+    {
+        Full,
+        Half,
+        Quarter,
+    };
+
+    struct Settings
+    {
+        Resolution resolution = Resolution::Half;
+        // Kernel samples per pixel, up to MaxSampleCount
+        std::uint32_t sampleCount = 16;
+        // View space radius of the hemisphere
+        float radius = 0.5f;
+        // Depth difference ignored against self occlusion
+        float bias = 0.025f;
+        // Exponent of the visibility, above 1 darkens
+        float power = 1.5f;
+        // Reprojected history, the noise offset changes every frame
+        bool temporal = true;
+        // Weight of the current frame in the history
+        float temporalBlend = 0.1f;
+    };
+
+    static constexpr std::uint32_t MaxSampleCount = 64;
+
+    // Profiler scopes of compute
+    static constexpr const char* DownsampleScope = "ssao downsample";
+    static constexpr const char* OcclusionScope = "ssao";
+    static constexpr const char* TemporalScope = "ssao temporal";
+    static constexpr const char* UpsampleScope = "ssao upsample";
+
+public:
+    // Size of the depth the occlusion is computed from
+    AmbientOcclusion(int width, int height, const Settings& settings);
+    AmbientOcclusion(int width, int height);
+    ~AmbientOcclusion();
+
+    AmbientOcclusion(const AmbientOcclusion&) = delete;
+    AmbientOcclusion& operator=(const AmbientOcclusion&) = delete;
+
+    // Reallocate targets when the size changed, the history restarts
+    void resize(int width, int height);
+
+    // Occlusion of the geometry pass of gbuffer, rendered through camera. Each pass is a scope of profiler.
+    // Framebuffer and viewport are restored, depth test is restored and blending left off.
+    void compute(const GBuffer& gbuffer, const Camera& camera, FrameProfiler* profiler = nullptr);
+    // Occlusion from a depth texture of width x height pixels only (e.g. a forward depth prepass), normals are reconstructed
+    void compute(std::uint32_t depthTexture, const Camera& camera, FrameProfiler* profiler = nullptr);
+
+    // Bind the result on a texture unit and set the uniforms of ambientocclusion.glsl, the shader must be in use
+    void bind(const Shader& shader, std::uint32_t unit) const;
+    // Leave ambientocclusion.glsl unoccluded, the shader must be in use
+    static void unbind(const Shader& shader);
+
+    [[nodiscard]] const Settings& settings() const { return _settings; }
+    // Changing the resolution reallocates the targets
+    void setSettings(const Settings& settings);
+    // Drop the history, e.g. on camera cuts
+    void resetHistory() { _historyValid = false; }
+
+    [[nodiscard]] int width() const { return _width; }
+    [[nodiscard]] int height() const { return _height; }
+    // Size of the occlusion pass
+    [[nodiscard]] int reducedWidth() const { return _reducedWidth; }
+    [[nodiscard]] int reducedHeight() const { return _reducedHeight; }
+    // Full resolution R8, 1 unoccluded
+    [[nodiscard]] std::uint32_t texture() const { return _resultTexture; }
+
+private:
+    // Reduced linear depth with view normals, one per frame for the history test
+    struct ReducedTarget
+    {
+        std::uint32_t depthTexture = 0;
+        std::uint32_t normalTexture = 0;
+        std::uint32_t framebuffer = 0;
+    };
+
+    // Color target with its framebuffer
+    struct Target
+    {
+        std::uint32_t texture = 0;
+        std::uint32_t framebuffer = 0;
+    };
+
+    void allocate();
+    void release();
+    void generateKernel();
+
+    // Normals of gbuffer when not null, reconstructed from depth otherwise
+    void computeFrom(std::uint32_t depthTexture, const GBuffer* gbuffer, const Camera& camera, FrameProfiler* profiler);
+    void drawFullScreen() const;
+
+    Settings _settings;
+    int _width = 0;
+    int _height = 0;
+    int _reducedWidth = 0;
+    int _reducedHeight = 0;
+
+    ReducedTarget _reduced[2];
+    Target _occlusion;
+    Target _history[2];
+    std::uint32_t _resultTexture = 0;
+    std::uint32_t _resultFramebuffer = 0;
+    // Target of the current frame in _reduced and _history
+    std::uint32_t _current = 0;
+
+    std::vector<glm::vec3> _kernel;
+    std::uint32_t _frameIndex = 0;
+    bool _historyValid = false;
+    // Camera of the last frame, reprojecting the history
+    glm::mat4 _previousViewProjection = glm::mat4(1.f);
+
+    std::unique_ptr<Shader> _downsampleShader;
+    std::unique_ptr<Shader> _occlusionShader;
+    std::unique_ptr<Shader> _temporalShader;
+    std::unique_ptr<Shader> _upsampleShader;
+    // Empty, the full screen triangle comes from gl_VertexID
+    std::uint32_t _fullScreenVao = 0;
+};
+
+}
+
+#endif
@@ -0,0 +1,291 @@
+#include <learnopengl/benchmark.hpp>
+#include <learnopengl/camera.hpp>
+#include <learnopengl/camerapath.hpp>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <type_traits>
+
+namespace learnopengl {
+
+std::unique_ptr<Benchmark> Benchmark::_active;
+
+namespace {
+
+std::uint64_t drawCalls = 0;
+std::uint64_t stateChanges = 0;
+
+#ifdef GLAD_DEBUG
+bool isStateChange(const char* name)
+{
+    constexpr const char* prefixes[] = {"glBind",
+        "glUseProgram",
+        "glActiveTexture",
+        "glEnable",
+        "glDisable",
+        "glBlend",
+        "glDepthFunc",
+        "glDepthMask",
+        "glStencil",
+        "glCullFace",
+        "glFrontFace",
+        "glColorMask",
+        "glPolygonMode",
+        "glViewport",
+        "glClipControl"};
+    for(const auto* prefix: prefixes)
+    {
+        if(std::strncmp(name, prefix, std::strlen(prefix)) == 0)
+            return true;
+    }
+    return false;
+}
+
+// Called by the glad debug loader after every OpenGL call
+void countGLCall(const char* name, void* function, int argumentCount, ...)
+{
+    if(std::strncmp(name, "glDraw", 6) == 0 || std::strncmp(name, "glMultiDraw", 11) == 0)
+        ++drawCalls;
+    else if(isStateChange(name))
+        ++stateChanges;
+}
+#endif
+
+double clockSeconds() { return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+
+template<typename T>
+T environmentValue(const char* name, T fallback)
+{
+    const char* value = std::getenv(name);
+    if(!value || !*value)
+        return fallback;
+    if constexpr(std::is_floating_point_v<T>)
+        return T(std::atof(value));
+    else
+        return T(std::atoll(value));
+}
+
+// Nearest rank percentile of unsorted values
+double percentile(std::vector<double> values, double rank)
+{
+    if(values.empty())
+        return 0.;
+    const auto index = std::min(values.size() - 1, std::size_t(rank * double(values.size())));
+    std::nth_element(values.begin(), values.begin() + std::ptrdiff_t(index), values.end());
+    return values[index];
+}
+
+}
+
+Benchmark& Benchmark::start(const Settings& settings)
+{
+    _active.reset(new Benchmark(settings));
+    return *_active;
+}
+
+Benchmark* Benchmark::startFromEnvironment()
+{
+    const char* outputPath = std::getenv("LEARNOPENGL_BENCHMARK");
+    if(!outputPath || !*outputPath)
+        return nullptr;
+
+    Settings settings;
+    settings.outputPath = outputPath;
+    settings.name = std::filesystem::path(outputPath).stem().string();
+    settings.frameCount = environmentValue("LEARNOPENGL_BENCHMARK_FRAMES", settings.frameCount);
+    settings.warmupFrames = environmentValue("LEARNOPENGL_BENCHMARK_WARMUP", settings.warmupFrames);
+    settings.timestep = environmentValue("LEARNOPENGL_BENCHMARK_TIMESTEP", settings.timestep);
+    settings.seed = environmentValue("LEARNOPENGL_BENCHMARK_SEED", settings.seed);
+    if(const char* cameraPath = std::getenv("LEARNOPENGL_BENCHMARK_CAMERA_PATH"))
+        settings.cameraPath = cameraPath;
+    return &start(settings);
+}
+
+Benchmark* Benchmark::active() { return _active.get(); }
+
+std::uint32_t Benchmark::seed() { return _active ? _active->_settings.seed : DefaultSeed; }
+
+Benchmark::Benchmark(const Settings& settings) : _settings(settings)
+{
+    // Frame time must not be bound to the display refresh rate
+    glfwSwapInterval(0);
+    glfwSetTime(0.);
+    std::srand(_settings.seed);
+
+#ifdef GLAD_DEBUG
+    glad_set_post_callback(countGLCall);
+#else
+    std::cout << "Benchmark: draw calls and state changes are not counted, configure with LEARNOPENGL_GL_CALL_COUNTERS=ON" << std::endl;
+#endif
+    drawCalls = 0;
+    stateChanges = 0;
+
+    if(!_settings.cameraPath.empty())
+    {
+        CameraPath path;
+        if(path.loadByName(_settings.cameraPath))
+            _cameraPath = std::make_unique<CameraPathPlayer>(std::move(path), float(_settings.timestep));
+    }
+
+    glGenQueries(GLsizei(QueryCount), _queries);
+    _records.reserve(std::size_t(_settings.frameCount));
+    _timestamps.reserve(std::size_t(_settings.warmupFrames + _settings.frameCount + 1));
+
+    queryTimestamp();
+    _lastFrameTime = clockSeconds();
+}
+
+Benchmark::~Benchmark() { glDeleteQueries(GLsizei(QueryCount), _queries); }
+
+void Benchmark::animateCamera(Camera& camera) const
+{
+    // Warmup frames stay on the first pose
+    if(_cameraPath)
+    {
+        camera.setPose(_cameraPath->pose(std::uint64_t(std::max(_frame - _settings.warmupFrames, 0))));
+        return;
+    }
+
+    if(_frame < _settings.warmupFrames || _settings.frameCount <= 0)
+        return;
+
+    // Same angle every frame, the path only depends on the frame count
+    const float step = 2.f * glm::pi<float>() / float(_settings.frameCount);
+    camera.orbitCenter(step, 0.f, 1.f, 1.f);
+}
+
+void Benchmark::queryTimestamp()
+{
+    // Ring is full: the oldest query must be read before being reused
+    if(_issuedTimestamps - _readTimestamps == QueryCount)
+        readTimestamps(true);
+
+    glQueryCounter(_queries[_issuedTimestamps % QueryCount], GL_TIMESTAMP);
+    ++_issuedTimestamps;
+}
+
+void Benchmark::readTimestamps(bool wait)
+{
+    while(_readTimestamps < _issuedTimestamps)
+    {
+        const auto query = _queries[_readTimestamps % QueryCount];
+        if(!wait)
+        {
+            GLint available = 0;
+            glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+            if(!available)
+                return;
+        }
+
+        GLuint64 timestamp = 0;
+        glGetQueryObjectui64v(query, GL_QUERY_RESULT, &timestamp);
+        _timestamps.push_back(timestamp);
+        ++_readTimestamps;
+    }
+}
+
+void Benchmark::endFrame(GLFWwindow* window)
+{
+    if(_finished)
+        return;
+
+    const auto now = clockSeconds();
+    const auto cpuMs = (now - _lastFrameTime) * 1000.;
+    _lastFrameTime = now;
+
+    queryTimestamp();
+    readTimestamps(false);
+
+    if(_frame >= _settings.warmupFrames)
+        _records.push_back({_frame - _settings.warmupFrames, cpuMs, 0., drawCalls, stateChanges});
+    drawCalls = 0;
+    stateChanges = 0;
+
+    ++_frame;
+    // Animations and CameraController only see the fixed timestep
+    glfwSetTime(double(_frame) * _settings.timestep);
+
+    if(_frame < _settings.warmupFrames + _settings.frameCount)
+        return;
+
+    readTimestamps(true);
+    for(auto& record: _records)
+    {
+        const auto frame = std::size_t(record.frame + _settings.warmupFrames);
+        record.gpuMs = double(_timestamps[frame + 1] - _timestamps[frame]) / 1e6;
+    }
+
+    _finished = true;
+    write();
+    glfwSetWindowShouldClose(window, true);
+}
+
+void Benchmark::write() const
+{
+    std::vector<double> cpuMs;
+    std::vector<double> gpuMs;
+    for(const auto& record: _records)
+    {
+        cpuMs.push_back(record.cpuMs);
+        gpuMs.push_back(record.gpuMs);
+    }
+
+    std::cout << std::fixed << std::setprecision(3) << "Benchmark " << _settings.name << ": " << _records.size() << " frames, cpu p50 "
+              << percentile(cpuMs, 0.5) << " ms p95 " << percentile(cpuMs, 0.95) << " ms, gpu p50 " << percentile(gpuMs, 0.5)
+              << " ms p95 " << percentile(gpuMs, 0.95) << " ms" << std::endl;
+
+    if(_settings.outputPath.empty())
+        return;
+
+    std::ofstream file(_settings.outputPath);
+    if(!file)
+    {
+        std::cerr << "Benchmark: can't write " << _settings.outputPath << std::endl;
+        return;
+    }
+    file << std::fixed << std::setprecision(4);
+
+    if(std::filesystem::path(_settings.outputPath).extension() == ".json")
+    {
+        file << "{\n";
+        file << "  \"name\": \"" << _settings.name << "\",\n";
+        file << "  \"frameCount\": " << _settings.frameCount << ",\n";
+        file << "  \"warmupFrames\": " << _settings.warmupFrames << ",\n";
+        file << "  \"timestep\": " << _settings.timestep << ",\n";
+        file << "  \"seed\": " << _settings.seed << ",\n";
+        file << "  \"cameraPath\": \"" << _settings.cameraPath << "\",\n";
+        file << "  \"cpuMsP50\": " << percentile(cpuMs, 0.5) << ",\n";
+        file << "  \"cpuMsP95\": " << percentile(cpuMs, 0.95) << ",\n";
+        file << "  \"gpuMsP50\": " << percentile(gpuMs, 0.5) << ",\n";
+        file << "  \"gpuMsP95\": " << percentile(gpuMs, 0.95) << ",\n";
+        file << "  \"frames\": [\n";
+        for(std::size_t i = 0; i < _records.size(); ++i)
+        {
+            const auto& record = _records[i];
+            file << "    {\"frame\": " << record.frame << ", \"cpuMs\": " << record.cpuMs << ", \"gpuMs\": " << record.gpuMs
+                 << ", \"drawCalls\": " << record.drawCalls << ", \"stateChanges\": " << record.stateChanges << "}"
+                 << (i + 1 < _records.size() ? ",\n" : "\n");
+        }
+        file << "  ]\n}\n";
+        return;
+    }
+
+    file << "frame,cpu_ms,gpu_ms,draw_calls,state_changes\n";
+    for(const auto& record: _records)
+    {
+        file << record.frame << "," << record.cpuMs << "," << record.gpuMs << "," << record.drawCalls << "," << record.stateChanges << "\n";
+    }
+}
+
+}
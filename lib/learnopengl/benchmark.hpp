@@ -0,0 +1,108 @@
+#ifndef __LEARNOPENGL_BENCHMARK_HPP__
+#define __LEARNOPENGL_BENCHMARK_HPP__
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct GLFWwindow;
+
+namespace learnopengl {
+
+class Camera;
+class CameraPathPlayer;
+
+// Run a demo for a fixed workload and record per frame timings.
+// While a benchmark is active, frames end in showFPS: glfw time advances by a fixed timestep, CameraController follows a scripted
+// camera path instead of user input, and the window is closed once every frame is recorded.
+// Started by createWindow when the LEARNOPENGL_BENCHMARK environment variable is set:
+//   LEARNOPENGL_BENCHMARK=<output path>  .json for JSON, CSV otherwise. The demo name is the file name without extension.
+//   LEARNOPENGL_BENCHMARK_FRAMES         recorded frames (300)
+//   LEARNOPENGL_BENCHMARK_WARMUP         frames run before recording (10)
+//   LEARNOPENGL_BENCHMARK_TIMESTEP       seconds per frame (1/60)
+//   LEARNOPENGL_BENCHMARK_SEED           random seed (42)
+//   LEARNOPENGL_BENCHMARK_CAMERA_PATH    camera path name or file (see CameraPath) replayed instead of the orbit
+// Draw calls and state changes are only counted when built with LEARNOPENGL_GL_CALL_COUNTERS (glad debug generator).
+class Benchmark
+{
+public:
+    struct Settings
+    {
+        std::string name = "benchmark";
+        // Empty to only print the summary
+        std::string outputPath;
+        int frameCount = 300;
+        int warmupFrames = 10;
+        double timestep = 1. / 60.;
+        std::uint32_t seed = 42;
+        // Empty for a full orbit around the camera center
+        std::string cameraPath;
+    };
+
+    struct FrameRecord
+    {
+        int frame = 0;
+        double cpuMs = 0.;
+        double gpuMs = 0.;
+        std::uint64_t drawCalls = 0;
+        std::uint64_t stateChanges = 0;
+    };
+
+    static constexpr std::uint32_t DefaultSeed = 42;
+
+public:
+    // Need a current OpenGL context. Replace the active benchmark.
+    static Benchmark& start(const Settings& settings);
+    // Start from environment variables, return null when LEARNOPENGL_BENCHMARK is not set
+    static Benchmark* startFromEnvironment();
+    // Null when no benchmark is running
+    [[nodiscard]] static Benchmark* active();
+    // Seed to use for random generators: benchmark seed when active, DefaultSeed otherwise
+    [[nodiscard]] static std::uint32_t seed();
+
+    ~Benchmark();
+
+    [[nodiscard]] const Settings& settings() const { return _settings; }
+    // Frame index since start, warmup included
+    [[nodiscard]] int frame() const { return _frame; }
+    [[nodiscard]] bool finished() const { return _finished; }
+    [[nodiscard]] const std::vector<FrameRecord>& records() const { return _records; }
+
+    // Move camera along the scripted path for the current frame: the camera path one timestep per frame when set,
+    // a full turn around its center over the recorded frames otherwise
+    void animateCamera(Camera& camera) const;
+
+    // Called once per presented frame
+    void endFrame(GLFWwindow* window);
+
+    // Write records to settings output path and print a summary
+    void write() const;
+
+private:
+    explicit Benchmark(const Settings& settings);
+
+    void queryTimestamp();
+    void readTimestamps(bool wait);
+
+    Settings _settings;
+    int _frame = 0;
+    bool _finished = false;
+
+    // GPU timestamps of frame boundaries, read a few frames later to not stall the pipeline
+    static constexpr std::size_t QueryCount = 8;
+    std::uint32_t _queries[QueryCount] = {};
+    std::size_t _issuedTimestamps = 0;
+    std::size_t _readTimestamps = 0;
+    std::vector<std::uint64_t> _timestamps;
+
+    double _lastFrameTime = 0.;
+    std::unique_ptr<CameraPathPlayer> _cameraPath;
+    std::vector<FrameRecord> _records;
+
+    static std::unique_ptr<Benchmark> _active;
+};
+
+}
+
+#endif
@@ -0,0 +1,118 @@
+#ifndef __LEARNOPENGL_BOUNDING_VOLUME_HPP__
+#define __LEARNOPENGL_BOUNDING_VOLUME_HPP__
+
+#include <glm/vec3.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/geometric.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace learnopengl {
+
+// Axis aligned bounding box
+struct AABB
+{
+    glm::vec3 min = glm::vec3(std::numeric_limits<float>::max());
+    glm::vec3 max = glm::vec3(std::numeric_limits<float>::lowest());
+
+    [[nodiscard]] bool valid() const { return min.x <= max.x && min.y <= max.y && min.z <= max.z; }
+    [[nodiscard]] glm::vec3 center() const { return (min + max) * 0.5f; }
+    [[nodiscard]] glm::vec3 extent() const { return (max - min) * 0.5f; }
+
+    void expand(const glm::vec3& point)
+    {
+        min = glm::min(min, point);
+        max = glm::max(max, point);
+    }
+
+    // Bounding box of this box once transformed (Arvo's method, exact for the 8 corners)
+    [[nodiscard]] AABB transformed(const glm::mat4& matrix) const
+    {
+        const auto c = glm::vec3(matrix * glm::vec4(center(), 1.f));
+        const auto e = extent();
+        const glm::vec3 transformedExtent = glm::abs(glm::vec3(matrix[0])) * e.x + glm::abs(glm::vec3(matrix[1])) * e.y +
+                                            glm::abs(glm::vec3(matrix[2])) * e.z;
+        return {c - transformedExtent, c + transformedExtent};
+    }
+};
+
+struct BoundingSphere
+{
+    glm::vec3 center = glm::vec3(0.f);
+    float radius = 0.f;
+};
+
+// Cone of a spot light: from apex along the normalized direction, up to range from the apex, within the half angle
+struct BoundingCone
+{
+    glm::vec3 apex = glm::vec3(0.f);
+    glm::vec3 direction = glm::vec3(0.f, 0.f, -1.f);
+    float range = 0.f;
+    float cosHalfAngle = 0.f;
+
+    // Smallest sphere around the cone
+    [[nodiscard]] BoundingSphere boundingSphere() const
+    {
+        const float cosAngle = std::fmin(std::fmax(cosHalfAngle, 0.f), 1.f);
+        // Wide cones: the sphere around the base disk does not hold the apex
+        if(cosAngle < std::sqrt(0.5f))
+            return {apex + direction * (range * cosAngle), range * std::sqrt(1.f - cosAngle * cosAngle)};
+
+        const float radius = range / (2.f * cosAngle);
+        return {apex + direction * radius, radius};
+    }
+};
+
+// Structure of arrays storage of boxes as center/extent, the layout expected by SIMD culling kernels
+class AABBArray
+{
+public:
+    void clear()
+    {
+        for(auto* array: arrays()) array->clear();
+    }
+
+    void reserve(std::size_t count)
+    {
+        for(auto* array: arrays()) array->reserve(count);
+    }
+
+    void push_back(const AABB& box)
+    {
+        const auto c = box.center();
+        const auto e = box.extent();
+        _centerX.push_back(c.x);
+        _centerY.push_back(c.y);
+        _centerZ.push_back(c.z);
+        _extentX.push_back(e.x);
+        _extentY.push_back(e.y);
+        _extentZ.push_back(e.z);
+    }
+
+    [[nodiscard]] std::size_t size() const { return _centerX.size(); }
+    [[nodiscard]] bool empty() const { return _centerX.empty(); }
+
+    [[nodiscard]] const float* centerX() const { return _centerX.data(); }
+    [[nodiscard]] const float* centerY() const { return _centerY.data(); }
+    [[nodiscard]] const float* centerZ() const { return _centerZ.data(); }
+    [[nodiscard]] const float* extentX() const { return _extentX.data(); }
+    [[nodiscard]] const float* extentY() const { return _extentY.data(); }
+    [[nodiscard]] const float* extentZ() const { return _extentZ.data(); }
+
+private:
+    std::vector<std::vector<float>*> arrays() { return {&_centerX, &_centerY, &_centerZ, &_extentX, &_extentY, &_extentZ}; }
+
+    std::vector<float> _centerX;
+    std::vector<float> _centerY;
+    std::vector<float> _centerZ;
+    std::vector<float> _extentX;
+    std::vector<float> _extentY;
+    std::vector<float> _extentZ;
+};
+
+}
+
+#endif
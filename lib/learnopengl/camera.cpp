@@ -5,9 +5,27 @@
 #include <glm/gtc/matrix_inverse.hpp>
 
 #include <algorithm>
+#include <cmath>
 
 namespace learnopengl {
 
+glm::mat4 reverseZInfinitePerspective(float fovy, float aspect, float near)
+{
+    const float focal = 1.f / std::tan(fovy / 2.f);
+
+    glm::mat4 projection(0.f);
+    projection[0][0] = focal / aspect;
+    projection[1][1] = focal;
+    projection[2][3] = -1.f;
+    projection[3][2] = near;
+    return projection;
+}
+
+CameraPose mix(const CameraPose& a, const CameraPose& b, float t)
+{
+    return {glm::mix(a.position, b.position, t), glm::mix(a.center, b.center, t), glm::mix(a.fovDegrees, b.fovDegrees, t)};
+}
+
 Camera::Camera() = default;
 
 void Camera::move(Movement movement, float delta)
@@ -145,6 +163,14 @@ void Camera::setFovDegrees(float fov)
     _projectionMatrixDirty = true;
 }
 
+void Camera::setPose(const CameraPose& pose)
+{
+    _cameraPos = pose.position;
+    _cameraCenter = pose.center;
+    _viewMatrixDirty = true;
+    setFovDegrees(pose.fovDegrees);
+}
+
 void Camera::setAspect(float aspect)
 {
     if(!glm::epsilonEqual(_aspect, aspect, 0.01f))
@@ -160,6 +186,7 @@ const glm::mat4& Camera::viewMatrix() const
     {
         _viewMatrixDirty = false;
         _viewMatrix = glm::lookAt(_cameraPos, _cameraCenter, _cameraUp);
+        _frustumDirty = true;
     }
     return _viewMatrix;
 }
@@ -169,8 +196,23 @@ const glm::mat4& Camera::projectionMatrix() const
     if(_projectionMatrixDirty)
     {
         _projectionMatrixDirty = false;
-        _projectionMatrix = glm::perspective(_fov, _aspect, _near, _far);
+        _projectionMatrix = _reverseZ ? reverseZInfinitePerspective(_fov, _aspect, _near) : glm::perspective(_fov, _aspect, _near, _far);
+        _frustumDirty = true;
     }
     return _projectionMatrix;
 }
+
+const Frustum& Camera::frustum() const
+{
+    // Matrix getters flag the frustum when they recompute
+    const auto& view = viewMatrix();
+    const auto& projection = projectionMatrix();
+    if(_frustumDirty)
+    {
+        _frustumDirty = false;
+        _frustum = Frustum(projection * view);
+    }
+    return _frustum;
+}
+
 }
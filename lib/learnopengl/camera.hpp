@@ -1,11 +1,34 @@
 #ifndef __LEARNOPENGL_CAMERA_HPP__
 #define __LEARNOPENGL_CAMERA_HPP__
 
+#include <learnopengl/frustum.hpp>
+
 #include <glm/vec3.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
+#include <cstdint>
+#include <span>
+
 namespace learnopengl {
 
+// Perspective projection with depth 1 at the near plane tending to 0 at infinity (clip z = near, w = -z view).
+// Depth then follows the float exponent instead of collapsing near the far plane. Zero to one clip depth (glClipControl) keeps
+// that precision, with the OpenGL default [-1, 1] clip depth, window depth only spans [0.5, 1].
+[[nodiscard]] glm::mat4 reverseZInfinitePerspective(float fovy, float aspect, float near);
+
+// What a camera path records of a camera
+struct CameraPose
+{
+    glm::vec3 position = glm::vec3(0.f);
+    glm::vec3 center = glm::vec3(0.f);
+    float fovDegrees = 45.f;
+
+    [[nodiscard]] bool operator==(const CameraPose&) const = default;
+};
+
+// Linear interpolation from a to b, for poses close to each other like two simulation ticks
+[[nodiscard]] CameraPose mix(const CameraPose& a, const CameraPose& b, float t);
+
 // Mix of Camera & CameraController
 class Camera
 {
@@ -33,19 +56,34 @@ public:
     // Camera API
 public:
     void setFovDegrees(float fov);
+    [[nodiscard]] float fovDegrees() const { return glm::degrees(_fov); }
     void setAspect(float aspect);
 
+    [[nodiscard]] CameraPose pose() const { return {_cameraPos, _cameraCenter, fovDegrees()}; }
+    void setPose(const CameraPose& pose);
+
     const glm::mat4& viewMatrix() const;
     const glm::mat4& projectionMatrix() const;
 
+    // Planes of projection * view, extracted again only when one of the matrices changed
+    const Frustum& frustum() const;
+    // Write 1 in visible for each box intersecting the frustum, 0 otherwise, see Frustum::cull. Return the number of visible boxes.
+    std::size_t cull(std::span<const AABB> boxes, std::span<std::uint8_t> visible) const { return frustum().cull(boxes, visible); }
+    std::size_t cull(const AABBArray& boxes, std::uint8_t* visible) const { return frustum().cull(boxes, visible); }
+
     const glm::vec3& cameraPos() const { return _cameraPos; }
-    void setCameraPos(const glm::vec3& cameraPos) { _cameraPos = cameraPos; }
+    void setCameraPos(const glm::vec3& cameraPos)
+    {
+        _cameraPos = cameraPos;
+        _viewMatrixDirty = true;
+    }
 
     glm::vec3 cameraFront() const { return glm::normalize(_cameraCenter - _cameraPos); }
     void setCameraFront(const glm::vec3& cameraFront)
     {
         const auto distanceToCenter = glm::length(_cameraCenter - _cameraPos);
         _cameraCenter = _cameraPos + cameraFront * distanceToCenter;
+        _viewMatrixDirty = true;
     }
 
     glm::vec3 cameraRight() const { return glm::normalize(glm::cross(cameraFront(), _cameraUp)); }
@@ -59,6 +97,7 @@ public:
         _projectionMatrixDirty = true;
     }
 
+    // With reverse-Z the projection has no far plane, far is only used by effects fading with distance
     [[nodiscard]] float far() const { return _far; }
 
     void setFar(float far)
@@ -67,6 +106,15 @@ public:
         _projectionMatrixDirty = true;
     }
 
+    // Project with reverseZInfinitePerspective, the depth state must match, see applyDepthState
+    [[nodiscard]] bool reverseZ() const { return _reverseZ; }
+
+    void setReverseZ(bool reverseZ)
+    {
+        _reverseZ = reverseZ;
+        _projectionMatrixDirty = true;
+    }
+
 private:
     glm::vec3 _cameraPos = glm::vec3(0.0f, 0.0f, 3.0f);
     glm::vec3 _cameraCenter = glm::vec3(0.0f, 0.0f, 0.0f);
@@ -81,12 +129,16 @@ private:
     float _aspect = 1.f;
     float _near = 0.1f;
     float _far = 100.f;
+    bool _reverseZ = false;
 
     mutable bool _viewMatrixDirty = true;
     mutable bool _projectionMatrixDirty = true;
+    // Set when either matrix is recomputed
+    mutable bool _frustumDirty = true;
 
     mutable glm::mat4 _viewMatrix = glm::mat4(1);
     mutable glm::mat4 _projectionMatrix = glm::mat4(1);
+    mutable Frustum _frustum;
 };
 
 }
@@ -1,31 +1,179 @@
 #include <learnopengl/cameracontroller.hpp>
 #include <learnopengl/camera.hpp>
+#include <learnopengl/window.hpp>
+#include <learnopengl/benchmark.hpp>
+#include <learnopengl/camerapath.hpp>
+#include <learnopengl/fpscounter.hpp>
+#include <learnopengl/framepacing.hpp>
 #include <GLFW/glfw3.h>
 
+#include <algorithm>
+#include <cstdlib>
+#include <optional>
+
 namespace learnopengl {
 
-CameraController::CameraController(Camera* camera) : _camera(camera) {}
+CameraController::CameraController(Camera* camera) : _camera(camera)
+{
+    const char* recordPath = std::getenv("LEARNOPENGL_RECORD_CAMERA");
+    if(recordPath && *recordPath)
+        _recorder = std::make_unique<CameraPathRecorder>(recordPath);
+}
+
+CameraController::~CameraController() = default;
 
 void CameraController::processInput(GLFWwindow* window)
 {
-    const auto currentFrame = float(glfwGetTime());
-    _deltaTime = currentFrame - _lastFrame;
-    _lastFrame = currentFrame;
+    const auto currentFrame = glfwGetTime();
+
+    // Camera moved by someone else since the last frame: start again from there
+    if(_camera && _ticking && _camera->pose() != _renderedPose)
+        _ticking = false;
+
+    // Simulation continues from the last tick, not from the interpolated pose shown
+    if(_camera && _ticking)
+        _camera->setPose(_currentPose);
+
+    const bool eventsApplied = applyEvents(window);
 
     if(!_camera)
         return;
 
+    // Scripted camera path instead of user input
+    if(auto* benchmark = Benchmark::active())
+    {
+        benchmark->animateCamera(*_camera);
+        _ticking = false;
+        return;
+    }
+
+    // Mouse manipulation is shown as is, without interpolating from the pose before it
+    if(!_ticking || eventsApplied)
+    {
+        _previousPose = _camera->pose();
+        _currentPose = _previousPose;
+        _ticking = true;
+    }
+
+    _timestep.update(currentFrame,
+        [&](double tickSeconds)
+        {
+            _previousPose = _currentPose;
+            applyKeys(window, float(tickSeconds));
+            _currentPose = _camera->pose();
+        });
+
+    _camera->setPose(mix(_previousPose, _currentPose, _timestep.alpha()));
+    _renderedPose = _camera->pose();
+
+    if(_recorder)
+        _recorder->record(float(currentFrame), *_camera);
+}
+
+void CameraController::applyKeys(GLFWwindow* window, float delta)
+{
     if(glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS)
-        _camera->move(learnopengl::Camera::Movement::Forward, _deltaTime);
+        _camera->move(learnopengl::Camera::Movement::Forward, delta);
     if(glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS)
-        _camera->move(learnopengl::Camera::Movement::Backward, _deltaTime);
+        _camera->move(learnopengl::Camera::Movement::Backward, delta);
     if(glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS)
-        _camera->move(learnopengl::Camera::Movement::Left, _deltaTime);
+        _camera->move(learnopengl::Camera::Movement::Left, delta);
     if(glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS)
-        _camera->move(learnopengl::Camera::Movement::Right, _deltaTime);
+        _camera->move(learnopengl::Camera::Movement::Right, delta);
 }
 
 void CameraController::mouseButtonCallback(GLFWwindow* window, int button, int action, int mods)
+{
+    InputEvent event;
+    event.type = InputEvent::Type::MouseButton;
+    event.button = button;
+    event.action = action;
+    event.mods = mods;
+    pushEvent(event);
+}
+
+void CameraController::mouseMoveCallback(GLFWwindow* window, float xpos, float ypos)
+{
+    InputEvent event;
+    event.type = InputEvent::Type::MouseMove;
+    event.x = xpos;
+    event.y = ypos;
+    pushEvent(event);
+}
+
+void CameraController::scrollCallback(float offset)
+{
+    InputEvent event;
+    event.type = InputEvent::Type::Scroll;
+    event.y = offset;
+    pushEvent(event);
+}
+
+void CameraController::pushEvent(InputEvent event)
+{
+    event.time = std::chrono::steady_clock::now();
+    if(!_events.push(event))
+        _droppedEvents.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool CameraController::applyEvents(GLFWwindow* window)
+{
+    // Only the last position of consecutive moves is applied, offsets are relative to the last applied position so the motion is the same.
+    // Consecutive scrolls are summed.
+    std::optional<InputEvent> pendingMove;
+    float pendingScroll = 0.f;
+    std::optional<std::chrono::steady_clock::time_point> oldest;
+    int width = 0;
+    int height = 0;
+    // Moves without a pressed button and scrolls clamped by the fov range leave the camera as is
+    const auto poseBefore = _camera ? _camera->pose() : CameraPose();
+
+    const auto flush = [&]()
+    {
+        if(pendingMove)
+        {
+            if(!width)
+                getWindowSize(window, &width, &height);
+            applyMouseMove(pendingMove->x, pendingMove->y, std::max(width, 1), std::max(height, 1));
+            pendingMove.reset();
+        }
+        if(pendingScroll != 0.f && _camera)
+            _camera->zoomFov(pendingScroll);
+        pendingScroll = 0.f;
+    };
+
+    while(const auto event = _events.pop())
+    {
+        if(!oldest)
+            oldest = event->time;
+
+        switch(event->type)
+        {
+        case InputEvent::Type::MouseMove:
+            if(pendingScroll != 0.f)
+                flush();
+            pendingMove = *event;
+            break;
+        case InputEvent::Type::Scroll:
+            if(pendingMove)
+                flush();
+            pendingScroll += event->y;
+            break;
+        case InputEvent::Type::MouseButton:
+            flush();
+            applyMouseButton(window, event->button, event->action, event->mods);
+            break;
+        }
+    }
+    flush();
+
+    // Latency until the frame rendered with these events is presented
+    if(oldest)
+        framePacingMonitor(window).inputApplied(*oldest);
+    return _camera && _camera->pose() != poseBefore;
+}
+
+void CameraController::applyMouseButton(GLFWwindow* window, int button, int action, int mods)
 {
     if(button == GLFW_MOUSE_BUTTON_RIGHT || button == GLFW_MOUSE_BUTTON_MIDDLE)
     {
@@ -65,7 +213,7 @@ void CameraController::mouseButtonCallback(GLFWwindow* window, int button, int a
     }
 }
 
-void CameraController::mouseMoveCallback(GLFWwindow* window, float xpos, float ypos)
+void CameraController::applyMouseMove(float xpos, float ypos, int width, int height)
 {
     if(_mousePressedMode == MouseMode::None)
         return;
@@ -85,9 +233,6 @@ void CameraController::mouseMoveCallback(GLFWwindow* window, float xpos, float y
     if(!_camera)
         return;
 
-    int width, height;
-    glfwGetWindowSize(window, &width, &height);
-
     if(_mousePressedMode == MouseMode::Orbit)
         _camera->orbit(xoffset, yoffset);
     else if(_mousePressedMode == MouseMode::Pan)
@@ -102,11 +247,4 @@ void CameraController::mouseMoveCallback(GLFWwindow* window, float xpos, float y
     }
 }
 
-void CameraController::scrollCallback(float offset)
-{
-    if(!_camera)
-        return;
-    _camera->zoomFov(offset);
-}
-
 }
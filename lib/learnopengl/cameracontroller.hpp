@@ -1,11 +1,19 @@
 #ifndef __LEARNOPENGL_CAMERA_CONTROLLER_HPP__
 #define __LEARNOPENGL_CAMERA_CONTROLLER_HPP__
 
+#include <learnopengl/camera.hpp>
+#include <learnopengl/fixedtimestep.hpp>
+#include <learnopengl/inputqueue.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
 struct GLFWwindow;
 
 namespace learnopengl {
 
-class Camera;
+class CameraPathRecorder;
 
 class CameraController
 {
@@ -20,16 +28,32 @@ public:
     };
 
 public:
+    // With LEARNOPENGL_RECORD_CAMERA=<file path>, the camera pose of every frame is recorded and written at destruction
     CameraController(Camera* camera);
+    ~CameraController();
 
+    // Start of a frame: applies the mouse events received since the last frame, moves the camera with the held keys at fixed ticks,
+    // then sets the camera to the pose interpolated between the last two ticks
     void processInput(GLFWwindow* window);
+
+    // GLFW callbacks only queue the event with its time, it is applied by the next processInput
     void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods);
     void mouseMoveCallback(GLFWwindow* window, float xpos, float ypos);
     void scrollCallback(float offset);
 
+    // Events lost because more than InputQueue::capacity() were received in one frame
+    [[nodiscard]] std::uint64_t droppedEvents() const { return _droppedEvents.load(std::memory_order_relaxed); }
+
+    // Keyboard movement ticks, 120 per second by default
+    [[nodiscard]] FixedTimestep& timestep() { return _timestep; }
+
 private:
-    float _deltaTime = 0.0f;
-    float _lastFrame = 0.0f;
+    void pushEvent(InputEvent event);
+    // True when an event changed the camera
+    bool applyEvents(GLFWwindow* window);
+    void applyKeys(GLFWwindow* window, float delta);
+    void applyMouseButton(GLFWwindow* window, int button, int action, int mods);
+    void applyMouseMove(float xpos, float ypos, int width, int height);
 
     float _lastPressedX = 0;
     float lastPressedY = 0;
@@ -37,6 +61,17 @@ private:
     MouseMode _mousePressedMode = MouseMode::None;
 
     Camera* _camera = nullptr;
+    std::unique_ptr<CameraPathRecorder> _recorder;
+
+    FixedTimestep _timestep;
+    // Simulated poses of the last two ticks, and the interpolated one given to the camera
+    CameraPose _previousPose;
+    CameraPose _currentPose;
+    CameraPose _renderedPose;
+    bool _ticking = false;
+
+    InputQueue _events;
+    std::atomic<std::uint64_t> _droppedEvents = 0;
 };
 
 }
@@ -0,0 +1,209 @@
+#include <learnopengl/camerapath.hpp>
+#include <learnopengl/fileinfo.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace learnopengl {
+
+namespace {
+
+constexpr char Magic[8] = {'L', 'O', 'G', 'L', 'C', 'A', 'M', 'P'};
+constexpr std::uint32_t FormatVersion = 1;
+constexpr std::size_t FloatsPerKey = 8;
+
+// Little endian whatever the host
+void writeUint32(std::ostream& stream, std::uint32_t value)
+{
+    const char bytes[4] = {char(value & 0xff), char((value >> 8) & 0xff), char((value >> 16) & 0xff), char((value >> 24) & 0xff)};
+    stream.write(bytes, 4);
+}
+
+std::uint32_t readUint32(std::istream& stream)
+{
+    unsigned char bytes[4] = {};
+    stream.read(reinterpret_cast<char*>(bytes), 4);
+    return std::uint32_t(bytes[0]) | (std::uint32_t(bytes[1]) << 8) | (std::uint32_t(bytes[2]) << 16) | (std::uint32_t(bytes[3]) << 24);
+}
+
+void writeFloat(std::ostream& stream, float value)
+{
+    std::uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    writeUint32(stream, bits);
+}
+
+float readFloat(std::istream& stream)
+{
+    const auto bits = readUint32(stream);
+    float value = 0.f;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+std::array<float, FloatsPerKey> toFloats(const CameraPath::Key& key)
+{
+    const auto& pose = key.pose;
+    return {key.time, pose.position.x, pose.position.y, pose.position.z, pose.center.x, pose.center.y, pose.center.z, pose.fovDegrees};
+}
+
+CameraPath::Key fromFloats(const std::array<float, FloatsPerKey>& values)
+{
+    return {values[0], {{values[1], values[2], values[3]}, {values[4], values[5], values[6]}, values[7]}};
+}
+
+// Cubic Hermite with Catmull-Rom tangents scaled to the key spacing, so keys recorded at uneven frame times stay smooth
+template<typename T>
+T catmullRom(const T& p0, const T& p1, const T& p2, const T& p3, float t0, float t1, float t2, float t3, float u)
+{
+    const float segment = t2 - t1;
+    const T m1 = t2 > t0 ? (p2 - p0) * (segment / (t2 - t0)) : T(0.f);
+    const T m2 = t3 > t1 ? (p3 - p1) * (segment / (t3 - t1)) : T(0.f);
+
+    const float u2 = u * u;
+    const float u3 = u2 * u;
+    return p1 * (2.f * u3 - 3.f * u2 + 1.f) + m1 * (u3 - 2.f * u2 + u) + p2 * (-2.f * u3 + 3.f * u2) + m2 * (u3 - u2);
+}
+
+}
+
+void CameraPath::addKey(float time, const CameraPose& pose)
+{
+    if(!_keys.empty() && time <= _keys.back().time)
+    {
+        _keys.back().pose = pose;
+        return;
+    }
+    _keys.push_back({time, pose});
+}
+
+CameraPose CameraPath::sample(float time) const
+{
+    if(_keys.empty())
+        return {};
+    if(time <= _keys.front().time)
+        return _keys.front().pose;
+    if(time >= _keys.back().time)
+        return _keys.back().pose;
+
+    // First key after time, the segment is [next - 1, next]
+    const auto next = std::size_t(std::upper_bound(_keys.begin(), _keys.end(), time, [](float t, const Key& key) { return t < key.time; }) -
+                                  _keys.begin());
+    const auto& k0 = _keys[next >= 2 ? next - 2 : 0];
+    const auto& k1 = _keys[next - 1];
+    const auto& k2 = _keys[next];
+    const auto& k3 = _keys[std::min(next + 1, _keys.size() - 1)];
+    const float u = (time - k1.time) / (k2.time - k1.time);
+
+    CameraPose pose;
+    pose.position = catmullRom(k0.pose.position, k1.pose.position, k2.pose.position, k3.pose.position, k0.time, k1.time, k2.time, k3.time, u);
+    pose.center = catmullRom(k0.pose.center, k1.pose.center, k2.pose.center, k3.pose.center, k0.time, k1.time, k2.time, k3.time, u);
+    pose.fovDegrees = catmullRom(k0.pose.fovDegrees, k1.pose.fovDegrees, k2.pose.fovDegrees, k3.pose.fovDegrees, k0.time, k1.time, k2.time, k3.time, u);
+    return pose;
+}
+
+bool CameraPath::load(const std::string& filePath)
+{
+    _keys.clear();
+
+    std::ifstream file(FileInfo(filePath).absolutePath(), std::ios::binary);
+    char magic[sizeof(Magic)] = {};
+    file.read(magic, sizeof(magic));
+    if(!file || std::memcmp(magic, Magic, sizeof(Magic)) != 0)
+    {
+        std::cerr << "CameraPath: " << filePath << " is not a camera path" << std::endl;
+        return false;
+    }
+
+    const auto version = readUint32(file);
+    const auto count = readUint32(file);
+    if(version != FormatVersion)
+    {
+        std::cerr << "CameraPath: unsupported version " << version << " in " << filePath << std::endl;
+        return false;
+    }
+
+    // Count comes from the file, check it against the keys actually stored before reserving for them
+    const auto keysBegin = file.tellg();
+    file.seekg(0, std::ios::end);
+    const auto remaining = std::uint64_t(file.tellg() - keysBegin);
+    file.seekg(keysBegin);
+    if(!file || remaining < std::uint64_t(count) * FloatsPerKey * sizeof(std::uint32_t))
+    {
+        std::cerr << "CameraPath: " << filePath << " is truncated" << std::endl;
+        return false;
+    }
+
+    _keys.reserve(count);
+    for(std::uint32_t i = 0; i < count && file; ++i)
+    {
+        std::array<float, FloatsPerKey> values = {};
+        for(auto& value: values) value = readFloat(file);
+        if(file)
+            _keys.push_back(fromFloats(values));
+    }
+
+    if(_keys.size() != count)
+    {
+        std::cerr << "CameraPath: " << filePath << " is truncated" << std::endl;
+        _keys.clear();
+        return false;
+    }
+    return true;
+}
+
+bool CameraPath::save(const std::string& filePath) const
+{
+    std::ofstream file(filePath, std::ios::binary);
+    if(!file)
+    {
+        std::cerr << "CameraPath: can't write " << filePath << std::endl;
+        return false;
+    }
+
+    file.write(Magic, sizeof(Magic));
+    writeUint32(file, FormatVersion);
+    writeUint32(file, std::uint32_t(_keys.size()));
+    for(const auto& key: _keys)
+    {
+        for(const auto value: toFloats(key)) writeFloat(file, value);
+    }
+    return bool(file);
+}
+
+std::string CameraPath::namedPath(const std::string& name) { return "resources/camerapaths/" + name + ".campath"; }
+
+bool CameraPath::loadByName(const std::string& name)
+{
+    const std::filesystem::path path(name);
+    if(!path.has_extension() && !path.has_parent_path())
+        return load(namedPath(name));
+    return load(name);
+}
+
+CameraPathRecorder::~CameraPathRecorder()
+{
+    if(_path.empty())
+        return;
+    if(_path.save(_filePath))
+        std::cout << "Camera path of " << _path.keys().size() << " frames written to " << _filePath << std::endl;
+}
+
+void CameraPathRecorder::record(float time, const Camera& camera)
+{
+    if(_path.empty())
+        _startTime = time;
+    _path.addKey(time - _startTime, camera.pose());
+}
+
+void CameraPathPlayer::apply(Camera& camera)
+{
+    camera.setPose(pose(_frame));
+    ++_frame;
+}
+
+}
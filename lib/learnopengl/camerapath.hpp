@@ -0,0 +1,96 @@
+#ifndef __LEARNOPENGL_CAMERA_PATH_HPP__
+#define __LEARNOPENGL_CAMERA_PATH_HPP__
+
+#include <learnopengl/camera.hpp>
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace learnopengl {
+
+// Camera poses over time, recorded from a live session and replayed for repeatable performance runs.
+// Binary file: "LOGLCAMP", format version, key count, then per key its time and pose as little endian 32-bit values (32 bytes per key).
+// Paths loaded by name come from resources/camerapaths/<name>.campath.
+class CameraPath
+{
+public:
+    struct Key
+    {
+        // Seconds since the first key
+        float time = 0.f;
+        CameraPose pose;
+    };
+
+public:
+    [[nodiscard]] const std::vector<Key>& keys() const { return _keys; }
+    [[nodiscard]] bool empty() const { return _keys.empty(); }
+    [[nodiscard]] float duration() const { return _keys.empty() ? 0.f : _keys.back().time; }
+
+    void clear() { _keys.clear(); }
+    // Times must increase, a key at the same time as the last one replaces it
+    void addKey(float time, const CameraPose& pose);
+
+    // Catmull-Rom interpolation between keys, clamped to the first and last pose outside of the path
+    [[nodiscard]] CameraPose sample(float time) const;
+
+    // Return false and leave the path empty when the file can't be read
+    bool load(const std::string& filePath);
+    bool save(const std::string& filePath) const;
+
+    // File of a named path in resources/camerapaths
+    [[nodiscard]] static std::string namedPath(const std::string& name);
+    // Named path when name has no extension nor directory, file path otherwise
+    bool loadByName(const std::string& name);
+
+private:
+    std::vector<Key> _keys;
+};
+
+// Record the camera pose every frame, written to the file when the recorder is destroyed
+class CameraPathRecorder
+{
+public:
+    explicit CameraPathRecorder(std::string filePath) : _filePath(std::move(filePath)) {}
+    ~CameraPathRecorder();
+
+    CameraPathRecorder(const CameraPathRecorder&) = delete;
+    CameraPathRecorder& operator=(const CameraPathRecorder&) = delete;
+
+    // time in seconds, any origin
+    void record(float time, const Camera& camera);
+
+    [[nodiscard]] const CameraPath& path() const { return _path; }
+
+private:
+    std::string _filePath;
+    CameraPath _path;
+    float _startTime = 0.f;
+};
+
+// Replay a path one fixed timestep per frame, independent of the real frame time
+class CameraPathPlayer
+{
+public:
+    CameraPathPlayer(CameraPath path, float timestep) : _path(std::move(path)), _timestep(timestep) {}
+
+    // Pose of the current frame on the camera, then move to the next frame
+    void apply(Camera& camera);
+    // Pose of any frame
+    [[nodiscard]] CameraPose pose(std::uint64_t frame) const { return _path.sample(float(double(frame) * double(_timestep))); }
+
+    [[nodiscard]] const CameraPath& path() const { return _path; }
+    [[nodiscard]] std::uint64_t frame() const { return _frame; }
+    void setFrame(std::uint64_t frame) { _frame = frame; }
+    [[nodiscard]] bool finished() const { return double(_frame) * double(_timestep) > double(_path.duration()); }
+
+private:
+    CameraPath _path;
+    float _timestep;
+    std::uint64_t _frame = 0;
+};
+
+}
+
+#endif
@@ -0,0 +1,109 @@
+#include <learnopengl/clusteredlighting.hpp>
+#include <learnopengl/camera.hpp>
+#include <learnopengl/shader.hpp>
+#include <learnopengl/trace.hpp>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace learnopengl {
+
+ClusteredLighting::ClusteredLighting() : ClusteredLighting(LightClusterGrid::Settings{}) {}
+
+ClusteredLighting::ClusteredLighting(const LightClusterGrid::Settings& settings) : _grid(settings) { setup(); }
+
+ClusteredLighting::~ClusteredLighting()
+{
+    const std::uint32_t textures[] = {_lightTexture, _clusterTexture, _indexTexture};
+    glDeleteTextures(3, textures);
+    const std::uint32_t buffers[] = {_lightBuffer, _clusterBuffer, _indexBuffer};
+    glDeleteBuffers(3, buffers);
+}
+
+void ClusteredLighting::setup()
+{
+    glGenBuffers(1, &_lightBuffer);
+    glGenBuffers(1, &_clusterBuffer);
+    glGenBuffers(1, &_indexBuffer);
+    glGenTextures(1, &_lightTexture);
+    glGenTextures(1, &_clusterTexture);
+    glGenTextures(1, &_indexTexture);
+
+    // Texture buffers (OpenGL 3.1) rather than storage buffers, so that it runs on 3.3 contexts too
+    const auto attach = [](std::uint32_t texture, std::uint32_t buffer, GLenum format, std::size_t& capacity)
+    {
+        glBindBuffer(GL_TEXTURE_BUFFER, buffer);
+        capacity = 256;
+        glBufferData(GL_TEXTURE_BUFFER, GLsizeiptr(capacity), nullptr, GL_STREAM_DRAW);
+        glBindTexture(GL_TEXTURE_BUFFER, texture);
+        glTexBuffer(GL_TEXTURE_BUFFER, format, buffer);
+    };
+    attach(_lightTexture, _lightBuffer, GL_RGBA32F, _lightCapacity);
+    attach(_clusterTexture, _clusterBuffer, GL_RG32UI, _clusterCapacity);
+    attach(_indexTexture, _indexBuffer, GL_R32UI, _indexCapacity);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
+
+void ClusteredLighting::clear() { _lights.clear(); }
+
+void ClusteredLighting::add(const PointLight& light) { _lights.add(light); }
+
+void ClusteredLighting::add(const SpotLight& light) { _lights.add(light); }
+
+void ClusteredLighting::update(const Camera& camera)
+{
+    LEARNOPENGL_TRACE_SCOPE("ClusteredLighting::update");
+
+    const auto start = std::chrono::steady_clock::now();
+
+    _stats.culledLightCount = _lights.cull(camera.frustum());
+    _grid.bin(camera, _lights.visibleBounds());
+    _stats.binningMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    _stats.clusters = _grid.stats();
+
+    const auto& clusters = _grid.clusters();
+    const auto& indices = _grid.indices();
+    static_assert(sizeof(LightClusterGrid::Cluster) == 2 * sizeof(std::uint32_t), "Cluster must match the RG32UI texel");
+    upload(_lightBuffer, _lightCapacity, _lights.visibleData().data(), _lights.visibleData().size() * sizeof(glm::vec4));
+    upload(_clusterBuffer, _clusterCapacity, clusters.data(), clusters.size() * sizeof(LightClusterGrid::Cluster));
+    upload(_indexBuffer, _indexCapacity, indices.data(), indices.size() * sizeof(std::uint32_t));
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+    _stats.uploadedBytes = _lights.visibleData().size() * sizeof(glm::vec4) + clusters.size() * sizeof(LightClusterGrid::Cluster) +
+                           indices.size() * sizeof(std::uint32_t);
+}
+
+void ClusteredLighting::upload(std::uint32_t buffer, std::size_t& capacity, const void* data, std::size_t size)
+{
+    glBindBuffer(GL_TEXTURE_BUFFER, buffer);
+    if(size > capacity)
+        capacity = std::max(size, capacity + capacity / 2);
+    // Orphan: the driver hands a new storage instead of waiting for the draws still reading the previous frame
+    glBufferData(GL_TEXTURE_BUFFER, GLsizeiptr(capacity), nullptr, GL_STREAM_DRAW);
+    if(size)
+        glBufferSubData(GL_TEXTURE_BUFFER, 0, GLsizeiptr(size), data);
+}
+
+void ClusteredLighting::bind(const Shader& shader, std::uint32_t firstUnit, int viewportWidth, int viewportHeight) const
+{
+    const std::uint32_t textures[] = {_lightTexture, _clusterTexture, _indexTexture};
+    const char* samplers[] = {"clusterLightData", "clusterRanges", "clusterLightIndices"};
+    for(std::uint32_t i = 0; i < 3; ++i)
+    {
+        glActiveTexture(GL_TEXTURE0 + firstUnit + i);
+        glBindTexture(GL_TEXTURE_BUFFER, textures[i]);
+        shader.setInt(samplers[i], int(firstUnit + i));
+    }
+    glActiveTexture(GL_TEXTURE0);
+
+    const auto& settings = _grid.settings();
+    shader.setVec3("clusterGrid", float(settings.tileCountX), float(settings.tileCountY), float(settings.sliceCount));
+    shader.setVec4(
+        "clusterDepth", _grid.sliceScale(), _grid.sliceBias(), float(std::max(viewportWidth, 1)), float(std::max(viewportHeight, 1)));
+}
+
+}
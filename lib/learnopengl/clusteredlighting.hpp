@@ -0,0 +1,90 @@
+#ifndef __LEARNOPENGL_CLUSTERED_LIGHTING_HPP__
+#define __LEARNOPENGL_CLUSTERED_LIGHTING_HPP__
+
+#include <learnopengl/lightclustergrid.hpp>
+#include <learnopengl/packedlights.hpp>
+
+#include <cstdint>
+
+namespace learnopengl {
+
+class Camera;
+class PointLight;
+class Shader;
+class SpotLight;
+
+// Clustered forward shading: point and spot lights are binned on the CPU in the froxels of the camera (LightClusterGrid),
+// then the light data, the (offset, count) range of each cluster and the light indices are uploaded in texture buffers.
+// Fragment shaders include resources/shaders/clusteredlighting.glsl and only evaluate the lights of their cluster.
+// A light only reaches as far as its attenuation range (PointLight::range, SpotLight::range), lights whose sphere or cone is
+// outside the camera frustum are dropped before binning and upload.
+class ClusteredLighting
+{
+public:
+    // RGBA32F texels of a light in the light data buffer
+    static constexpr std::uint32_t TexelsPerLight = PackedLights::TexelsPerLight;
+
+    struct Stats
+    {
+        LightClusterGrid::Stats clusters;
+        // Lights outside the camera frustum, not uploaded
+        std::size_t culledLightCount = 0;
+        // CPU time of culling and binning
+        double binningMs = 0.;
+        std::size_t uploadedBytes = 0;
+    };
+
+public:
+    ClusteredLighting();
+    explicit ClusteredLighting(const LightClusterGrid::Settings& settings);
+    ~ClusteredLighting();
+
+    ClusteredLighting(const ClusteredLighting&) = delete;
+    ClusteredLighting& operator=(const ClusteredLighting&) = delete;
+
+    void clear();
+    void add(const PointLight& light);
+    void add(const SpotLight& light);
+
+    [[nodiscard]] std::size_t size() const { return _lights.size(); }
+    [[nodiscard]] bool empty() const { return _lights.empty(); }
+
+    // Cull the lights outside the camera frustum, bin the others in the clusters of the camera and upload.
+    // Must be called after lights or camera changed and before drawing. Lights of the shader are numbered among the visible ones,
+    // visibleLightCount() of them.
+    void update(const Camera& camera);
+
+    // Bind the buffers on texture units firstUnit to firstUnit + 2 and set the uniforms of the include, the shader must be in use.
+    // viewport is the size of the render target, in pixels.
+    void bind(const Shader& shader, std::uint32_t firstUnit, int viewportWidth, int viewportHeight) const;
+
+    [[nodiscard]] std::size_t visibleLightCount() const { return _lights.visibleCount(); }
+
+    [[nodiscard]] const LightClusterGrid& grid() const { return _grid; }
+    [[nodiscard]] const Stats& stats() const { return _stats; }
+
+private:
+    void setup();
+    // Reallocate when the data outgrows the buffer, orphan otherwise
+    void upload(std::uint32_t buffer, std::size_t& capacity, const void* data, std::size_t size);
+
+    LightClusterGrid _grid;
+
+    PackedLights _lights;
+
+    std::uint32_t _lightBuffer = 0;
+    std::uint32_t _clusterBuffer = 0;
+    std::uint32_t _indexBuffer = 0;
+    std::size_t _lightCapacity = 0;
+    std::size_t _clusterCapacity = 0;
+    std::size_t _indexCapacity = 0;
+    std::uint32_t _lightTexture = 0;
+    std::uint32_t _clusterTexture = 0;
+    std::uint32_t _indexTexture = 0;
+
+    Stats _stats;
+};
+
+}
+
+#endif
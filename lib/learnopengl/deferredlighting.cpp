@@ -0,0 +1,310 @@
+#include <learnopengl/deferredlighting.hpp>
+#include <learnopengl/camera.hpp>
+#include <learnopengl/gbuffer.hpp>
+#include <learnopengl/lighttilegrid.hpp>
+#include <learnopengl/mesh.hpp>
+#include <learnopengl/primitives.hpp>
+#include <learnopengl/shader.hpp>
+#include <learnopengl/trace.hpp>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <algorithm>
+#include <chrono>
+
+namespace learnopengl {
+
+namespace {
+
+constexpr std::uint32_t LightDataUnit = 3;
+constexpr std::uint32_t LightBoundsUnit = 4;
+
+// Depth test passing where the tested fragment is behind the stored depth
+GLenum behindDepthFunc(GLint depthFunc)
+{
+    switch(depthFunc)
+    {
+    case GL_LESS: return GL_GEQUAL;
+    case GL_LEQUAL: return GL_GREATER;
+    case GL_GREATER: return GL_LEQUAL;
+    case GL_GEQUAL: return GL_LESS;
+    default: return GL_ALWAYS;
+    }
+}
+
+}
+
+DeferredLighting::DeferredLighting() : DeferredLighting(Settings{}) {}
+
+DeferredLighting::DeferredLighting(const Settings& settings) : _settings(settings) { setup(); }
+
+DeferredLighting::~DeferredLighting()
+{
+    const std::uint32_t vertexArrays[] = {_volumeVao, _fullScreenVao};
+    glDeleteVertexArrays(2, vertexArrays);
+    const std::uint32_t buffers[] = {_boundsBuffer, _lightBuffer, _tileCountBuffer};
+    glDeleteBuffers(3, buffers);
+    const std::uint32_t textures[] = {_lightTexture, _boundsTexture};
+    glDeleteTextures(2, textures);
+}
+
+bool DeferredLighting::tiledSupported() { return GLAD_GL_VERSION_4_3; }
+
+void DeferredLighting::setup()
+{
+    const auto sphere = createSphere(_settings.sphereSegments, _settings.sphereRings);
+    _sphere = std::make_unique<Mesh>(sphere.vertices, sphere.indices, std::vector<Texture>{});
+    _volumeScale = 1.f / sphereInscribedRadius(_settings.sphereSegments, _settings.sphereRings);
+
+    _directionShader = std::make_unique<Shader>("resources/shaders/deferredfullscreen.vs", "resources/shaders/deferreddirectional.fs");
+    _volumeShader = std::make_unique<Shader>("resources/shaders/deferredvolume.vs", "resources/shaders/deferredvolume.fs");
+    _stencilShader = std::make_unique<Shader>("resources/shaders/deferredvolume.vs", "resources/shaders/deferredstencil.fs");
+
+    glGenBuffers(1, &_boundsBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, _boundsBuffer);
+    _boundsCapacity = 256;
+    glBufferData(GL_ARRAY_BUFFER, GLsizeiptr(_boundsCapacity), nullptr, GL_STREAM_DRAW);
+
+    glGenVertexArrays(1, &_volumeVao);
+    glBindVertexArray(_volumeVao);
+    _sphere->setupVertexAttributes();
+    glBindBuffer(GL_ARRAY_BUFFER, _boundsBuffer);
+    glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(glm::vec4), nullptr);
+    glVertexAttribDivisor(3, 1);
+    glEnableVertexAttribArray(3);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glGenVertexArrays(1, &_fullScreenVao);
+
+    // Texture buffer as in ClusteredLighting, read by packedlights.glsl
+    glGenBuffers(1, &_lightBuffer);
+    glBindBuffer(GL_TEXTURE_BUFFER, _lightBuffer);
+    _lightCapacity = 256;
+    glBufferData(GL_TEXTURE_BUFFER, GLsizeiptr(_lightCapacity), nullptr, GL_STREAM_DRAW);
+    glGenTextures(1, &_lightTexture);
+    glBindTexture(GL_TEXTURE_BUFFER, _lightTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, _lightBuffer);
+    glGenTextures(1, &_boundsTexture);
+    glBindTexture(GL_TEXTURE_BUFFER, _boundsTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, _boundsBuffer);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
+
+void DeferredLighting::clear() { _lights.clear(); }
+
+void DeferredLighting::add(const PointLight& light) { _lights.add(light); }
+
+void DeferredLighting::add(const SpotLight& light) { _lights.add(light); }
+
+void DeferredLighting::update(const Camera& camera)
+{
+    LEARNOPENGL_TRACE_SCOPE("DeferredLighting::update");
+
+    const auto start = std::chrono::steady_clock::now();
+    _stats.culledLightCount = _lights.cull(camera.frustum());
+    _stats.lightCount = _lights.visibleCount();
+
+    const auto& data = _lights.visibleData();
+    const auto& bounds = _lights.visibleBounds();
+    upload(GL_TEXTURE_BUFFER, _lightBuffer, _lightCapacity, data.data(), data.size() * sizeof(glm::vec4));
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+    upload(GL_ARRAY_BUFFER, _boundsBuffer, _boundsCapacity, bounds.data(), bounds.size() * sizeof(glm::vec4));
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    _stats.uploadedBytes = (data.size() + bounds.size()) * sizeof(glm::vec4);
+    _stats.updateMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void DeferredLighting::upload(std::uint32_t target, std::uint32_t buffer, std::size_t& capacity, const void* data, std::size_t size)
+{
+    glBindBuffer(target, buffer);
+    if(size > capacity)
+        capacity = std::max(size, capacity + capacity / 2);
+    // Orphan: the driver hands a new storage instead of waiting for the draws still reading the previous frame
+    glBufferData(target, GLsizeiptr(capacity), nullptr, GL_STREAM_DRAW);
+    if(size)
+        glBufferSubData(target, 0, GLsizeiptr(size), data);
+}
+
+void DeferredLighting::bindLightData(const Shader& shader, std::uint32_t unit, const char* name) const
+{
+    glActiveTexture(GL_TEXTURE0 + unit);
+    glBindTexture(GL_TEXTURE_BUFFER, _lightTexture);
+    shader.setInt(name, int(unit));
+    glActiveTexture(GL_TEXTURE0);
+}
+
+void DeferredLighting::draw(const GBuffer& gbuffer, const Camera& camera)
+{
+    LEARNOPENGL_TRACE_SCOPE("DeferredLighting::draw");
+
+    const auto& cameraPos = camera.cameraPos();
+    const bool fullScreen = _settings.mode == Mode::FullScreen;
+
+    if(_settings.mode == Mode::Tiled && tiledSupported())
+    {
+        drawTiled(gbuffer, camera);
+    }
+    else
+    {
+        // Direction light on the pixels covered by geometry
+        glDisable(GL_DEPTH_TEST);
+        glDepthMask(GL_FALSE);
+        glEnable(GL_STENCIL_TEST);
+        glStencilMask(0);
+        glStencilFunc(GL_EQUAL, GLint(GBuffer::GeometryStencilBit), GBuffer::GeometryStencilBit);
+
+        _directionShader->use();
+        gbuffer.bind(*_directionShader, 0, camera);
+        bindLightData(*_directionShader, LightDataUnit);
+        _directionShader->setDirectionLight("directionLight", _directionLight);
+        _directionShader->setVec3("cameraPos", cameraPos.x, cameraPos.y, cameraPos.z);
+        _directionShader->setFloat("shininess", _settings.shininess);
+        _directionShader->setInt("lightCount", fullScreen ? int(_lights.visibleCount()) : 0);
+        glBindVertexArray(_fullScreenVao);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        glBindVertexArray(0);
+
+        if(!fullScreen && _lights.visibleCount())
+            drawVolumes(gbuffer, camera);
+    }
+
+    glDisable(GL_STENCIL_TEST);
+    glStencilMask(0xFF);
+    glEnable(GL_DEPTH_TEST);
+    glDepthMask(GL_TRUE);
+}
+
+void DeferredLighting::drawVolumes(const GBuffer& gbuffer, const Camera& camera)
+{
+    const auto& cameraPos = camera.cameraPos();
+    const auto instanceCount = _lights.visibleCount();
+
+    GLint depthFunc = GL_LESS;
+    glGetIntegerv(GL_DEPTH_FUNC, &depthFunc);
+    // Volumes crossing the far plane still cover the geometry in front of it
+    glEnable(GL_DEPTH_CLAMP);
+    glBindVertexArray(_volumeVao);
+
+    for(const auto* shader: {_stencilShader.get(), _volumeShader.get()})
+    {
+        shader->use();
+        shader->setMat4("view", glm::value_ptr(camera.viewMatrix()));
+        shader->setMat4("projection", glm::value_ptr(camera.projectionMatrix()));
+        shader->setFloat("volumeScale", _volumeScale);
+    }
+
+    // Low stencil bits count the volumes holding the geometry, modulo 128
+    constexpr GLuint CountMask = 0xFF & ~GBuffer::GeometryStencilBit;
+    const bool stencil = _settings.mode != Mode::Volumes;
+    if(stencil)
+    {
+        glEnable(GL_DEPTH_TEST);
+        glDisable(GL_CULL_FACE);
+        glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+        glStencilMask(CountMask);
+        glStencilFunc(GL_ALWAYS, 0, 0);
+        glStencilOpSeparate(GL_BACK, GL_KEEP, GL_INCR_WRAP, GL_KEEP);
+        glStencilOpSeparate(GL_FRONT, GL_KEEP, GL_DECR_WRAP, GL_KEEP);
+        _stencilShader->use();
+        _sphere->drawInstances(instanceCount);
+        glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+
+        // Counts are left in the stencil, cleared by the next geometry pass. The count is shared by all lights, so the depth test
+        // below still skips the pixels of each light whose geometry is behind its volume.
+        glStencilMask(0);
+        glStencilFunc(GL_NOTEQUAL, 0, CountMask);
+        glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+    }
+    else
+    {
+        glDisable(GL_STENCIL_TEST);
+    }
+    glEnable(GL_DEPTH_TEST);
+    glDepthFunc(behindDepthFunc(depthFunc));
+
+    // Back faces: still drawn when the camera is inside a volume
+    glEnable(GL_CULL_FACE);
+    glCullFace(GL_FRONT);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE);
+
+    _volumeShader->use();
+    gbuffer.bind(*_volumeShader, 0, camera);
+    bindLightData(*_volumeShader, LightDataUnit);
+    _volumeShader->setVec3("cameraPos", cameraPos.x, cameraPos.y, cameraPos.z);
+    _volumeShader->setFloat("shininess", _settings.shininess);
+    _sphere->drawInstances(instanceCount);
+
+    glBindVertexArray(0);
+    glDisable(GL_BLEND);
+    glCullFace(GL_BACK);
+    glDisable(GL_CULL_FACE);
+    glDisable(GL_DEPTH_CLAMP);
+    glDepthFunc(GLenum(depthFunc));
+}
+
+void DeferredLighting::drawTiled(const GBuffer& gbuffer, const Camera& camera)
+{
+    if(!_tiledShader)
+    {
+        _tiledShader = std::make_unique<Shader>("resources/shaders/deferredtiled.cs");
+        glGenBuffers(1, &_tileCountBuffer);
+    }
+
+    const auto tileCountX = (std::uint32_t(gbuffer.width()) + LightTileGrid::TileSize - 1) / LightTileGrid::TileSize;
+    const auto tileCountY = (std::uint32_t(gbuffer.height()) + LightTileGrid::TileSize - 1) / LightTileGrid::TileSize;
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, _tileCountBuffer);
+    if(_tileCount != std::size_t(tileCountX) * tileCountY)
+    {
+        _tileCount = std::size_t(tileCountX) * tileCountY;
+        glBufferData(GL_SHADER_STORAGE_BUFFER, GLsizeiptr(_tileCount * sizeof(std::uint32_t)), nullptr, GL_DYNAMIC_READ);
+    }
+
+    GLfloat clearDepth = 1.f;
+    glGetFloatv(GL_DEPTH_CLEAR_VALUE, &clearDepth);
+    const auto& projection = camera.projectionMatrix();
+    const auto& cameraPos = camera.cameraPos();
+
+    _tiledShader->use();
+    gbuffer.bind(*_tiledShader, 0, camera);
+    bindLightData(*_tiledShader, LightDataUnit);
+    glActiveTexture(GL_TEXTURE0 + LightBoundsUnit);
+    glBindTexture(GL_TEXTURE_BUFFER, _boundsTexture);
+    _tiledShader->setInt("lightBounds", int(LightBoundsUnit));
+    glActiveTexture(GL_TEXTURE0);
+    _tiledShader->setInt("lightCount", int(_lights.visibleCount()));
+    _tiledShader->setDirectionLight("directionLight", _directionLight);
+    _tiledShader->setVec3("cameraPos", cameraPos.x, cameraPos.y, cameraPos.z);
+    _tiledShader->setFloat("shininess", _settings.shininess);
+    _tiledShader->setMat4("view", glm::value_ptr(camera.viewMatrix()));
+    _tiledShader->setVec4("projectionScales", projection[0][0], projection[1][1], projection[2][2], projection[3][2]);
+    _tiledShader->setFloat("clearDepth", clearDepth);
+
+    glBindImageTexture(0, gbuffer.lightTexture(), 0, GL_FALSE, 0, GL_WRITE_ONLY, gbuffer.lightInternalFormat());
+    _tiledShader->setInt("lightImage", 0);
+    glDispatchCompute(tileCountX, tileCountY, 1);
+
+    // Image stores visible to the following draws, blits and texture reads
+    glMemoryBarrier(GL_FRAMEBUFFER_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+    glBindImageTexture(0, 0, 0, GL_FALSE, 0, GL_WRITE_ONLY, gbuffer.lightInternalFormat());
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, 0);
+}
+
+std::vector<std::uint32_t> DeferredLighting::readTileLightCounts() const
+{
+    std::vector<std::uint32_t> counts(_tileCountBuffer ? _tileCount : 0);
+    if(counts.empty())
+        return counts;
+
+    glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _tileCountBuffer);
+    glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, GLsizeiptr(counts.size() * sizeof(std::uint32_t)), counts.data());
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    return counts;
+}
+
+}
@@ -0,0 +1,149 @@
+#ifndef __LEARNOPENGL_DEFERRED_LIGHTING_HPP__
+#define __LEARNOPENGL_DEFERRED_LIGHTING_HPP__
+
+#include <learnopengl/directionlight.hpp>
+#include <learnopengl/packedlights.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace learnopengl {
+
+class Camera;
+class GBuffer;
+class Mesh;
+class PointLight;
+class Shader;
+class SpotLight;
+
+// Lighting passes of deferred shading over a GBuffer: a full screen pass for the direction light, then point and spot lights
+// drawn as instanced spheres (their bounding sphere) that only shade the pixels they cover.
+// Lights outside the camera frustum are culled before upload, as in ClusteredLighting.
+// The tiled mode replaces the volumes by a compute shader reading the geometry buffer once per pixel for all its lights.
+class DeferredLighting
+{
+public:
+    enum class Mode
+    {
+        // Every light evaluated for every pixel by the full screen pass, the baseline of the LearnOpenGL chapter
+        FullScreen,
+        // Back faces of the light volumes, depth tested against the scene: skips the pixels whose geometry is behind the volume
+        Volumes,
+        // A stencil pass first counts the volumes holding the geometry of each pixel (depth fail on back faces minus front faces),
+        // then back faces, depth tested as Volumes, only shade the pixels whose geometry lies inside a volume. The count is shared
+        // by all lights: it drops the pixels in front of every volume, while the depth test still culls per light.
+        StencilVolumes,
+        // Compute shader shading 16x16 pixels tiles with the lights reaching into their depth range, listed in shared memory
+        // (OpenGL 4.3, StencilVolumes otherwise). Light target formats other than SRGB8Alpha8 only. See LightTileGrid.
+        Tiled,
+    };
+
+    struct Settings
+    {
+        Mode mode = Mode::StencilVolumes;
+        // Tessellation of the light volume sphere
+        std::uint32_t sphereSegments = 16;
+        std::uint32_t sphereRings = 8;
+        // Specular exponent of every surface, the geometry buffer has no room for it
+        float shininess = 32.f;
+    };
+
+    struct Stats
+    {
+        // Lights in the frustum, drawn
+        std::size_t lightCount = 0;
+        std::size_t culledLightCount = 0;
+        // CPU time of culling and upload
+        double updateMs = 0.;
+        std::size_t uploadedBytes = 0;
+    };
+
+public:
+    DeferredLighting();
+    explicit DeferredLighting(const Settings& settings);
+    ~DeferredLighting();
+
+    // Tiled mode needs compute shaders
+    [[nodiscard]] static bool tiledSupported();
+
+    DeferredLighting(const DeferredLighting&) = delete;
+    DeferredLighting& operator=(const DeferredLighting&) = delete;
+
+    void clear();
+    void add(const PointLight& light);
+    void add(const SpotLight& light);
+
+    [[nodiscard]] std::size_t size() const { return _lights.size(); }
+    [[nodiscard]] bool empty() const { return _lights.empty(); }
+
+    [[nodiscard]] const DirectionLight& directionLight() const { return _directionLight; }
+    void setDirectionLight(const DirectionLight& directionLight) { _directionLight = directionLight; }
+
+    [[nodiscard]] const Settings& settings() const { return _settings; }
+    void setMode(Mode mode) { _settings.mode = mode; }
+
+    // Cull the lights outside the camera frustum and upload the others. Must be called after lights or camera changed and before draw.
+    void update(const Camera& camera);
+
+    // Add the lighting of the gbuffer geometry to its light target, bound by GBuffer::beginLightingPass (the tiled mode writes it).
+    // Leave depth test on, depth writes on, blending, culling, stencil test and depth clamp off.
+    void draw(const GBuffer& gbuffer, const Camera& camera);
+
+    // Bind the data of the lights left by update on a texture unit and set the sampler, e.g. to draw light cubes from it.
+    // The shader must be in use.
+    void bindLightData(const Shader& shader, std::uint32_t unit, const char* name = "lightData") const;
+    [[nodiscard]] std::size_t visibleLightCount() const { return _lights.visibleCount(); }
+    // Lights of the last update, visibleBounds are indexed as the tiled mode lists them
+    [[nodiscard]] const PackedLights& lights() const { return _lights; }
+
+    // Lights reaching each tile in the last tiled draw before the list capacity applies, by LightTileGrid::tileIndex.
+    // Reads back from the GPU, for validation against LightTileGrid.
+    [[nodiscard]] std::vector<std::uint32_t> readTileLightCounts() const;
+
+    [[nodiscard]] const Stats& stats() const { return _stats; }
+
+private:
+    void setup();
+    void drawVolumes(const GBuffer& gbuffer, const Camera& camera);
+    void drawTiled(const GBuffer& gbuffer, const Camera& camera);
+    // Reallocate when the data outgrows the buffer, orphan otherwise
+    void upload(std::uint32_t target, std::uint32_t buffer, std::size_t& capacity, const void* data, std::size_t size);
+
+    Settings _settings;
+    PackedLights _lights;
+    DirectionLight _directionLight;
+
+    std::unique_ptr<Mesh> _sphere;
+    // Scale of the sphere mesh holding the unit sphere
+    float _volumeScale = 1.f;
+
+    std::unique_ptr<Shader> _directionShader;
+    std::unique_ptr<Shader> _volumeShader;
+    std::unique_ptr<Shader> _stencilShader;
+    // Created by the first tiled draw
+    std::unique_ptr<Shader> _tiledShader;
+
+    // Sphere geometry with the per instance bounding sphere of the lights
+    std::uint32_t _volumeVao = 0;
+    std::uint32_t _boundsBuffer = 0;
+    std::size_t _boundsCapacity = 0;
+    // Same buffer read by the tiled shader
+    std::uint32_t _boundsTexture = 0;
+    // Empty, the full screen triangle comes from gl_VertexID
+    std::uint32_t _fullScreenVao = 0;
+
+    std::uint32_t _lightBuffer = 0;
+    std::uint32_t _lightTexture = 0;
+    std::size_t _lightCapacity = 0;
+
+    // Shader storage of the light count of each tile
+    std::uint32_t _tileCountBuffer = 0;
+    std::size_t _tileCount = 0;
+
+    Stats _stats;
+};
+
+}
+
+#endif
@@ -0,0 +1,112 @@
+#include <learnopengl/depthpyramid.hpp>
+#include <learnopengl/camera.hpp>
+#include <learnopengl/depthstate.hpp>
+#include <learnopengl/shader.hpp>
+
+#include <glad/glad.h>
+
+#include <glm/gtc/type_ptr.hpp>
+
+#include <algorithm>
+#include <bit>
+
+namespace learnopengl {
+
+namespace {
+
+// Same as depthpyramid.cs
+constexpr int GroupSize = 8;
+
+}
+
+DepthPyramid::DepthPyramid() = default;
+
+DepthPyramid::~DepthPyramid()
+{
+    if(_texture)
+        glDeleteTextures(1, &_texture);
+}
+
+bool DepthPyramid::supported() { return GLAD_GL_VERSION_4_3; }
+
+void DepthPyramid::resize(int width, int height)
+{
+    if(_texture)
+        glDeleteTextures(1, &_texture);
+
+    _width = width;
+    _height = height;
+    // Mip levels round down, down to a single texel: floor(log2(size)) + 1 levels
+    _levelCount = int(std::bit_width(unsigned(std::max(width, height))));
+
+    // Immutable storage: levels can be bound as images
+    glGenTextures(1, &_texture);
+    glBindTexture(GL_TEXTURE_2D, _texture);
+    glTexStorage2D(GL_TEXTURE_2D, _levelCount, GL_R32F, width, height);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    _built = false;
+}
+
+void DepthPyramid::build(const Camera& camera, std::uint32_t depthTexture, int width, int height)
+{
+    if(width <= 0 || height <= 0)
+        return;
+    if(width != _width || height != _height)
+        resize(width, height);
+    if(!_shader)
+        _shader = std::make_unique<Shader>("resources/shaders/depthpyramid.cs");
+
+    _viewProjection = camera.projectionMatrix() * camera.viewMatrix();
+    _reverseZ = camera.reverseZ();
+    _zeroToOne = zeroToOneClipDepth();
+
+    _shader->use();
+    _shader->setInt("source", 0);
+    _shader->setInt("destination", 0);
+    _shader->setBool("reverseZ", _reverseZ);
+    glActiveTexture(GL_TEXTURE0);
+
+    for(int level = 0; level < _levelCount; ++level)
+    {
+        // Level 0 copies the depth texture, the others reduce the level above
+        const int sourceLevel = std::max(level - 1, 0);
+        const int sourceWidth = std::max(1, width >> sourceLevel);
+        const int sourceHeight = std::max(1, height >> sourceLevel);
+        const int levelWidth = std::max(1, width >> level);
+        const int levelHeight = std::max(1, height >> level);
+
+        glBindTexture(GL_TEXTURE_2D, level == 0 ? depthTexture : _texture);
+        _shader->setInt("sourceLevel", sourceLevel);
+        _shader->setInt("sourceWidth", sourceWidth);
+        _shader->setInt("sourceHeight", sourceHeight);
+        _shader->setBool("reduce", level > 0);
+        glBindImageTexture(0, _texture, level, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+        glDispatchCompute(GLuint((levelWidth + GroupSize - 1) / GroupSize), GLuint((levelHeight + GroupSize - 1) / GroupSize), 1);
+        // The next level fetches this one
+        glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+    }
+
+    glBindImageTexture(0, 0, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    _built = true;
+}
+
+void DepthPyramid::bind(const Shader& shader, std::uint32_t unit) const
+{
+    glActiveTexture(GL_TEXTURE0 + unit);
+    glBindTexture(GL_TEXTURE_2D, _texture);
+    glActiveTexture(GL_TEXTURE0);
+    shader.setInt("depthPyramid", int(unit));
+    shader.setInt("depthPyramidLevels", _built ? _levelCount : 0);
+    shader.setInt("depthPyramidWidth", _width);
+    shader.setInt("depthPyramidHeight", _height);
+    shader.setMat4("depthPyramidViewProjection", glm::value_ptr(_viewProjection));
+    shader.setBool("depthPyramidReverseZ", _reverseZ);
+    shader.setBool("depthPyramidZeroToOne", _zeroToOne);
+}
+
+}
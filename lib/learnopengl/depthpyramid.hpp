@@ -0,0 +1,61 @@
+#ifndef __LEARNOPENGL_DEPTH_PYRAMID_HPP__
+#define __LEARNOPENGL_DEPTH_PYRAMID_HPP__
+
+#include <glm/mat4x4.hpp>
+
+#include <cstdint>
+#include <memory>
+
+namespace learnopengl {
+
+class Camera;
+class Shader;
+
+// Hierarchical depth (Hi-Z) of a rendered frame for GPU occlusion culling (OpenGL 4.3): an R32F mipmapped texture whose level 0
+// copies the depth buffer and each texel of the next levels holds the farthest depth of the 2x2 texels below (up to 3x3 on the
+// last row and column of odd sizes, as mip levels round down), reduced by
+// a compute shader (resources/shaders/depthpyramid.cs). Boxes are tested against it with resources/shaders/depthpyramid.glsl,
+// through the camera of the frame it was built from: a frame of latency, see OcclusionCuller.
+class DepthPyramid
+{
+public:
+    DepthPyramid();
+    ~DepthPyramid();
+
+    DepthPyramid(const DepthPyramid&) = delete;
+    DepthPyramid& operator=(const DepthPyramid&) = delete;
+
+    [[nodiscard]] static bool supported();
+
+    // Build from the depth texture of width x height pixels of a frame rendered through camera, once its depth is written.
+    // Reallocated when the size changes.
+    void build(const Camera& camera, std::uint32_t depthTexture, int width, int height);
+
+    // Bind the pyramid on a texture unit and set the uniforms of depthpyramid.glsl, the shader must be in use.
+    // Tests are disabled until the first build.
+    void bind(const Shader& shader, std::uint32_t unit) const;
+
+    [[nodiscard]] std::uint32_t texture() const { return _texture; }
+    [[nodiscard]] int width() const { return _width; }
+    [[nodiscard]] int height() const { return _height; }
+    [[nodiscard]] int levelCount() const { return _levelCount; }
+
+private:
+    void resize(int width, int height);
+
+    std::unique_ptr<Shader> _shader;
+    std::uint32_t _texture = 0;
+    int _width = 0;
+    int _height = 0;
+    int _levelCount = 0;
+    bool _built = false;
+
+    // Camera of the last build
+    glm::mat4 _viewProjection = glm::mat4(1.f);
+    bool _reverseZ = false;
+    bool _zeroToOne = false;
+};
+
+}
+
+#endif
@@ -0,0 +1,32 @@
+#include <learnopengl/depthstate.hpp>
+#include <learnopengl/camera.hpp>
+
+#include <glad/glad.h>
+
+namespace learnopengl {
+
+namespace {
+
+bool zeroToOne = false;
+
+}
+
+bool clipControlSupported() { return GLAD_GL_VERSION_4_5; }
+
+void applyDepthState(const Camera& camera) { applyDepthState(camera.reverseZ()); }
+
+void applyDepthState(bool reverseZ)
+{
+    if(clipControlSupported())
+    {
+        zeroToOne = reverseZ;
+        glClipControl(GL_LOWER_LEFT, zeroToOne ? GL_ZERO_TO_ONE : GL_NEGATIVE_ONE_TO_ONE);
+    }
+
+    glClearDepth(reverseZ ? 0. : 1.);
+    glDepthFunc(reverseZ ? GL_GREATER : GL_LESS);
+}
+
+bool zeroToOneClipDepth() { return zeroToOne; }
+
+}
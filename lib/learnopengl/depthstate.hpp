@@ -0,0 +1,22 @@
+#ifndef __LEARNOPENGL_DEPTH_STATE_HPP__
+#define __LEARNOPENGL_DEPTH_STATE_HPP__
+
+namespace learnopengl {
+
+class Camera;
+
+// glClipControl is core since OpenGL 4.5
+[[nodiscard]] bool clipControlSupported();
+
+// Depth clear value, compare function and clip depth range matching the camera projection.
+// Reverse-Z clears to 0 and keeps greater depths, with zero to one clip depth when supported. Standard projection restores the defaults.
+// Depth test itself is still enabled by the caller.
+void applyDepthState(const Camera& camera);
+void applyDepthState(bool reverseZ);
+
+// Clip depth range set by the last applyDepthState: [0, 1] instead of [-1, 1]. Shaders writing gl_FragDepth need it.
+[[nodiscard]] bool zeroToOneClipDepth();
+
+}
+
+#endif
@@ -0,0 +1,63 @@
+#include <learnopengl/fixedtimestep.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace learnopengl {
+
+FixedTimestep::FixedTimestep() : FixedTimestep(Settings{}) {}
+
+FixedTimestep::FixedTimestep(const Settings& settings) : _settings(settings) {}
+
+void FixedTimestep::setSettings(const Settings& settings)
+{
+    // Keep the simulation time, ticks continue at the new rate from there
+    _start += simulationTime();
+    _settings = settings;
+    _start -= simulationTime();
+}
+
+std::uint32_t FixedTimestep::advance(double time)
+{
+    if(!_started)
+    {
+        _start = time;
+        _started = true;
+        _alpha = 0.f;
+        return 0;
+    }
+
+    // Time going back (clock reset): continue from the last tick
+    auto elapsedTicks = (time - _start) * _settings.tickRate;
+    if(elapsedTicks < double(_tickCount))
+    {
+        _start = time - simulationTime();
+        elapsedTicks = double(_tickCount);
+    }
+
+    // Small epsilon so that a time landing on a tick, like a fixed benchmark step, is not rounded to the previous one
+    auto ticks = std::uint64_t(std::floor(elapsedTicks + 1e-6)) - _tickCount;
+    if(ticks > _settings.maxTicksPerFrame)
+    {
+        const auto dropped = ticks - _settings.maxTicksPerFrame;
+        _droppedTicks += dropped;
+        _start += double(dropped) * tickSeconds();
+        ticks = _settings.maxTicksPerFrame;
+    }
+    _tickCount += ticks;
+
+    _alpha = float(std::clamp((time - _start) * _settings.tickRate - double(_tickCount), 0., 1.));
+    _alpha = std::min(_alpha, std::nextafter(1.f, 0.f));
+    return std::uint32_t(ticks);
+}
+
+void FixedTimestep::reset()
+{
+    _start = 0.;
+    _tickCount = 0;
+    _droppedTicks = 0;
+    _alpha = 0.f;
+    _started = false;
+}
+
+}
@@ -0,0 +1,62 @@
+#ifndef __LEARNOPENGL_FIXED_TIMESTEP_HPP__
+#define __LEARNOPENGL_FIXED_TIMESTEP_HPP__
+
+#include <cstdint>
+
+namespace learnopengl {
+
+// Splits frame time into simulation ticks of a fixed duration: state only changes at ticks, so it does not depend on the frame rate
+// and is the same for the same times, and frames show the state interpolated between the last two ticks by alpha().
+// Ticks are counted from the first time given, not accumulated per frame, so no rounding error builds up.
+class FixedTimestep
+{
+public:
+    struct Settings
+    {
+        // Ticks per second
+        double tickRate = 120.;
+        // A longer frame (breakpoint, loading) drops the ticks over this count instead of catching up on them
+        std::uint32_t maxTicksPerFrame = 8;
+    };
+
+public:
+    FixedTimestep();
+    explicit FixedTimestep(const Settings& settings);
+
+    [[nodiscard]] const Settings& settings() const { return _settings; }
+    void setSettings(const Settings& settings);
+
+    // Time of the frame in seconds, returns how many ticks to simulate. The first call starts the clock.
+    [[nodiscard]] std::uint32_t advance(double time);
+
+    // Run update(tickSeconds) for every tick of the frame, returns the tick count
+    template<typename Update>
+    std::uint32_t update(double time, Update&& update)
+    {
+        const auto ticks = advance(time);
+        for(std::uint32_t i = 0; i < ticks; ++i) update(tickSeconds());
+        return ticks;
+    }
+
+    [[nodiscard]] double tickSeconds() const { return 1. / _settings.tickRate; }
+    // Position of the frame between the previous and the last tick, in [0, 1)
+    [[nodiscard]] float alpha() const { return _alpha; }
+    [[nodiscard]] std::uint64_t tickCount() const { return _tickCount; }
+    [[nodiscard]] double simulationTime() const { return double(_tickCount) * tickSeconds(); }
+    // Ticks dropped by maxTicksPerFrame since reset
+    [[nodiscard]] std::uint64_t droppedTicks() const { return _droppedTicks; }
+
+    void reset();
+
+private:
+    Settings _settings;
+    double _start = 0.;
+    std::uint64_t _tickCount = 0;
+    std::uint64_t _droppedTicks = 0;
+    float _alpha = 0.f;
+    bool _started = false;
+};
+
+}
+
+#endif
@@ -1,31 +1,87 @@
 #include <learnopengl/fpscounter.hpp>
+#include <learnopengl/frameprofiler.hpp>
+#include <learnopengl/framepacing.hpp>
+#include <learnopengl/benchmark.hpp>
 #include <GLFW/glfw3.h>
 
+#include <cstdlib>
+#include <iomanip>
+#include <map>
+#include <memory>
 #include <sstream>
 
 namespace learnopengl {
 
-void showFPS(GLFWwindow* pWindow)
+namespace {
+
+struct WindowProfiler
 {
-    static double lastTime = 0;
-    static int nbFrames = 0;
-    // Measure speed
-    const double currentTime = glfwGetTime();
-    const double delta = currentTime - lastTime;
-    nbFrames++;
-    if(delta >= 1.0)
+    ~WindowProfiler()
     {
-        const double fps = double(nbFrames) / delta;
+        const char* path = std::getenv("LEARNOPENGL_FRAME_PACING");
+        if(path && *path)
+            pacing.write(path);
+    }
 
-        std::stringstream ss;
-        ss << "LearnOpenGL"
-           << " [" << fps << " FPS]";
+    FrameProfiler profiler;
+    FramePacingMonitor pacing;
+    double lastTitleTime = 0.;
+};
 
-        glfwSetWindowTitle(pWindow, ss.str().c_str());
+std::map<GLFWwindow*, std::unique_ptr<WindowProfiler>> windowProfilers;
 
-        nbFrames = 0;
-        lastTime = currentTime;
+WindowProfiler& windowProfiler(GLFWwindow* pWindow)
+{
+    auto& windowProfiler = windowProfilers[pWindow];
+    if(!windowProfiler)
+    {
+        windowProfiler = std::make_unique<WindowProfiler>();
+        windowProfiler->profiler.beginFrame();
     }
+    return *windowProfiler;
+}
+
+}
+
+FrameProfiler& frameProfiler(GLFWwindow* pWindow) { return windowProfiler(pWindow).profiler; }
+
+FramePacingMonitor& framePacingMonitor(GLFWwindow* pWindow) { return windowProfiler(pWindow).pacing; }
+
+void showFPS(GLFWwindow* pWindow)
+{
+    // Called once per frame by every demo, end of a benchmark frame
+    if(auto* benchmark = Benchmark::active())
+        benchmark->endFrame(pWindow);
+
+    auto& windowProfiler = learnopengl::windowProfiler(pWindow);
+    auto& profiler = windowProfiler.profiler;
+    profiler.endFrame();
+    profiler.beginFrame();
+    windowProfiler.pacing.frame();
+
+    const double currentTime = glfwGetTime();
+    if(currentTime - windowProfiler.lastTitleTime < 1.0)
+        return;
+    windowProfiler.lastTitleTime = currentTime;
+
+    // Percentiles over the last seconds show spikes that an average hides
+    const auto interval = profiler.statistics(FrameProfiler::Metric::Interval);
+    const auto cpu = profiler.statistics(FrameProfiler::Metric::Cpu);
+    const auto gpu = profiler.statistics(FrameProfiler::Metric::Gpu);
+    if(!interval.count)
+        return;
+
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(1) << "LearnOpenGL"
+       << " [" << 1000. / interval.mean << " FPS, 1% low " << windowProfiler.pacing.onePercentLowFps() << "]"
+       << " [stutters " << windowProfiler.pacing.stutterCount() << "]"
+       << " [cpu p50 " << cpu.p50 << " p99 " << cpu.p99 << " max " << cpu.max << " ms]"
+       << " [gpu p50 " << gpu.p50 << " p99 " << gpu.p99 << " max " << gpu.max << " ms]";
+    // Event to present latency, once the mouse has been used
+    if(const auto& input = windowProfiler.pacing.inputLatency(); input.count())
+        ss << " [input p50 " << input.percentileMs(50.) << " p99 " << input.percentileMs(99.) << " ms]";
+
+    glfwSetWindowTitle(pWindow, ss.str().c_str());
 }
 
 }
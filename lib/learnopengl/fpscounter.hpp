@@ -5,8 +5,21 @@ struct GLFWwindow;
 
 namespace learnopengl {
 
+class FrameProfiler;
+class FramePacingMonitor;
+
+// Call once per frame after glfwSwapBuffers: close the frame of the window profiler, start the next one,
+// record the frame interval in the window frame pacing monitor,
+// and show FPS with 1% low, stutters and CPU/GPU frame time percentiles in the window title once per second.
+// With LEARNOPENGL_FRAME_PACING=<path>, the frame pacing report is written to path at exit.
 void showFPS(GLFWwindow* pWindow);
 
+// Profiler of the window context, created on first use. Scopes added between two showFPS calls belong to the frame.
+FrameProfiler& frameProfiler(GLFWwindow* pWindow);
+
+// Frame pacing monitor of the window, created on first use
+FramePacingMonitor& framePacingMonitor(GLFWwindow* pWindow);
+
 }
 
 #endif
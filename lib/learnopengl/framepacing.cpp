@@ -0,0 +1,253 @@
+#include <learnopengl/framepacing.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+namespace learnopengl {
+
+namespace {
+
+constexpr std::size_t FrameEventCount = std::size_t(FrameEvent::Count);
+
+// Events since the last frame, from any thread
+std::array<std::atomic<std::uint32_t>, FrameEventCount> pendingEventCounts = {};
+std::array<std::atomic<std::uint64_t>, FrameEventCount> pendingEventNs = {};
+
+}
+
+const char* frameEventName(FrameEvent event)
+{
+    switch(event)
+    {
+    case FrameEvent::TextureUpload: return "texture upload";
+    case FrameEvent::ShaderCompile: return "shader compile";
+    case FrameEvent::ModelLoad: return "model load";
+    default: return "unknown";
+    }
+}
+
+void recordFrameEvent(FrameEvent event, double durationMs)
+{
+    const auto index = std::size_t(event);
+    pendingEventCounts[index].fetch_add(1, std::memory_order_relaxed);
+    pendingEventNs[index].fetch_add(std::uint64_t(std::max(durationMs, 0.) * 1e6), std::memory_order_relaxed);
+}
+
+std::size_t FrameTimeHistogram::bucketIndex(std::uint64_t us)
+{
+    if(us < SubBucketCount)
+        return std::size_t(us);
+
+    // Value shifted into [SubBucketHalfCount, SubBucketCount)
+    const auto exponent = std::min(int(std::bit_width(us)) - SubBucketBits, MaxExponent - 1);
+    const auto subBucket = std::min<std::uint64_t>(us >> exponent, SubBucketCount - 1);
+    return std::size_t(SubBucketCount + std::uint64_t(exponent - 1) * SubBucketHalfCount + subBucket - SubBucketHalfCount);
+}
+
+std::uint64_t FrameTimeHistogram::bucketMaxUs(std::size_t index)
+{
+    if(index < SubBucketCount)
+        return index;
+
+    const auto exponent = (index - SubBucketCount) / SubBucketHalfCount + 1;
+    const auto subBucket = (index - SubBucketCount) % SubBucketHalfCount + SubBucketHalfCount;
+    return ((subBucket + 1) << exponent) - 1;
+}
+
+void FrameTimeHistogram::record(double ms)
+{
+    const auto us = std::uint64_t(std::llround(std::max(ms, 0.) * 1000.));
+    ++_buckets[bucketIndex(us)];
+    ++_count;
+    _min = std::min(_min, us);
+    _max = std::max(_max, us);
+    _sumMs += ms;
+}
+
+void FrameTimeHistogram::clear() { *this = FrameTimeHistogram(); }
+
+double FrameTimeHistogram::percentileMs(double percentile) const
+{
+    if(!_count)
+        return 0.;
+
+    const auto rank = std::max<std::uint64_t>(1, std::uint64_t(std::ceil(std::clamp(percentile, 0., 100.) / 100. * double(_count))));
+    std::uint64_t total = 0;
+    for(std::size_t i = 0; i < BucketCount; ++i)
+    {
+        total += _buckets[i];
+        if(total >= rank)
+            return double(std::min(bucketMaxUs(i), _max)) / 1000.;
+    }
+    return maxMs();
+}
+
+void FrameTimeHistogram::write(std::ostream& stream) const
+{
+    stream << std::fixed << std::setw(12) << "Value (ms)" << std::setw(14) << "Percentile" << std::setw(12) << "TotalCount" << std::setw(18)
+           << "1/(1-Percentile)" << "\n";
+
+    // One line per non empty bucket
+    std::uint64_t total = 0;
+    for(std::size_t i = 0; i < BucketCount; ++i)
+    {
+        if(!_buckets[i])
+            continue;
+        total += _buckets[i];
+        const auto fraction = double(total) / double(_count);
+        stream << std::setprecision(3) << std::setw(12) << double(std::min(bucketMaxUs(i), _max)) / 1000. << std::setprecision(6) << std::setw(14)
+               << fraction << std::setw(12) << total;
+        if(total < _count)
+            stream << std::setprecision(2) << std::setw(18) << 1. / (1. - fraction);
+        stream << "\n";
+    }
+    stream << std::setprecision(3) << "#[Mean = " << meanMs() << ", Min = " << minMs() << ", Max = " << maxMs() << ", Count = " << _count << "]\n";
+}
+
+FramePacingMonitor::FramePacingMonitor() : FramePacingMonitor(Settings{}) {}
+
+FramePacingMonitor::FramePacingMonitor(const Settings& settings) : _settings(settings) {}
+
+void FramePacingMonitor::setSettings(const Settings& settings)
+{
+    _settings = settings;
+    while(_recentIntervals.size() > _settings.historySize) _recentIntervals.pop_front();
+    while(_stutters.size() > _settings.maxStutters) _stutters.pop_front();
+}
+
+void FramePacingMonitor::frame()
+{
+    const auto now = std::chrono::steady_clock::now();
+    if(_started)
+        recordInterval(std::chrono::duration<double, std::milli>(now - _lastFrame).count());
+    else
+    {
+        // Loading done before the first frame is not part of any interval
+        for(std::size_t i = 0; i < FrameEventCount; ++i)
+        {
+            pendingEventCounts[i].store(0, std::memory_order_relaxed);
+            pendingEventNs[i].store(0, std::memory_order_relaxed);
+        }
+    }
+    _lastFrame = now;
+    _started = true;
+
+    if(_pendingInput)
+    {
+        _inputLatency.record(std::chrono::duration<double, std::milli>(now - *_pendingInput).count());
+        _pendingInput.reset();
+    }
+}
+
+void FramePacingMonitor::inputApplied(std::chrono::steady_clock::time_point eventTime)
+{
+    if(!_pendingInput || eventTime < *_pendingInput)
+        _pendingInput = eventTime;
+}
+
+void FramePacingMonitor::recordInterval(double intervalMs)
+{
+    Stutter stutter;
+    stutter.frame = _frameCount++;
+    stutter.intervalMs = intervalMs;
+    for(std::size_t i = 0; i < FrameEventCount; ++i)
+    {
+        stutter.events[i].count = pendingEventCounts[i].exchange(0, std::memory_order_relaxed);
+        stutter.events[i].ms = double(pendingEventNs[i].exchange(0, std::memory_order_relaxed)) / 1e6;
+        if(stutter.events[i].count)
+            ++_framesWithEvent[i];
+    }
+
+    _histogram.record(intervalMs);
+    _recentIntervals.push_back(intervalMs);
+    while(_recentIntervals.size() > _settings.historySize) _recentIntervals.pop_front();
+
+    if(intervalMs <= stutterThresholdMs())
+        return;
+
+    ++_stutterCount;
+    for(std::size_t i = 0; i < FrameEventCount; ++i)
+    {
+        if(stutter.events[i].count)
+            ++_stuttersWithEvent[i];
+    }
+    _stutters.push_back(stutter);
+    while(_stutters.size() > _settings.maxStutters) _stutters.pop_front();
+}
+
+double FramePacingMonitor::onePercentLowFps() const
+{
+    const auto ms = _histogram.percentileMs(99.);
+    return ms > 0. ? 1000. / ms : 0.;
+}
+
+void FramePacingMonitor::reset()
+{
+    _histogram.clear();
+    _recentIntervals.clear();
+    _stutters.clear();
+    _frameCount = 0;
+    _stutterCount = 0;
+    _stuttersWithEvent = {};
+    _framesWithEvent = {};
+    _started = false;
+    _inputLatency.clear();
+    _pendingInput.reset();
+}
+
+void FramePacingMonitor::write(std::ostream& stream) const
+{
+    stream << std::fixed << std::setprecision(3) << "Frame intervals: " << _histogram.count() << " frames, mean " << _histogram.meanMs()
+           << " ms, p50 " << _histogram.percentileMs(50.) << " p90 " << _histogram.percentileMs(90.) << " p99 " << _histogram.percentileMs(99.)
+           << " p99.9 " << _histogram.percentileMs(99.9) << " max " << _histogram.maxMs() << " ms, 1% low " << std::setprecision(1)
+           << onePercentLowFps() << " FPS\n";
+    if(_inputLatency.count())
+    {
+        stream << std::setprecision(3) << "Input to present latency: " << _inputLatency.count() << " frames, p50 " << _inputLatency.percentileMs(50.)
+               << " p99 " << _inputLatency.percentileMs(99.) << " max " << _inputLatency.maxMs() << " ms\n";
+    }
+    stream << std::setprecision(3) << "Stutters (> " << stutterThresholdMs() << " ms): " << _stutterCount << "\n";
+
+    // A spike correlates with an event type when the event is much more frequent in stutters than in frames overall
+    for(std::size_t i = 0; i < FrameEventCount; ++i)
+    {
+        stream << "  " << std::setw(16) << std::left << frameEventName(FrameEvent(i)) << std::right << " in " << _stuttersWithEvent[i] << " stutters, "
+               << _framesWithEvent[i] << " frames\n";
+    }
+
+    stream << "\n";
+    _histogram.write(stream);
+
+    if(_stutters.empty())
+        return;
+    stream << "\nLast stutters:\n";
+    for(const auto& stutter: _stutters)
+    {
+        stream << "  frame " << stutter.frame << " " << std::setprecision(3) << stutter.intervalMs << " ms";
+        for(std::size_t i = 0; i < FrameEventCount; ++i)
+        {
+            if(stutter.events[i].count)
+                stream << ", " << frameEventName(FrameEvent(i)) << " x" << stutter.events[i].count << " (" << stutter.events[i].ms << " ms)";
+        }
+        stream << "\n";
+    }
+}
+
+bool FramePacingMonitor::write(const std::string& path) const
+{
+    std::ofstream file(path);
+    if(!file)
+    {
+        std::cerr << "FramePacingMonitor: can't write " << path << std::endl;
+        return false;
+    }
+    write(file);
+    return bool(file);
+}
+
+}
@@ -0,0 +1,162 @@
+#ifndef __LEARNOPENGL_FRAME_PACING_HPP__
+#define __LEARNOPENGL_FRAME_PACING_HPP__
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace learnopengl {
+
+// Work that commonly causes a stutter when done inside the render loop
+enum class FrameEvent
+{
+    TextureUpload,
+    ShaderCompile,
+    ModelLoad,
+    Count,
+};
+
+[[nodiscard]] const char* frameEventName(FrameEvent event);
+
+// Add an event of this duration to the current frame. Thread safe, events are taken by the next FramePacingMonitor::frame.
+void recordFrameEvent(FrameEvent event, double durationMs);
+
+// Record the event with the duration of the scope
+class FrameEventScope
+{
+public:
+    explicit FrameEventScope(FrameEvent event) : _event(event), _begin(std::chrono::steady_clock::now()) {}
+    ~FrameEventScope() { recordFrameEvent(_event, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - _begin).count()); }
+
+    FrameEventScope(const FrameEventScope&) = delete;
+    FrameEventScope& operator=(const FrameEventScope&) = delete;
+
+private:
+    FrameEvent _event;
+    std::chrono::steady_clock::time_point _begin;
+};
+
+// Histogram of durations in microseconds with a bounded relative error (HdrHistogram layout): values below 256 µs have their own bucket,
+// above each power of two range is split in 128 buckets, so any recorded value is known within 0.8% from 1 µs to over an hour.
+class FrameTimeHistogram
+{
+public:
+    static constexpr int SubBucketBits = 8;
+    static constexpr std::uint64_t SubBucketCount = 1u << SubBucketBits;
+    static constexpr std::uint64_t SubBucketHalfCount = SubBucketCount / 2;
+    // Values up to 2^32 µs, larger ones are clamped
+    static constexpr int MaxExponent = 32 - SubBucketBits + 1;
+    static constexpr std::size_t BucketCount = SubBucketCount + std::size_t(MaxExponent - 1) * SubBucketHalfCount;
+
+    void record(double ms);
+    void clear();
+
+    [[nodiscard]] std::uint64_t count() const { return _count; }
+    [[nodiscard]] double minMs() const { return _count ? double(_min) / 1000. : 0.; }
+    [[nodiscard]] double maxMs() const { return double(_max) / 1000.; }
+    [[nodiscard]] double meanMs() const { return _count ? _sumMs / double(_count) : 0.; }
+    // Upper bound of the bucket holding the value at this percentile (0 to 100)
+    [[nodiscard]] double percentileMs(double percentile) const;
+
+    // Percentile distribution as HdrHistogram prints it: value, percentile, total count, 1/(1-percentile)
+    void write(std::ostream& stream) const;
+
+private:
+    [[nodiscard]] static std::size_t bucketIndex(std::uint64_t us);
+    // Highest value of the bucket
+    [[nodiscard]] static std::uint64_t bucketMaxUs(std::size_t index);
+
+    std::array<std::uint64_t, BucketCount> _buckets = {};
+    std::uint64_t _count = 0;
+    std::uint64_t _min = ~std::uint64_t(0);
+    std::uint64_t _max = 0;
+    double _sumMs = 0.;
+};
+
+// Frame to frame intervals of presented frames, measured with steady_clock (glfw time follows the fixed step of benchmarks).
+// A frame longer than stutterFactor times the budget is a stutter, kept with the frame events that happened during it.
+class FramePacingMonitor
+{
+public:
+    struct Settings
+    {
+        double budgetMs = 1000. / 60.;
+        double stutterFactor = 2.;
+        // Last intervals kept for the overlay
+        std::size_t historySize = 240;
+        std::size_t maxStutters = 256;
+    };
+
+    struct EventStats
+    {
+        std::uint32_t count = 0;
+        double ms = 0.;
+    };
+
+    struct Stutter
+    {
+        std::uint64_t frame = 0;
+        double intervalMs = 0.;
+        std::array<EventStats, std::size_t(FrameEvent::Count)> events = {};
+    };
+
+public:
+    FramePacingMonitor();
+    explicit FramePacingMonitor(const Settings& settings);
+
+    [[nodiscard]] const Settings& settings() const { return _settings; }
+    void setSettings(const Settings& settings);
+
+    // Call once per presented frame, the first call only starts the clock
+    void frame();
+    // Record an interval measured elsewhere, takes pending frame events
+    void recordInterval(double intervalMs);
+    // Input received at this time is applied to the frame being rendered: its latency is measured when the next frame() presents it.
+    // Only the oldest input of a frame counts, it waited the longest.
+    void inputApplied(std::chrono::steady_clock::time_point eventTime);
+
+    [[nodiscard]] std::uint64_t frameCount() const { return _frameCount; }
+    [[nodiscard]] const FrameTimeHistogram& histogram() const { return _histogram; }
+    // Oldest first
+    [[nodiscard]] const std::deque<double>& recentIntervals() const { return _recentIntervals; }
+    [[nodiscard]] double stutterThresholdMs() const { return _settings.budgetMs * _settings.stutterFactor; }
+    // Every stutter since reset, the stutter list only keeps the last maxStutters
+    [[nodiscard]] std::uint64_t stutterCount() const { return _stutterCount; }
+    [[nodiscard]] const std::deque<Stutter>& stutters() const { return _stutters; }
+    // Stutters and frames during which an event of this type happened, since reset
+    [[nodiscard]] std::uint64_t stuttersWithEvent(FrameEvent event) const { return _stuttersWithEvent[std::size_t(event)]; }
+    [[nodiscard]] std::uint64_t framesWithEvent(FrameEvent event) const { return _framesWithEvent[std::size_t(event)]; }
+    // FPS of the slowest 1% frames
+    [[nodiscard]] double onePercentLowFps() const;
+    // Time from an input event to the presentation of the first frame showing it
+    [[nodiscard]] const FrameTimeHistogram& inputLatency() const { return _inputLatency; }
+
+    void reset();
+
+    // Summary, stutter correlation, percentile distribution and stutter list
+    void write(std::ostream& stream) const;
+    bool write(const std::string& path) const;
+
+private:
+    Settings _settings;
+    FrameTimeHistogram _histogram;
+    std::deque<double> _recentIntervals;
+    std::deque<Stutter> _stutters;
+    std::uint64_t _frameCount = 0;
+    std::uint64_t _stutterCount = 0;
+    std::array<std::uint64_t, std::size_t(FrameEvent::Count)> _stuttersWithEvent = {};
+    std::array<std::uint64_t, std::size_t(FrameEvent::Count)> _framesWithEvent = {};
+    std::chrono::steady_clock::time_point _lastFrame;
+    bool _started = false;
+    FrameTimeHistogram _inputLatency;
+    std::optional<std::chrono::steady_clock::time_point> _pendingInput;
+};
+
+}
+
+#endif
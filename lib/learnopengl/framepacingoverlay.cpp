@@ -0,0 +1,78 @@
+#include <learnopengl/framepacingoverlay.hpp>
+#include <learnopengl/framepacing.hpp>
+#include <learnopengl/shader.hpp>
+
+#include <glad/glad.h>
+
+#include <algorithm>
+
+namespace learnopengl {
+
+FramePacingOverlay::FramePacingOverlay()
+{
+    glGenVertexArrays(1, &_VAO);
+    glGenBuffers(1, &_VBO);
+
+    glBindVertexArray(_VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, _VBO);
+    glVertexAttribPointer(0, 1, GL_FLOAT, GL_FALSE, sizeof(float), reinterpret_cast<void*>(0));
+    glEnableVertexAttribArray(0);
+    glVertexAttribDivisor(0, 1);
+    glBindVertexArray(0);
+
+    _shader = std::make_unique<Shader>("resources/shaders/framepacing.vs", "resources/shaders/framepacing.fs");
+}
+
+FramePacingOverlay::~FramePacingOverlay()
+{
+    glDeleteVertexArrays(1, &_VAO);
+    glDeleteBuffers(1, &_VBO);
+}
+
+void FramePacingOverlay::draw(const FramePacingMonitor& monitor)
+{
+    const auto& recentIntervals = monitor.recentIntervals();
+    if(recentIntervals.empty())
+        return;
+
+    _intervals.assign(recentIntervals.begin(), recentIntervals.end());
+    glBindBuffer(GL_ARRAY_BUFFER, _VBO);
+    if(_intervals.size() > _capacity)
+    {
+        _capacity = std::max(_intervals.size(), monitor.settings().historySize);
+        glBufferData(GL_ARRAY_BUFFER, GLsizeiptr(_capacity * sizeof(float)), nullptr, GL_STREAM_DRAW);
+    }
+    glBufferSubData(GL_ARRAY_BUFFER, 0, GLsizeiptr(_intervals.size() * sizeof(float)), _intervals.data());
+
+    // Stutter threshold at two thirds of the height
+    const auto stutterMs = float(monitor.stutterThresholdMs());
+    _shader->use();
+    _shader->setVec4("rect", _rect.x, _rect.y, _rect.z, _rect.w);
+    _shader->setInt("barCount", int(std::max(_intervals.size(), monitor.settings().historySize)));
+    _shader->setFloat("budgetMs", float(monitor.settings().budgetMs));
+    _shader->setFloat("stutterMs", stutterMs);
+    _shader->setFloat("scaleMs", stutterMs * 1.5f);
+
+    const auto depthTest = glIsEnabled(GL_DEPTH_TEST);
+    const auto blend = glIsEnabled(GL_BLEND);
+    GLint blendFunc[4];
+    glGetIntegerv(GL_BLEND_SRC_RGB, &blendFunc[0]);
+    glGetIntegerv(GL_BLEND_DST_RGB, &blendFunc[1]);
+    glGetIntegerv(GL_BLEND_SRC_ALPHA, &blendFunc[2]);
+    glGetIntegerv(GL_BLEND_DST_ALPHA, &blendFunc[3]);
+    glDisable(GL_DEPTH_TEST);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    glBindVertexArray(_VAO);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, GLsizei(_intervals.size()));
+    glBindVertexArray(0);
+
+    if(depthTest)
+        glEnable(GL_DEPTH_TEST);
+    if(!blend)
+        glDisable(GL_BLEND);
+    glBlendFuncSeparate(GLenum(blendFunc[0]), GLenum(blendFunc[1]), GLenum(blendFunc[2]), GLenum(blendFunc[3]));
+}
+
+}
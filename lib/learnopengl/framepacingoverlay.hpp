@@ -0,0 +1,45 @@
+#ifndef __LEARNOPENGL_FRAME_PACING_OVERLAY_HPP__
+#define __LEARNOPENGL_FRAME_PACING_OVERLAY_HPP__
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <glm/vec4.hpp>
+
+namespace learnopengl {
+
+class Shader;
+class FramePacingMonitor;
+
+// Bar graph of the recent frame intervals of a FramePacingMonitor, drawn over the current framebuffer before swapping buffers.
+// Green within budget, yellow over budget, red for stutters.
+class FramePacingOverlay
+{
+public:
+    FramePacingOverlay();
+    ~FramePacingOverlay();
+
+    FramePacingOverlay(const FramePacingOverlay&) = delete;
+    FramePacingOverlay& operator=(const FramePacingOverlay&) = delete;
+
+    void draw(const FramePacingMonitor& monitor);
+
+    // Graph area in normalized device coordinates: x, y, width, height
+    [[nodiscard]] const glm::vec4& rect() const { return _rect; }
+    void setRect(const glm::vec4& rect) { _rect = rect; }
+
+private:
+    std::uint32_t _VAO = 0;
+    std::uint32_t _VBO = 0;
+    std::size_t _capacity = 0;
+    std::vector<float> _intervals;
+
+    std::unique_ptr<Shader> _shader;
+
+    glm::vec4 _rect = glm::vec4(-0.98f, -0.98f, 0.8f, 0.3f);
+};
+
+}
+
+#endif
@@ -0,0 +1,245 @@
+#include <learnopengl/frameprofiler.hpp>
+#include <learnopengl/trace.hpp>
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstring>
+
+namespace learnopengl {
+
+namespace {
+
+double clockMs() { return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+
+FrameProfiler::Statistics computeStatistics(std::vector<double> values)
+{
+    FrameProfiler::Statistics statistics;
+    if(values.empty())
+        return statistics;
+
+    std::sort(values.begin(), values.end());
+    // Nearest rank
+    const auto percentile = [&](double rank) { return values[std::min(values.size() - 1, std::size_t(rank * double(values.size())))]; };
+
+    statistics.count = values.size();
+    for(const auto value: values) statistics.mean += value;
+    statistics.mean /= double(values.size());
+    statistics.p50 = percentile(0.5);
+    statistics.p95 = percentile(0.95);
+    statistics.p99 = percentile(0.99);
+    statistics.max = values.back();
+    return statistics;
+}
+
+}
+
+FrameProfiler::FrameProfiler(std::size_t historySize, std::size_t gpuLatency) :
+    _historySize(historySize), _frames(std::max<std::size_t>(gpuLatency, 1) + 1)
+{
+}
+
+FrameProfiler::~FrameProfiler()
+{
+    for(auto& frame: _frames)
+    {
+        if(!frame.queries.empty())
+            glDeleteQueries(GLsizei(frame.queries.size()), frame.queries.data());
+    }
+}
+
+int FrameProfiler::queryTimestamp(PendingFrame& frame)
+{
+    if(frame.usedQueries == frame.queries.size())
+    {
+        std::uint32_t query = 0;
+        glGenQueries(1, &query);
+        frame.queries.push_back(query);
+    }
+
+    const auto index = frame.usedQueries++;
+    glQueryCounter(frame.queries[index], GL_TIMESTAMP);
+    return int(index);
+}
+
+void FrameProfiler::beginFrame()
+{
+    assert(!_inFrame);
+
+    // The slot still holds the frame issued gpuLatency frames ago, its queries are most likely available by now.
+    // Timestamps complete in order, the last one tells for the whole frame: reading a pending one would stall.
+    auto& frame = _frames[_frameIndex % _frames.size()];
+    if(frame.used)
+    {
+        GLuint available = GL_FALSE;
+        glGetQueryObjectuiv(frame.queries[frame.usedQueries - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+        if(available)
+            resolve(frame);
+        else
+            ++_droppedFrameCount;
+    }
+
+    frame.used = true;
+    frame.index = _frameIndex;
+    frame.scopes.clear();
+    frame.usedQueries = 0;
+    frame.cpuBegin = clockMs();
+    frame.beginQuery = queryTimestamp(frame);
+    frame.traceBegin = 0;
+
+    if(tracingEnabled())
+    {
+        frame.traceBegin = traceTicks();
+        if(!_calibrated || _frameIndex - _calibrationFrame >= CalibrationInterval)
+            calibrateGpuClock();
+    }
+
+    _inFrame = true;
+}
+
+void FrameProfiler::endFrame()
+{
+    assert(_inFrame && _openScopes.empty());
+
+    auto& frame = _frames[_frameIndex % _frames.size()];
+    frame.endQuery = queryTimestamp(frame);
+    frame.cpuEnd = clockMs();
+    if(tracingEnabled() && frame.traceBegin)
+        recordTraceEvent("frame", frame.traceBegin, traceTicks());
+
+    _inFrame = false;
+    ++_frameIndex;
+}
+
+void FrameProfiler::beginScope(const char* name, bool gpu)
+{
+    if(!_inFrame)
+        return;
+
+    auto& frame = _frames[_frameIndex % _frames.size()];
+    PendingScope scope;
+    scope.name = name;
+    scope.depth = int(_openScopes.size());
+    if(gpu)
+        scope.beginQuery = queryTimestamp(frame);
+    scope.cpuBegin = clockMs();
+    if(tracingEnabled())
+        scope.traceBegin = traceTicks();
+
+    _openScopes.push_back(frame.scopes.size());
+    frame.scopes.push_back(scope);
+}
+
+void FrameProfiler::endScope()
+{
+    if(!_inFrame || _openScopes.empty())
+        return;
+
+    auto& frame = _frames[_frameIndex % _frames.size()];
+    auto& scope = frame.scopes[_openScopes.back()];
+    _openScopes.pop_back();
+
+    scope.cpuEnd = clockMs();
+    if(tracingEnabled() && scope.traceBegin)
+        recordTraceEvent(scope.name, scope.traceBegin, traceTicks());
+    if(scope.beginQuery >= 0)
+        scope.endQuery = queryTimestamp(frame);
+}
+
+void FrameProfiler::calibrateGpuClock()
+{
+    // GL_TIMESTAMP state is the GPU time once previous commands reached the GPU, without waiting for them to complete
+    GLint64 gpuTime = 0;
+    const auto before = traceClockNs();
+    glGetInteger64v(GL_TIMESTAMP, &gpuTime);
+    const auto after = traceClockNs();
+
+    _gpuClockOffset = std::int64_t(before + (after - before) / 2) - std::int64_t(gpuTime);
+    _calibrationFrame = _frameIndex;
+    _calibrated = true;
+}
+
+void FrameProfiler::traceGpuEvents(const PendingFrame& frame, const std::vector<std::uint64_t>& timestamps) const
+{
+    const auto toTraceClock = [&](int query) { return std::uint64_t(std::int64_t(timestamps[std::size_t(query)]) + _gpuClockOffset); };
+
+    recordGpuTraceEvent("frame", toTraceClock(frame.beginQuery), toTraceClock(frame.endQuery));
+    for(const auto& scope: frame.scopes)
+    {
+        if(scope.beginQuery >= 0)
+            recordGpuTraceEvent(scope.name, toTraceClock(scope.beginQuery), toTraceClock(scope.endQuery));
+    }
+}
+
+void FrameProfiler::resolve(PendingFrame& pending)
+{
+    std::vector<std::uint64_t> timestamps(pending.usedQueries);
+    for(std::size_t i = 0; i < pending.usedQueries; ++i) glGetQueryObjectui64v(pending.queries[i], GL_QUERY_RESULT, &timestamps[i]);
+
+    if(tracingEnabled() && _calibrated)
+        traceGpuEvents(pending, timestamps);
+
+    const auto gpuMs = [&](int begin, int end) { return double(timestamps[std::size_t(end)] - timestamps[std::size_t(begin)]) / 1e6; };
+
+    Frame frame;
+    frame.index = pending.index;
+    frame.cpuMs = pending.cpuEnd - pending.cpuBegin;
+    frame.gpuMs = gpuMs(pending.beginQuery, pending.endQuery);
+    // The next slot holds the following frame, which has begun already
+    const auto& next = _frames[(pending.index + 1) % _frames.size()];
+    frame.intervalMs = next.used && next.index == pending.index + 1 ? next.cpuBegin - pending.cpuBegin : frame.cpuMs;
+
+    frame.scopes.reserve(pending.scopes.size());
+    for(const auto& scope: pending.scopes)
+    {
+        frame.scopes.push_back(
+            {scope.name, scope.depth, scope.cpuEnd - scope.cpuBegin, scope.beginQuery >= 0 ? gpuMs(scope.beginQuery, scope.endQuery) : -1.});
+    }
+
+    _history.push_back(std::move(frame));
+    while(_history.size() > _historySize) _history.pop_front();
+
+    pending.used = false;
+}
+
+FrameProfiler::Statistics FrameProfiler::statistics(Metric metric) const
+{
+    std::vector<double> values;
+    values.reserve(_history.size());
+    for(const auto& frame: _history)
+    {
+        switch(metric)
+        {
+        case Metric::Cpu: values.push_back(frame.cpuMs); break;
+        case Metric::Gpu: values.push_back(frame.gpuMs); break;
+        case Metric::Interval: values.push_back(frame.intervalMs); break;
+        }
+    }
+    return computeStatistics(std::move(values));
+}
+
+FrameProfiler::Statistics FrameProfiler::scopeStatistics(const char* name, Metric metric) const
+{
+    std::vector<double> values;
+    for(const auto& frame: _history)
+    {
+        double total = 0.;
+        bool found = false;
+        for(const auto& scope: frame.scopes)
+        {
+            if(scope.name != name && std::strcmp(scope.name, name) != 0)
+                continue;
+            if(metric == Metric::Gpu && scope.gpuMs < 0.)
+                continue;
+            total += metric == Metric::Gpu ? scope.gpuMs : scope.cpuMs;
+            found = true;
+        }
+        if(found)
+            values.push_back(total);
+    }
+    return computeStatistics(std::move(values));
+}
+
+}
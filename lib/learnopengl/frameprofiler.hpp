@@ -0,0 +1,154 @@
+#ifndef __LEARNOPENGL_FRAME_PROFILER_HPP__
+#define __LEARNOPENGL_FRAME_PROFILER_HPP__
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace learnopengl {
+
+// CPU and GPU timings of frames and of nested scopes inside them.
+// GPU times come from GL_TIMESTAMP queries (nestable, unlike GL_TIME_ELAPSED) issued in a ring of frames:
+// a frame is only read back gpuLatency frames later, so the CPU never waits on the GPU. A frame whose queries are still pending
+// when its slot is reused (the GPU is more than gpuLatency frames behind) is dropped from the history instead.
+// One profiler per OpenGL context, it must be created and used with its context current.
+// While tracing is enabled (trace.hpp), frames and scopes are also recorded as trace events, GPU ones on the GPU track.
+class FrameProfiler
+{
+public:
+    struct Scope
+    {
+        // Scope names must be string literals, or outlive the profiler history
+        const char* name = nullptr;
+        // 0 for scopes directly in the frame
+        int depth = 0;
+        double cpuMs = 0.;
+        // Negative when the scope has no GPU queries
+        double gpuMs = -1.;
+    };
+
+    struct Frame
+    {
+        std::uint64_t index = 0;
+        // beginFrame to endFrame
+        double cpuMs = 0.;
+        double gpuMs = 0.;
+        // beginFrame to next beginFrame
+        double intervalMs = 0.;
+        // In begin order, parents before children
+        std::vector<Scope> scopes;
+    };
+
+    struct Statistics
+    {
+        std::size_t count = 0;
+        double mean = 0.;
+        double p50 = 0.;
+        double p95 = 0.;
+        double p99 = 0.;
+        double max = 0.;
+    };
+
+    enum class Metric
+    {
+        Cpu,
+        Gpu,
+        Interval,
+    };
+
+    // Scoped begin/end
+    class ScopeGuard
+    {
+    public:
+        ScopeGuard(FrameProfiler& profiler, const char* name, bool gpu = true) : _profiler(profiler) { _profiler.beginScope(name, gpu); }
+        ~ScopeGuard() { _profiler.endScope(); }
+
+        ScopeGuard(const ScopeGuard&) = delete;
+        ScopeGuard& operator=(const ScopeGuard&) = delete;
+
+    private:
+        FrameProfiler& _profiler;
+    };
+
+public:
+    explicit FrameProfiler(std::size_t historySize = 600, std::size_t gpuLatency = 3);
+    ~FrameProfiler();
+
+    FrameProfiler(const FrameProfiler&) = delete;
+    FrameProfiler& operator=(const FrameProfiler&) = delete;
+
+    void beginFrame();
+    void endFrame();
+    [[nodiscard]] bool inFrame() const { return _inFrame; }
+
+    // Scopes nest, and must be closed before endFrame. With gpu, timestamps are queried at begin and end.
+    void beginScope(const char* name, bool gpu = true);
+    void endScope();
+
+    // Resolved frames, oldest first. The last gpuLatency frames are not resolved yet.
+    [[nodiscard]] const std::deque<Frame>& history() const { return _history; }
+    [[nodiscard]] const Frame* lastFrame() const { return _history.empty() ? nullptr : &_history.back(); }
+
+    // Over the whole history
+    [[nodiscard]] Statistics statistics(Metric metric) const;
+    // Time of every scope with this name, summed per frame. Gpu metric only counts scopes with GPU queries.
+    [[nodiscard]] Statistics scopeStatistics(const char* name, Metric metric = Metric::Cpu) const;
+
+    void clearHistory() { _history.clear(); }
+    // Frames left out of the history because their GPU results were not available in time
+    [[nodiscard]] std::uint64_t droppedFrameCount() const { return _droppedFrameCount; }
+
+private:
+    struct PendingScope
+    {
+        const char* name = nullptr;
+        int depth = 0;
+        double cpuBegin = 0.;
+        double cpuEnd = 0.;
+        std::uint64_t traceBegin = 0;
+        // Indices in the frame query pool, -1 without GPU timing
+        int beginQuery = -1;
+        int endQuery = -1;
+    };
+
+    // Frame waiting for its GPU results
+    struct PendingFrame
+    {
+        bool used = false;
+        std::uint64_t index = 0;
+        double cpuBegin = 0.;
+        double cpuEnd = 0.;
+        std::uint64_t traceBegin = 0;
+        int beginQuery = -1;
+        int endQuery = -1;
+        std::vector<PendingScope> scopes;
+        // Grows to the max number of queries of a frame, then reused
+        std::vector<std::uint32_t> queries;
+        std::size_t usedQueries = 0;
+    };
+
+    int queryTimestamp(PendingFrame& frame);
+    void resolve(PendingFrame& frame);
+    void calibrateGpuClock();
+    void traceGpuEvents(const PendingFrame& frame, const std::vector<std::uint64_t>& timestamps) const;
+
+    std::size_t _historySize;
+    std::vector<PendingFrame> _frames;
+    std::deque<Frame> _history;
+
+    std::uint64_t _frameIndex = 0;
+    std::uint64_t _droppedFrameCount = 0;
+    bool _inFrame = false;
+    // Indices in current frame scopes
+    std::vector<std::size_t> _openScopes;
+
+    // Trace clock minus GPU clock in nanoseconds, measured again every CalibrationInterval frames as the clocks drift
+    static constexpr std::uint64_t CalibrationInterval = 600;
+    std::int64_t _gpuClockOffset = 0;
+    std::uint64_t _calibrationFrame = 0;
+    bool _calibrated = false;
+};
+
+}
+
+#endif
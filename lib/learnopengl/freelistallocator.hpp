@@ -0,0 +1,105 @@
+#ifndef __LEARNOPENGL_FREE_LIST_ALLOCATOR_HPP__
+#define __LEARNOPENGL_FREE_LIST_ALLOCATOR_HPP__
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace learnopengl {
+
+// First fit allocator of [0, capacity) ranges, free ranges are kept sorted and coalesced.
+// Only offsets are managed, the storage itself (ex: a GPU buffer) is owned by the caller.
+class FreeListAllocator
+{
+public:
+    struct Range
+    {
+        std::size_t offset = 0;
+        std::size_t size = 0;
+    };
+
+    explicit FreeListAllocator(std::size_t capacity = 0) { reset(capacity); }
+
+    void reset(std::size_t capacity, std::size_t used = 0)
+    {
+        _capacity = capacity;
+        _used = used;
+        _freeRanges.clear();
+        if(used < capacity)
+            _freeRanges.push_back({used, capacity - used});
+    }
+
+    // An empty range takes no space and always succeeds, its offset is meaningless
+    std::optional<std::size_t> allocate(std::size_t size)
+    {
+        if(!size)
+            return std::size_t(0);
+
+        for(auto it = _freeRanges.begin(); it != _freeRanges.end(); ++it)
+        {
+            if(it->size < size)
+                continue;
+
+            const auto offset = it->offset;
+            it->offset += size;
+            it->size -= size;
+            if(!it->size)
+                _freeRanges.erase(it);
+            _used += size;
+            return offset;
+        }
+        return std::nullopt;
+    }
+
+    void free(std::size_t offset, std::size_t size)
+    {
+        if(!size)
+            return;
+
+        _used -= size;
+        auto next = std::lower_bound(
+            _freeRanges.begin(), _freeRanges.end(), offset, [](const Range& range, std::size_t value) { return range.offset < value; });
+        next = _freeRanges.insert(next, {offset, size});
+
+        // Merge with next range
+        if(next + 1 != _freeRanges.end() && next->offset + next->size == (next + 1)->offset)
+        {
+            next->size += (next + 1)->size;
+            _freeRanges.erase(next + 1);
+        }
+        // Merge with previous range
+        if(next != _freeRanges.begin() && (next - 1)->offset + (next - 1)->size == next->offset)
+        {
+            (next - 1)->size += next->size;
+            _freeRanges.erase(next);
+        }
+    }
+
+    [[nodiscard]] std::size_t capacity() const { return _capacity; }
+    [[nodiscard]] std::size_t used() const { return _used; }
+    [[nodiscard]] std::size_t freeRangeCount() const { return _freeRanges.size(); }
+
+    [[nodiscard]] std::size_t largestFreeRange() const
+    {
+        std::size_t largest = 0;
+        for(const auto& range: _freeRanges) largest = std::max(largest, range.size);
+        return largest;
+    }
+
+    // 0 when all free space is contiguous, close to 1 when free space is scattered in small ranges
+    [[nodiscard]] float fragmentation() const
+    {
+        const auto freeSize = _capacity - _used;
+        return freeSize ? 1.f - float(largestFreeRange()) / float(freeSize) : 0.f;
+    }
+
+private:
+    std::size_t _capacity = 0;
+    std::size_t _used = 0;
+    std::vector<Range> _freeRanges;
+};
+
+}
+
+#endif
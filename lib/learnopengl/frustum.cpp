@@ -0,0 +1,284 @@
+#include <learnopengl/frustum.hpp>
+
+#include <glm/geometric.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define LEARNOPENGL_FRUSTUM_SSE
+#    include <emmintrin.h>
+#endif
+
+// 8 boxes at a time when built for AVX (LEARNOPENGL_AVX2 option)
+#ifdef __AVX__
+#    define LEARNOPENGL_FRUSTUM_AVX
+#    include <immintrin.h>
+#endif
+
+namespace learnopengl {
+
+static bool boxInsidePlanes(const std::array<glm::vec4, Frustum::PlaneCount>& planes,
+    float cx,
+    float cy,
+    float cz,
+    float ex,
+    float ey,
+    float ez)
+{
+    for(const auto& plane: planes)
+    {
+        const float distance = plane.x * cx + plane.y * cy + plane.z * cz + plane.w;
+        const float radius = std::fabs(plane.x) * ex + std::fabs(plane.y) * ey + std::fabs(plane.z) * ez;
+        if(distance + radius < 0.f)
+            return false;
+    }
+    return true;
+}
+
+Frustum::Frustum(const glm::mat4& viewProjection)
+{
+    // glm matrices are column major, m[column][row]
+    const auto row = [&](int i)
+    { return glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]); };
+
+    const auto r0 = row(0);
+    const auto r1 = row(1);
+    const auto r2 = row(2);
+    const auto r3 = row(3);
+
+    // OpenGL clip space: -w <= x, y, z <= w
+    _planes[Left] = r3 + r0;
+    _planes[Right] = r3 - r0;
+    _planes[Bottom] = r3 + r1;
+    _planes[Top] = r3 - r1;
+    _planes[Near] = r3 + r2;
+    _planes[Far] = r3 - r2;
+
+    for(auto& plane: _planes)
+    {
+        const float length = glm::length(glm::vec3(plane));
+        if(length > 0.f)
+            plane /= length;
+    }
+}
+
+bool Frustum::intersects(const AABB& box) const
+{
+    const auto c = box.center();
+    const auto e = box.extent();
+    return boxInsidePlanes(_planes, c.x, c.y, c.z, e.x, e.y, e.z);
+}
+
+bool Frustum::intersects(const BoundingSphere& sphere) const
+{
+    for(const auto& plane: _planes)
+    {
+        if(glm::dot(glm::vec3(plane), sphere.center) + plane.w < -sphere.radius)
+            return false;
+    }
+    return true;
+}
+
+bool Frustum::intersects(const BoundingCone& cone) const
+{
+    // Close to a half space the base gets huge, test the range sphere instead
+    if(cone.cosHalfAngle < 0.1f)
+        return intersects(BoundingSphere{cone.apex, cone.range});
+
+    const auto baseCenter = cone.apex + cone.direction * cone.range;
+    const float baseRadius = cone.range * std::sqrt(1.f - cone.cosHalfAngle * cone.cosHalfAngle) / cone.cosHalfAngle;
+    for(const auto& plane: _planes)
+    {
+        // The cone is the hull of its apex and base disk: outside when both are, the disk point nearest the plane inside being
+        // along the plane normal projected on the disk
+        const auto normal = glm::vec3(plane);
+        if(glm::dot(normal, cone.apex) + plane.w >= 0.f)
+            continue;
+
+        auto towardPlane = normal - cone.direction * glm::dot(normal, cone.direction);
+        const float length = glm::length(towardPlane);
+        if(length > 1e-6f)
+            towardPlane /= length;
+        const auto basePoint = baseCenter + towardPlane * baseRadius;
+        if(glm::dot(normal, basePoint) + plane.w < 0.f)
+            return false;
+    }
+    return true;
+}
+
+std::size_t Frustum::cullScalar(const AABBArray& boxes, std::uint8_t* visible) const
+{
+    const auto* cx = boxes.centerX();
+    const auto* cy = boxes.centerY();
+    const auto* cz = boxes.centerZ();
+    const auto* ex = boxes.extentX();
+    const auto* ey = boxes.extentY();
+    const auto* ez = boxes.extentZ();
+
+    std::size_t visibleCount = 0;
+    for(std::size_t i = 0; i < boxes.size(); ++i)
+    {
+        visible[i] = boxInsidePlanes(_planes, cx[i], cy[i], cz[i], ex[i], ey[i], ez[i]) ? 1 : 0;
+        visibleCount += visible[i];
+    }
+    return visibleCount;
+}
+
+// SoA boxes against the planes, 8 at a time with AVX, 4 at a time with SSE, then one at a time
+static std::size_t cullBoxes(const std::array<glm::vec4, Frustum::PlaneCount>& planes,
+    const float* cx,
+    const float* cy,
+    const float* cz,
+    const float* ex,
+    const float* ey,
+    const float* ez,
+    std::size_t count,
+    std::uint8_t* visible)
+{
+    std::size_t i = 0;
+    std::size_t visibleCount = 0;
+
+#ifdef LEARNOPENGL_FRUSTUM_AVX
+    {
+        // Splat plane coefficients once, abs of the normal is used to project the extent on the plane normal
+        __m256 planeX[Frustum::PlaneCount], planeY[Frustum::PlaneCount], planeZ[Frustum::PlaneCount], planeW[Frustum::PlaneCount];
+        __m256 absPlaneX[Frustum::PlaneCount], absPlaneY[Frustum::PlaneCount], absPlaneZ[Frustum::PlaneCount];
+        for(int p = 0; p < Frustum::PlaneCount; ++p)
+        {
+            planeX[p] = _mm256_set1_ps(planes[p].x);
+            planeY[p] = _mm256_set1_ps(planes[p].y);
+            planeZ[p] = _mm256_set1_ps(planes[p].z);
+            planeW[p] = _mm256_set1_ps(planes[p].w);
+            absPlaneX[p] = _mm256_set1_ps(std::fabs(planes[p].x));
+            absPlaneY[p] = _mm256_set1_ps(std::fabs(planes[p].y));
+            absPlaneZ[p] = _mm256_set1_ps(std::fabs(planes[p].z));
+        }
+
+        const auto zero = _mm256_setzero_ps();
+        for(; i + 8 <= count; i += 8)
+        {
+            const auto x = _mm256_loadu_ps(cx + i);
+            const auto y = _mm256_loadu_ps(cy + i);
+            const auto z = _mm256_loadu_ps(cz + i);
+            const auto extentX = _mm256_loadu_ps(ex + i);
+            const auto extentY = _mm256_loadu_ps(ey + i);
+            const auto extentZ = _mm256_loadu_ps(ez + i);
+
+            // All lanes start inside, each plane can only clear lanes
+            auto inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+            for(int p = 0; p < Frustum::PlaneCount; ++p)
+            {
+                auto distance = _mm256_add_ps(_mm256_mul_ps(planeX[p], x), _mm256_mul_ps(planeY[p], y));
+                distance = _mm256_add_ps(distance, _mm256_add_ps(_mm256_mul_ps(planeZ[p], z), planeW[p]));
+                auto radius = _mm256_add_ps(_mm256_mul_ps(absPlaneX[p], extentX), _mm256_mul_ps(absPlaneY[p], extentY));
+                radius = _mm256_add_ps(radius, _mm256_mul_ps(absPlaneZ[p], extentZ));
+                inside = _mm256_and_ps(inside, _mm256_cmp_ps(_mm256_add_ps(distance, radius), zero, _CMP_GE_OQ));
+            }
+
+            const int mask = _mm256_movemask_ps(inside);
+            for(int lane = 0; lane < 8; ++lane) visible[i + std::size_t(lane)] = std::uint8_t((mask >> lane) & 1);
+            visibleCount += std::size_t(std::popcount(unsigned(mask)));
+        }
+    }
+#endif
+
+#ifdef LEARNOPENGL_FRUSTUM_SSE
+    {
+        __m128 planeX[Frustum::PlaneCount], planeY[Frustum::PlaneCount], planeZ[Frustum::PlaneCount], planeW[Frustum::PlaneCount];
+        __m128 absPlaneX[Frustum::PlaneCount], absPlaneY[Frustum::PlaneCount], absPlaneZ[Frustum::PlaneCount];
+        for(int p = 0; p < Frustum::PlaneCount; ++p)
+        {
+            planeX[p] = _mm_set1_ps(planes[p].x);
+            planeY[p] = _mm_set1_ps(planes[p].y);
+            planeZ[p] = _mm_set1_ps(planes[p].z);
+            planeW[p] = _mm_set1_ps(planes[p].w);
+            absPlaneX[p] = _mm_set1_ps(std::fabs(planes[p].x));
+            absPlaneY[p] = _mm_set1_ps(std::fabs(planes[p].y));
+            absPlaneZ[p] = _mm_set1_ps(std::fabs(planes[p].z));
+        }
+
+        const auto zero = _mm_setzero_ps();
+        for(; i + 4 <= count; i += 4)
+        {
+            const auto x = _mm_loadu_ps(cx + i);
+            const auto y = _mm_loadu_ps(cy + i);
+            const auto z = _mm_loadu_ps(cz + i);
+            const auto extentX = _mm_loadu_ps(ex + i);
+            const auto extentY = _mm_loadu_ps(ey + i);
+            const auto extentZ = _mm_loadu_ps(ez + i);
+
+            auto inside = _mm_cmpeq_ps(zero, zero);
+            for(int p = 0; p < Frustum::PlaneCount; ++p)
+            {
+                auto distance = _mm_add_ps(_mm_mul_ps(planeX[p], x), _mm_mul_ps(planeY[p], y));
+                distance = _mm_add_ps(distance, _mm_add_ps(_mm_mul_ps(planeZ[p], z), planeW[p]));
+                auto radius = _mm_add_ps(_mm_mul_ps(absPlaneX[p], extentX), _mm_mul_ps(absPlaneY[p], extentY));
+                radius = _mm_add_ps(radius, _mm_mul_ps(absPlaneZ[p], extentZ));
+                inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(distance, radius), zero));
+            }
+
+            const int mask = _mm_movemask_ps(inside);
+            for(int lane = 0; lane < 4; ++lane) visible[i + std::size_t(lane)] = std::uint8_t((mask >> lane) & 1);
+            visibleCount += std::size_t(((mask >> 0) & 1) + ((mask >> 1) & 1) + ((mask >> 2) & 1) + ((mask >> 3) & 1));
+        }
+    }
+#endif
+
+    // Remaining boxes
+    for(; i < count; ++i)
+    {
+        visible[i] = boxInsidePlanes(planes, cx[i], cy[i], cz[i], ex[i], ey[i], ez[i]) ? 1 : 0;
+        visibleCount += visible[i];
+    }
+
+    return visibleCount;
+}
+
+std::size_t Frustum::cull(const AABBArray& boxes, std::uint8_t* visible) const
+{
+    return cullBoxes(
+        _planes, boxes.centerX(), boxes.centerY(), boxes.centerZ(), boxes.extentX(), boxes.extentY(), boxes.extentZ(), boxes.size(), visible);
+}
+
+std::size_t Frustum::cull(std::span<const AABB> boxes, std::span<std::uint8_t> visible) const
+{
+    assert(visible.size() >= boxes.size());
+
+    // Boxes converted to center/extent SoA one block at a time, small enough to stay in L1
+    constexpr std::size_t BlockSize = 256;
+    alignas(32) float cx[BlockSize], cy[BlockSize], cz[BlockSize], ex[BlockSize], ey[BlockSize], ez[BlockSize];
+
+    std::size_t visibleCount = 0;
+    for(std::size_t begin = 0; begin < boxes.size(); begin += BlockSize)
+    {
+        const auto count = std::min(BlockSize, boxes.size() - begin);
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            const auto& box = boxes[begin + i];
+            cx[i] = (box.min.x + box.max.x) * 0.5f;
+            cy[i] = (box.min.y + box.max.y) * 0.5f;
+            cz[i] = (box.min.z + box.max.z) * 0.5f;
+            ex[i] = (box.max.x - box.min.x) * 0.5f;
+            ey[i] = (box.max.y - box.min.y) * 0.5f;
+            ez[i] = (box.max.z - box.min.z) * 0.5f;
+        }
+        visibleCount += cullBoxes(_planes, cx, cy, cz, ex, ey, ez, count, visible.data() + begin);
+    }
+    return visibleCount;
+}
+
+int Frustum::simdWidth()
+{
+#if defined(LEARNOPENGL_FRUSTUM_AVX)
+    return 8;
+#elif defined(LEARNOPENGL_FRUSTUM_SSE)
+    return 4;
+#else
+    return 1;
+#endif
+}
+
+}
@@ -0,0 +1,61 @@
+#ifndef __LEARNOPENGL_FRUSTUM_HPP__
+#define __LEARNOPENGL_FRUSTUM_HPP__
+
+#include <learnopengl/boundingvolume.hpp>
+
+#include <glm/vec4.hpp>
+#include <glm/mat4x4.hpp>
+
+#include <array>
+#include <cstdint>
+#include <span>
+
+namespace learnopengl {
+
+// 6 planes of a view frustum, with normals pointing inside.
+// A point p is inside a plane when dot(plane.xyz, p) + plane.w >= 0
+class Frustum
+{
+public:
+    enum Plane
+    {
+        Left,
+        Right,
+        Bottom,
+        Top,
+        Near,
+        Far,
+        PlaneCount
+    };
+
+    Frustum() = default;
+    // Extract planes from projection * view (Gribb & Hartmann)
+    explicit Frustum(const glm::mat4& viewProjection);
+
+    [[nodiscard]] const std::array<glm::vec4, PlaneCount>& planes() const { return _planes; }
+    [[nodiscard]] const glm::vec4& plane(Plane plane) const { return _planes[plane]; }
+
+    [[nodiscard]] bool intersects(const AABB& box) const;
+    [[nodiscard]] bool intersects(const BoundingSphere& sphere) const;
+    // Conservative: tested as the flat cone of height range, which holds the cone capped by the range sphere
+    [[nodiscard]] bool intersects(const BoundingCone& cone) const;
+
+    // Test boxes 8 at a time with AVX or 4 at a time with SSE (scalar fallback), write 1 in visible for each box intersecting the frustum,
+    // 0 otherwise. visible must have room for boxes.size() entries. Return the number of visible boxes.
+    std::size_t cull(const AABBArray& boxes, std::uint8_t* visible) const;
+    // Same with min/max boxes, converted to SoA by blocks on the fly
+    std::size_t cull(std::span<const AABB> boxes, std::span<std::uint8_t> visible) const;
+
+    // Reference implementation of cull, one box at a time
+    std::size_t cullScalar(const AABBArray& boxes, std::uint8_t* visible) const;
+
+    // Boxes tested at a time by cull as the library was built: 8 with AVX, 4 with SSE, 1 without SIMD
+    [[nodiscard]] static int simdWidth();
+
+private:
+    std::array<glm::vec4, PlaneCount> _planes = {};
+};
+
+}
+
+#endif
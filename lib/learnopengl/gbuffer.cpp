@@ -0,0 +1,206 @@
+#include <learnopengl/gbuffer.hpp>
+#include <learnopengl/camera.hpp>
+#include <learnopengl/depthstate.hpp>
+#include <learnopengl/shader.hpp>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <algorithm>
+#include <iostream>
+
+namespace learnopengl {
+
+namespace {
+
+struct TextureFormat
+{
+    GLenum internalFormat;
+    GLenum format;
+    GLenum type;
+    std::uint32_t bytes;
+};
+
+TextureFormat textureFormat(GBuffer::ColorFormat format)
+{
+    switch(format)
+    {
+    case GBuffer::ColorFormat::RGBA8: return {GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, 4};
+    case GBuffer::ColorFormat::SRGB8Alpha8: return {GL_SRGB8_ALPHA8, GL_RGBA, GL_UNSIGNED_BYTE, 4};
+    case GBuffer::ColorFormat::RGBA16F: return {GL_RGBA16F, GL_RGBA, GL_HALF_FLOAT, 8};
+    case GBuffer::ColorFormat::R11G11B10F: return {GL_R11F_G11F_B10F, GL_RGB, GL_FLOAT, 4};
+    default: return {GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, 4};
+    }
+}
+
+TextureFormat textureFormat(GBuffer::NormalEncoding encoding)
+{
+    // Unsigned normalized: signed normalized formats are not required to be color renderable
+    switch(encoding)
+    {
+    case GBuffer::NormalEncoding::Octahedral16: return {GL_RG16, GL_RG, GL_UNSIGNED_SHORT, 4};
+    case GBuffer::NormalEncoding::Octahedral8: return {GL_RG8, GL_RG, GL_UNSIGNED_BYTE, 2};
+    case GBuffer::NormalEncoding::Float16: return {GL_RGBA16F, GL_RGBA, GL_HALF_FLOAT, 8};
+    default: return {GL_RG16, GL_RG, GL_UNSIGNED_SHORT, 4};
+    }
+}
+
+TextureFormat textureFormat(GBuffer::DepthFormat format)
+{
+    if(format == GBuffer::DepthFormat::Depth32FStencil8)
+        return {GL_DEPTH32F_STENCIL8, GL_DEPTH_STENCIL, GL_FLOAT_32_UNSIGNED_INT_24_8_REV, 8};
+    return {GL_DEPTH24_STENCIL8, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, 4};
+}
+
+std::uint32_t createTexture(int width, int height, const TextureFormat& format)
+{
+    std::uint32_t texture = 0;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GLint(format.internalFormat), width, height, 0, format.format, format.type, nullptr);
+    // Read one texel per pixel
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    return texture;
+}
+
+}
+
+GBuffer::GBuffer(int width, int height) : GBuffer(width, height, Settings{}) {}
+
+GBuffer::GBuffer(int width, int height, const Settings& settings) :
+    _settings(settings), _width(std::max(width, 1)), _height(std::max(height, 1))
+{
+    allocate();
+}
+
+GBuffer::~GBuffer() { release(); }
+
+void GBuffer::resize(int width, int height)
+{
+    width = std::max(width, 1);
+    height = std::max(height, 1);
+    if(width == _width && height == _height)
+        return;
+
+    _width = width;
+    _height = height;
+    release();
+    allocate();
+}
+
+void GBuffer::allocate()
+{
+    _albedoTexture = createTexture(_width, _height, textureFormat(_settings.albedoFormat));
+    _normalTexture = createTexture(_width, _height, textureFormat(_settings.normalEncoding));
+    _lightTexture = createTexture(_width, _height, textureFormat(_settings.lightFormat));
+    _depthStencilTexture = createTexture(_width, _height, textureFormat(_settings.depthFormat));
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    GLint previousFramebuffer = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
+    glGenFramebuffers(1, &_framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, _framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, _albedoTexture, 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, _normalTexture, 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT2, GL_TEXTURE_2D, _lightTexture, 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D, _depthStencilTexture, 0);
+    if(glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        std::cout << "GBuffer framebuffer is incomplete" << std::endl;
+    glBindFramebuffer(GL_FRAMEBUFFER, GLuint(previousFramebuffer));
+}
+
+void GBuffer::release()
+{
+    glDeleteFramebuffers(1, &_framebuffer);
+    const std::uint32_t textures[] = {_albedoTexture, _normalTexture, _lightTexture, _depthStencilTexture};
+    glDeleteTextures(4, textures);
+    _framebuffer = 0;
+    _albedoTexture = 0;
+    _normalTexture = 0;
+    _lightTexture = 0;
+    _depthStencilTexture = 0;
+}
+
+void GBuffer::beginGeometryPass() const
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, _framebuffer);
+    glViewport(0, 0, _width, _height);
+    const GLenum drawBuffers[] = {GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1};
+    glDrawBuffers(2, drawBuffers);
+
+    const GLfloat zero[] = {0.f, 0.f, 0.f, 0.f};
+    glClearBufferfv(GL_COLOR, 0, zero);
+    glClearBufferfv(GL_COLOR, 1, zero);
+    glDepthMask(GL_TRUE);
+    glStencilMask(0xFF);
+    glClearStencil(0);
+    glClear(GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+
+    glEnable(GL_STENCIL_TEST);
+    glStencilFunc(GL_ALWAYS, GLint(GeometryStencilBit), GeometryStencilBit);
+    glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
+    glStencilMask(GeometryStencilBit);
+}
+
+void GBuffer::beginLightingPass() const
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, _framebuffer);
+    glViewport(0, 0, _width, _height);
+    glDrawBuffer(GL_COLOR_ATTACHMENT2);
+
+    const GLfloat black[] = {0.f, 0.f, 0.f, 1.f};
+    glClearBufferfv(GL_COLOR, 0, black);
+
+    glDisable(GL_STENCIL_TEST);
+    glStencilMask(0xFF);
+}
+
+void GBuffer::blitLighting(std::uint32_t framebuffer, int width, int height) const
+{
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, _framebuffer);
+    glReadBuffer(GL_COLOR_ATTACHMENT2);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffer);
+    const auto filter = width == _width && height == _height ? GL_NEAREST : GL_LINEAR;
+    glBlitFramebuffer(0, 0, _width, _height, 0, 0, width, height, GL_COLOR_BUFFER_BIT, filter);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glViewport(0, 0, width, height);
+}
+
+void GBuffer::setEncoding(const Shader& shader) const
+{
+    shader.setBool("gbufferOctahedral", _settings.normalEncoding != NormalEncoding::Float16);
+}
+
+void GBuffer::bind(const Shader& shader, std::uint32_t firstUnit, const Camera& camera) const
+{
+    const std::uint32_t textures[] = {_albedoTexture, _normalTexture, _depthStencilTexture};
+    const char* samplers[] = {"gbufferAlbedoSpecular", "gbufferNormal", "gbufferDepth"};
+    for(std::uint32_t i = 0; i < 3; ++i)
+    {
+        glActiveTexture(GL_TEXTURE0 + firstUnit + i);
+        glBindTexture(GL_TEXTURE_2D, textures[i]);
+        shader.setInt(samplers[i], int(firstUnit + i));
+    }
+    glActiveTexture(GL_TEXTURE0);
+
+    setEncoding(shader);
+    const auto inverseViewProjection = glm::inverse(camera.projectionMatrix() * camera.viewMatrix());
+    shader.setMat4("gbufferInverseViewProjection", glm::value_ptr(inverseViewProjection));
+    // Depth in [0, 1] to clip depth, and size in pixels
+    const bool zeroToOne = zeroToOneClipDepth();
+    shader.setVec4("gbufferDepthToNdc", zeroToOne ? 1.f : 2.f, zeroToOne ? 0.f : -1.f, float(_width), float(_height));
+}
+
+std::uint32_t GBuffer::geometryBytesPerPixel() const
+{
+    return textureFormat(_settings.albedoFormat).bytes + textureFormat(_settings.normalEncoding).bytes +
+           textureFormat(_settings.depthFormat).bytes;
+}
+
+std::uint32_t GBuffer::lightInternalFormat() const { return textureFormat(_settings.lightFormat).internalFormat; }
+
+}
@@ -0,0 +1,111 @@
+#ifndef __LEARNOPENGL_GBUFFER_HPP__
+#define __LEARNOPENGL_GBUFFER_HPP__
+
+#include <cstdint>
+
+namespace learnopengl {
+
+class Camera;
+class Shader;
+
+// Geometry buffer of deferred shading: albedo and specular intensity, encoded normal, depth and stencil, plus the light
+// accumulation target the lighting passes add into. Positions are reconstructed from depth instead of being stored.
+// Geometry fragment shaders and lighting shaders include resources/shaders/gbuffer.glsl.
+class GBuffer
+{
+public:
+    enum class NormalEncoding
+    {
+        // Octahedral in 2 x 16 bits (RG16)
+        Octahedral16,
+        // Octahedral in 2 x 8 bits (RG8): half the bandwidth, banding shows in sharp highlights
+        Octahedral8,
+        // xyz in half floats (RGBA16F), as reference
+        Float16,
+    };
+
+    enum class ColorFormat
+    {
+        RGBA8,
+        SRGB8Alpha8,
+        RGBA16F,
+        // No alpha, for light accumulation only
+        R11G11B10F,
+    };
+
+    enum class DepthFormat
+    {
+        Depth24Stencil8,
+        // Matches reverse-Z depth
+        Depth32FStencil8,
+    };
+
+    struct Settings
+    {
+        NormalEncoding normalEncoding = NormalEncoding::Octahedral16;
+        // Albedo in rgb, specular intensity in alpha
+        ColorFormat albedoFormat = ColorFormat::RGBA8;
+        ColorFormat lightFormat = ColorFormat::RGBA16F;
+        DepthFormat depthFormat = DepthFormat::Depth24Stencil8;
+    };
+
+    // Stencil bit written under geometry by the geometry pass, the other bits are free for the lighting passes
+    static constexpr std::uint32_t GeometryStencilBit = 0x80;
+
+public:
+    GBuffer(int width, int height, const Settings& settings);
+    GBuffer(int width, int height);
+    ~GBuffer();
+
+    GBuffer(const GBuffer&) = delete;
+    GBuffer& operator=(const GBuffer&) = delete;
+
+    // Reallocate attachments when the size changed
+    void resize(int width, int height);
+
+    // Bind the framebuffer with albedo and normal draw buffers, clear them, depth and stencil, and write GeometryStencilBit
+    // under drawn fragments. The depth state (applyDepthState) is the one of the caller.
+    void beginGeometryPass() const;
+    // Bind the framebuffer with the light draw buffer and clear it. Depth and stencil of the geometry pass stay bound.
+    void beginLightingPass() const;
+    // Copy the light target to framebuffer (e.g. defaultFramebuffer()), scaled to its size
+    void blitLighting(std::uint32_t framebuffer, int width, int height) const;
+
+    // Set the normal encoding uniform of a geometry pass shader, which must be in use
+    void setEncoding(const Shader& shader) const;
+    // Bind albedo, normal and depth on texture units firstUnit to firstUnit + 2 and set the uniforms of the include,
+    // camera gives the matrices reconstructing positions. The shader must be in use.
+    void bind(const Shader& shader, std::uint32_t firstUnit, const Camera& camera) const;
+
+    [[nodiscard]] int width() const { return _width; }
+    [[nodiscard]] int height() const { return _height; }
+    [[nodiscard]] const Settings& settings() const { return _settings; }
+    // Bytes written per pixel by the geometry pass, light target excluded
+    [[nodiscard]] std::uint32_t geometryBytesPerPixel() const;
+
+    [[nodiscard]] std::uint32_t framebuffer() const { return _framebuffer; }
+    [[nodiscard]] std::uint32_t albedoTexture() const { return _albedoTexture; }
+    [[nodiscard]] std::uint32_t normalTexture() const { return _normalTexture; }
+    [[nodiscard]] std::uint32_t lightTexture() const { return _lightTexture; }
+    [[nodiscard]] std::uint32_t depthStencilTexture() const { return _depthStencilTexture; }
+    // OpenGL internal format of the light target, e.g. to bind it as an image
+    [[nodiscard]] std::uint32_t lightInternalFormat() const;
+
+private:
+    void allocate();
+    void release();
+
+    Settings _settings;
+    int _width = 0;
+    int _height = 0;
+
+    std::uint32_t _framebuffer = 0;
+    std::uint32_t _albedoTexture = 0;
+    std::uint32_t _normalTexture = 0;
+    std::uint32_t _lightTexture = 0;
+    std::uint32_t _depthStencilTexture = 0;
+};
+
+}
+
+#endif
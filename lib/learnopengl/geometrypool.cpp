@@ -0,0 +1,304 @@
+#include <learnopengl/geometrypool.hpp>
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <cstddef>
+
+namespace learnopengl {
+
+GeometryPool::GeometryPool(std::size_t verticesPerBlock, std::size_t indicesPerBlock) :
+    _verticesPerBlock(verticesPerBlock), _indicesPerBlock(indicesPerBlock)
+{
+}
+
+GeometryPool::~GeometryPool()
+{
+    for(auto& block: _blocks)
+    {
+        glDeleteVertexArrays(1, &block.vao);
+        glDeleteBuffers(1, &block.ebo);
+        glDeleteBuffers(1, &block.vbo);
+    }
+}
+
+std::uint32_t GeometryPool::createBlock(std::size_t vertexCapacity, std::size_t indexCapacity)
+{
+    Block block;
+    block.vertices.reset(vertexCapacity);
+    block.indices.reset(indexCapacity);
+
+    glGenVertexArrays(1, &block.vao);
+    glGenBuffers(1, &block.vbo);
+    glGenBuffers(1, &block.ebo);
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, block.vbo);
+    glBufferData(GL_COPY_WRITE_BUFFER, GLsizeiptr(vertexCapacity * sizeof(Mesh::Vertex)), nullptr, GL_STATIC_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, block.ebo);
+    glBufferData(GL_COPY_WRITE_BUFFER, GLsizeiptr(indexCapacity * sizeof(std::uint32_t)), nullptr, GL_STATIC_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    _blocks.push_back(std::move(block));
+    const auto blockIndex = std::uint32_t(_blocks.size() - 1);
+    setupVertexArray(blockIndex);
+    return blockIndex;
+}
+
+void GeometryPool::setupVertexArray(std::uint32_t blockIndex) const
+{
+    glBindVertexArray(_blocks[blockIndex].vao);
+    setupVertexAttributes(blockIndex);
+    glBindVertexArray(0);
+}
+
+void GeometryPool::setupVertexAttributes(std::uint32_t blockIndex) const
+{
+    using Vertex = Mesh::Vertex;
+
+    const auto& block = _blocks[blockIndex];
+    glBindBuffer(GL_ARRAY_BUFFER, block.vbo);
+
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, position)));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, normal)));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, texCoords)));
+    glEnableVertexAttribArray(2);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, block.ebo);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void GeometryPool::setBlockSize(std::size_t verticesPerBlock, std::size_t indicesPerBlock)
+{
+    _verticesPerBlock = verticesPerBlock;
+    _indicesPerBlock = indicesPerBlock;
+}
+
+GeometryPool::Handle GeometryPool::allocate(const std::vector<Mesh::Vertex>& vertices, const std::vector<std::uint32_t>& indices)
+{
+    Allocation allocation;
+    allocation.vertexCount = std::uint32_t(vertices.size());
+    allocation.indexCount = std::uint32_t(indices.size());
+    allocation.live = true;
+
+    // First block with room for both vertices and indices
+    bool allocated = false;
+    for(std::uint32_t i = 0; i < _blocks.size() && !allocated; ++i)
+    {
+        auto& block = _blocks[i];
+        const auto baseVertex = block.vertices.allocate(vertices.size());
+        if(!baseVertex)
+            continue;
+        const auto firstIndex = block.indices.allocate(indices.size());
+        if(!firstIndex)
+        {
+            block.vertices.free(*baseVertex, vertices.size());
+            continue;
+        }
+
+        allocation.block = i;
+        allocation.baseVertex = std::uint32_t(*baseVertex);
+        allocation.firstIndex = std::uint32_t(*firstIndex);
+        allocated = true;
+    }
+
+    if(!allocated)
+    {
+        allocation.block = createBlock(std::max(_verticesPerBlock, vertices.size()), std::max(_indicesPerBlock, indices.size()));
+        auto& block = _blocks[allocation.block];
+        allocation.baseVertex = std::uint32_t(block.vertices.allocate(vertices.size()).value_or(0));
+        allocation.firstIndex = std::uint32_t(block.indices.allocate(indices.size()).value_or(0));
+    }
+
+    const auto& block = _blocks[allocation.block];
+
+    // Indices are relative to the mesh, baseVertex is applied by glDrawElementsBaseVertex
+    glBindBuffer(GL_ARRAY_BUFFER, block.vbo);
+    glBufferSubData(GL_ARRAY_BUFFER,
+        GLintptr(allocation.baseVertex * sizeof(Mesh::Vertex)),
+        GLsizeiptr(vertices.size() * sizeof(Mesh::Vertex)),
+        vertices.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    // Element array binding is part of the vertex array state, use copy write target to not alter it
+    glBindBuffer(GL_COPY_WRITE_BUFFER, block.ebo);
+    glBufferSubData(GL_COPY_WRITE_BUFFER,
+        GLintptr(allocation.firstIndex * sizeof(std::uint32_t)),
+        GLsizeiptr(indices.size() * sizeof(std::uint32_t)),
+        indices.data());
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    Handle handle;
+    if(!_freeHandles.empty())
+    {
+        handle = _freeHandles.back();
+        _freeHandles.pop_back();
+        _allocations[handle] = allocation;
+    }
+    else
+    {
+        handle = Handle(_allocations.size());
+        _allocations.push_back(allocation);
+    }
+    return handle;
+}
+
+void GeometryPool::free(Handle handle)
+{
+    if(handle >= _allocations.size() || !_allocations[handle].live)
+        return;
+
+    auto& allocation = _allocations[handle];
+    auto& block = _blocks[allocation.block];
+    block.vertices.free(allocation.baseVertex, allocation.vertexCount);
+    block.indices.free(allocation.firstIndex, allocation.indexCount);
+    allocation.live = false;
+    _freeHandles.push_back(handle);
+}
+
+void GeometryPool::beginBatch()
+{
+    _batching = true;
+    _boundVertexArray = 0;
+}
+
+void GeometryPool::endBatch()
+{
+    _batching = false;
+    _boundVertexArray = 0;
+    glBindVertexArray(0);
+}
+
+void GeometryPool::bind(Handle handle)
+{
+    const auto vao = _blocks[_allocations[handle].block].vao;
+    if(_batching && _boundVertexArray == vao)
+        return;
+
+    glBindVertexArray(vao);
+    _boundVertexArray = vao;
+    ++_vertexArrayBinds;
+}
+
+void GeometryPool::draw(Handle handle)
+{
+    const auto& allocation = _allocations[handle];
+    bind(handle);
+    glDrawElementsBaseVertex(GL_TRIANGLES,
+        GLsizei(allocation.indexCount),
+        GL_UNSIGNED_INT,
+        reinterpret_cast<void*>(std::size_t(allocation.firstIndex) * sizeof(std::uint32_t)),
+        GLint(allocation.baseVertex));
+    ++_drawCalls;
+
+    if(!_batching)
+    {
+        glBindVertexArray(0);
+        _boundVertexArray = 0;
+    }
+}
+
+void GeometryPool::defragment()
+{
+    for(std::uint32_t blockIndex = 0; blockIndex < _blocks.size(); ++blockIndex)
+    {
+        auto& block = _blocks[blockIndex];
+        if(block.vertices.fragmentation() == 0.f && block.indices.fragmentation() == 0.f)
+            continue;
+
+        // Live allocations of this block, in buffer order
+        std::vector<Handle> handles;
+        for(Handle handle = 0; handle < _allocations.size(); ++handle)
+        {
+            if(_allocations[handle].live && _allocations[handle].block == blockIndex)
+                handles.push_back(handle);
+        }
+        std::sort(handles.begin(),
+            handles.end(),
+            [&](Handle a, Handle b) { return _allocations[a].baseVertex < _allocations[b].baseVertex; });
+
+        // Source and destination ranges can overlap inside one buffer, so copy everything into new buffers.
+        std::uint32_t vbo = 0;
+        std::uint32_t ebo = 0;
+        glGenBuffers(1, &vbo);
+        glGenBuffers(1, &ebo);
+
+        glBindBuffer(GL_COPY_WRITE_BUFFER, vbo);
+        glBufferData(GL_COPY_WRITE_BUFFER, GLsizeiptr(block.vertices.capacity() * sizeof(Mesh::Vertex)), nullptr, GL_STATIC_DRAW);
+        glBindBuffer(GL_COPY_READ_BUFFER, block.vbo);
+        std::size_t vertexOffset = 0;
+        for(const auto handle: handles)
+        {
+            auto& allocation = _allocations[handle];
+            glCopyBufferSubData(GL_COPY_READ_BUFFER,
+                GL_COPY_WRITE_BUFFER,
+                GLintptr(allocation.baseVertex * sizeof(Mesh::Vertex)),
+                GLintptr(vertexOffset * sizeof(Mesh::Vertex)),
+                GLsizeiptr(allocation.vertexCount * sizeof(Mesh::Vertex)));
+            allocation.baseVertex = std::uint32_t(vertexOffset);
+            vertexOffset += allocation.vertexCount;
+        }
+
+        glBindBuffer(GL_COPY_WRITE_BUFFER, ebo);
+        glBufferData(GL_COPY_WRITE_BUFFER, GLsizeiptr(block.indices.capacity() * sizeof(std::uint32_t)), nullptr, GL_STATIC_DRAW);
+        glBindBuffer(GL_COPY_READ_BUFFER, block.ebo);
+        std::size_t indexOffset = 0;
+        for(const auto handle: handles)
+        {
+            auto& allocation = _allocations[handle];
+            glCopyBufferSubData(GL_COPY_READ_BUFFER,
+                GL_COPY_WRITE_BUFFER,
+                GLintptr(allocation.firstIndex * sizeof(std::uint32_t)),
+                GLintptr(indexOffset * sizeof(std::uint32_t)),
+                GLsizeiptr(allocation.indexCount * sizeof(std::uint32_t)));
+            allocation.firstIndex = std::uint32_t(indexOffset);
+            indexOffset += allocation.indexCount;
+        }
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+        glDeleteBuffers(1, &block.vbo);
+        glDeleteBuffers(1, &block.ebo);
+        block.vbo = vbo;
+        block.ebo = ebo;
+        setupVertexArray(blockIndex);
+
+        block.vertices.reset(block.vertices.capacity(), vertexOffset);
+        block.indices.reset(block.indices.capacity(), indexOffset);
+        ++_generation;
+    }
+}
+
+GeometryPool::Stats GeometryPool::stats() const
+{
+    Stats stats;
+    std::size_t vertexFree = 0, vertexLargestFree = 0;
+    std::size_t indexFree = 0, indexLargestFree = 0;
+    for(const auto& block: _blocks)
+    {
+        // One vertex buffer and one index buffer per block
+        stats.bufferCount += 2;
+        stats.vertexCapacity += block.vertices.capacity();
+        stats.vertexUsed += block.vertices.used();
+        stats.indexCapacity += block.indices.capacity();
+        stats.indexUsed += block.indices.used();
+        vertexFree += block.vertices.capacity() - block.vertices.used();
+        indexFree += block.indices.capacity() - block.indices.used();
+        vertexLargestFree = std::max(vertexLargestFree, block.vertices.largestFreeRange());
+        indexLargestFree = std::max(indexLargestFree, block.indices.largestFreeRange());
+    }
+    stats.vertexFragmentation = vertexFree ? 1.f - float(vertexLargestFree) / float(vertexFree) : 0.f;
+    stats.indexFragmentation = indexFree ? 1.f - float(indexLargestFree) / float(indexFree) : 0.f;
+    stats.vertexArrayBinds = _vertexArrayBinds;
+    stats.drawCalls = _drawCalls;
+    return stats;
+}
+
+void GeometryPool::resetFrameStats()
+{
+    _vertexArrayBinds = 0;
+    _drawCalls = 0;
+}
+
+}
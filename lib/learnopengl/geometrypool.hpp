@@ -0,0 +1,117 @@
+#ifndef __LEARNOPENGL_GEOMETRY_POOL_HPP__
+#define __LEARNOPENGL_GEOMETRY_POOL_HPP__
+
+#include <learnopengl/mesh.hpp>
+#include <learnopengl/freelistallocator.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace learnopengl {
+
+// Suballocate Mesh::Vertex and index data of many meshes from a few large buffers.
+// Each block (VBO + EBO) has a single VAO, so consecutive meshes of the same block are drawn with
+// glDrawElementsBaseVertex without switching vertex array.
+// The pool must outlive the meshes allocated from it.
+class GeometryPool
+{
+public:
+    using Handle = std::uint32_t;
+    static constexpr Handle InvalidHandle = ~Handle(0);
+
+    struct Allocation
+    {
+        std::uint32_t block = 0;
+        std::uint32_t baseVertex = 0;
+        std::uint32_t vertexCount = 0;
+        std::uint32_t firstIndex = 0;
+        std::uint32_t indexCount = 0;
+        bool live = false;
+    };
+
+    struct Stats
+    {
+        std::size_t bufferCount = 0;
+        std::size_t vertexCapacity = 0;
+        std::size_t vertexUsed = 0;
+        std::size_t indexCapacity = 0;
+        std::size_t indexUsed = 0;
+        float vertexFragmentation = 0.f;
+        float indexFragmentation = 0.f;
+        // Since last resetFrameStats
+        std::size_t vertexArrayBinds = 0;
+        std::size_t drawCalls = 0;
+    };
+
+public:
+    GeometryPool(std::size_t verticesPerBlock = 1 << 20, std::size_t indicesPerBlock = 3 << 20);
+    ~GeometryPool();
+
+    GeometryPool(const GeometryPool&) = delete;
+    GeometryPool& operator=(const GeometryPool&) = delete;
+
+    // Capacity of the blocks created from now on, a mesh larger than that gets a block of its own size
+    void setBlockSize(std::size_t verticesPerBlock, std::size_t indicesPerBlock);
+
+    Handle allocate(const std::vector<Mesh::Vertex>& vertices, const std::vector<std::uint32_t>& indices);
+    void free(Handle handle);
+
+    [[nodiscard]] const Allocation& allocation(Handle handle) const { return _allocations[handle]; }
+
+    // Between beginBatch and endBatch, the vertex array stays bound between draws and is only switched when the block change.
+    // Outside of a batch, draw bind and unbind the vertex array.
+    void beginBatch();
+    void endBatch();
+    void draw(Handle handle);
+
+    // Bind the vertex array of an allocation, no-op when already bound in the current batch
+    void bind(Handle handle);
+    [[nodiscard]] std::uint32_t vertexArray(std::uint32_t block) const { return _blocks[block].vao; }
+    [[nodiscard]] std::uint32_t vertexBuffer(std::uint32_t block) const { return _blocks[block].vbo; }
+    [[nodiscard]] std::uint32_t indexBuffer(std::uint32_t block) const { return _blocks[block].ebo; }
+    [[nodiscard]] std::size_t blockCount() const { return _blocks.size(); }
+
+    // Configure Mesh::Vertex attributes (location 0 to 2) and element buffer of a block on the currently bound vertex array.
+    // Allow other vertex arrays (ex: with extra per instance attributes) to source a block.
+    void setupVertexAttributes(std::uint32_t block) const;
+
+    // Compact live allocations at the start of their block. Handles stay valid, offsets and buffers change.
+    void defragment();
+    // Incremented each time block buffers are replaced, vertex arrays created with setupVertexAttributes must be rebuilt
+    [[nodiscard]] std::uint32_t generation() const { return _generation; }
+
+    [[nodiscard]] Stats stats() const;
+    void resetFrameStats();
+
+private:
+    struct Block
+    {
+        std::uint32_t vao = 0;
+        std::uint32_t vbo = 0;
+        std::uint32_t ebo = 0;
+        FreeListAllocator vertices;
+        FreeListAllocator indices;
+    };
+
+    std::uint32_t createBlock(std::size_t vertexCapacity, std::size_t indexCapacity);
+    void setupVertexArray(std::uint32_t blockIndex) const;
+
+    std::size_t _verticesPerBlock;
+    std::size_t _indicesPerBlock;
+
+    std::vector<Block> _blocks;
+    std::vector<Allocation> _allocations;
+    std::vector<Handle> _freeHandles;
+
+    bool _batching = false;
+    std::uint32_t _boundVertexArray = 0;
+
+    std::uint32_t _generation = 0;
+
+    std::size_t _vertexArrayBinds = 0;
+    std::size_t _drawCalls = 0;
+};
+
+}
+
+#endif
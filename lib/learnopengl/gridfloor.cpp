@@ -1,6 +1,7 @@
 #include <learnopengl/gridfloor.hpp>
 #include <learnopengl/shader.hpp>
 #include <learnopengl/camera.hpp>
+#include <learnopengl/depthstate.hpp>
 
 #include <glm/gtc/type_ptr.hpp>
 #include <glad/glad.h>
@@ -29,6 +30,10 @@ void GridFloor::draw(const Camera& camera) const
     _shader->setMat4("inverseViewProjectionMatrix", glm::value_ptr(inverseViewProjection));
     _shader->setFloat("nearPlane", camera.near());
     _shader->setFloat("farPlane", camera.far());
+    // Points of the view ray in clip depth: reverse-Z has no far plane, the near plane is at 1
+    _shader->setFloat("nearPointDepth", camera.reverseZ() ? 1.f : 0.f);
+    _shader->setFloat("farPointDepth", camera.reverseZ() ? 0.5f : 1.f);
+    _shader->setBool("zeroToOneDepth", zeroToOneClipDepth());
 
     _shader->setVec4("xAxisColor", _xAxisColor.r, _xAxisColor.g, _xAxisColor.b, _drawXAxis ? 1.f : 0.f);
     _shader->setVec4("yAxisColor", _yAxisColor.r, _yAxisColor.g, _yAxisColor.b, _drawYAxis ? 1.f : 0.f);
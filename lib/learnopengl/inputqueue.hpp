@@ -0,0 +1,93 @@
+#ifndef __LEARNOPENGL_INPUT_QUEUE_HPP__
+#define __LEARNOPENGL_INPUT_QUEUE_HPP__
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace learnopengl {
+
+// Bounded lock-free queue for exactly one producer thread and one consumer thread.
+// Each side owns one index and only reads the other one, a copy of which is kept to avoid touching its cache line on every call.
+template<typename T, std::size_t Capacity>
+class SpscQueue
+{
+    static_assert(Capacity && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    // Producer side, false when the queue is full
+    bool push(const T& value)
+    {
+        const auto tail = _tail.load(std::memory_order_relaxed);
+        if(tail - _cachedHead == Capacity)
+        {
+            _cachedHead = _head.load(std::memory_order_acquire);
+            if(tail - _cachedHead == Capacity)
+                return false;
+        }
+        _items[tail & (Capacity - 1)] = value;
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side, empty when the queue is empty
+    std::optional<T> pop()
+    {
+        const auto head = _head.load(std::memory_order_relaxed);
+        if(head == _cachedTail)
+        {
+            _cachedTail = _tail.load(std::memory_order_acquire);
+            if(head == _cachedTail)
+                return std::nullopt;
+        }
+        T value = _items[head & (Capacity - 1)];
+        _head.store(head + 1, std::memory_order_release);
+        return value;
+    }
+
+    // Approximate when called while the other side is running
+    [[nodiscard]] std::size_t size() const
+    {
+        return std::size_t(_tail.load(std::memory_order_acquire) - _head.load(std::memory_order_acquire));
+    }
+    [[nodiscard]] static constexpr std::size_t capacity() { return Capacity; }
+
+private:
+    // Consumer
+    alignas(64) std::atomic<std::uint64_t> _head = 0;
+    std::uint64_t _cachedTail = 0;
+    // Producer
+    alignas(64) std::atomic<std::uint64_t> _tail = 0;
+    std::uint64_t _cachedHead = 0;
+    alignas(64) std::array<T, Capacity> _items = {};
+};
+
+// Input event with the time it was received, in GLFW values (GLFW_PRESS, GLFW_MOUSE_BUTTON_RIGHT, GLFW_MOD_SHIFT, ...)
+struct InputEvent
+{
+    enum class Type
+    {
+        MouseButton,
+        MouseMove,
+        Scroll
+    };
+
+    Type type = Type::MouseMove;
+    int button = 0;
+    int action = 0;
+    int mods = 0;
+    // Cursor position, or scroll offset in y
+    float x = 0.f;
+    float y = 0.f;
+    std::chrono::steady_clock::time_point time;
+};
+
+// Events received between two frames, more than this in one frame are dropped
+using InputQueue = SpscQueue<InputEvent, 256>;
+
+}
+
+#endif
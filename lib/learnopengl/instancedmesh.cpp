@@ -0,0 +1,291 @@
+#include <learnopengl/instancedmesh.hpp>
+#include <learnopengl/mesh.hpp>
+#include <learnopengl/shader.hpp>
+#include <learnopengl/geometrypool.hpp>
+#include <learnopengl/threadpool.hpp>
+
+#include <glad/glad.h>
+
+#include <glm/gtc/matrix_inverse.hpp>
+
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define LEARNOPENGL_INSTANCED_MESH_SSE
+#    include <emmintrin.h>
+#endif
+
+namespace learnopengl {
+
+void computeNormalMatricesScalar(const glm::mat4* models, glm::mat3* normalMatrices, std::size_t count)
+{
+    for(std::size_t i = 0; i < count; ++i) normalMatrices[i] = glm::inverseTranspose(glm::mat3(models[i]));
+}
+
+#ifdef LEARNOPENGL_INSTANCED_MESH_SSE
+static inline __m128 cross(__m128 a, __m128 b)
+{
+    // a.yzx * b.zxy - a.zxy * b.yzx, w stays 0
+    const auto aYZX = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+    const auto bYZX = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+    const auto c = _mm_sub_ps(_mm_mul_ps(a, bYZX), _mm_mul_ps(aYZX, b));
+    return _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+}
+#endif
+
+void computeNormalMatrices(const glm::mat4* models, glm::mat3* normalMatrices, std::size_t count)
+{
+#ifdef LEARNOPENGL_INSTANCED_MESH_SSE
+    // With a, b, c the columns of the upper 3x3, the inverse transpose columns are (b x c, c x a, a x b) / det
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        const float* model = &models[i][0][0];
+        const auto a = _mm_loadu_ps(model);
+        const auto b = _mm_loadu_ps(model + 4);
+        const auto c = _mm_loadu_ps(model + 8);
+
+        const auto bc = cross(b, c);
+        const auto ca = cross(c, a);
+        const auto ab = cross(a, b);
+
+        // det = a . (b x c), w of the cross product is 0 so the 4 lanes can be summed
+        auto det = _mm_mul_ps(a, bc);
+        det = _mm_add_ps(det, _mm_shuffle_ps(det, det, _MM_SHUFFLE(2, 3, 0, 1)));
+        det = _mm_add_ps(det, _mm_shuffle_ps(det, det, _MM_SHUFFLE(1, 0, 3, 2)));
+        const auto inverseDet = _mm_div_ps(_mm_set1_ps(1.f), det);
+
+        const auto column0 = _mm_mul_ps(bc, inverseDet);
+        const auto column1 = _mm_mul_ps(ca, inverseDet);
+        const auto column2 = _mm_mul_ps(ab, inverseDet);
+
+        // mat3 is 9 packed floats: each 4 floats store is overwritten by the next column
+        float* normalMatrix = &normalMatrices[i][0][0];
+        _mm_storeu_ps(normalMatrix, column0);
+        _mm_storeu_ps(normalMatrix + 3, column1);
+        _mm_storel_pi(reinterpret_cast<__m64*>(normalMatrix + 6), column2);
+        _mm_store_ss(normalMatrix + 8, _mm_shuffle_ps(column2, column2, _MM_SHUFFLE(2, 2, 2, 2)));
+    }
+#else
+    computeNormalMatricesScalar(models, normalMatrices, count);
+#endif
+}
+
+InstancedMesh::InstancedMesh(const Mesh& mesh) : InstancedMesh(mesh, Settings{}) {}
+
+InstancedMesh::InstancedMesh(const Mesh& mesh, const Settings& settings) :
+    _mesh(mesh),
+    _persistent(settings.persistentMapping && persistentMappingSupported())
+{
+    glGenVertexArrays(1, &_vao);
+    glGenBuffers(1, &_instanceBuffer);
+}
+
+InstancedMesh::~InstancedMesh()
+{
+    for(auto* fence: _regionFences) glDeleteSync(fence);
+    // Deleting a mapped buffer unmaps it
+    glDeleteBuffers(1, &_instanceBuffer);
+    glDeleteVertexArrays(1, &_depthVao);
+    glDeleteVertexArrays(1, &_vao);
+}
+
+bool InstancedMesh::persistentMappingSupported() { return GLAD_GL_VERSION_4_4; }
+
+void InstancedMesh::clear() { _models.clear(); }
+
+void InstancedMesh::reserve(std::size_t instanceCount) { _models.reserve(instanceCount); }
+
+void InstancedMesh::add(const glm::mat4& model) { _models.push_back(model); }
+
+void InstancedMesh::resize(std::size_t instanceCount) { _models.resize(instanceCount); }
+
+void InstancedMesh::upload()
+{
+    const auto count = _models.size();
+    reserveBuffer(count);
+
+    // Chunks of instances over the pool: normal matrices of 1M instances take milliseconds on one thread
+    constexpr std::size_t GrainSize = 16384;
+    if(!_persistent)
+    {
+        _normalMatrices.resize(count);
+        ThreadPool::global().parallelFor(count,
+            GrainSize,
+            [&](std::size_t begin, std::size_t end) { computeNormalMatrices(&_models[begin], &_normalMatrices[begin], end - begin); });
+
+        glBindBuffer(GL_ARRAY_BUFFER, _instanceBuffer);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, GLsizeiptr(count * sizeof(glm::mat4)), _models.data());
+        glBufferSubData(
+            GL_ARRAY_BUFFER, GLintptr(_capacity * sizeof(glm::mat4)), GLsizeiptr(count * sizeof(glm::mat3)), _normalMatrices.data());
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        _uploadedCount = count;
+        return;
+    }
+
+    // The draws since the last upload read its region
+    if(_uploadedCount)
+    {
+        glDeleteSync(_regionFences[_region]);
+        _regionFences[_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+    _region = (_region + 1) % PersistentRegionCount;
+    waitRegion(_region);
+
+    // Coherent mapping: writes are visible to the draws issued after them, the normal matrices are computed in place
+    auto* bytes = static_cast<std::uint8_t*>(_mapped);
+    const auto first = _region * _capacity;
+    auto* models = reinterpret_cast<glm::mat4*>(bytes) + first;
+    auto* normalMatrices = reinterpret_cast<glm::mat3*>(bytes + PersistentRegionCount * _capacity * sizeof(glm::mat4)) + first;
+    ThreadPool::global().parallelFor(count,
+        GrainSize,
+        [&](std::size_t begin, std::size_t end)
+        {
+            std::copy(_models.begin() + std::ptrdiff_t(begin), _models.begin() + std::ptrdiff_t(end), models + begin);
+            computeNormalMatrices(&_models[begin], normalMatrices + begin, end - begin);
+        });
+
+    _uploadedCount = count;
+}
+
+void InstancedMesh::reserveBuffer(std::size_t count)
+{
+    if(count <= _capacity)
+        return;
+
+    // Attribute offsets depend on the capacity, the vertex array is configured again
+    _capacity = std::max(count, _capacity * 2);
+    if(!_persistent)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, _instanceBuffer);
+        glBufferData(GL_ARRAY_BUFFER, GLsizeiptr(_capacity * (sizeof(glm::mat4) + sizeof(glm::mat3))), nullptr, GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        setupVertexArray();
+        return;
+    }
+
+    // Immutable storage cannot be resized: a new buffer replaces it, the driver keeps the old one until pending draws are done
+    for(auto*& fence: _regionFences)
+    {
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+    glDeleteBuffers(1, &_instanceBuffer);
+    glGenBuffers(1, &_instanceBuffer);
+
+    glBindBuffer(GL_ARRAY_BUFFER, _instanceBuffer);
+    const auto size = GLsizeiptr(PersistentRegionCount * _capacity * (sizeof(glm::mat4) + sizeof(glm::mat3)));
+    constexpr GLbitfield Flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glBufferStorage(GL_ARRAY_BUFFER, size, nullptr, Flags);
+    _mapped = glMapBufferRange(GL_ARRAY_BUFFER, 0, size, Flags);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    setupVertexArray();
+
+    // Next upload fills region 0 without fence
+    _uploadedCount = 0;
+    _region = PersistentRegionCount - 1;
+}
+
+void InstancedMesh::waitRegion(std::uint32_t region)
+{
+    auto& fence = _regionFences[region];
+    if(!fence)
+        return;
+
+    // Flush on the first wait so that the fence is submitted, then wait by slices of 1 ms
+    GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+    while(true)
+    {
+        const auto status = glClientWaitSync(fence, flags, 1'000'000);
+        if(status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED || status == GL_WAIT_FAILED)
+            break;
+        flags = 0;
+    }
+    glDeleteSync(fence);
+    fence = nullptr;
+}
+
+void InstancedMesh::setupVertexArray()
+{
+    glBindVertexArray(_vao);
+    _mesh.setupVertexAttributes();
+    setupInstanceAttributes(true);
+
+    if(_depthVao)
+    {
+        glBindVertexArray(_depthVao);
+        _mesh.setupPositionAttributes();
+        setupInstanceAttributes(false);
+    }
+
+    glBindVertexArray(0);
+
+    if(_mesh.geometryPool())
+        _poolGeneration = _mesh.geometryPool()->generation();
+}
+
+void InstancedMesh::setupInstanceAttributes(bool normalMatrices) const
+{
+    glBindBuffer(GL_ARRAY_BUFFER, _instanceBuffer);
+    // One vec4 attribute per mat4 column and one vec3 attribute per mat3 column, advanced once per instance
+    for(std::uint32_t column = 0; column < 4; ++column)
+    {
+        const auto location = ModelLocation + column;
+        glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), reinterpret_cast<void*>(column * sizeof(glm::vec4)));
+        glVertexAttribDivisor(location, 1);
+        glEnableVertexAttribArray(location);
+    }
+    const auto normalOffset = (_persistent ? PersistentRegionCount : 1) * _capacity * sizeof(glm::mat4);
+    for(std::uint32_t column = 0; normalMatrices && column < 3; ++column)
+    {
+        const auto location = NormalModelLocation + column;
+        glVertexAttribPointer(location,
+            3,
+            GL_FLOAT,
+            GL_FALSE,
+            sizeof(glm::mat3),
+            reinterpret_cast<void*>(normalOffset + column * sizeof(glm::vec3)));
+        glVertexAttribDivisor(location, 1);
+        glEnableVertexAttribArray(location);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void InstancedMesh::draw(const Shader& shader)
+{
+    if(!_uploadedCount)
+        return;
+
+    // Defragmentation replaced the pool buffers sourced by the vertex array
+    if(_mesh.geometryPool() && _mesh.geometryPool()->generation() != _poolGeneration)
+        setupVertexArray();
+
+    shader.use();
+    _mesh.bindTextures(shader);
+
+    glBindVertexArray(_vao);
+    _mesh.drawInstances(_uploadedCount, _persistent ? std::uint32_t(_region * _capacity) : 0);
+    glBindVertexArray(0);
+}
+
+void InstancedMesh::drawDepth(const Shader& shader)
+{
+    if(!_uploadedCount)
+        return;
+
+    if(!_depthVao)
+    {
+        glGenVertexArrays(1, &_depthVao);
+        setupVertexArray();
+    }
+    // Defragmentation replaced the pool buffers sourced by the vertex array
+    if(_mesh.geometryPool() && _mesh.geometryPool()->generation() != _poolGeneration)
+        setupVertexArray();
+
+    shader.use();
+    glBindVertexArray(_depthVao);
+    _mesh.drawInstances(_uploadedCount, _persistent ? std::uint32_t(_region * _capacity) : 0);
+    glBindVertexArray(0);
+}
+
+}
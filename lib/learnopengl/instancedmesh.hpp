@@ -0,0 +1,107 @@
+#ifndef __LEARNOPENGL_INSTANCED_MESH_HPP__
+#define __LEARNOPENGL_INSTANCED_MESH_HPP__
+
+#include <glm/mat3x3.hpp>
+#include <glm/mat4x4.hpp>
+
+#include <cstdint>
+#include <vector>
+
+struct __GLsync;
+
+namespace learnopengl {
+
+class Mesh;
+class Shader;
+
+// Normal matrices (inverse transpose of the upper 3x3) of count model matrices. SSE kernel when available.
+void computeNormalMatrices(const glm::mat4* models, glm::mat3* normalMatrices, std::size_t count);
+// Reference implementation with glm::inverseTranspose
+void computeNormalMatricesScalar(const glm::mat4* models, glm::mat3* normalMatrices, std::size_t count);
+
+// Draw many copies of a Mesh with a single glDrawElementsInstanced.
+// Per instance model matrices (attribute locations 3 to 6) and normal matrices (locations 7 to 9) are stored in an instance buffer,
+// see resources/shaders/instanced.vs. The mesh must outlive the instanced mesh.
+class InstancedMesh
+{
+public:
+    static constexpr std::uint32_t ModelLocation = 3;
+    static constexpr std::uint32_t NormalModelLocation = 7;
+    // Buffer regions of a persistently mapped instance buffer: the CPU writes one while the GPU may still read the others
+    static constexpr std::uint32_t PersistentRegionCount = 3;
+
+    struct Settings
+    {
+        // Write instances in a persistently mapped buffer (OpenGL 4.4) instead of glBufferSubData, for instances changing every frame.
+        // Each upload fills the next region, waiting on the fence of its last draws, and draws select it with a base instance.
+        bool persistentMapping = false;
+    };
+
+public:
+    explicit InstancedMesh(const Mesh& mesh);
+    InstancedMesh(const Mesh& mesh, const Settings& settings);
+    ~InstancedMesh();
+
+    // glBufferStorage and base instance draws
+    [[nodiscard]] static bool persistentMappingSupported();
+
+    InstancedMesh(const InstancedMesh&) = delete;
+    InstancedMesh& operator=(const InstancedMesh&) = delete;
+
+    void clear();
+    void reserve(std::size_t instanceCount);
+    void add(const glm::mat4& model);
+    // Resize the instances, e.g. to write models in parallel
+    void resize(std::size_t instanceCount);
+
+    [[nodiscard]] std::size_t size() const { return _models.size(); }
+    [[nodiscard]] bool empty() const { return _models.empty(); }
+    [[nodiscard]] const std::vector<glm::mat4>& models() const { return _models; }
+    [[nodiscard]] std::vector<glm::mat4>& models() { return _models; }
+    // Persistent mapping is requested and supported
+    [[nodiscard]] bool persistentlyMapped() const { return _persistent; }
+
+    // Compute normal matrices (in parallel over ThreadPool::global()) and upload instances.
+    // Must be called after instances changed and before draw.
+    void upload();
+
+    // Bind mesh textures and draw every instance with shader
+    void draw(const Shader& shader);
+    // Draw every instance with mesh positions only (Mesh::setupPositionAttributes) and model matrices, for depth only shaders.
+    // The vertex array is created on first use.
+    void drawDepth(const Shader& shader);
+
+private:
+    void setupVertexArray();
+    // Per instance attributes of the bound vertex array, normal matrices are skipped by depth only draws
+    void setupInstanceAttributes(bool normalMatrices) const;
+    // Reallocate the instance buffer for at least count instances
+    void reserveBuffer(std::size_t count);
+    // Wait until the GPU is done with a region of the persistent buffer
+    void waitRegion(std::uint32_t region);
+
+    const Mesh& _mesh;
+    bool _persistent = false;
+
+    std::vector<glm::mat4> _models;
+    std::vector<glm::mat3> _normalMatrices;
+
+    std::uint32_t _vao = 0;
+    // Positions and model matrices, see drawDepth
+    std::uint32_t _depthVao = 0;
+    // Model matrices then normal matrices, each range sized for _capacity instances (times PersistentRegionCount when persistent)
+    std::uint32_t _instanceBuffer = 0;
+    std::size_t _capacity = 0;
+    std::size_t _uploadedCount = 0;
+
+    // Persistent mapping: mapped buffer, region of the last upload and fences of the draws reading each region
+    void* _mapped = nullptr;
+    std::uint32_t _region = 0;
+    __GLsync* _regionFences[PersistentRegionCount] = {};
+    // Generation of the mesh geometry pool when the vertex array was configured
+    std::uint32_t _poolGeneration = 0;
+};
+
+}
+
+#endif
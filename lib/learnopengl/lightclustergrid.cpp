@@ -0,0 +1,264 @@
+#include <learnopengl/lightclustergrid.hpp>
+#include <learnopengl/camera.hpp>
+#include <learnopengl/threadpool.hpp>
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define LEARNOPENGL_LIGHT_CLUSTER_SSE
+#    include <emmintrin.h>
+#endif
+
+namespace learnopengl {
+
+namespace {
+
+// Far bound of the last slice, large enough to be infinite but squared distances stay finite
+constexpr float InfiniteDepth = 1e18f;
+
+// Distance from value to the [min, max] range, 0 inside
+float outside(float value, float min, float max) { return std::max({min - value, value - max, 0.f}); }
+
+}
+
+LightClusterGrid::LightClusterGrid() : LightClusterGrid(Settings{}) {}
+
+LightClusterGrid::LightClusterGrid(const Settings& settings) { setSettings(settings); }
+
+void LightClusterGrid::setSettings(const Settings& settings)
+{
+    _settings = settings;
+    _settings.tileCountX = std::max(_settings.tileCountX, 1u);
+    _settings.tileCountY = std::max(_settings.tileCountY, 1u);
+    _settings.sliceCount = std::max(_settings.sliceCount, 1u);
+
+    // One more group of 4 so that SIMD loads starting at the last tile stay in the row
+    _tileStrideX = (_settings.tileCountX + 3) / 4 * 4 + 4;
+    _tileMinX.assign(std::size_t(_tileStrideX) * _settings.sliceCount, 0.f);
+    _tileMaxX.assign(_tileMinX.size(), 0.f);
+    _tileMinY.assign(std::size_t(_settings.tileCountY) * _settings.sliceCount, 0.f);
+    _tileMaxY.assign(_tileMinY.size(), 0.f);
+    _sliceNear.assign(_settings.sliceCount, 0.f);
+    _sliceFar.assign(_settings.sliceCount, 0.f);
+
+    _clusterLights.clear();
+    _clusterLights.resize(clusterCount());
+    _clusters.assign(clusterCount(), {});
+    _indices.clear();
+    _stats = {};
+}
+
+std::uint32_t LightClusterGrid::sliceOf(float depth) const
+{
+    const auto slice = std::floor(std::log(std::max(depth, 1e-6f)) * _sliceScale + _sliceBias);
+    return std::uint32_t(std::clamp(slice, 0.f, float(_settings.sliceCount - 1)));
+}
+
+void LightClusterGrid::computeClusterBounds(const Camera& camera)
+{
+    // Symmetric perspective: ndc x = projectionX * x / depth
+    const auto& projection = camera.projectionMatrix();
+    _projectionX = projection[0][0];
+    _projectionY = projection[1][1];
+
+    const float near = camera.near();
+    const float far = std::max(camera.far(), near * 1.001f);
+    _sliceScale = float(_settings.sliceCount) / std::log(far / near);
+    _sliceBias = -std::log(near) * _sliceScale;
+
+    for(std::uint32_t slice = 0; slice < _settings.sliceCount; ++slice)
+    {
+        const auto sliceDepth = [&](std::uint32_t slice) { return near * std::pow(far / near, float(slice) / float(_settings.sliceCount)); };
+        const float d0 = sliceDepth(slice);
+        const float d1 = slice + 1 == _settings.sliceCount ? InfiniteDepth : sliceDepth(slice + 1);
+        _sliceNear[slice] = d0;
+        _sliceFar[slice] = d1;
+
+        // A tile side at ndc n spans n * depth / projection over the slice depths
+        const auto tileBounds = [&](std::uint32_t tile, std::uint32_t tileCount, float projectionScale, float& min, float& max)
+        {
+            const float n0 = -1.f + 2.f * float(tile) / float(tileCount);
+            const float n1 = -1.f + 2.f * float(tile + 1) / float(tileCount);
+            min = std::min(n0 * d0, n0 * d1) / projectionScale;
+            max = std::max(n1 * d0, n1 * d1) / projectionScale;
+        };
+
+        for(std::uint32_t x = 0; x < _settings.tileCountX; ++x)
+        {
+            const auto index = std::size_t(slice) * _tileStrideX + x;
+            tileBounds(x, _settings.tileCountX, _projectionX, _tileMinX[index], _tileMaxX[index]);
+        }
+        for(std::uint32_t y = 0; y < _settings.tileCountY; ++y)
+        {
+            const auto index = std::size_t(slice) * _settings.tileCountY + y;
+            tileBounds(y, _settings.tileCountY, _projectionY, _tileMinY[index], _tileMaxY[index]);
+        }
+    }
+}
+
+void LightClusterGrid::boundLights(const glm::mat4& view, std::span<const glm::vec4> lights, std::size_t begin, std::size_t end)
+{
+    const float near = _sliceNear.front();
+    const auto tileRange = [](float minNdc, float maxNdc, std::uint32_t tileCount, std::uint32_t& tile0, std::uint32_t& tile1)
+    {
+        const auto toTile = [tileCount](float ndc)
+        { return std::uint32_t(std::clamp(std::floor((ndc + 1.f) * 0.5f * float(tileCount)), 0.f, float(tileCount - 1))); };
+        tile0 = toTile(minNdc);
+        tile1 = toTile(maxNdc);
+    };
+
+    for(std::size_t i = begin; i < end; ++i)
+    {
+        auto& bounds = _bounds[i];
+        bounds.visible = false;
+
+        const float radius = std::min(lights[i].w, InfiniteDepth);
+        if(!(radius > 0.f))
+            continue;
+
+        const auto center = glm::vec3(view * glm::vec4(glm::vec3(lights[i]), 1.f));
+        const float depth = -center.z;
+        const float depthMax = depth + radius;
+        if(depthMax < near)
+            continue;
+        const float depthMin = std::max(depth - radius, near);
+
+        // Screen extent of the view space box of the sphere between its depths: extremes are at the nearest or farthest depth
+        const float minX = (center.x - radius) * _projectionX;
+        const float maxX = (center.x + radius) * _projectionX;
+        const float minY = (center.y - radius) * _projectionY;
+        const float maxY = (center.y + radius) * _projectionY;
+        const float minNdcX = std::min(minX / depthMin, minX / depthMax);
+        const float maxNdcX = std::max(maxX / depthMin, maxX / depthMax);
+        const float minNdcY = std::min(minY / depthMin, minY / depthMax);
+        const float maxNdcY = std::max(maxY / depthMin, maxY / depthMax);
+        if(maxNdcX < -1.f || minNdcX > 1.f || maxNdcY < -1.f || minNdcY > 1.f)
+            continue;
+
+        bounds.center = center;
+        bounds.radius = radius;
+        bounds.slice0 = sliceOf(depthMin);
+        bounds.slice1 = sliceOf(depthMax);
+        tileRange(minNdcX, maxNdcX, _settings.tileCountX, bounds.tileX0, bounds.tileX1);
+        tileRange(minNdcY, maxNdcY, _settings.tileCountY, bounds.tileY0, bounds.tileY1);
+        bounds.visible = true;
+    }
+}
+
+void LightClusterGrid::binSlice(std::uint32_t slice)
+{
+    const float sliceNear = _sliceNear[slice];
+    const float sliceFar = _sliceFar[slice];
+    const float* tileMinX = _tileMinX.data() + std::size_t(slice) * _tileStrideX;
+    const float* tileMaxX = _tileMaxX.data() + std::size_t(slice) * _tileStrideX;
+    const float* tileMinY = _tileMinY.data() + std::size_t(slice) * _settings.tileCountY;
+    const float* tileMaxY = _tileMaxY.data() + std::size_t(slice) * _settings.tileCountY;
+
+    const auto firstCluster = clusterIndex(0, 0, slice);
+    for(std::size_t cluster = firstCluster; cluster < firstCluster + std::size_t(_settings.tileCountX) * _settings.tileCountY; ++cluster)
+        _clusterLights[cluster].clear();
+
+    for(std::size_t i = 0; i < _bounds.size(); ++i)
+    {
+        const auto& bounds = _bounds[i];
+        if(!bounds.visible || slice < bounds.slice0 || slice > bounds.slice1)
+            continue;
+
+        // Squared distance from the sphere center to the cluster box, axis by axis: depth for the slice, then y by row and x by tile
+        const float radius2 = bounds.radius * bounds.radius;
+        const float dz = outside(-bounds.center.z, sliceNear, sliceFar);
+        const float remainingZ = radius2 - dz * dz;
+        if(remainingZ < 0.f)
+            continue;
+
+        for(std::uint32_t y = bounds.tileY0; y <= bounds.tileY1; ++y)
+        {
+            const float dy = outside(bounds.center.y, tileMinY[y], tileMaxY[y]);
+            const float remaining = remainingZ - dy * dy;
+            if(remaining < 0.f)
+                continue;
+
+            auto* clusterLights = _clusterLights.data() + clusterIndex(0, y, slice);
+            std::uint32_t x = bounds.tileX0;
+#ifdef LEARNOPENGL_LIGHT_CLUSTER_SSE
+            const __m128 centerX = _mm_set1_ps(bounds.center.x);
+            const __m128 remaining4 = _mm_set1_ps(remaining);
+            const __m128 zero = _mm_setzero_ps();
+            for(; x <= bounds.tileX1; x += 4)
+            {
+                const __m128 below = _mm_sub_ps(_mm_loadu_ps(tileMinX + x), centerX);
+                const __m128 above = _mm_sub_ps(centerX, _mm_loadu_ps(tileMaxX + x));
+                const __m128 dx = _mm_max_ps(_mm_max_ps(below, above), zero);
+                auto mask = std::uint32_t(_mm_movemask_ps(_mm_cmple_ps(_mm_mul_ps(dx, dx), remaining4)));
+                // Tiles past the light range
+                if(bounds.tileX1 - x < 3)
+                    mask &= (1u << (bounds.tileX1 - x + 1)) - 1u;
+                for(; mask; mask &= mask - 1)
+                {
+                    const auto tile = x + std::uint32_t(std::countr_zero(mask));
+                    clusterLights[tile].push_back(std::uint32_t(i));
+                }
+            }
+#else
+            for(; x <= bounds.tileX1; ++x)
+            {
+                const float dx = outside(bounds.center.x, tileMinX[x], tileMaxX[x]);
+                if(dx * dx <= remaining)
+                    clusterLights[x].push_back(std::uint32_t(i));
+            }
+#endif
+        }
+    }
+}
+
+void LightClusterGrid::bin(const Camera& camera, std::span<const glm::vec4> lights) { bin(camera, lights, ThreadPool::global()); }
+
+void LightClusterGrid::bin(const Camera& camera, std::span<const glm::vec4> lights, ThreadPool& pool)
+{
+    computeClusterBounds(camera);
+
+    _bounds.resize(lights.size());
+    const auto view = camera.viewMatrix();
+    pool.parallelFor(lights.size(), 1024, [&](std::size_t begin, std::size_t end) { boundLights(view, lights, begin, end); });
+
+    pool.parallelFor(_settings.sliceCount,
+        1,
+        [&](std::size_t begin, std::size_t end)
+        {
+            for(auto slice = begin; slice < end; ++slice) binSlice(std::uint32_t(slice));
+        });
+
+    // Flatten the lists, clusters of a slice are contiguous so each slice is copied by one thread
+    _stats = {};
+    _stats.lightCount = lights.size();
+    _stats.visibleLightCount =
+        std::size_t(std::count_if(_bounds.begin(), _bounds.end(), [](const LightBounds& bounds) { return bounds.visible; }));
+
+    std::uint32_t offset = 0;
+    for(std::size_t cluster = 0; cluster < _clusters.size(); ++cluster)
+    {
+        const auto count = std::uint32_t(_clusterLights[cluster].size());
+        _clusters[cluster] = {offset, count};
+        offset += count;
+        if(count)
+            ++_stats.activeClusterCount;
+        _stats.maxLightsPerCluster = std::max<std::size_t>(_stats.maxLightsPerCluster, count);
+    }
+    _stats.indexCount = offset;
+
+    _indices.resize(offset);
+    const auto clustersPerSlice = std::size_t(_settings.tileCountX) * _settings.tileCountY;
+    pool.parallelFor(_settings.sliceCount,
+        1,
+        [&](std::size_t begin, std::size_t end)
+        {
+            for(auto cluster = begin * clustersPerSlice; cluster < end * clustersPerSlice; ++cluster)
+                std::copy(_clusterLights[cluster].begin(), _clusterLights[cluster].end(), _indices.begin() + _clusters[cluster].offset);
+        });
+}
+
+}
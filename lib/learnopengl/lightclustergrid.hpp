@@ -0,0 +1,127 @@
+#ifndef __LEARNOPENGL_LIGHT_CLUSTER_GRID_HPP__
+#define __LEARNOPENGL_LIGHT_CLUSTER_GRID_HPP__
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace learnopengl {
+
+class Camera;
+class ThreadPool;
+
+// Froxels of a camera: tileCountX by tileCountY screen tiles, each split in sliceCount view depth slices spaced exponentially from
+// the camera near to far distance, the last slice going on to infinity. bin() lists the lights overlapping each cluster on the CPU.
+class LightClusterGrid
+{
+public:
+    struct Settings
+    {
+        std::uint32_t tileCountX = 16;
+        std::uint32_t tileCountY = 9;
+        std::uint32_t sliceCount = 24;
+    };
+
+    // Lights of a cluster are indices()[offset, offset + count)
+    struct Cluster
+    {
+        std::uint32_t offset = 0;
+        std::uint32_t count = 0;
+    };
+
+    struct Stats
+    {
+        std::size_t lightCount = 0;
+        // Lights overlapping at least one cluster
+        std::size_t visibleLightCount = 0;
+        std::size_t activeClusterCount = 0;
+        std::size_t indexCount = 0;
+        std::size_t maxLightsPerCluster = 0;
+    };
+
+public:
+    LightClusterGrid();
+    explicit LightClusterGrid(const Settings& settings);
+
+    [[nodiscard]] const Settings& settings() const { return _settings; }
+    void setSettings(const Settings& settings);
+
+    [[nodiscard]] std::size_t clusterCount() const
+    {
+        return std::size_t(_settings.tileCountX) * _settings.tileCountY * _settings.sliceCount;
+    }
+    // Tile y and slice 0 are at the bottom of the screen and the near plane
+    [[nodiscard]] std::size_t clusterIndex(std::uint32_t tileX, std::uint32_t tileY, std::uint32_t slice) const
+    {
+        return (std::size_t(slice) * _settings.tileCountY + tileY) * _settings.tileCountX + tileX;
+    }
+
+    // List the lights overlapping each cluster of the camera. Lights are world space bounding spheres (center, radius w).
+    // Lights are bounded by slices then by clusters in parallel over the pool, the sphere to cluster test is SIMD over 4 tiles.
+    void bin(const Camera& camera, std::span<const glm::vec4> lights, ThreadPool& pool);
+    // Same over ThreadPool::global()
+    void bin(const Camera& camera, std::span<const glm::vec4> lights);
+
+    // By clusterIndex, light indices of a cluster are sorted
+    [[nodiscard]] const std::vector<Cluster>& clusters() const { return _clusters; }
+    [[nodiscard]] const std::vector<std::uint32_t>& indices() const { return _indices; }
+    [[nodiscard]] const Stats& stats() const { return _stats; }
+
+    // Slice of a view space depth is floor(log(depth) * sliceScale + sliceBias)
+    [[nodiscard]] float sliceScale() const { return _sliceScale; }
+    [[nodiscard]] float sliceBias() const { return _sliceBias; }
+
+private:
+    // View space sphere and the clusters range it may overlap
+    struct LightBounds
+    {
+        glm::vec3 center = glm::vec3(0.f);
+        float radius = 0.f;
+        std::uint32_t slice0 = 0;
+        std::uint32_t slice1 = 0;
+        std::uint32_t tileX0 = 0;
+        std::uint32_t tileX1 = 0;
+        std::uint32_t tileY0 = 0;
+        std::uint32_t tileY1 = 0;
+        bool visible = false;
+    };
+
+    void computeClusterBounds(const Camera& camera);
+    void boundLights(const glm::mat4& view, std::span<const glm::vec4> lights, std::size_t begin, std::size_t end);
+    void binSlice(std::uint32_t slice);
+    [[nodiscard]] std::uint32_t sliceOf(float depth) const;
+
+    Settings _settings;
+
+    // View space projection scales and slicing of the last bin
+    float _projectionX = 1.f;
+    float _projectionY = 1.f;
+    float _sliceScale = 1.f;
+    float _sliceBias = 0.f;
+
+    // View space bounds of the clusters: x of each tile column and y of each tile row by slice, depth range by slice.
+    // Rows of x are padded to a multiple of 4 for SIMD loads.
+    std::uint32_t _tileStrideX = 0;
+    std::vector<float> _tileMinX;
+    std::vector<float> _tileMaxX;
+    std::vector<float> _tileMinY;
+    std::vector<float> _tileMaxY;
+    std::vector<float> _sliceNear;
+    std::vector<float> _sliceFar;
+
+    std::vector<LightBounds> _bounds;
+    // Lights of each cluster, capacity kept from frame to frame
+    std::vector<std::vector<std::uint32_t>> _clusterLights;
+
+    std::vector<Cluster> _clusters;
+    std::vector<std::uint32_t> _indices;
+    Stats _stats;
+};
+
+}
+
+#endif
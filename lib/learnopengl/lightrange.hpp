@@ -0,0 +1,33 @@
+#ifndef __LEARNOPENGL_LIGHT_RANGE_HPP__
+#define __LEARNOPENGL_LIGHT_RANGE_HPP__
+
+#include <cmath>
+#include <limits>
+
+namespace learnopengl {
+
+// Light contribution under which a light is ignored, 5/256 as in the deferred shading chapter (under one 8-bit step once lit)
+inline constexpr float LightRangeThreshold = 5.f / 256.f;
+
+// Distance at which a light of maxIntensity (brightest diffuse component) attenuated by 1 / (constant + linear d + quadratic d²)
+// falls under threshold. Infinite without linear and quadratic terms.
+[[nodiscard]] inline float lightRange(float constant,
+    float linear,
+    float quadratic,
+    float maxIntensity,
+    float threshold = LightRangeThreshold)
+{
+    // Solve quadratic d² + linear d + constant - maxIntensity / threshold = 0
+    const float c = constant - maxIntensity / threshold;
+    if(c >= 0.f)
+        return 0.f;
+    if(quadratic > 0.f)
+        return (-linear + std::sqrt(linear * linear - 4.f * quadratic * c)) / (2.f * quadratic);
+    if(linear > 0.f)
+        return -c / linear;
+    return std::numeric_limits<float>::infinity();
+}
+
+}
+
+#endif
@@ -0,0 +1,106 @@
+#include <learnopengl/lighttilegrid.hpp>
+#include <learnopengl/camera.hpp>
+#include <learnopengl/depthstate.hpp>
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <limits>
+
+namespace learnopengl {
+
+void LightTileGrid::cull(
+    const Camera& camera, int width, int height, std::span<const float> depth, float clearDepth, std::span<const glm::vec4> lights)
+{
+    _tileCountX = std::uint32_t(std::max(width, 0) + int(TileSize) - 1) / TileSize;
+    _tileCountY = std::uint32_t(std::max(height, 0) + int(TileSize) - 1) / TileSize;
+    _tiles.assign(std::size_t(_tileCountX) * _tileCountY, {});
+    _indices.clear();
+    _stats = {};
+    _stats.tileCount = _tiles.size();
+    if(depth.size() < std::size_t(width) * std::size_t(height))
+        return;
+
+    // ndc z = (projection[2][2] * z + projection[3][2]) / -z, stored depth to ndc as in GBuffer::bind
+    const auto& projection = camera.projectionMatrix();
+    const bool zeroToOne = zeroToOneClipDepth();
+    const auto viewDepth = [&](float stored)
+    {
+        const float ndc = zeroToOne ? stored : stored * 2.f - 1.f;
+        return projection[3][2] / (ndc + projection[2][2]);
+    };
+
+    const auto& view = camera.viewMatrix();
+    _viewLights.resize(lights.size());
+    for(std::size_t light = 0; light < lights.size(); ++light)
+        _viewLights[light] = glm::vec4(glm::vec3(view * glm::vec4(glm::vec3(lights[light]), 1.f)), lights[light].w);
+
+    for(std::uint32_t tileY = 0; tileY < _tileCountY; ++tileY)
+    {
+        for(std::uint32_t tileX = 0; tileX < _tileCountX; ++tileX)
+        {
+            auto& tile = _tiles[tileIndex(tileX, tileY)];
+            tile.offset = std::uint32_t(_indices.size());
+
+            // Stored depth range of the geometry
+            const auto x0 = int(tileX * TileSize);
+            const auto y0 = int(tileY * TileSize);
+            const auto x1 = std::min(x0 + int(TileSize), width);
+            const auto y1 = std::min(y0 + int(TileSize), height);
+            float minStored = std::numeric_limits<float>::max();
+            float maxStored = std::numeric_limits<float>::lowest();
+            for(int y = y0; y < y1; ++y)
+            {
+                for(int x = x0; x < x1; ++x)
+                {
+                    const float stored = depth[std::size_t(y) * std::size_t(width) + std::size_t(x)];
+                    if(stored == clearDepth)
+                        continue;
+                    minStored = std::min(minStored, stored);
+                    maxStored = std::max(maxStored, stored);
+                }
+            }
+            if(minStored > maxStored)
+            {
+                tile.minDepth = 1.f;
+                tile.maxDepth = 0.f;
+                continue;
+            }
+            ++_stats.activeTileCount;
+
+            const float depth0 = viewDepth(minStored);
+            const float depth1 = viewDepth(maxStored);
+            tile.minDepth = std::min(depth0, depth1);
+            tile.maxDepth = std::max(depth0, depth1);
+
+            // Side planes through the camera, normals pointing inside: ndc x = projection[0][0] * x / -z
+            const glm::vec2 tileMin = glm::vec2(float(x0) / float(width), float(y0) / float(height)) * 2.f - glm::vec2(1.f);
+            const glm::vec2 tileMax = glm::vec2(float(x1) / float(width), float(y1) / float(height)) * 2.f - glm::vec2(1.f);
+            const glm::vec3 planes[] = {glm::normalize(glm::vec3(projection[0][0], 0.f, tileMin.x)),
+                glm::normalize(glm::vec3(-projection[0][0], 0.f, -tileMax.x)),
+                glm::normalize(glm::vec3(0.f, projection[1][1], tileMin.y)),
+                glm::normalize(glm::vec3(0.f, -projection[1][1], -tileMax.y))};
+
+            for(std::uint32_t light = 0; light < _viewLights.size(); ++light)
+            {
+                const auto center = glm::vec3(_viewLights[light]);
+                const float radius = _viewLights[light].w;
+                const float centerDepth = -center.z;
+                if(centerDepth + radius < tile.minDepth || centerDepth - radius > tile.maxDepth)
+                    continue;
+                const auto outside = [&](const glm::vec3& plane) { return glm::dot(plane, center) < -radius; };
+                if(std::any_of(std::begin(planes), std::end(planes), outside))
+                    continue;
+                _indices.push_back(light);
+            }
+
+            tile.count = std::uint32_t(_indices.size()) - tile.offset;
+            _stats.maxLightsPerTile = std::max<std::size_t>(_stats.maxLightsPerTile, tile.count);
+            if(tile.count > MaxLightsPerTile)
+                ++_stats.overflowTileCount;
+        }
+    }
+    _stats.indexCount = _indices.size();
+}
+
+}
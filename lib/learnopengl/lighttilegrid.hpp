@@ -0,0 +1,72 @@
+#ifndef __LEARNOPENGL_LIGHT_TILE_GRID_HPP__
+#define __LEARNOPENGL_LIGHT_TILE_GRID_HPP__
+
+#include <glm/vec4.hpp>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace learnopengl {
+
+class Camera;
+
+// Screen tiles of TileSize pixels bounded by the view depth range of their geometry, and the lights reaching into each of them.
+// CPU reference of the culling done by the compute shader of DeferredLighting::Mode::Tiled (resources/shaders/deferredtiled.cs),
+// with the same tests: bounding sphere against the 4 side planes of the tile and its depth range, in view space.
+class LightTileGrid
+{
+public:
+    static constexpr std::uint32_t TileSize = 16;
+    // Capacity of the shared memory light list of a tile in the compute shader, lights beyond are not shaded
+    static constexpr std::uint32_t MaxLightsPerTile = 1024;
+
+    // Lights of a tile are indices()[offset, offset + count). View depth range of the geometry, minDepth > maxDepth without geometry.
+    struct Tile
+    {
+        std::uint32_t offset = 0;
+        std::uint32_t count = 0;
+        float minDepth = 0.f;
+        float maxDepth = 0.f;
+    };
+
+    struct Stats
+    {
+        std::size_t tileCount = 0;
+        // Tiles with geometry
+        std::size_t activeTileCount = 0;
+        std::size_t indexCount = 0;
+        std::size_t maxLightsPerTile = 0;
+        // Tiles listing more than MaxLightsPerTile lights
+        std::size_t overflowTileCount = 0;
+    };
+
+public:
+    // List the lights reaching into each tile. depth holds the stored depth of width x height pixels by rows from the bottom, as
+    // glReadPixels returns them, pixels at clearDepth have no geometry. Lights are world space bounding spheres (center, radius w).
+    void cull(
+        const Camera& camera, int width, int height, std::span<const float> depth, float clearDepth, std::span<const glm::vec4> lights);
+
+    [[nodiscard]] std::uint32_t tileCountX() const { return _tileCountX; }
+    [[nodiscard]] std::uint32_t tileCountY() const { return _tileCountY; }
+    // Tile y 0 is at the bottom of the screen
+    [[nodiscard]] std::size_t tileIndex(std::uint32_t tileX, std::uint32_t tileY) const { return std::size_t(tileY) * _tileCountX + tileX; }
+
+    // By tileIndex, light indices of a tile are sorted
+    [[nodiscard]] const std::vector<Tile>& tiles() const { return _tiles; }
+    [[nodiscard]] const std::vector<std::uint32_t>& indices() const { return _indices; }
+    [[nodiscard]] const Stats& stats() const { return _stats; }
+
+private:
+    std::uint32_t _tileCountX = 0;
+    std::uint32_t _tileCountY = 0;
+    std::vector<Tile> _tiles;
+    std::vector<std::uint32_t> _indices;
+    // View space bounding spheres of the last cull
+    std::vector<glm::vec4> _viewLights;
+    Stats _stats;
+};
+
+}
+
+#endif
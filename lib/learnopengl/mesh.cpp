@@ -1,14 +1,27 @@
 #include <learnopengl/mesh.hpp>
 #include <learnopengl/shader.hpp>
+#include <learnopengl/geometrypool.hpp>
+#include <learnopengl/trace.hpp>
 
 #include <glad/glad.h>
 
+#include <glm/geometric.hpp>
+
+#include <algorithm>
 #include <cstddef>
 
 namespace learnopengl {
 
 Mesh::~Mesh()
 {
+    if(_geometryPool)
+    {
+        _geometryPool->free(_geometryHandle);
+        return;
+    }
+
+    glDeleteVertexArrays(1, &_positionVAO);
+    glDeleteBuffers(1, &_positionVBO);
     glDeleteVertexArrays(1, &_VAO);
     glDeleteBuffers(1, &_EBO);
     glDeleteBuffers(1, &_VBO);
@@ -16,8 +29,44 @@ Mesh::~Mesh()
 
 void Mesh::draw(const Shader& shader) const
 {
+    LEARNOPENGL_TRACE_SCOPE("Mesh::draw");
     shader.use();
+    bindTextures(shader);
+
+    if(_geometryPool)
+    {
+        _geometryPool->draw(_geometryHandle);
+        return;
+    }
+
+    glBindVertexArray(_VAO);
+    glDrawElements(GL_TRIANGLES, int(_indices.size()), GL_UNSIGNED_INT, nullptr);
+    glBindVertexArray(0);
+}
+
+void Mesh::drawPositions() const
+{
+    LEARNOPENGL_TRACE_SCOPE("Mesh::drawPositions");
+    if(_geometryPool)
+    {
+        _geometryPool->draw(_geometryHandle);
+        return;
+    }
+
+    if(!_positionVAO)
+    {
+        glGenVertexArrays(1, &_positionVAO);
+        glBindVertexArray(_positionVAO);
+        setupPositionAttributes();
+    }
 
+    glBindVertexArray(_positionVAO);
+    glDrawElements(GL_TRIANGLES, int(_indices.size()), GL_UNSIGNED_INT, nullptr);
+    glBindVertexArray(0);
+}
+
+void Mesh::bindTextures(const Shader& shader) const
+{
     unsigned int diffuseNr = 1;
     unsigned int specularNr = 1;
     for(int i = 0; i < int(_textures.size()); i++)
@@ -37,21 +86,61 @@ void Mesh::draw(const Shader& shader) const
         _textures[i].use(i);
     }
     glActiveTexture(GL_TEXTURE0);
+}
 
-    glBindVertexArray(_VAO);
-    glDrawElements(GL_TRIANGLES, int(_indices.size()), GL_UNSIGNED_INT, nullptr);
-    glBindVertexArray(0);
+void Mesh::computeBounds()
+{
+    for(const auto& vertex: _vertices) _bounds.expand(vertex.position);
+
+    if(!_bounds.valid())
+        return;
+
+    // Centered on the box, radius is the farthest vertex. Tighter than the box half diagonal.
+    _boundingSphere.center = _bounds.center();
+    float radius2 = 0.f;
+    for(const auto& vertex: _vertices)
+    {
+        const auto delta = vertex.position - _boundingSphere.center;
+        radius2 = std::max(radius2, glm::dot(delta, delta));
+    }
+    _boundingSphere.radius = std::sqrt(radius2);
 }
 
 void Mesh::setup()
 {
+    if(_geometryPool)
+    {
+        _geometryHandle = _geometryPool->allocate(_vertices, _indices);
+        return;
+    }
+
     glGenVertexArrays(1, &_VAO);
     glGenBuffers(1, &_VBO);
     glGenBuffers(1, &_EBO);
 
-    glBindVertexArray(_VAO);
     glBindBuffer(GL_ARRAY_BUFFER, _VBO);
     glBufferData(GL_ARRAY_BUFFER, _vertices.size() * sizeof(Vertex), _vertices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    // Element array binding is part of the vertex array state, use copy write target to not alter it
+    glBindBuffer(GL_COPY_WRITE_BUFFER, _EBO);
+    glBufferData(GL_COPY_WRITE_BUFFER, sizeof(std::uint32_t) * _indices.size(), _indices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    glBindVertexArray(_VAO);
+    setupVertexAttributes();
+    glBindVertexArray(0);
+}
+
+void Mesh::setupVertexAttributes() const
+{
+    if(_geometryPool)
+    {
+        _geometryPool->setupVertexAttributes(_geometryPool->allocation(_geometryHandle).block);
+        return;
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, _VBO);
 
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, position)));
     glEnableVertexAttribArray(0);
@@ -61,9 +150,69 @@ void Mesh::setup()
     glEnableVertexAttribArray(2);
 
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(std::uint32_t) * _indices.size(), _indices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
 
-    glBindVertexArray(0);
+void Mesh::setupPositionAttributes() const
+{
+    // Pool vertices are interleaved in shared buffers
+    if(_geometryPool)
+    {
+        setupVertexAttributes();
+        return;
+    }
+
+    if(!_positionVBO)
+    {
+        std::vector<glm::vec3> positions(_vertices.size());
+        std::transform(_vertices.begin(), _vertices.end(), positions.begin(), [](const Vertex& vertex) { return vertex.position; });
+        glGenBuffers(1, &_positionVBO);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, _positionVBO);
+        glBufferData(GL_COPY_WRITE_BUFFER, positions.size() * sizeof(glm::vec3), positions.data(), GL_STATIC_DRAW);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, _positionVBO);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), nullptr);
+    glEnableVertexAttribArray(0);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _EBO);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void Mesh::drawInstances(std::size_t instanceCount, std::uint32_t baseInstance) const
+{
+    if(_geometryPool)
+    {
+        const auto& allocation = _geometryPool->allocation(_geometryHandle);
+        const auto* firstIndex = reinterpret_cast<void*>(std::size_t(allocation.firstIndex) * sizeof(std::uint32_t));
+        if(baseInstance)
+        {
+            glDrawElementsInstancedBaseVertexBaseInstance(GL_TRIANGLES,
+                GLsizei(allocation.indexCount),
+                GL_UNSIGNED_INT,
+                firstIndex,
+                GLsizei(instanceCount),
+                GLint(allocation.baseVertex),
+                baseInstance);
+            return;
+        }
+        glDrawElementsInstancedBaseVertex(GL_TRIANGLES,
+            GLsizei(allocation.indexCount),
+            GL_UNSIGNED_INT,
+            firstIndex,
+            GLsizei(instanceCount),
+            GLint(allocation.baseVertex));
+        return;
+    }
+
+    if(baseInstance)
+    {
+        glDrawElementsInstancedBaseInstance(
+            GL_TRIANGLES, GLsizei(_indices.size()), GL_UNSIGNED_INT, nullptr, GLsizei(instanceCount), baseInstance);
+        return;
+    }
+    glDrawElementsInstanced(GL_TRIANGLES, GLsizei(_indices.size()), GL_UNSIGNED_INT, nullptr, GLsizei(instanceCount));
 }
 
 }
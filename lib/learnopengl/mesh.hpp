@@ -2,6 +2,7 @@
 #define __LEARNOPENGL_MESH_HPP__
 
 #include <learnopengl/texture.hpp>
+#include <learnopengl/boundingvolume.hpp>
 
 #include <glm/vec3.hpp>
 #include <glm/vec2.hpp>
@@ -13,6 +14,7 @@
 namespace learnopengl {
 
 class Shader;
+class GeometryPool;
 
 class Mesh
 {
@@ -24,26 +26,71 @@ public:
         glm::vec2 texCoords;
     };
 
-    Mesh(std::vector<Vertex> vertices, std::vector<std::uint32_t> indices, std::vector<Texture> textures) :
-        _vertices(std::move(vertices)), _indices(std::move(indices)), _textures(std::move(textures))
+    // When a geometry pool is given, vertices and indices are suballocated from it instead of owning a VAO/VBO/EBO
+    Mesh(std::vector<Vertex> vertices,
+        std::vector<std::uint32_t> indices,
+        std::vector<Texture> textures,
+        GeometryPool* geometryPool = nullptr) :
+        _vertices(std::move(vertices)),
+        _indices(std::move(indices)),
+        _textures(std::move(textures)),
+        _geometryPool(geometryPool)
     {
+        computeBounds();
         setup();
     }
     ~Mesh();
 
 public:
     void draw(const Shader& shader) const;
+    // Bind textures to units and set "material.texture_diffuseN"/"material.texture_specularN" samplers. shader must be in use.
+    void bindTextures(const Shader& shader) const;
+
+    // Configure vertex attributes (location 0 to 2) and element buffer of this mesh on the currently bound vertex array.
+    // Allow other vertex arrays (ex: with per instance attributes) to source the mesh geometry.
+    void setupVertexAttributes() const;
+    // Draw instanceCount instances with the currently bound vertex array, configured with setupVertexAttributes.
+    // Per instance attributes start at baseInstance (OpenGL 4.2 when not 0).
+    void drawInstances(std::size_t instanceCount, std::uint32_t baseInstance = 0) const;
+
+    // Depth only passes (e.g. shadow maps) read positions packed in their own buffer, 12 bytes per vertex instead of 32, created on
+    // first use. Configure location 0 and the element buffer on the currently bound vertex array (every attribute with a geometry pool).
+    void setupPositionAttributes() const;
+    // Draw with positions only at location 0, shader must be in use
+    void drawPositions() const;
+
+    // Bounds in mesh space, computed once at load
+    [[nodiscard]] const AABB& bounds() const { return _bounds; }
+    [[nodiscard]] const BoundingSphere& boundingSphere() const { return _boundingSphere; }
+    [[nodiscard]] std::size_t indexCount() const { return _indices.size(); }
+    // CPU copy of the geometry, e.g. for software rasterization (OcclusionBuffer)
+    [[nodiscard]] const std::vector<Vertex>& vertices() const { return _vertices; }
+    [[nodiscard]] const std::vector<std::uint32_t>& indices() const { return _indices; }
+
+    [[nodiscard]] GeometryPool* geometryPool() const { return _geometryPool; }
+    [[nodiscard]] std::uint32_t geometryHandle() const { return _geometryHandle; }
 
 private:
+    void computeBounds();
     void setup();
 
     std::vector<Vertex> _vertices;
     std::vector<std::uint32_t> _indices;
     std::vector<Texture> _textures;
 
+    AABB _bounds;
+    BoundingSphere _boundingSphere;
+
+    // Own buffers, when not using a geometry pool
     std::uint32_t _VAO = 0;
     std::uint32_t _VBO = 0;
     std::uint32_t _EBO = 0;
+    // Position only stream, see setupPositionAttributes
+    mutable std::uint32_t _positionVAO = 0;
+    mutable std::uint32_t _positionVBO = 0;
+
+    GeometryPool* _geometryPool = nullptr;
+    std::uint32_t _geometryHandle = 0;
 };
 
 }
@@ -1,27 +1,180 @@
 #include <learnopengl/model.hpp>
 #include <learnopengl/fileinfo.hpp>
+#include <learnopengl/shader.hpp>
+#include <learnopengl/frustum.hpp>
+#include <learnopengl/geometrypool.hpp>
+#include <learnopengl/multidrawbatch.hpp>
+#include <learnopengl/occlusionbuffer.hpp>
+#include <learnopengl/occlusionculler.hpp>
+#include <learnopengl/trace.hpp>
+#include <learnopengl/framepacing.hpp>
 
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <glm/gtc/matrix_inverse.hpp>
+
 #include <iostream>
 
 namespace learnopengl {
 
-Model::Model(const std::string& filePath, bool verticalFlipTextures) : _verticalFlipTextures(verticalFlipTextures)
+Model::Model(const std::string& filePath, bool verticalFlipTextures, GeometryPool* geometryPool) :
+    _geometryPool(geometryPool), _verticalFlipTextures(verticalFlipTextures)
 {
+    if(!_geometryPool)
+    {
+        _ownedGeometryPool = std::make_unique<GeometryPool>();
+        _geometryPool = _ownedGeometryPool.get();
+    }
+
     const auto absolutePath = FileInfo(filePath).absolutePath();
     loadModel(absolutePath);
 }
 
-void Model::draw(const Shader& shader)
+Model::~Model() = default;
+
+static glm::mat4 toMat4(const aiMatrix4x4& m)
+{
+    // assimp matrices are row major, glm matrices are column major
+    return glm::mat4(glm::vec4(m.a1, m.b1, m.c1, m.d1),
+        glm::vec4(m.a2, m.b2, m.c2, m.d2),
+        glm::vec4(m.a3, m.b3, m.c3, m.d3),
+        glm::vec4(m.a4, m.b4, m.c4, m.d4));
+}
+
+// Vertices and indices of the meshes referenced by node and its children, as processNode allocates them
+static void countGeometry(const aiNode* node, const aiScene* scene, std::size_t& vertexCount, std::size_t& indexCount)
 {
-    for(const auto& mesh: _meshes) { mesh->draw(shader); }
+    for(unsigned int i = 0; i < node->mNumMeshes; i++)
+    {
+        const aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
+        vertexCount += mesh->mNumVertices;
+        for(unsigned int j = 0; j < mesh->mNumFaces; j++) indexCount += mesh->mFaces[j].mNumIndices;
+    }
+    for(unsigned int i = 0; i < node->mNumChildren; i++) countGeometry(node->mChildren[i], scene, vertexCount, indexCount);
+}
+
+void Model::updateVisibility(const glm::mat4& model, const Frustum* frustum, bool worldBounds)
+{
+    if(_sceneGraph.updateWorldMatrices() > 0)
+        _indirectNodesChanged = true;
+
+    const auto meshCount = _meshes.size();
+    _meshMatrices.resize(meshCount);
+    for(std::size_t i = 0; i < meshCount; ++i) _meshMatrices[i] = model * _sceneGraph.worldMatrix(_meshNodes[i]);
+
+    _visibleMeshes.assign(meshCount, 1);
+    if(frustum || worldBounds)
+    {
+        _worldBounds.clear();
+        for(std::size_t i = 0; i < meshCount; ++i) _worldBounds.push_back(_meshes[i]->bounds().transformed(_meshMatrices[i]));
+    }
+    if(frustum)
+        frustum->cull(_worldBounds, _visibleMeshes.data());
+}
+
+void Model::draw(const Shader& shader, const glm::mat4& model, const Frustum* frustum, const OcclusionBuffer* occlusion)
+{
+    updateVisibility(model, frustum, occlusion != nullptr);
+    const auto meshCount = _meshes.size();
+
+    _drawStats = {};
+    if(occlusion)
+        _drawStats.occludedMeshes = occlusion->cull(_worldBounds, _visibleMeshes.data());
+
+    shader.use();
+    // Meshes of the same pool block share a vertex array, only bind it once
+    _geometryPool->beginBatch();
+    for(std::size_t i = 0; i < meshCount; ++i)
+    {
+        if(!_visibleMeshes[i])
+        {
+            ++_drawStats.culledMeshes;
+            continue;
+        }
+        ++_drawStats.drawnMeshes;
+
+        const auto& meshModel = _meshMatrices[i];
+        shader.setMat4("model", glm::value_ptr(meshModel));
+
+        const glm::mat3 normalModelMatrix = glm::inverseTranspose(glm::mat3(meshModel));
+        shader.setMat3("normalModelMatrix", glm::value_ptr(normalModelMatrix));
+
+        _meshes[i]->draw(shader);
+    }
+    _geometryPool->endBatch();
+    _drawStats.drawCalls = _drawStats.drawnMeshes;
+}
+
+void Model::drawIndirect(const Shader& shader, const glm::mat4& model, const Frustum* frustum, OcclusionCuller* occlusion)
+{
+    if(!MultiDrawBatch::supported())
+    {
+        draw(shader, model, frustum);
+        return;
+    }
+
+    updateVisibility(model, frustum);
+    const auto meshCount = _meshes.size();
+
+    // Commands left culled by the last occlusion pass are rebuilt when it stops, and pool defragmentation moves the geometry
+    const bool occlusionChanged = (occlusion != nullptr) != _indirectOcclusion;
+    const bool poolChanged = _multiDrawBatch && _multiDrawBatch->outdated();
+    if(!_multiDrawBatch || _indirectNodesChanged || occlusionChanged || poolChanged || model != _indirectModel ||
+        _visibleMeshes != _indirectVisibleMeshes)
+    {
+        if(!_multiDrawBatch)
+            _multiDrawBatch = std::make_unique<MultiDrawBatch>(*_geometryPool, MultiDrawBatch::Usage::Static);
+
+        _multiDrawBatch->clear();
+        for(std::size_t i = 0; i < meshCount; ++i)
+        {
+            if(!_visibleMeshes[i])
+                continue;
+            const auto bounds = occlusion ? _meshes[i]->bounds().transformed(_meshMatrices[i]) : AABB();
+            _multiDrawBatch->add(_meshes[i]->geometryHandle(), _meshMatrices[i], _meshMaterials[i], bounds);
+        }
+        _multiDrawBatch->upload();
+
+        _indirectModel = model;
+        _indirectVisibleMeshes = _visibleMeshes;
+        _indirectOcclusion = occlusion != nullptr;
+        _indirectNodesChanged = false;
+    }
+
+    if(occlusion)
+        occlusion->cull(*_multiDrawBatch);
+
+    _drawStats = {};
+    _drawStats.drawnMeshes = _multiDrawBatch->size();
+    _drawStats.culledMeshes = meshCount - _multiDrawBatch->size();
+
+    shader.use();
+    _multiDrawBatch->resetFrameStats();
+    _multiDrawBatch->draw([&](std::uint32_t materialIndex) { _meshes[_materialMeshes[materialIndex]]->bindTextures(shader); });
+    _drawStats.drawCalls = _multiDrawBatch->stats().multiDrawCalls;
+}
+
+void Model::rasterizeOccluders(OcclusionBuffer& buffer, const glm::mat4& model, const Frustum* frustum, float minExtent)
+{
+    updateVisibility(model, frustum, true);
+    const auto* extentX = _worldBounds.extentX();
+    const auto* extentY = _worldBounds.extentY();
+    const auto* extentZ = _worldBounds.extentZ();
+    for(std::size_t i = 0; i < _meshes.size(); ++i)
+    {
+        if(_visibleMeshes[i] && glm::length(glm::vec3(extentX[i], extentY[i], extentZ[i])) >= minExtent)
+            buffer.rasterize(*_meshes[i], _meshMatrices[i]);
+    }
 }
 
 void Model::loadModel(const std::string& path)
 {
+    LEARNOPENGL_TRACE_SCOPE("Model::loadModel");
+    const FrameEventScope frameEvent(FrameEvent::ModelLoad);
     std::cout << "Load model " << path << std::endl;
     _directory = path.substr(0, path.find_last_of('/'));
     std::cout << "Folder is " << _directory << std::endl;
@@ -35,19 +188,40 @@ void Model::loadModel(const std::string& path)
         return;
     }
 
-    processNode(scene->mRootNode, scene);
+    // An owned pool only holds this model: one block of its size instead of the default block size of shared pools
+    if(_ownedGeometryPool)
+    {
+        std::size_t vertexCount = 0;
+        std::size_t indexCount = 0;
+        countGeometry(scene->mRootNode, scene, vertexCount, indexCount);
+        _ownedGeometryPool->setBlockSize(vertexCount, indexCount);
+    }
+
+    processNode(scene->mRootNode, scene, SceneGraph::InvalidNode);
+    _sceneGraph.updateWorldMatrices();
 }
 
-void Model::processNode(aiNode* node, const aiScene* scene)
+void Model::processNode(aiNode* node, const aiScene* scene, SceneGraph::NodeIndex parent)
 {
+    // Nodes are flattened depth first, so parent is always inserted before its children
+    const auto nodeIndex = _sceneGraph.addNode(parent, toMat4(node->mTransformation));
+
     // process all the node's meshes (if any)
     for(unsigned int i = 0; i < node->mNumMeshes; i++)
     {
         aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
         _meshes.emplace_back(processMesh(mesh, scene));
+        _meshNodes.push_back(nodeIndex);
+
+        _meshMaterials.push_back(mesh->mMaterialIndex);
+        constexpr auto noMesh = ~std::size_t(0);
+        if(_materialMeshes.size() <= mesh->mMaterialIndex)
+            _materialMeshes.resize(mesh->mMaterialIndex + 1, noMesh);
+        if(_materialMeshes[mesh->mMaterialIndex] == noMesh)
+            _materialMeshes[mesh->mMaterialIndex] = _meshes.size() - 1;
     }
     // then do the same for each of its children
-    for(unsigned int i = 0; i < node->mNumChildren; i++) { processNode(node->mChildren[i], scene); }
+    for(unsigned int i = 0; i < node->mNumChildren; i++) { processNode(node->mChildren[i], scene, nodeIndex); }
 }
 
 std::unique_ptr<Mesh> Model::processMesh(aiMesh* mesh, const aiScene* scene) const
@@ -98,7 +272,7 @@ std::unique_ptr<Mesh> Model::processMesh(aiMesh* mesh, const aiScene* scene) con
             }));
     }
 
-    return std::make_unique<Mesh>(vertices, indices, textures);
+    return std::make_unique<Mesh>(vertices, indices, textures, _geometryPool);
 }
 
 std::vector<Texture> Model::loadMaterialTextures(aiMaterial* mat, int type, const std::string& typeName) const
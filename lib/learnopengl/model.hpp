@@ -2,6 +2,10 @@
 #define __LEARNOPENGL_MODEL_HPP__
 
 #include <learnopengl/mesh.hpp>
+#include <learnopengl/scenegraph.hpp>
+#include <learnopengl/boundingvolume.hpp>
+
+#include <glm/mat4x4.hpp>
 
 #include <memory>
 
@@ -12,22 +16,97 @@ struct aiMaterial;
 
 namespace learnopengl {
 
+class Frustum;
+class GeometryPool;
+class MultiDrawBatch;
+class OcclusionBuffer;
+class OcclusionCuller;
+
 class Model
 {
 public:
-    Model(const std::string& filePath, bool verticalFlipTextures = false);
+    // Meshes are allocated from geometryPool, or from a pool owned by the model when null.
+    // A shared geometryPool must outlive the model.
+    Model(const std::string& filePath, bool verticalFlipTextures = false, GeometryPool* geometryPool = nullptr);
+    ~Model();
+
+public:
+    struct DrawStats
+    {
+        std::size_t drawnMeshes = 0;
+        std::size_t culledMeshes = 0;
+        // Inside the frustum but behind the occluders, counted in culledMeshes too
+        std::size_t occludedMeshes = 0;
+        std::size_t drawCalls = 0;
+    };
 
 public:
-    void draw(const Shader& shader);
+    // Set "model" and "normalModelMatrix" uniforms for each mesh, combining model with the mesh node world matrix.
+    // When a frustum is given, meshes whose world bounding box is outside are skipped.
+    // When a finished occlusion buffer is given, meshes whose world bounding box is behind its occluders are skipped too.
+    void draw(const Shader& shader,
+        const glm::mat4& model = glm::mat4(1.f),
+        const Frustum* frustum = nullptr,
+        const OcclusionBuffer* occlusion = nullptr);
+
+    // Same as draw, with one glMultiDrawElementsIndirect per pool block and material instead of one draw per mesh.
+    // shader must use resources/shaders/multidraw.vs (per draw matrices in a storage buffer). Commands are only rebuilt
+    // when model, node transforms or visible meshes change. Fallback to draw when OpenGL 4.3 is not available.
+    // With an occlusion culler, the commands of meshes behind its depth pyramid are culled on the GPU: they are counted by the
+    // culler, not in drawStats.
+    void drawIndirect(const Shader& shader,
+        const glm::mat4& model = glm::mat4(1.f),
+        const Frustum* frustum = nullptr,
+        OcclusionCuller* occlusion = nullptr);
+
+    // Rasterize the meshes inside the frustum whose world bounding box has an extent of at least minExtent (length of the half
+    // diagonal) into an occlusion buffer, between its clear and finish
+    void rasterizeOccluders(
+        OcclusionBuffer& buffer, const glm::mat4& model = glm::mat4(1.f), const Frustum* frustum = nullptr, float minExtent = 0.f);
+
+    // Stats of last draw call
+    [[nodiscard]] const DrawStats& drawStats() const { return _drawStats; }
+
+    [[nodiscard]] GeometryPool* geometryPool() const { return _geometryPool; }
+
+    [[nodiscard]] SceneGraph& sceneGraph() { return _sceneGraph; }
+    [[nodiscard]] const SceneGraph& sceneGraph() const { return _sceneGraph; }
 
 private:
+    // Compute mesh world matrices and visibility of the frame, and world bounds with a frustum or when asked for
+    void updateVisibility(const glm::mat4& model, const Frustum* frustum, bool worldBounds = false);
+
     void loadModel(const std::string& path);
 
-    void processNode(aiNode* node, const aiScene* scene);
+    void processNode(aiNode* node, const aiScene* scene, SceneGraph::NodeIndex parent);
     std::unique_ptr<Mesh> processMesh(aiMesh* mesh, const aiScene* scene) const;
     std::vector<Texture> loadMaterialTextures(aiMaterial* mat, int type, const std::string& typeName) const;
 
+    // Declared before _meshes so that meshes are released first
+    std::unique_ptr<GeometryPool> _ownedGeometryPool;
+    GeometryPool* _geometryPool = nullptr;
+
     std::vector<std::unique_ptr<Mesh>> _meshes;
+    // Node of each mesh in _sceneGraph
+    std::vector<SceneGraph::NodeIndex> _meshNodes;
+    // aiMesh material index of each mesh, and first mesh using each material (its textures are bound for the whole material)
+    std::vector<std::uint32_t> _meshMaterials;
+    std::vector<std::size_t> _materialMeshes;
+    SceneGraph _sceneGraph;
+
+    // Per frame culling storage, kept to avoid allocations
+    std::vector<glm::mat4> _meshMatrices;
+    AABBArray _worldBounds;
+    std::vector<std::uint8_t> _visibleMeshes;
+    DrawStats _drawStats;
+
+    // drawIndirect commands, with the state they were built for
+    std::unique_ptr<MultiDrawBatch> _multiDrawBatch;
+    glm::mat4 _indirectModel = glm::mat4(1.f);
+    std::vector<std::uint8_t> _indirectVisibleMeshes;
+    bool _indirectOcclusion = false;
+    // Node matrices were updated since the commands were built, possibly by another call than drawIndirect
+    bool _indirectNodesChanged = false;
     std::string _directory;
     bool _verticalFlipTextures = false;
 };
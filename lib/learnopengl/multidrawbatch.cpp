@@ -0,0 +1,192 @@
+#include <learnopengl/multidrawbatch.hpp>
+
+#include <glad/glad.h>
+
+#include <glm/gtc/matrix_inverse.hpp>
+
+#include <algorithm>
+#include <numeric>
+
+namespace learnopengl {
+
+MultiDrawBatch::MultiDrawBatch(GeometryPool& pool, Usage usage) :
+    _pool(pool),
+    _usage(usage),
+    _poolGeneration(pool.generation()),
+    _uploadGeneration(pool.generation())
+{
+    glGenBuffers(1, &_commandBuffer);
+    glGenBuffers(1, &_drawDataBuffer);
+    glGenBuffers(1, &_boundsBuffer);
+    glGenBuffers(1, &_drawIdBuffer);
+}
+
+MultiDrawBatch::~MultiDrawBatch()
+{
+    releaseVertexArrays();
+    glDeleteBuffers(1, &_drawIdBuffer);
+    glDeleteBuffers(1, &_boundsBuffer);
+    glDeleteBuffers(1, &_drawDataBuffer);
+    glDeleteBuffers(1, &_commandBuffer);
+}
+
+bool MultiDrawBatch::supported() { return GLAD_GL_VERSION_4_3; }
+
+void MultiDrawBatch::clear() { _pending.clear(); }
+
+void MultiDrawBatch::add(GeometryPool::Handle handle, const glm::mat4& model, std::uint32_t materialIndex, const AABB& bounds)
+{
+    _pending.push_back({handle, materialIndex, model, bounds});
+}
+
+void MultiDrawBatch::upload()
+{
+    // Group by block first to switch vertex array as little as possible, then by material
+    std::sort(_pending.begin(),
+        _pending.end(),
+        [this](const PendingDraw& a, const PendingDraw& b)
+        {
+            const auto blockA = _pool.allocation(a.handle).block;
+            const auto blockB = _pool.allocation(b.handle).block;
+            return blockA != blockB ? blockA < blockB : a.materialIndex < b.materialIndex;
+        });
+
+    _uploadGeneration = _pool.generation();
+    _commands.resize(_pending.size());
+    _drawData.resize(_pending.size());
+    _bounds.resize(_pending.size());
+    _groups.clear();
+
+    for(std::size_t i = 0; i < _pending.size(); ++i)
+    {
+        const auto& draw = _pending[i];
+        const auto& allocation = _pool.allocation(draw.handle);
+
+        auto& command = _commands[i];
+        command.count = allocation.indexCount;
+        command.instanceCount = 1;
+        command.firstIndex = allocation.firstIndex;
+        command.baseVertex = std::int32_t(allocation.baseVertex);
+        // Instanced draw id attribute reads element baseInstance
+        command.baseInstance = std::uint32_t(i);
+
+        auto& data = _drawData[i];
+        data.model = draw.model;
+        data.normalModel = glm::mat4(glm::inverseTranspose(glm::mat3(draw.model)));
+        data.materialIndex = draw.materialIndex;
+
+        _bounds[i] = {};
+        if(draw.bounds.valid())
+            _bounds[i] = {glm::vec4(draw.bounds.center(), 1.f), glm::vec4(draw.bounds.extent(), 0.f)};
+
+        if(_groups.empty() || _groups.back().block != allocation.block || _groups.back().materialIndex != draw.materialIndex)
+            _groups.push_back({allocation.block, draw.materialIndex, std::uint32_t(i), 0});
+        ++_groups.back().commandCount;
+    }
+
+    // Respecifying the whole store orphans the previous one, so a dynamic upload never waits on draws of the previous frame
+    const auto usage = _usage == Usage::Static ? GL_STATIC_DRAW : GL_STREAM_DRAW;
+
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, _commandBuffer);
+    glBufferData(GL_DRAW_INDIRECT_BUFFER, GLsizeiptr(_commands.size() * sizeof(DrawElementsIndirectCommand)), _commands.data(), usage);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _drawDataBuffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, GLsizeiptr(_drawData.size() * sizeof(DrawData)), _drawData.data(), usage);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _boundsBuffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, GLsizeiptr(_bounds.size() * sizeof(DrawBounds)), _bounds.data(), usage);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    if(_pending.size() > _drawIdCapacity)
+    {
+        // Vertex arrays reference the buffer name, respecifying its store keeps them valid
+        _drawIdCapacity = std::max<std::size_t>(_pending.size(), _drawIdCapacity * 2);
+        std::vector<std::uint32_t> drawIds(_drawIdCapacity);
+        std::iota(drawIds.begin(), drawIds.end(), 0u);
+        glBindBuffer(GL_ARRAY_BUFFER, _drawIdBuffer);
+        glBufferData(GL_ARRAY_BUFFER, GLsizeiptr(drawIds.size() * sizeof(std::uint32_t)), drawIds.data(), GL_STATIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    ++_stats.uploads;
+}
+
+void MultiDrawBatch::draw(const std::function<void(std::uint32_t materialIndex)>& bindMaterial)
+{
+    // Defragmentation moved allocations, firstIndex and baseVertex must be rebuilt
+    if(outdated())
+        upload();
+
+    if(_groups.empty())
+        return;
+
+    updateVertexArrays();
+
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, _commandBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, DrawDataBinding, _drawDataBuffer);
+
+    std::uint32_t boundBlock = ~0u;
+    std::uint32_t boundMaterial = ~0u;
+    for(const auto& group: _groups)
+    {
+        if(group.block != boundBlock)
+        {
+            glBindVertexArray(_vertexArrays[group.block]);
+            boundBlock = group.block;
+        }
+        if(bindMaterial && group.materialIndex != boundMaterial)
+        {
+            bindMaterial(group.materialIndex);
+            boundMaterial = group.materialIndex;
+        }
+
+        glMultiDrawElementsIndirect(GL_TRIANGLES,
+            GL_UNSIGNED_INT,
+            reinterpret_cast<void*>(std::size_t(group.firstCommand) * sizeof(DrawElementsIndirectCommand)),
+            GLsizei(group.commandCount),
+            0);
+        ++_stats.multiDrawCalls;
+        _stats.draws += group.commandCount;
+    }
+
+    glBindVertexArray(0);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, DrawDataBinding, 0);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
+
+void MultiDrawBatch::updateVertexArrays()
+{
+    // Defragmentation replaced block buffers
+    if(_poolGeneration != _pool.generation())
+    {
+        releaseVertexArrays();
+        _poolGeneration = _pool.generation();
+    }
+
+    while(_vertexArrays.size() < _pool.blockCount())
+    {
+        const auto block = std::uint32_t(_vertexArrays.size());
+        std::uint32_t vao = 0;
+        glGenVertexArrays(1, &vao);
+        glBindVertexArray(vao);
+        _pool.setupVertexAttributes(block);
+
+        glBindBuffer(GL_ARRAY_BUFFER, _drawIdBuffer);
+        glVertexAttribIPointer(DrawIdLocation, 1, GL_UNSIGNED_INT, sizeof(std::uint32_t), nullptr);
+        glVertexAttribDivisor(DrawIdLocation, 1);
+        glEnableVertexAttribArray(DrawIdLocation);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        glBindVertexArray(0);
+        _vertexArrays.push_back(vao);
+    }
+}
+
+void MultiDrawBatch::releaseVertexArrays()
+{
+    if(!_vertexArrays.empty())
+        glDeleteVertexArrays(GLsizei(_vertexArrays.size()), _vertexArrays.data());
+    _vertexArrays.clear();
+}
+
+}
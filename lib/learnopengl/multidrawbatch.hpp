@@ -0,0 +1,149 @@
+#ifndef __LEARNOPENGL_MULTI_DRAW_BATCH_HPP__
+#define __LEARNOPENGL_MULTI_DRAW_BATCH_HPP__
+
+#include <learnopengl/boundingvolume.hpp>
+#include <learnopengl/geometrypool.hpp>
+
+#include <glm/mat4x4.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace learnopengl {
+
+// Submit many GeometryPool allocations with glMultiDrawElementsIndirect (OpenGL 4.3).
+// Draws are grouped by pool block and material, each group is a single multi draw call.
+// Per draw data is stored in a shader storage buffer (binding 0) indexed by the "aDrawId" vertex attribute (location 3),
+// an instanced attribute sourced through the command baseInstance, see resources/shaders/multidraw.vs.
+class MultiDrawBatch
+{
+public:
+    // Layout imposed by glMultiDrawElementsIndirect
+    struct DrawElementsIndirectCommand
+    {
+        std::uint32_t count = 0;
+        std::uint32_t instanceCount = 0;
+        std::uint32_t firstIndex = 0;
+        std::int32_t baseVertex = 0;
+        std::uint32_t baseInstance = 0;
+    };
+
+    // std430 layout
+    struct DrawData
+    {
+        glm::mat4 model;
+        // mat3 columns are padded to vec4 in std430, a mat4 is simpler
+        glm::mat4 normalModel;
+        std::uint32_t materialIndex = 0;
+        std::uint32_t padding[3] = {};
+    };
+
+    // std430 layout, world space bounds of a draw for GPU culling (OcclusionCuller), center w is 0 without bounds
+    struct DrawBounds
+    {
+        glm::vec4 center = glm::vec4(0.f);
+        glm::vec4 extent = glm::vec4(0.f);
+    };
+
+    enum class Usage
+    {
+        // Uploaded once, draws rarely change
+        Static,
+        // Rebuilt every frame, buffers are orphaned on upload
+        Dynamic,
+    };
+
+    struct Stats
+    {
+        std::size_t draws = 0;
+        std::size_t multiDrawCalls = 0;
+        std::size_t uploads = 0;
+    };
+
+    static constexpr std::uint32_t DrawDataBinding = 0;
+    static constexpr std::uint32_t DrawIdLocation = 3;
+
+public:
+    // pool must outlive the batch
+    explicit MultiDrawBatch(GeometryPool& pool, Usage usage = Usage::Dynamic);
+    ~MultiDrawBatch();
+
+    MultiDrawBatch(const MultiDrawBatch&) = delete;
+    MultiDrawBatch& operator=(const MultiDrawBatch&) = delete;
+
+    // glMultiDrawElementsIndirect and shader storage buffers are available
+    [[nodiscard]] static bool supported();
+
+    void clear();
+    // bounds are only needed to cull the draws on the GPU
+    void add(GeometryPool::Handle handle, const glm::mat4& model, std::uint32_t materialIndex = 0, const AABB& bounds = {});
+
+    [[nodiscard]] std::size_t size() const { return _pending.size(); }
+    [[nodiscard]] bool empty() const { return _pending.empty(); }
+
+    // Sort draws, build commands and upload them with per draw data. Must be called after add and before draw.
+    void upload();
+    // The pool was defragmented since the last upload, commands hold stale offsets. draw uploads them again.
+    [[nodiscard]] bool outdated() const { return _uploadGeneration != _pool.generation(); }
+
+    // Draw every group with the shader in use. bindMaterial is called before each group whose material differs from the previous one.
+    void draw(const std::function<void(std::uint32_t materialIndex)>& bindMaterial = {});
+
+    // Uploaded commands in draw order, and their DrawBounds. Compute shaders may write the command instance counts between draws.
+    [[nodiscard]] std::uint32_t commandBuffer() const { return _commandBuffer; }
+    [[nodiscard]] std::uint32_t boundsBuffer() const { return _boundsBuffer; }
+    [[nodiscard]] std::size_t commandCount() const { return _commands.size(); }
+
+    [[nodiscard]] const Stats& stats() const { return _stats; }
+    void resetFrameStats() { _stats = {}; }
+
+private:
+    struct PendingDraw
+    {
+        GeometryPool::Handle handle;
+        std::uint32_t materialIndex;
+        glm::mat4 model;
+        AABB bounds;
+    };
+
+    // Consecutive commands of the same block and material
+    struct Group
+    {
+        std::uint32_t block = 0;
+        std::uint32_t materialIndex = 0;
+        std::uint32_t firstCommand = 0;
+        std::uint32_t commandCount = 0;
+    };
+
+    void updateVertexArrays();
+    void releaseVertexArrays();
+
+    GeometryPool& _pool;
+    Usage _usage;
+
+    std::vector<PendingDraw> _pending;
+    std::vector<DrawElementsIndirectCommand> _commands;
+    std::vector<DrawData> _drawData;
+    std::vector<DrawBounds> _bounds;
+    std::vector<Group> _groups;
+
+    std::uint32_t _commandBuffer = 0;
+    std::uint32_t _drawDataBuffer = 0;
+    std::uint32_t _boundsBuffer = 0;
+    // 0, 1, 2, ... read through baseInstance
+    std::uint32_t _drawIdBuffer = 0;
+    std::size_t _drawIdCapacity = 0;
+
+    // One vertex array per pool block, with the draw id attribute
+    std::vector<std::uint32_t> _vertexArrays;
+    std::uint32_t _poolGeneration = 0;
+    // Pool generation the commands were built for
+    std::uint32_t _uploadGeneration = 0;
+
+    Stats _stats;
+};
+
+}
+
+#endif
@@ -0,0 +1,322 @@
+#include <learnopengl/occlusionbuffer.hpp>
+#include <learnopengl/mesh.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define LEARNOPENGL_OCCLUSION_SSE
+#    include <emmintrin.h>
+#endif
+
+namespace learnopengl {
+
+namespace {
+
+// Edge function a * x + b * y + c, positive inside a counter clockwise triangle
+struct Edge
+{
+    float a = 0.f;
+    float b = 0.f;
+    float c = 0.f;
+};
+
+Edge edge(const glm::vec3& from, const glm::vec3& to)
+{
+    const float a = from.y - to.y;
+    const float b = to.x - from.x;
+    return {a, b, -(a * from.x + b * from.y)};
+}
+
+}
+
+OcclusionBuffer::OcclusionBuffer(int width, int height) : _width((std::max(width, 4) + 3) & ~3), _height(std::max(height, 1))
+{
+    // Down to a single texel
+    const auto levelCount = std::size_t(std::bit_width(unsigned(std::max(_width, _height) - 1))) + 1;
+    _levels.resize(levelCount);
+    for(std::size_t level = 0; level < levelCount; ++level)
+        _levels[level].assign(std::size_t(levelWidth(level)) * std::size_t(levelHeight(level)), 0.f);
+}
+
+void OcclusionBuffer::clear(const glm::mat4& viewProjection, float near)
+{
+    _viewProjection = viewProjection;
+    _near = near;
+    _finished = false;
+    std::fill(_levels[0].begin(), _levels[0].end(), 0.f);
+    _stats = {};
+}
+
+void OcclusionBuffer::rasterize(const glm::mat4& model,
+    const glm::vec3* positions,
+    std::size_t stride,
+    std::size_t vertexCount,
+    std::span<const std::uint32_t> indices)
+{
+    rasterizeTriangles<true>(model, positions, stride, vertexCount, indices);
+}
+
+void OcclusionBuffer::rasterize(const Mesh& mesh, const glm::mat4& model)
+{
+    const auto& vertices = mesh.vertices();
+    if(vertices.empty())
+        return;
+    rasterizeTriangles<true>(model, &vertices[0].position, sizeof(Mesh::Vertex), vertices.size(), mesh.indices());
+}
+
+void OcclusionBuffer::rasterizeScalar(const glm::mat4& model,
+    const glm::vec3* positions,
+    std::size_t stride,
+    std::size_t vertexCount,
+    std::span<const std::uint32_t> indices)
+{
+    rasterizeTriangles<false>(model, positions, stride, vertexCount, indices);
+}
+
+template<bool Simd>
+void OcclusionBuffer::rasterizeTriangles(const glm::mat4& model,
+    const glm::vec3* positions,
+    std::size_t stride,
+    std::size_t vertexCount,
+    std::span<const std::uint32_t> indices)
+{
+    const auto matrix = _viewProjection * model;
+    _clipVertices.resize(vertexCount);
+    const auto* bytes = reinterpret_cast<const std::uint8_t*>(positions);
+    for(std::size_t i = 0; i < vertexCount; ++i)
+        _clipVertices[i] = matrix * glm::vec4(*reinterpret_cast<const glm::vec3*>(bytes + i * stride), 1.f);
+
+    const float halfWidth = float(_width) * 0.5f;
+    const float halfHeight = float(_height) * 0.5f;
+    const auto toScreen = [&](const glm::vec4& clip)
+    {
+        const float inverseW = 1.f / clip.w;
+        return ScreenVertex((clip.x * inverseW + 1.f) * halfWidth, (clip.y * inverseW + 1.f) * halfHeight, inverseW);
+    };
+
+    for(std::size_t i = 0; i + 2 < indices.size(); i += 3)
+    {
+        ++_stats.triangleCount;
+        if(indices[i] >= vertexCount || indices[i + 1] >= vertexCount || indices[i + 2] >= vertexCount)
+            continue;
+
+        const glm::vec4 triangle[3] = {_clipVertices[indices[i]], _clipVertices[indices[i + 1]], _clipVertices[indices[i + 2]]};
+        if(triangle[0].w >= _near && triangle[1].w >= _near && triangle[2].w >= _near)
+        {
+            rasterizeTriangle<Simd>(toScreen(triangle[0]), toScreen(triangle[1]), toScreen(triangle[2]));
+            continue;
+        }
+
+        // Clip against the near plane w = near, a triangle becomes a polygon of up to 4 vertices
+        glm::vec4 polygon[4];
+        int polygonSize = 0;
+        for(int vertex = 0; vertex < 3; ++vertex)
+        {
+            const auto& current = triangle[vertex];
+            const auto& next = triangle[(vertex + 1) % 3];
+            const float currentDistance = current.w - _near;
+            const float nextDistance = next.w - _near;
+            if(currentDistance >= 0.f)
+                polygon[polygonSize++] = current;
+            if((currentDistance >= 0.f) != (nextDistance >= 0.f))
+                polygon[polygonSize++] = current + (next - current) * (currentDistance / (currentDistance - nextDistance));
+        }
+        for(int vertex = 2; vertex < polygonSize; ++vertex)
+            rasterizeTriangle<Simd>(toScreen(polygon[0]), toScreen(polygon[vertex - 1]), toScreen(polygon[vertex]));
+    }
+}
+
+template<bool Simd>
+void OcclusionBuffer::rasterizeTriangle(ScreenVertex a, ScreenVertex b, ScreenVertex c)
+{
+    float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+    // Also rejects NaN
+    if(!(std::fabs(area) > 1e-6f))
+        return;
+    // Both orientations are occluders
+    if(area < 0.f)
+    {
+        std::swap(b, c);
+        area = -area;
+    }
+
+    // Pixels whose center is inside the bounds, clamped before the conversion to int
+    const float minX = std::clamp(std::min({a.x, b.x, c.x}), -1.f, float(_width));
+    const float maxX = std::clamp(std::max({a.x, b.x, c.x}), -1.f, float(_width));
+    const float minY = std::clamp(std::min({a.y, b.y, c.y}), -1.f, float(_height));
+    const float maxY = std::clamp(std::max({a.y, b.y, c.y}), -1.f, float(_height));
+    const int x0 = std::max(0, int(std::ceil(minX - 0.5f)));
+    const int x1 = std::min(_width - 1, int(std::floor(maxX - 0.5f)));
+    const int y0 = std::max(0, int(std::ceil(minY - 0.5f)));
+    const int y1 = std::min(_height - 1, int(std::floor(maxY - 0.5f)));
+    if(x0 > x1 || y0 > y1)
+        return;
+    ++_stats.rasterizedCount;
+
+    const Edge edges[3] = {edge(a, b), edge(b, c), edge(c, a)};
+    // 1 / w plane over the screen
+    const float depthX = ((b.z - a.z) * (c.y - a.y) - (c.z - a.z) * (b.y - a.y)) / area;
+    const float depthY = ((c.z - a.z) * (b.x - a.x) - (b.z - a.z) * (c.x - a.x)) / area;
+    const float depthC = a.z - depthX * a.x - depthY * a.y;
+
+    auto& depth = _levels[0];
+    for(int y = y0; y <= y1; ++y)
+    {
+        const float pixelY = float(y) + 0.5f;
+        const float row0 = edges[0].b * pixelY + edges[0].c;
+        const float row1 = edges[1].b * pixelY + edges[1].c;
+        const float row2 = edges[2].b * pixelY + edges[2].c;
+        const float rowDepth = depthY * pixelY + depthC;
+        float* row = depth.data() + std::size_t(y) * std::size_t(_width);
+
+        int x = x0;
+#ifdef LEARNOPENGL_OCCLUSION_SSE
+        if constexpr(Simd)
+        {
+            // 4 pixels from a multiple of 4, rows are a multiple of 4 wide. Lanes outside the bounds fail the edge tests.
+            const auto zero = _mm_setzero_ps();
+            const auto laneOffsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+            const auto edgeA0 = _mm_set1_ps(edges[0].a);
+            const auto edgeA1 = _mm_set1_ps(edges[1].a);
+            const auto edgeA2 = _mm_set1_ps(edges[2].a);
+            const auto edgeRow0 = _mm_set1_ps(row0);
+            const auto edgeRow1 = _mm_set1_ps(row1);
+            const auto edgeRow2 = _mm_set1_ps(row2);
+            const auto planeX = _mm_set1_ps(depthX);
+            const auto planeRow = _mm_set1_ps(rowDepth);
+            for(x = x0 & ~3; x <= x1; x += 4)
+            {
+                const auto pixelX = _mm_add_ps(_mm_set1_ps(float(x)), laneOffsets);
+                auto inside = _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edgeA0, pixelX), edgeRow0), zero);
+                inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edgeA1, pixelX), edgeRow1), zero));
+                inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edgeA2, pixelX), edgeRow2), zero));
+                if(!_mm_movemask_ps(inside))
+                    continue;
+
+                const auto triangleDepth = _mm_add_ps(_mm_mul_ps(planeX, pixelX), planeRow);
+                const auto stored = _mm_loadu_ps(row + x);
+                const auto nearest = _mm_max_ps(stored, triangleDepth);
+                _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, stored)));
+            }
+        }
+#endif
+
+        for(; x <= x1; ++x)
+        {
+            const float pixelX = float(x) + 0.5f;
+            if(edges[0].a * pixelX + row0 >= 0.f && edges[1].a * pixelX + row1 >= 0.f && edges[2].a * pixelX + row2 >= 0.f)
+                row[x] = std::max(row[x], depthX * pixelX + rowDepth);
+        }
+    }
+}
+
+void OcclusionBuffer::finish()
+{
+    // Farthest of the 2x2 texels below, the last row and column of odd levels cover a single one
+    for(std::size_t level = 1; level < _levels.size(); ++level)
+    {
+        const auto& source = _levels[level - 1];
+        auto& destination = _levels[level];
+        const int sourceWidth = levelWidth(level - 1);
+        const int sourceHeight = levelHeight(level - 1);
+        const int width = levelWidth(level);
+        const int height = levelHeight(level);
+        for(int y = 0; y < height; ++y)
+        {
+            const auto row0 = std::size_t(2 * y) * std::size_t(sourceWidth);
+            const auto row1 = std::size_t(std::min(2 * y + 1, sourceHeight - 1)) * std::size_t(sourceWidth);
+            for(int x = 0; x < width; ++x)
+            {
+                const auto column0 = std::size_t(2 * x);
+                const auto column1 = std::size_t(std::min(2 * x + 1, sourceWidth - 1));
+                destination[std::size_t(y) * std::size_t(width) + std::size_t(x)] =
+                    std::min({source[row0 + column0], source[row0 + column1], source[row1 + column0], source[row1 + column1]});
+            }
+        }
+    }
+    _finished = true;
+}
+
+bool OcclusionBuffer::occluded(const AABB& box) const
+{
+    if(!_finished || !box.valid())
+        return false;
+
+    // Screen rectangle and nearest 1 / w of the corners: w is linear over the box, its minimum is at a corner
+    float minX = float(_width);
+    float maxX = 0.f;
+    float minY = float(_height);
+    float maxY = 0.f;
+    float nearest = 0.f;
+    for(int corner = 0; corner < 8; ++corner)
+    {
+        const glm::vec3 position(
+            corner & 1 ? box.max.x : box.min.x, corner & 2 ? box.max.y : box.min.y, corner & 4 ? box.max.z : box.min.z);
+        const auto clip = _viewProjection * glm::vec4(position, 1.f);
+        if(clip.w < _near)
+            return false;
+
+        const float inverseW = 1.f / clip.w;
+        const float x = (clip.x * inverseW + 1.f) * 0.5f * float(_width);
+        const float y = (clip.y * inverseW + 1.f) * 0.5f * float(_height);
+        minX = std::min(minX, x);
+        maxX = std::max(maxX, x);
+        minY = std::min(minY, y);
+        maxY = std::max(maxY, y);
+        nearest = std::max(nearest, inverseW);
+    }
+    if(maxX < 0.f || maxY < 0.f || minX >= float(_width) || minY >= float(_height))
+        return false;
+
+    const int x0 = std::clamp(int(minX), 0, _width - 1);
+    const int x1 = std::clamp(int(maxX), 0, _width - 1);
+    const int y0 = std::clamp(int(minY), 0, _height - 1);
+    const int y1 = std::clamp(int(maxY), 0, _height - 1);
+
+    // Smallest level where the rectangle spans at most 2x2 texels
+    const auto span = unsigned(std::max(x1 - x0, y1 - y0));
+    auto level = std::size_t(std::max(int(std::bit_width(span)) - 1, 0));
+    if(((x1 >> level) - (x0 >> level)) > 1 || ((y1 >> level) - (y0 >> level)) > 1)
+        ++level;
+    level = std::min(level, _levels.size() - 1);
+
+    const auto& depth = _levels[level];
+    const auto width = std::size_t(levelWidth(level));
+    const auto left = std::size_t(x0 >> level);
+    const auto right = std::size_t(x1 >> level);
+    const auto bottom = std::size_t(y0 >> level);
+    const auto top = std::size_t(y1 >> level);
+    const float farthest =
+        std::min({depth[bottom * width + left], depth[bottom * width + right], depth[top * width + left], depth[top * width + right]});
+    return nearest < farthest;
+}
+
+std::size_t OcclusionBuffer::cull(const AABBArray& boxes, std::uint8_t* visible) const
+{
+    const auto* cx = boxes.centerX();
+    const auto* cy = boxes.centerY();
+    const auto* cz = boxes.centerZ();
+    const auto* ex = boxes.extentX();
+    const auto* ey = boxes.extentY();
+    const auto* ez = boxes.extentZ();
+
+    std::size_t occludedCount = 0;
+    for(std::size_t i = 0; i < boxes.size(); ++i)
+    {
+        if(!visible[i])
+            continue;
+
+        const glm::vec3 center(cx[i], cy[i], cz[i]);
+        const glm::vec3 extent(ex[i], ey[i], ez[i]);
+        if(occluded({center - extent, center + extent}))
+        {
+            visible[i] = 0;
+            ++occludedCount;
+        }
+    }
+    return occludedCount;
+}
+
+}
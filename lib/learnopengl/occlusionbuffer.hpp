@@ -0,0 +1,101 @@
+#ifndef __LEARNOPENGL_OCCLUSION_BUFFER_HPP__
+#define __LEARNOPENGL_OCCLUSION_BUFFER_HPP__
+
+#include <learnopengl/boundingvolume.hpp>
+
+#include <glm/vec4.hpp>
+#include <glm/mat4x4.hpp>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace learnopengl {
+
+class Mesh;
+
+// Software occlusion culling on the CPU. Occluder triangles are rasterized at low resolution into a depth buffer of 1 / w (larger
+// is nearer, linear in screen space, independent of the depth convention of the camera), reduced to a pyramid holding the farthest
+// depth of each texel (Hi-Z). A box is occluded when its nearest depth is behind the farthest depth of the at most 2x2 texels
+// of the level covering its screen rectangle. Pixels are rasterized 4 at a time with SSE (scalar fallback), rasterizeScalar is
+// the reference. The CPU counterpart of DepthPyramid and OcclusionCuller, without OpenGL and without their frame of latency.
+class OcclusionBuffer
+{
+public:
+    struct Stats
+    {
+        // Since clear
+        std::size_t triangleCount = 0;
+        // Triangles left after near plane clipping, in front and with an area
+        std::size_t rasterizedCount = 0;
+    };
+
+public:
+    // width is rounded up to a multiple of 4
+    explicit OcclusionBuffer(int width = 320, int height = 160);
+
+    // Start a frame seen through viewProjection, whose near plane is at near (view distance): geometry in front of it is clipped
+    void clear(const glm::mat4& viewProjection, float near);
+
+    // Rasterize the indexed triangles of vertexCount positions, stride bytes apart, transformed by model
+    void rasterize(const glm::mat4& model,
+        const glm::vec3* positions,
+        std::size_t stride,
+        std::size_t vertexCount,
+        std::span<const std::uint32_t> indices);
+    void rasterize(const Mesh& mesh, const glm::mat4& model);
+    // Reference implementation of rasterize, one pixel at a time
+    void rasterizeScalar(const glm::mat4& model,
+        const glm::vec3* positions,
+        std::size_t stride,
+        std::size_t vertexCount,
+        std::span<const std::uint32_t> indices);
+
+    // Build the pyramid once the occluders are rasterized, before testing
+    void finish();
+
+    // World space box behind the occluders. False when the box crosses the near plane or is off screen.
+    [[nodiscard]] bool occluded(const AABB& box) const;
+    // Clear the entries of visible whose box is occluded, boxes already not visible are skipped. Return the number of occluded boxes.
+    std::size_t cull(const AABBArray& boxes, std::uint8_t* visible) const;
+
+    [[nodiscard]] int width() const { return _width; }
+    [[nodiscard]] int height() const { return _height; }
+    [[nodiscard]] std::size_t levelCount() const { return _levels.size(); }
+    // 1 / w of the farthest occluder of each texel of a level, 0 without occluder; level 0 by rows from the bottom
+    [[nodiscard]] std::span<const float> depth(std::size_t level = 0) const { return _levels[level]; }
+    [[nodiscard]] int levelWidth(std::size_t level) const { return (_width + (1 << level) - 1) >> level; }
+    [[nodiscard]] int levelHeight(std::size_t level) const { return (_height + (1 << level) - 1) >> level; }
+
+    [[nodiscard]] const Stats& stats() const { return _stats; }
+
+private:
+    // Screen position, 1 / w
+    using ScreenVertex = glm::vec3;
+
+    template<bool Simd>
+    void rasterizeTriangles(const glm::mat4& model,
+        const glm::vec3* positions,
+        std::size_t stride,
+        std::size_t vertexCount,
+        std::span<const std::uint32_t> indices);
+    template<bool Simd>
+    void rasterizeTriangle(ScreenVertex a, ScreenVertex b, ScreenVertex c);
+
+    int _width = 0;
+    int _height = 0;
+    glm::mat4 _viewProjection = glm::mat4(1.f);
+    float _near = 0.f;
+    bool _finished = false;
+
+    // Level 0 is the rasterized depth buffer
+    std::vector<std::vector<float>> _levels;
+    // Clip space vertices of the last rasterize call
+    std::vector<glm::vec4> _clipVertices;
+
+    Stats _stats;
+};
+
+}
+
+#endif
@@ -0,0 +1,77 @@
+#include <learnopengl/occlusionculler.hpp>
+#include <learnopengl/depthpyramid.hpp>
+#include <learnopengl/multidrawbatch.hpp>
+#include <learnopengl/shader.hpp>
+
+#include <glad/glad.h>
+
+namespace learnopengl {
+
+namespace {
+
+// Same as occlusioncull.cs
+constexpr std::uint32_t GroupSize = 64;
+constexpr std::uint32_t CommandBinding = 0;
+constexpr std::uint32_t BoundsBinding = 1;
+constexpr std::uint32_t CounterBinding = 2;
+constexpr std::uint32_t DepthPyramidUnit = 0;
+
+}
+
+OcclusionCuller::OcclusionCuller(const DepthPyramid& pyramid) : _pyramid(pyramid)
+{
+    const std::uint32_t zero = 0;
+    glGenBuffers(GLsizei(_counterBuffers.size()), _counterBuffers.data());
+    for(const auto buffer: _counterBuffers)
+    {
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(zero), &zero, GL_DYNAMIC_READ);
+    }
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+OcclusionCuller::~OcclusionCuller() { glDeleteBuffers(GLsizei(_counterBuffers.size()), _counterBuffers.data()); }
+
+bool OcclusionCuller::supported() { return GLAD_GL_VERSION_4_3; }
+
+void OcclusionCuller::beginFrame()
+{
+    _frame = (_frame + 1) % _counterBuffers.size();
+
+    // Written 2 frames ago, usually done by now
+    std::uint32_t occludedCount = 0;
+    const std::uint32_t zero = 0;
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _counterBuffers[_frame]);
+    glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(occludedCount), &occludedCount);
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(zero), &zero);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    _stats = {_testedCounts[_frame], occludedCount};
+    _testedCounts[_frame] = 0;
+}
+
+void OcclusionCuller::cull(MultiDrawBatch& batch)
+{
+    const auto drawCount = batch.commandCount();
+    if(drawCount == 0)
+        return;
+    if(!_shader)
+        _shader = std::make_unique<Shader>("resources/shaders/occlusioncull.cs");
+
+    _shader->use();
+    _pyramid.bind(*_shader, DepthPyramidUnit);
+    _shader->setInt("drawCount", int(drawCount));
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, CommandBinding, batch.commandBuffer());
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, BoundsBinding, batch.boundsBuffer());
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, CounterBinding, _counterBuffers[_frame]);
+    glDispatchCompute(GLuint((drawCount + GroupSize - 1) / GroupSize), 1, 1);
+    // Instance counts are read by the indirect draws, the counter by beginFrame
+    glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, CounterBinding, 0);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, BoundsBinding, 0);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, CommandBinding, 0);
+    _testedCounts[_frame] += drawCount;
+}
+
+}
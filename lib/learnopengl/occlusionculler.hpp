@@ -0,0 +1,60 @@
+#ifndef __LEARNOPENGL_OCCLUSION_CULLER_HPP__
+#define __LEARNOPENGL_OCCLUSION_CULLER_HPP__
+
+#include <array>
+#include <cstdint>
+#include <memory>
+
+namespace learnopengl {
+
+class DepthPyramid;
+class MultiDrawBatch;
+class Shader;
+
+// GPU occlusion culling of the draws of a MultiDrawBatch (OpenGL 4.3): a compute shader (resources/shaders/occlusioncull.cs)
+// tests the bounds of every command against a DepthPyramid and writes its instance count, 0 when occluded, so the indirect draw
+// skips it without a read back. The pyramid holds the depth of the previous frame: objects it hides that became visible since
+// pop in a frame late. The occluded count is read back 2 frames later to not stall the pipeline.
+class OcclusionCuller
+{
+public:
+    struct Stats
+    {
+        // Of the frame before last, see beginFrame
+        std::size_t testedCount = 0;
+        std::size_t occludedCount = 0;
+    };
+
+public:
+    // pyramid must outlive the culler
+    explicit OcclusionCuller(const DepthPyramid& pyramid);
+    ~OcclusionCuller();
+
+    OcclusionCuller(const OcclusionCuller&) = delete;
+    OcclusionCuller& operator=(const OcclusionCuller&) = delete;
+
+    [[nodiscard]] static bool supported();
+
+    // Start a frame: stats takes the counts of the frame before last, whose counter is reused
+    void beginFrame();
+
+    // Cull the commands of batch, after upload and before draw. Draws without bounds are kept.
+    void cull(MultiDrawBatch& batch);
+
+    [[nodiscard]] const Stats& stats() const { return _stats; }
+
+private:
+    const DepthPyramid& _pyramid;
+    std::unique_ptr<Shader> _shader;
+
+    // Occluded count of the last 2 frames
+    std::array<std::uint32_t, 2> _counterBuffers = {};
+    std::array<std::size_t, 2> _testedCounts = {};
+    std::size_t _frame = 0;
+
+    Stats _stats;
+};
+
+}
+
+#endif
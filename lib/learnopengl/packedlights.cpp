@@ -0,0 +1,64 @@
+#include <learnopengl/packedlights.hpp>
+#include <learnopengl/frustum.hpp>
+#include <learnopengl/pointlight.hpp>
+#include <learnopengl/spotlight.hpp>
+
+namespace learnopengl {
+
+void PackedLights::clear()
+{
+    _data.clear();
+    _bounds.clear();
+    _cullVolumes.clear();
+}
+
+void PackedLights::add(const PointLight& light)
+{
+    const float range = light.range();
+
+    _data.emplace_back(light.position(), range);
+    _data.emplace_back(0.f, 0.f, 0.f, 0.f);
+    _data.emplace_back(light.ambient(), light.attenuationConstant());
+    _data.emplace_back(light.diffuse(), light.attenuationLinear());
+    _data.emplace_back(light.specular(), light.attenuationQuadratic());
+    _data.emplace_back(0.f);
+    _bounds.emplace_back(light.position(), range);
+    _cullVolumes.push_back({light.position(), glm::vec3(0.f, 0.f, -1.f), range, -1.f});
+}
+
+void PackedLights::add(const SpotLight& light)
+{
+    const auto cone = light.boundingCone();
+    _data.emplace_back(light.position(), cone.range);
+    _data.emplace_back(cone.direction, 1.f);
+    _data.emplace_back(light.ambient(), light.attenuationConstant());
+    _data.emplace_back(light.diffuse(), light.attenuationLinear());
+    _data.emplace_back(light.specular(), light.attenuationQuadratic());
+    _data.emplace_back(light.cutOff(), light.outerCutOff(), 0.f, 0.f);
+
+    const auto sphere = light.boundingSphere();
+    _bounds.emplace_back(sphere.center, sphere.radius);
+    // The ambient term is not limited to the cone
+    if(light.ambient() == glm::vec3(0.f))
+        _cullVolumes.push_back(cone);
+    else
+        _cullVolumes.push_back({light.position(), cone.direction, cone.range, -1.f});
+}
+
+std::size_t PackedLights::cull(const Frustum& frustum)
+{
+    _visibleData.clear();
+    _visibleBounds.clear();
+    for(std::size_t light = 0; light < _cullVolumes.size(); ++light)
+    {
+        if(!frustum.intersects(_cullVolumes[light]))
+            continue;
+
+        const auto texels = _data.begin() + std::ptrdiff_t(light * TexelsPerLight);
+        _visibleData.insert(_visibleData.end(), texels, texels + TexelsPerLight);
+        _visibleBounds.push_back(_bounds[light]);
+    }
+    return _cullVolumes.size() - _visibleBounds.size();
+}
+
+}
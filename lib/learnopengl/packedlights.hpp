@@ -0,0 +1,58 @@
+#ifndef __LEARNOPENGL_PACKED_LIGHTS_HPP__
+#define __LEARNOPENGL_PACKED_LIGHTS_HPP__
+
+#include <learnopengl/boundingvolume.hpp>
+
+#include <glm/vec4.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace learnopengl {
+
+class Frustum;
+class PointLight;
+class SpotLight;
+
+// Point and spot lights packed in RGBA32F texels, as resources/shaders/packedlights.glsl reads them from a texture buffer,
+// with the bounding sphere of each light and the volume it is frustum culled with.
+class PackedLights
+{
+public:
+    // position, range | direction, type (0 point, 1 spot) | ambient, constant | diffuse, linear | specular, quadratic | cutOff, outerCutOff
+    static constexpr std::uint32_t TexelsPerLight = 6;
+
+public:
+    void clear();
+    void add(const PointLight& light);
+    void add(const SpotLight& light);
+
+    [[nodiscard]] std::size_t size() const { return _cullVolumes.size(); }
+    [[nodiscard]] bool empty() const { return _cullVolumes.empty(); }
+
+    // Keep the lights reaching into the frustum in visibleData and visibleBounds, in order. Return the number of culled lights.
+    std::size_t cull(const Frustum& frustum);
+
+    // TexelsPerLight texels per light
+    [[nodiscard]] const std::vector<glm::vec4>& data() const { return _data; }
+    // World space bounding sphere (center, radius) of each light
+    [[nodiscard]] const std::vector<glm::vec4>& bounds() const { return _bounds; }
+
+    // Lights kept by the last cull
+    [[nodiscard]] const std::vector<glm::vec4>& visibleData() const { return _visibleData; }
+    [[nodiscard]] const std::vector<glm::vec4>& visibleBounds() const { return _visibleBounds; }
+    [[nodiscard]] std::size_t visibleCount() const { return _visibleBounds.size(); }
+
+private:
+    std::vector<glm::vec4> _data;
+    std::vector<glm::vec4> _bounds;
+    // Point lights as a cone of cosine -1 (their range sphere)
+    std::vector<BoundingCone> _cullVolumes;
+
+    std::vector<glm::vec4> _visibleData;
+    std::vector<glm::vec4> _visibleBounds;
+};
+
+}
+
+#endif
@@ -1,8 +1,13 @@
 #ifndef __LEARNOPENGL_POINT_LIGHT_HPP__
 #define __LEARNOPENGL_POINT_LIGHT_HPP__
 
+#include <learnopengl/boundingvolume.hpp>
+#include <learnopengl/lightrange.hpp>
+
 #include <glm/vec3.hpp>
 
+#include <algorithm>
+
 namespace learnopengl {
 
 class PointLight
@@ -15,7 +20,11 @@ public:
     constexpr void setAmbient(const glm::vec3& ambient) { _ambient = ambient; }
 
     [[nodiscard]] constexpr const glm::vec3& diffuse() const { return _diffuse; }
-    constexpr void setDiffuse(const glm::vec3& diffuse) { _diffuse = diffuse; }
+    constexpr void setDiffuse(const glm::vec3& diffuse)
+    {
+        _diffuse = diffuse;
+        _rangeDirty = true;
+    }
 
     [[nodiscard]] constexpr const glm::vec3& specular() const { return _specular; }
     constexpr void setSpecular(const glm::vec3& specular) { _specular = specular; }
@@ -31,6 +40,31 @@ public:
         _attenuationConstant = constant;
         _attenuationLinear = linear;
         _attenuationQuadratic = quadratic;
+        _rangeDirty = true;
+    }
+
+    // Distance at which the brightest diffuse component falls under the threshold, cached until attenuation or diffuse change
+    [[nodiscard]] float range() const
+    {
+        if(_rangeDirty)
+        {
+            _range = lightRange(_attenuationConstant,
+                _attenuationLinear,
+                _attenuationQuadratic,
+                std::max({_diffuse.r, _diffuse.g, _diffuse.b}),
+                _rangeThreshold);
+            _rangeDirty = false;
+        }
+        return _range;
+    }
+
+    [[nodiscard]] BoundingSphere boundingSphere() const { return {_position, range()}; }
+
+    [[nodiscard]] constexpr float rangeThreshold() const { return _rangeThreshold; }
+    constexpr void setRangeThreshold(float threshold)
+    {
+        _rangeThreshold = threshold;
+        _rangeDirty = true;
     }
 
 private:
@@ -42,6 +76,11 @@ private:
     float _attenuationConstant = 1.f;
     float _attenuationLinear = 0.045f;
     float _attenuationQuadratic = 0.0075f;
+
+    float _rangeThreshold = LightRangeThreshold;
+    // Cache of range(), not thread safe on first read after a change
+    mutable float _range = 0.f;
+    mutable bool _rangeDirty = true;
 };
 
 }
@@ -0,0 +1,360 @@
+#include <learnopengl/postprocess.hpp>
+#include <learnopengl/frameprofiler.hpp>
+#include <learnopengl/shader.hpp>
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace learnopengl {
+
+namespace {
+
+// Same as luminancehistogram.cs
+constexpr std::uint32_t HistogramGroupSize = 16;
+constexpr std::uint32_t HistogramBinding = 0;
+
+std::uint32_t createTexture(GLenum internalFormat, GLenum format, GLenum type, int width, int height, GLenum filter)
+{
+    std::uint32_t texture = 0;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GLint(internalFormat), width, height, 0, format, type, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GLint(filter));
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GLint(filter));
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return texture;
+}
+
+std::uint32_t createFramebuffer(std::uint32_t colorTexture)
+{
+    std::uint32_t framebuffer = 0;
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, colorTexture, 0);
+    return framebuffer;
+}
+
+}
+
+PostProcess::PostProcess(int width, int height) : PostProcess(width, height, Settings{}) {}
+
+PostProcess::PostProcess(int width, int height, const Settings& settings) :
+    _settings(settings), _width(std::max(width, 1)), _height(std::max(height, 1))
+{
+    _downsampleShader = std::make_unique<Shader>("resources/shaders/deferredfullscreen.vs", "resources/shaders/bloomdownsample.fs");
+    _upsampleShader = std::make_unique<Shader>("resources/shaders/deferredfullscreen.vs", "resources/shaders/bloomupsample.fs");
+    _gaussianShader = std::make_unique<Shader>("resources/shaders/deferredfullscreen.vs", "resources/shaders/bloomgaussian.fs");
+    _toneMapShader = std::make_unique<Shader>("resources/shaders/deferredfullscreen.vs", "resources/shaders/tonemap.fs");
+    glGenVertexArrays(1, &_fullScreenVao);
+
+    // Adapted luminance is read by the tone mapping even without auto exposure
+    const float luminance = 1.f;
+    glGenTextures(1, &_luminanceTexture);
+    glBindTexture(GL_TEXTURE_2D, _luminanceTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, 1, 1, 0, GL_RED, GL_FLOAT, &luminance);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    if(autoExposureSupported())
+    {
+        _histogramShader = std::make_unique<Shader>("resources/shaders/luminancehistogram.cs");
+        _averageShader = std::make_unique<Shader>("resources/shaders/luminanceaverage.cs");
+        const std::vector<std::uint32_t> bins(HistogramBinCount, 0);
+        glGenBuffers(1, &_histogramBuffer);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, _histogramBuffer);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, GLsizeiptr(bins.size() * sizeof(std::uint32_t)), bins.data(), GL_DYNAMIC_COPY);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    }
+
+    allocate();
+}
+
+PostProcess::~PostProcess()
+{
+    release();
+    if(_histogramBuffer)
+        glDeleteBuffers(1, &_histogramBuffer);
+    glDeleteTextures(1, &_luminanceTexture);
+    glDeleteVertexArrays(1, &_fullScreenVao);
+}
+
+bool PostProcess::autoExposureSupported() { return GLAD_GL_VERSION_4_3; }
+
+void PostProcess::resize(int width, int height)
+{
+    width = std::max(width, 1);
+    height = std::max(height, 1);
+    if(width == _width && height == _height)
+        return;
+    release();
+    _width = width;
+    _height = height;
+    allocate();
+}
+
+void PostProcess::setAutoExposure(bool autoExposure)
+{
+    if(autoExposure && !_settings.autoExposure)
+        _resetAdaptation = true;
+    _settings.autoExposure = autoExposure;
+}
+
+void PostProcess::allocate()
+{
+    GLint previousFramebuffer = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
+
+    _sceneTexture = createTexture(GL_RGBA16F, GL_RGBA, GL_HALF_FLOAT, _width, _height, GL_LINEAR);
+    _depthTexture = createTexture(GL_DEPTH_COMPONENT32F, GL_DEPTH_COMPONENT, GL_FLOAT, _width, _height, GL_NEAREST);
+    _framebuffer = createFramebuffer(_sceneTexture);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, _depthTexture, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, GLuint(previousFramebuffer));
+}
+
+void PostProcess::release()
+{
+    releaseBloom();
+    if(_framebuffer)
+        glDeleteFramebuffers(1, &_framebuffer);
+    const std::uint32_t textures[] = {_sceneTexture, _depthTexture};
+    glDeleteTextures(2, textures);
+    _framebuffer = 0;
+    _sceneTexture = 0;
+    _depthTexture = 0;
+}
+
+void PostProcess::allocateBloom()
+{
+    releaseBloom();
+    _bloomMode = _settings.bloom;
+
+    GLint previousFramebuffer = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
+
+    if(_bloomMode == Bloom::MipChain)
+    {
+        // Bloom needs no alpha nor sign: 4 bytes per pixel instead of 8
+        int width = _width;
+        int height = _height;
+        for(std::uint32_t level = 0; level < _settings.bloomLevelCount && (width > 1 || height > 1); ++level)
+        {
+            width = std::max(width / 2, 1);
+            height = std::max(height / 2, 1);
+            const auto texture = createTexture(GL_R11F_G11F_B10F, GL_RGB, GL_FLOAT, width, height, GL_LINEAR);
+            _bloomTargets.push_back({texture, createFramebuffer(texture), width, height});
+        }
+    }
+    else if(_bloomMode == Bloom::Gaussian)
+    {
+        for(int i = 0; i < 2; ++i)
+        {
+            const auto texture = createTexture(GL_RGBA16F, GL_RGBA, GL_HALF_FLOAT, _width, _height, GL_LINEAR);
+            _bloomTargets.push_back({texture, createFramebuffer(texture), _width, _height});
+        }
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, GLuint(previousFramebuffer));
+}
+
+void PostProcess::releaseBloom()
+{
+    for(const auto& target: _bloomTargets)
+    {
+        glDeleteFramebuffers(1, &target.framebuffer);
+        glDeleteTextures(1, &target.texture);
+    }
+    _bloomTargets.clear();
+    _bloomMode = Bloom::Off;
+}
+
+void PostProcess::beginScene() const
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, _framebuffer);
+    glViewport(0, 0, _width, _height);
+    const GLfloat black[] = {0.f, 0.f, 0.f, 1.f};
+    glClearBufferfv(GL_COLOR, 0, black);
+    glDepthMask(GL_TRUE);
+    glClear(GL_DEPTH_BUFFER_BIT);
+}
+
+void PostProcess::apply(std::uint32_t framebuffer, float deltaTime, FrameProfiler* profiler)
+{
+    const bool depthTest = glIsEnabled(GL_DEPTH_TEST);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_BLEND);
+    glBindVertexArray(_fullScreenVao);
+
+    if(_settings.bloom != _bloomMode)
+        allocateBloom();
+    if(_bloomMode != Bloom::Off)
+    {
+        if(profiler)
+            profiler->beginScope(BloomScope);
+        if(_bloomMode == Bloom::MipChain)
+            drawMipChainBloom();
+        else
+            drawGaussianBloom();
+        if(profiler)
+            profiler->endScope();
+    }
+
+    const bool autoExposure = _settings.autoExposure && autoExposureSupported();
+    if(autoExposure)
+    {
+        if(profiler)
+            profiler->beginScope(ExposureScope);
+        updateExposure(deltaTime);
+        if(profiler)
+            profiler->endScope();
+    }
+
+    if(profiler)
+        profiler->beginScope(ToneMappingScope);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glViewport(0, 0, _width, _height);
+    _toneMapShader->use();
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, _sceneTexture);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, bloomTexture());
+    glActiveTexture(GL_TEXTURE2);
+    glBindTexture(GL_TEXTURE_2D, _luminanceTexture);
+    glActiveTexture(GL_TEXTURE0);
+    _toneMapShader->setInt("scene", 0);
+    _toneMapShader->setInt("bloom", 1);
+    _toneMapShader->setInt("adaptedLuminance", 2);
+    _toneMapShader->setBool("bloomEnabled", _bloomMode != Bloom::Off);
+    _toneMapShader->setFloat("bloomStrength", _settings.bloomStrength);
+    _toneMapShader->setBool("autoExposure", autoExposure);
+    _toneMapShader->setFloat("exposure", _settings.exposure);
+    drawFullScreen();
+    if(profiler)
+        profiler->endScope();
+
+    glBindVertexArray(0);
+    if(depthTest)
+        glEnable(GL_DEPTH_TEST);
+}
+
+void PostProcess::drawMipChainBloom()
+{
+    // Down the chain from the scene
+    _downsampleShader->use();
+    _downsampleShader->setInt("source", 0);
+    _downsampleShader->setFloat("threshold", _settings.bloomThreshold);
+    glActiveTexture(GL_TEXTURE0);
+    for(std::size_t level = 0; level < _bloomTargets.size(); ++level)
+    {
+        const auto& target = _bloomTargets[level];
+        glBindFramebuffer(GL_FRAMEBUFFER, target.framebuffer);
+        glViewport(0, 0, target.width, target.height);
+        glBindTexture(GL_TEXTURE_2D, level == 0 ? _sceneTexture : _bloomTargets[level - 1].texture);
+        _downsampleShader->setVec2("inverseDestinationSize", 1.f / float(target.width), 1.f / float(target.height));
+        _downsampleShader->setBool("firstLevel", level == 0);
+        drawFullScreen();
+    }
+
+    // Back up, each level adds the blurred smaller one to its own downsample
+    _upsampleShader->use();
+    _upsampleShader->setInt("source", 0);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE);
+    glBlendEquation(GL_FUNC_ADD);
+    for(std::size_t level = _bloomTargets.size() - 1; level > 0; --level)
+    {
+        const auto& target = _bloomTargets[level - 1];
+        glBindFramebuffer(GL_FRAMEBUFFER, target.framebuffer);
+        glViewport(0, 0, target.width, target.height);
+        glBindTexture(GL_TEXTURE_2D, _bloomTargets[level].texture);
+        _upsampleShader->setVec2("inverseDestinationSize", 1.f / float(target.width), 1.f / float(target.height));
+        drawFullScreen();
+    }
+    glDisable(GL_BLEND);
+}
+
+void PostProcess::drawGaussianBloom()
+{
+    _gaussianShader->use();
+    _gaussianShader->setInt("source", 0);
+    _gaussianShader->setFloat("threshold", _settings.bloomThreshold);
+    glActiveTexture(GL_TEXTURE0);
+    glViewport(0, 0, _width, _height);
+
+    // Ping-pong between the 2 targets, the first pass reads the scene
+    const auto passCount = std::max<std::uint32_t>(_settings.gaussianPassCount, 1);
+    for(std::uint32_t pass = 0; pass < passCount; ++pass)
+    {
+        const auto destination = std::size_t(pass % 2);
+        glBindFramebuffer(GL_FRAMEBUFFER, _bloomTargets[destination].framebuffer);
+        glBindTexture(GL_TEXTURE_2D, pass == 0 ? _sceneTexture : _bloomTargets[1 - destination].texture);
+        _gaussianShader->setBool("horizontal", pass % 2 == 0);
+        _gaussianShader->setBool("firstPass", pass == 0);
+        drawFullScreen();
+        _gaussianResult = destination;
+    }
+}
+
+void PostProcess::updateExposure(float deltaTime)
+{
+    const float logRange = std::max(_settings.maxLogLuminance - _settings.minLogLuminance, 1e-3f);
+
+    _histogramShader->use();
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, _sceneTexture);
+    _histogramShader->setInt("scene", 0);
+    _histogramShader->setFloat("minLogLuminance", _settings.minLogLuminance);
+    _histogramShader->setFloat("inverseLogRange", 1.f / logRange);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, HistogramBinding, _histogramBuffer);
+    glDispatchCompute(GLuint((_width + int(HistogramGroupSize) - 1) / int(HistogramGroupSize)),
+        GLuint((_height + int(HistogramGroupSize) - 1) / int(HistogramGroupSize)),
+        1);
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+    // A single group averages the bins, clears them for the next frame and adapts the luminance
+    _averageShader->use();
+    _averageShader->setFloat("minLogLuminance", _settings.minLogLuminance);
+    _averageShader->setFloat("logRange", logRange);
+    _averageShader->setInt("pixelCount", _width * _height);
+    const float adaptation = _resetAdaptation ? 1.f : 1.f - std::exp(-std::max(deltaTime, 0.f) * _settings.adaptationRate);
+    _averageShader->setFloat("adaptation", adaptation);
+    _averageShader->setInt("adaptedLuminance", 0);
+    glBindImageTexture(0, _luminanceTexture, 0, GL_FALSE, 0, GL_READ_WRITE, GL_R32F);
+    glDispatchCompute(1, 1, 1);
+    glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT | GL_TEXTURE_UPDATE_BARRIER_BIT);
+    glBindImageTexture(0, 0, 0, GL_FALSE, 0, GL_READ_WRITE, GL_R32F);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, HistogramBinding, 0);
+    _resetAdaptation = false;
+}
+
+void PostProcess::drawFullScreen() const { glDrawArrays(GL_TRIANGLES, 0, 3); }
+
+std::uint32_t PostProcess::bloomTexture() const
+{
+    if(_bloomTargets.empty())
+        return 0;
+    return _bloomMode == Bloom::MipChain ? _bloomTargets.front().texture : _bloomTargets[_gaussianResult].texture;
+}
+
+std::size_t PostProcess::bloomBytes() const
+{
+    const std::size_t bytesPerPixel = _bloomMode == Bloom::MipChain ? 4 : 8;
+    std::size_t bytes = 0;
+    for(const auto& target: _bloomTargets) bytes += std::size_t(target.width) * std::size_t(target.height) * bytesPerPixel;
+    return bytes;
+}
+
+float PostProcess::readAdaptedLuminance() const
+{
+    float luminance = 0.f;
+    glBindTexture(GL_TEXTURE_2D, _luminanceTexture);
+    glGetTexImage(GL_TEXTURE_2D, 0, GL_RED, GL_FLOAT, &luminance);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return luminance;
+}
+
+}
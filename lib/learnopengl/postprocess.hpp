@@ -0,0 +1,149 @@
+#ifndef __LEARNOPENGL_POST_PROCESS_HPP__
+#define __LEARNOPENGL_POST_PROCESS_HPP__
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace learnopengl {
+
+class FrameProfiler;
+class Shader;
+
+// HDR post processing: the scene is drawn into an RGBA16F target with a depth texture, bloom spreads its bright parts and tone
+// mapping (ACES fit) brings it back to display range with gamma correction.
+// Bloom runs down a chain of targets from half resolution: a 13 taps downsample per level, the first one weighting its 2x2 groups
+// by luminance (Karis average) against fireflies, then a 3x3 tent upsample adding each level into the next larger one.
+// The full resolution ping-pong gaussian blur of the LearnOpenGL chapter is kept as reference.
+// Auto exposure (OpenGL 4.3) builds a 256 bins histogram of the scene log luminance with a compute shader, averages it and adapts
+// to it over time on the GPU, without read back.
+class PostProcess
+{
+public:
+    enum class Bloom
+    {
+        Off,
+        MipChain,
+        // 9 taps separable blur at full resolution, the chapter implementation
+        Gaussian,
+    };
+
+    struct Settings
+    {
+        Bloom bloom = Bloom::MipChain;
+        // Levels of the chain, the first at half resolution, fewer when the target gets to a pixel
+        std::uint32_t bloomLevelCount = 6;
+        // Horizontal and vertical passes of the gaussian bloom
+        std::uint32_t gaussianPassCount = 10;
+        // Luminance below is left out of the bloom, 0 blooms everything
+        float bloomThreshold = 0.f;
+        // Weight of the bloom mixed with the scene
+        float bloomStrength = 0.04f;
+        // Scale the average luminance to middle gray, exposure compensates then. Fixed exposure without OpenGL 4.3.
+        bool autoExposure = true;
+        float exposure = 1.f;
+        // log2 luminance range of the histogram, darker pixels are left out of the average
+        float minLogLuminance = -10.f;
+        float maxLogLuminance = 6.f;
+        // Rate per second of the exponential adaptation to the average luminance
+        float adaptationRate = 1.5f;
+    };
+
+    static constexpr std::uint32_t HistogramBinCount = 256;
+
+    // Profiler scopes of the stages of apply
+    static constexpr const char* BloomScope = "bloom";
+    static constexpr const char* ExposureScope = "exposure";
+    static constexpr const char* ToneMappingScope = "tone mapping";
+
+public:
+    PostProcess(int width, int height, const Settings& settings);
+    PostProcess(int width, int height);
+    ~PostProcess();
+
+    PostProcess(const PostProcess&) = delete;
+    PostProcess& operator=(const PostProcess&) = delete;
+
+    [[nodiscard]] static bool autoExposureSupported();
+
+    // Reallocate targets when the size changed
+    void resize(int width, int height);
+
+    // Bind the scene framebuffer and its viewport, clear color to black and depth.
+    // The depth state (applyDepthState) is the one of the caller.
+    void beginScene() const;
+    // Bloom, exposure and tone mapping of the scene into framebuffer (e.g. defaultFramebuffer()) of the same size, left bound.
+    // deltaTime in seconds drives the exposure adaptation. Each stage is a scope of profiler.
+    // Depth test is restored, blending is left off.
+    void apply(std::uint32_t framebuffer, float deltaTime, FrameProfiler* profiler = nullptr);
+
+    [[nodiscard]] const Settings& settings() const { return _settings; }
+    void setBloom(Bloom bloom) { _settings.bloom = bloom; }
+    void setAutoExposure(bool autoExposure);
+    void setExposure(float exposure) { _settings.exposure = exposure; }
+
+    [[nodiscard]] int width() const { return _width; }
+    [[nodiscard]] int height() const { return _height; }
+    [[nodiscard]] std::uint32_t framebuffer() const { return _framebuffer; }
+    [[nodiscard]] std::uint32_t sceneTexture() const { return _sceneTexture; }
+    [[nodiscard]] std::uint32_t depthTexture() const { return _depthTexture; }
+    // Bloom of the last apply, 0 without
+    [[nodiscard]] std::uint32_t bloomTexture() const;
+    // Bytes of the bloom targets of the current mode
+    [[nodiscard]] std::size_t bloomBytes() const;
+
+    // Adapted average luminance of the last apply, read back from the GPU for validation
+    [[nodiscard]] float readAdaptedLuminance() const;
+
+private:
+    // Color target with its framebuffer
+    struct Target
+    {
+        std::uint32_t texture = 0;
+        std::uint32_t framebuffer = 0;
+        int width = 0;
+        int height = 0;
+    };
+
+    void allocate();
+    void release();
+    void allocateBloom();
+    void releaseBloom();
+
+    void drawMipChainBloom();
+    void drawGaussianBloom();
+    void updateExposure(float deltaTime);
+    void drawFullScreen() const;
+
+    Settings _settings;
+    int _width = 0;
+    int _height = 0;
+
+    std::uint32_t _framebuffer = 0;
+    std::uint32_t _sceneTexture = 0;
+    std::uint32_t _depthTexture = 0;
+
+    // Mip chain levels or the 2 gaussian ping-pong targets, for _bloomMode
+    std::vector<Target> _bloomTargets;
+    Bloom _bloomMode = Bloom::Off;
+    // Gaussian target holding the last result
+    std::size_t _gaussianResult = 0;
+
+    // Histogram storage buffer and 1x1 R32F adapted luminance
+    std::uint32_t _histogramBuffer = 0;
+    std::uint32_t _luminanceTexture = 0;
+    bool _resetAdaptation = true;
+
+    std::unique_ptr<Shader> _downsampleShader;
+    std::unique_ptr<Shader> _upsampleShader;
+    std::unique_ptr<Shader> _gaussianShader;
+    std::unique_ptr<Shader> _toneMapShader;
+    std::unique_ptr<Shader> _histogramShader;
+    std::unique_ptr<Shader> _averageShader;
+    // Empty, the full screen triangle comes from gl_VertexID
+    std::uint32_t _fullScreenVao = 0;
+};
+
+}
+
+#endif
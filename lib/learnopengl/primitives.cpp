@@ -0,0 +1,152 @@
+#include <learnopengl/primitives.hpp>
+
+#include <glm/gtc/constants.hpp>
+#include <glm/geometric.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace learnopengl {
+
+MeshData createCube()
+{
+    MeshData cube;
+    cube.vertices.reserve(24);
+    cube.indices.reserve(36);
+
+    for(int axis = 0; axis < 3; ++axis)
+    {
+        for(const float side: {-1.f, 1.f})
+        {
+            glm::vec3 normal(0.f);
+            normal[axis] = side;
+            // u cross v is the face normal, so faces are counter clockwise seen from outside
+            glm::vec3 u(0.f);
+            glm::vec3 v(0.f);
+            u[(axis + 1) % 3] = 0.5f * side;
+            v[(axis + 2) % 3] = 0.5f;
+
+            const auto first = std::uint32_t(cube.vertices.size());
+            const auto center = normal * 0.5f;
+            cube.vertices.push_back({center - u - v, normal, {0.f, 0.f}});
+            cube.vertices.push_back({center + u - v, normal, {1.f, 0.f}});
+            cube.vertices.push_back({center + u + v, normal, {1.f, 1.f}});
+            cube.vertices.push_back({center - u + v, normal, {0.f, 1.f}});
+            for(const std::uint32_t index: {0u, 1u, 2u, 0u, 2u, 3u}) cube.indices.push_back(first + index);
+        }
+    }
+
+    return cube;
+}
+
+MeshData createSphere(std::uint32_t segments, std::uint32_t rings)
+{
+    segments = std::max(segments, 3u);
+    rings = std::max(rings, 2u);
+
+    MeshData sphere;
+    sphere.vertices.reserve((rings + 1) * (segments + 1));
+    sphere.indices.reserve(rings * segments * 6);
+
+    // Seam vertices are duplicated for the texture coordinates
+    for(std::uint32_t ring = 0; ring <= rings; ++ring)
+    {
+        const float v = float(ring) / float(rings);
+        const float theta = v * glm::pi<float>();
+        for(std::uint32_t segment = 0; segment <= segments; ++segment)
+        {
+            const float u = float(segment) / float(segments);
+            const float phi = u * 2.f * glm::pi<float>();
+            const glm::vec3 normal(std::sin(theta) * std::cos(phi), std::cos(theta), -std::sin(theta) * std::sin(phi));
+            sphere.vertices.push_back({normal, normal, {u, 1.f - v}});
+        }
+    }
+
+    // Counter clockwise seen from outside, degenerate triangles at the poles are skipped
+    const auto row = segments + 1;
+    for(std::uint32_t ring = 0; ring < rings; ++ring)
+    {
+        for(std::uint32_t segment = 0; segment < segments; ++segment)
+        {
+            const auto topLeft = ring * row + segment;
+            const auto bottomLeft = topLeft + row;
+            if(ring != 0)
+            {
+                for(const auto index: {topLeft, bottomLeft, topLeft + 1}) sphere.indices.push_back(index);
+            }
+            if(ring != rings - 1)
+            {
+                for(const auto index: {topLeft + 1, bottomLeft, bottomLeft + 1}) sphere.indices.push_back(index);
+            }
+        }
+    }
+
+    return sphere;
+}
+
+float sphereInscribedRadius(std::uint32_t segments, std::uint32_t rings)
+{
+    segments = std::max(segments, 3u);
+    rings = std::max(rings, 2u);
+    // A face spans 2 pi / segments around the axis and pi / rings from pole to pole
+    return std::cos(glm::pi<float>() / float(segments)) * std::cos(glm::pi<float>() / (2.f * float(rings)));
+}
+
+MeshData createRock(std::uint32_t seed, std::uint32_t segments, std::uint32_t rings)
+{
+    segments = std::max(segments, 3u);
+    rings = std::max(rings, 2u);
+    auto rock = createSphere(segments, rings);
+
+    // Flattened caps around random directions
+    constexpr int DentCount = 7;
+    std::mt19937 random(seed);
+    std::normal_distribution<float> gaussian;
+    std::uniform_real_distribution<float> depth(0.1f, 0.3f);
+    glm::vec3 dentDirections[DentCount];
+    float dentDepths[DentCount];
+    for(int dent = 0; dent < DentCount; ++dent)
+    {
+        dentDirections[dent] = glm::normalize(glm::vec3(gaussian(random), gaussian(random), gaussian(random)) + glm::vec3(1e-6f));
+        dentDepths[dent] = depth(random);
+    }
+    for(auto& vertex: rock.vertices)
+    {
+        float radius = 1.f;
+        for(int dent = 0; dent < DentCount; ++dent)
+        {
+            const float alignment = std::max(glm::dot(vertex.normal, dentDirections[dent]), 0.f);
+            radius -= dentDepths[dent] * alignment * alignment * alignment;
+        }
+        vertex.position = vertex.normal * std::max(radius, 0.3f);
+    }
+
+    // Face normals summed per position: seam and pole vertices share one
+    const auto row = segments + 1;
+    const auto shared = [&](std::uint32_t index)
+    {
+        const auto ring = index / row;
+        if(ring == 0)
+            return 0u;
+        if(ring == rings)
+            return rings * row;
+        return ring * row + index % row % segments;
+    };
+    std::vector<glm::vec3> normals(rock.vertices.size(), glm::vec3(0.f));
+    for(std::size_t i = 0; i < rock.indices.size(); i += 3)
+    {
+        const auto& a = rock.vertices[rock.indices[i]].position;
+        const auto& b = rock.vertices[rock.indices[i + 1]].position;
+        const auto& c = rock.vertices[rock.indices[i + 2]].position;
+        // Area weighted
+        const auto normal = glm::cross(b - a, c - a);
+        for(std::size_t corner = 0; corner < 3; ++corner) normals[shared(rock.indices[i + corner])] += normal;
+    }
+    for(std::uint32_t index = 0; index < rock.vertices.size(); ++index)
+        rock.vertices[index].normal = glm::normalize(normals[shared(index)]);
+
+    return rock;
+}
+
+}
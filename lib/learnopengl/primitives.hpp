@@ -0,0 +1,32 @@
+#ifndef __LEARNOPENGL_PRIMITIVES_HPP__
+#define __LEARNOPENGL_PRIMITIVES_HPP__
+
+#include <learnopengl/mesh.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace learnopengl {
+
+// Vertices and indices ready to build a Mesh
+struct MeshData
+{
+    std::vector<Mesh::Vertex> vertices;
+    std::vector<std::uint32_t> indices;
+};
+
+// Unit cube centered on origin, 4 vertices per face with face normal and [0, 1] texture coordinates
+MeshData createCube();
+
+// Unit radius UV sphere centered on origin, rings from pole to pole and segments around the y axis (at least 2 and 3).
+// Vertices are on the sphere: faces cut inside it, by a factor of sphereInscribedRadius.
+MeshData createSphere(std::uint32_t segments = 16, std::uint32_t rings = 8);
+// Smallest distance from the center to the faces of createSphere(segments, rings)
+[[nodiscard]] float sphereInscribedRadius(std::uint32_t segments, std::uint32_t rings);
+
+// Rock of radius up to 1: createSphere(segments, rings) dented along random directions drawn from seed, with smooth normals
+MeshData createRock(std::uint32_t seed, std::uint32_t segments = 12, std::uint32_t rings = 8);
+
+}
+
+#endif
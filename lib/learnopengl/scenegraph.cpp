@@ -0,0 +1,85 @@
+#include <learnopengl/scenegraph.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+namespace learnopengl {
+
+SceneGraph::NodeIndex SceneGraph::addNode(NodeIndex parent, const glm::mat4& localMatrix)
+{
+    const auto node = NodeIndex(size());
+    // Subtree must stay contiguous, so the node can only be appended to the last opened subtree
+    assert(parent == InvalidNode || _subtreeEnds[parent] == node);
+
+    _parents.push_back(parent);
+    _subtreeEnds.push_back(node + 1);
+    _localMatrices.push_back(localMatrix);
+    _worldMatrices.push_back(localMatrix);
+    _dirty.push_back(1);
+
+    for(auto ancestor = parent; ancestor != InvalidNode; ancestor = _parents[ancestor]) _subtreeEnds[ancestor] = node + 1;
+
+    _firstDirty = std::min(_firstDirty, node);
+
+    return node;
+}
+
+void SceneGraph::reserve(std::size_t nodeCount)
+{
+    _parents.reserve(nodeCount);
+    _subtreeEnds.reserve(nodeCount);
+    _localMatrices.reserve(nodeCount);
+    _worldMatrices.reserve(nodeCount);
+    _dirty.reserve(nodeCount);
+}
+
+void SceneGraph::clear()
+{
+    _parents.clear();
+    _subtreeEnds.clear();
+    _localMatrices.clear();
+    _worldMatrices.clear();
+    _dirty.clear();
+    _firstDirty = 0;
+}
+
+void SceneGraph::setLocalMatrix(NodeIndex node, const glm::mat4& localMatrix)
+{
+    _localMatrices[node] = localMatrix;
+    _dirty[node] = 1;
+    _firstDirty = std::min(_firstDirty, node);
+}
+
+std::size_t SceneGraph::updateWorldMatrices()
+{
+    const auto count = NodeIndex(size());
+    std::size_t updated = 0;
+
+    NodeIndex node = _firstDirty;
+    while(node < count)
+    {
+        if(!_dirty[node])
+        {
+            ++node;
+            continue;
+        }
+
+        // Every node of a dirty subtree must be recomputed. Parents are always visited before their children.
+        const auto end = _subtreeEnds[node];
+        for(auto child = node; child < end; ++child)
+        {
+            const auto parent = _parents[child];
+            _worldMatrices[child] = parent != InvalidNode ? _worldMatrices[parent] * _localMatrices[child] : _localMatrices[child];
+            _dirty[child] = 0;
+        }
+
+        updated += std::size_t(end - node);
+        node = end;
+    }
+
+    _firstDirty = count;
+
+    return updated;
+}
+
+}
@@ -0,0 +1,59 @@
+#ifndef __LEARNOPENGL_SCENE_GRAPH_HPP__
+#define __LEARNOPENGL_SCENE_GRAPH_HPP__
+
+#include <glm/mat4x4.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace learnopengl {
+
+// Flattened scene graph.
+// Nodes are stored in depth first order: a parent index is always lower than its children indices,
+// and a whole subtree is the contiguous range [node, subtreeEnd(node)).
+// Each attribute is stored in its own array (parent, subtree end, local, world, dirty) to keep the world update a linear pass.
+class SceneGraph
+{
+public:
+    using NodeIndex = std::int32_t;
+    static constexpr NodeIndex InvalidNode = -1;
+
+public:
+    // Append a node. parent must be InvalidNode (root) or a node of the last inserted node ancestors chain (depth first insertion).
+    NodeIndex addNode(NodeIndex parent, const glm::mat4& localMatrix = glm::mat4(1.f));
+
+    void reserve(std::size_t nodeCount);
+    void clear();
+
+    [[nodiscard]] std::size_t size() const { return _parents.size(); }
+    [[nodiscard]] bool empty() const { return _parents.empty(); }
+
+    [[nodiscard]] NodeIndex parent(NodeIndex node) const { return _parents[node]; }
+    [[nodiscard]] NodeIndex subtreeEnd(NodeIndex node) const { return _subtreeEnds[node]; }
+
+    [[nodiscard]] const glm::mat4& localMatrix(NodeIndex node) const { return _localMatrices[node]; }
+    // Mark node and its whole subtree as dirty. World matrices are refreshed on next updateWorldMatrices.
+    void setLocalMatrix(NodeIndex node, const glm::mat4& localMatrix);
+
+    // Only valid after updateWorldMatrices
+    [[nodiscard]] const glm::mat4& worldMatrix(NodeIndex node) const { return _worldMatrices[node]; }
+
+    // Recompute world matrices of dirty subtrees only. Return the number of recomputed matrices.
+    std::size_t updateWorldMatrices();
+
+    [[nodiscard]] bool dirty() const { return _firstDirty < NodeIndex(size()); }
+
+private:
+    std::vector<NodeIndex> _parents;
+    std::vector<NodeIndex> _subtreeEnds;
+    std::vector<glm::mat4> _localMatrices;
+    std::vector<glm::mat4> _worldMatrices;
+    std::vector<std::uint8_t> _dirty;
+
+    // Every node before this index is clean, the update start from here.
+    NodeIndex _firstDirty = 0;
+};
+
+}
+
+#endif
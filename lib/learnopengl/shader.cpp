@@ -5,9 +5,12 @@
 #include <learnopengl/directionlight.hpp>
 #include <learnopengl/spotlight.hpp>
 #include <learnopengl/fileinfo.hpp>
+#include <learnopengl/trace.hpp>
+#include <learnopengl/framepacing.hpp>
 
 #include <glad/glad.h>
 
+#include <filesystem>
 #include <fstream>
 #include <sstream>
 #include <iostream>
@@ -46,38 +49,61 @@ bool checkShaderProgramCompilationError(unsigned int shaderProgram)
     return true;
 }
 
+// Read a shader file, replacing each #include "path" line by the file content. The path is searched next to the including file,
+// then like any resource (e.g. "/resources/shaders/clusteredlighting.glsl").
+bool readShaderSource(const std::string& path, std::string& code, int depth = 0)
+{
+    constexpr int MaxIncludeDepth = 8;
+
+    std::ifstream file(path);
+    if(!file)
+    {
+        std::cout << "ERROR::SHADER::CANNOT_OPEN " << path << std::endl;
+        return false;
+    }
+
+    std::string line;
+    while(std::getline(file, line))
+    {
+        const auto first = line.find_first_not_of(" \t");
+        if(first == std::string::npos || line.compare(first, 8, "#include") != 0)
+        {
+            code += line;
+            code += '\n';
+            continue;
+        }
+
+        const auto open = line.find('"', first);
+        const auto close = open == std::string::npos ? open : line.find('"', open + 1);
+        if(close == std::string::npos || close == open + 1 || depth >= MaxIncludeDepth)
+        {
+            std::cout << "ERROR::SHADER::INVALID_INCLUDE " << path << ": " << line << std::endl;
+            return false;
+        }
+
+        const auto includePath = line.substr(open + 1, close - open - 1);
+        const auto includeDir = std::filesystem::path(path).parent_path();
+        auto includeAbsPath = (includeDir / std::filesystem::path(includePath).relative_path()).generic_string();
+        if(includePath.front() == '/' || !std::filesystem::exists(includeAbsPath))
+            includeAbsPath = FileInfo(includePath).absolutePath();
+
+        if(!readShaderSource(includeAbsPath, code, depth + 1))
+            return false;
+    }
+    return true;
+}
+
 Shader::Shader(const char* vertexPath, const char* fragmentPath)
 {
+    LEARNOPENGL_TRACE_SCOPE("Shader::Shader");
+    const FrameEventScope frameEvent(FrameEvent::ShaderCompile);
     const auto absVertexPath = FileInfo(vertexPath).absolutePath();
     const auto absFragmentPath = FileInfo(fragmentPath).absolutePath();
 
     std::string vertexCode;
     std::string fragmentCode;
-    std::ifstream vShaderFile;
-    std::ifstream fShaderFile;
-    // ensure ifstream objects can throw exceptions:
-    vShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-    fShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-    try
-    {
-        // open files
-        vShaderFile.open(absVertexPath);
-        fShaderFile.open(absFragmentPath);
-        std::stringstream vShaderStream, fShaderStream;
-        // read file's buffer contents into streams
-        vShaderStream << vShaderFile.rdbuf();
-        fShaderStream << fShaderFile.rdbuf();
-        // close file handlers
-        vShaderFile.close();
-        fShaderFile.close();
-        // convert stream into string
-        vertexCode = vShaderStream.str();
-        fragmentCode = fShaderStream.str();
-    }
-    catch(std::ifstream::failure e)
-    {
+    if(!readShaderSource(absVertexPath, vertexCode) || !readShaderSource(absFragmentPath, fragmentCode))
         std::cout << "ERROR::SHADER::FILE_NOT_SUCCESFULLY_READ" << std::endl;
-    }
     const char* vShaderCode = vertexCode.c_str();
     const char* fShaderCode = fragmentCode.c_str();
 
@@ -110,6 +136,31 @@ Shader::Shader(const char* vertexPath, const char* fragmentPath)
     _id = shaderProgram;
 }
 
+Shader::Shader(const char* computePath)
+{
+    LEARNOPENGL_TRACE_SCOPE("Shader::Shader");
+    const FrameEventScope frameEvent(FrameEvent::ShaderCompile);
+    const auto absComputePath = FileInfo(computePath).absolutePath();
+
+    std::string computeCode;
+    if(!readShaderSource(absComputePath, computeCode))
+        std::cout << "ERROR::SHADER::FILE_NOT_SUCCESFULLY_READ" << std::endl;
+    const char* cShaderCode = computeCode.c_str();
+
+    const unsigned int computeShader = glCreateShader(GL_COMPUTE_SHADER);
+    glShaderSource(computeShader, 1, &cShaderCode, nullptr);
+    glCompileShader(computeShader);
+    checkShaderCompilationError(computeShader);
+
+    const unsigned int shaderProgram = glCreateProgram();
+    glAttachShader(shaderProgram, computeShader);
+    glLinkProgram(shaderProgram);
+    checkShaderProgramCompilationError(shaderProgram);
+    glDeleteShader(computeShader);
+
+    _id = shaderProgram;
+}
+
 Shader::~Shader()
 {
     if(_id)
@@ -136,6 +187,11 @@ void Shader::setMat3(const std::string& name, const float* values) const
     glUniformMatrix3fv(glGetUniformLocation(_id, name.c_str()), 1, GL_FALSE, values);
 }
 
+void Shader::setVec2(const std::string& name, const float& x, const float& y) const
+{
+    glUniform2f(glGetUniformLocation(_id, name.c_str()), x, y);
+}
+
 void Shader::setVec3(const std::string& name, const float& x, const float& y, const float& z) const
 {
     glUniform3f(glGetUniformLocation(_id, name.c_str()), x, y, z);
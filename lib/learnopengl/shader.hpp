@@ -16,6 +16,8 @@ class Shader
 public:
     // constructor reads and builds the shader
     Shader(const char* vertexPath, const char* fragmentPath);
+    // compute program (OpenGL 4.3)
+    explicit Shader(const char* computePath);
     ~Shader();
     // use/activate the shader
     void use() const;
@@ -25,6 +27,7 @@ public:
     void setFloat(const std::string& name, float value) const;
     void setMat4(const std::string& name, const float* values) const;
     void setMat3(const std::string& name, const float* values) const;
+    void setVec2(const std::string& name, const float& x, const float& y) const;
     void setVec3(const std::string& name, const float& x, const float& y, const float& z) const;
     void setVec4(const std::string& name, const float& x, const float& y, const float& z, const float& w) const;
     void setPhongMaterial(const std::string& name, const PhongMaterial& material) const;
@@ -0,0 +1,457 @@
+#include <learnopengl/shadowatlas.hpp>
+#include <learnopengl/camera.hpp>
+#include <learnopengl/depthstate.hpp>
+#include <learnopengl/frameprofiler.hpp>
+#include <learnopengl/pointlight.hpp>
+#include <learnopengl/shader.hpp>
+#include <learnopengl/spotlight.hpp>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+
+namespace learnopengl {
+
+namespace {
+
+constexpr std::uint32_t InvalidTile = ShadowAtlasAllocator::InvalidTile;
+
+// Cube faces +x, -x, +y, -y, +z, -z, as shadowatlas.glsl selects them from the major axis
+const glm::vec3 FaceDirections[] = {
+    {1.f, 0.f, 0.f}, {-1.f, 0.f, 0.f}, {0.f, 1.f, 0.f}, {0.f, -1.f, 0.f}, {0.f, 0.f, 1.f}, {0.f, 0.f, -1.f}};
+const glm::vec3 FaceUps[] = {{0.f, -1.f, 0.f}, {0.f, -1.f, 0.f}, {0.f, 0.f, 1.f}, {0.f, 0.f, -1.f}, {0.f, -1.f, 0.f}, {0.f, -1.f, 0.f}};
+
+// Tiles are owned by a face, as its shown or pending tile
+std::uint32_t tileOwner(std::uint32_t light, std::uint32_t face, bool pending)
+{
+    return (light * ShadowAtlas::FacesPerLight + face) * 2 + (pending ? 1 : 0);
+}
+
+}
+
+ShadowAtlas::ShadowAtlas() : ShadowAtlas(Settings{}) {}
+
+ShadowAtlas::ShadowAtlas(const Settings& settings) :
+    _settings(settings),
+    _allocator(settings.atlasSize, settings.maxTileSize, settings.minTileSize)
+{
+    _settings.atlasSize = _allocator.atlasSize();
+    _settings.maxTileSize = _allocator.pageSize();
+    _settings.minTileSize = _allocator.minTileSize();
+    setup();
+}
+
+ShadowAtlas::~ShadowAtlas()
+{
+    glDeleteTextures(1, &_faceTexture);
+    glDeleteBuffers(1, &_faceBuffer);
+    glDeleteFramebuffers(1, &_framebuffer);
+    glDeleteTextures(1, &_texture);
+}
+
+void ShadowAtlas::setup()
+{
+    _meshShader = std::make_unique<Shader>("resources/shaders/shadowdepth.vs", "resources/shaders/shadowdepth.fs");
+    _instancedShader = std::make_unique<Shader>("resources/shaders/shadowdepthinstanced.vs", "resources/shaders/shadowdepth.fs");
+
+    const auto size = GLsizei(_settings.atlasSize);
+    glGenTextures(1, &_texture);
+    glBindTexture(GL_TEXTURE_2D, _texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT32F, size, size, 0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    GLint previousFramebuffer = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
+    glGenFramebuffers(1, &_framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, _framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, _texture, 0);
+    glDrawBuffer(GL_NONE);
+    glReadBuffer(GL_NONE);
+    if(glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        std::cout << "ShadowAtlas framebuffer is incomplete" << std::endl;
+    glBindFramebuffer(GL_FRAMEBUFFER, GLuint(previousFramebuffer));
+
+    glGenBuffers(1, &_faceBuffer);
+    glBindBuffer(GL_TEXTURE_BUFFER, _faceBuffer);
+    glBufferData(GL_TEXTURE_BUFFER, sizeof(glm::vec4), nullptr, GL_DYNAMIC_DRAW);
+    glGenTextures(1, &_faceTexture);
+    glBindTexture(GL_TEXTURE_BUFFER, _faceTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, _faceBuffer);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
+
+void ShadowAtlas::update(
+    const Camera& camera, int viewportHeight, std::span<const PointLight> pointLights, std::span<const SpotLight> spotLights)
+{
+    ++_frame;
+    _reverseZ = camera.reverseZ();
+    _stats.shadowedLightCount = 0;
+    _stats.missingTileCount = 0;
+
+    const auto lightCount = pointLights.size() + spotLights.size();
+    for(std::size_t index = lightCount; index < _lights.size(); ++index) releaseTiles(_lights[index]);
+    _lights.resize(lightCount);
+
+    for(std::size_t index = 0; index < pointLights.size(); ++index)
+    {
+        const auto& light = pointLights[index];
+        setLight(index, light.position(), glm::vec3(0.f), light.range(), 0.f, false);
+    }
+    for(std::size_t index = 0; index < spotLights.size(); ++index)
+    {
+        const auto cone = spotLights[index].boundingCone();
+        const float halfAngle = std::acos(std::clamp(cone.cosHalfAngle, -1.f, 1.f));
+        setLight(pointLights.size() + index, cone.apex, cone.direction, cone.range, halfAngle, true);
+    }
+
+    // Radius in pixels of the range sphere at its distance: (height / 2) * range * projection[1][1] / distance
+    const auto& frustum = camera.frustum();
+    const float pixelScale = float(std::max(viewportHeight, 1)) * 0.5f * camera.projectionMatrix()[1][1];
+    std::vector<std::uint32_t> visibleLights;
+    for(std::uint32_t index = 0; index < _lights.size(); ++index)
+    {
+        auto& light = _lights[index];
+        const float distance = glm::length(light.position - camera.cameraPos());
+        light.visible = distance - light.range < _settings.maxDistance && frustum.intersects(BoundingSphere{light.position, light.range});
+        if(light.spot && light.visible)
+            light.visible = frustum.intersects(BoundingCone{light.position, light.direction, light.range, std::cos(light.halfAngle)});
+        light.importance = pixelScale * light.range / std::max(distance, _settings.near);
+        light.tileSize = _allocator.tileSize(std::uint32_t(std::min(light.importance * _settings.resolutionScale, 65536.f)));
+        if(light.visible)
+            visibleLights.push_back(index);
+    }
+    _stats.shadowedLightCount = visibleLights.size();
+
+    // Most important first: the least important lights of the frame have not touched their tiles yet, and lose them first
+    std::sort(visibleLights.begin(),
+        visibleLights.end(),
+        [&](std::uint32_t a, std::uint32_t b) { return _lights[a].importance > _lights[b].importance; });
+    for(const auto index: visibleLights) allocateTiles(index);
+}
+
+void ShadowAtlas::setLight(
+    std::size_t index, const glm::vec3& position, const glm::vec3& direction, float range, float halfAngle, bool spot)
+{
+    auto& light = _lights[index];
+    if(light.position == position && light.direction == direction && light.range == range && light.halfAngle == halfAngle &&
+       light.spot == spot && light.range > 0.f)
+        return;
+
+    if(light.spot != spot)
+        releaseTiles(light);
+    light.position = position;
+    light.direction = direction;
+    light.range = range;
+    light.halfAngle = halfAngle;
+    light.spot = spot;
+
+    const float far = std::max(range, _settings.near * 2.f);
+    for(std::uint32_t faceIndex = 0; faceIndex < light.faceCount(); ++faceIndex)
+    {
+        auto& face = light.faces[faceIndex];
+        glm::mat4 projection;
+        glm::mat4 view;
+        if(spot)
+        {
+            const auto up = std::abs(direction.y) > 0.99f ? glm::vec3(0.f, 0.f, 1.f) : glm::vec3(0.f, 1.f, 0.f);
+            projection = glm::perspective(std::min(2.f * halfAngle, glm::radians(170.f)), 1.f, _settings.near, far);
+            view = glm::lookAt(position, position + direction, up);
+        }
+        else
+        {
+            projection = glm::perspective(glm::half_pi<float>(), 1.f, _settings.near, far);
+            view = glm::lookAt(position, position + FaceDirections[faceIndex], FaceUps[faceIndex]);
+        }
+        face.viewProjection = projection * view;
+        face.frustum = Frustum(face.viewProjection);
+        if(!face.dirty)
+            face.dirtyFrame = _frame;
+        face.dirty = true;
+    }
+}
+
+void ShadowAtlas::allocateTiles(std::uint32_t lightIndex)
+{
+    auto& light = _lights[lightIndex];
+    for(std::uint32_t index = 0; index < light.faceCount(); ++index)
+    {
+        auto& face = light.faces[index];
+        const auto currentSize = face.tile != InvalidTile ? _allocator.tile(face.tile).size : 0u;
+        if(face.tile != InvalidTile)
+            _allocator.touch(face.tile, _frame);
+
+        if(currentSize == light.tileSize)
+        {
+            if(face.pendingTile != InvalidTile)
+                _allocator.free(face.pendingTile);
+            face.pendingTile = InvalidTile;
+            continue;
+        }
+        if(face.pendingTile != InvalidTile)
+        {
+            if(_allocator.tile(face.pendingTile).size == light.tileSize)
+            {
+                _allocator.touch(face.pendingTile, _frame);
+                continue;
+            }
+            _allocator.free(face.pendingTile);
+            face.pendingTile = InvalidTile;
+        }
+
+        // Smaller tiles when the atlas is full, down to the current size
+        const bool pending = face.tile != InvalidTile;
+        std::uint32_t tile = InvalidTile;
+        for(auto size = light.tileSize; tile == InvalidTile && size >= _settings.minTileSize && size != currentSize; size /= 2)
+        {
+            std::uint32_t evictedOwner = InvalidTile;
+            tile = _allocator.allocate(size, _frame, tileOwner(lightIndex, index, pending), &evictedOwner);
+            if(evictedOwner == InvalidTile)
+                continue;
+
+            // The evicted face loses its content
+            auto& evicted = _lights[evictedOwner / 2 / FacesPerLight].faces[evictedOwner / 2 % FacesPerLight];
+            assert((evictedOwner % 2 ? evicted.pendingTile : evicted.tile) == tile);
+            if(evictedOwner % 2)
+            {
+                evicted.pendingTile = InvalidTile;
+                continue;
+            }
+            evicted.tile = InvalidTile;
+            evicted.rendered = false;
+        }
+
+        if(tile == InvalidTile)
+        {
+            _stats.missingTileCount += face.tile == InvalidTile;
+            continue;
+        }
+        if(pending)
+        {
+            face.pendingTile = tile;
+            continue;
+        }
+        face.tile = tile;
+        face.rendered = false;
+    }
+}
+
+void ShadowAtlas::releaseTiles(Light& light)
+{
+    for(auto& face: light.faces)
+    {
+        for(auto* tile: {&face.tile, &face.pendingTile})
+        {
+            if(*tile != InvalidTile)
+                _allocator.free(*tile);
+            *tile = InvalidTile;
+        }
+        face.rendered = false;
+    }
+}
+
+void ShadowAtlas::invalidate(const AABB& bounds)
+{
+    if(!bounds.valid())
+        return;
+
+    for(auto& light: _lights)
+    {
+        // Range sphere against the box first, most lights are far from it
+        const auto closest = glm::min(glm::max(light.position, bounds.min), bounds.max);
+        if(glm::length(closest - light.position) > light.range)
+            continue;
+
+        for(std::uint32_t index = 0; index < light.faceCount(); ++index)
+        {
+            auto& face = light.faces[index];
+            if(!face.frustum.intersects(bounds))
+                continue;
+            if(!face.dirty)
+                face.dirtyFrame = _frame;
+            face.dirty = true;
+            face.castersMoved = true;
+        }
+    }
+}
+
+void ShadowAtlas::invalidate()
+{
+    for(auto& light: _lights)
+    {
+        for(auto& face: light.faces)
+        {
+            if(!face.dirty)
+                face.dirtyFrame = _frame;
+            face.dirty = true;
+        }
+    }
+}
+
+void ShadowAtlas::render(const DrawCasters& drawCasters, FrameProfiler* profiler)
+{
+    struct Candidate
+    {
+        std::uint32_t light = 0;
+        std::uint32_t face = 0;
+        float priority = 0.f;
+    };
+
+    // Faces of the visible lights with a tile to fill. Missing shadows go first, then moved casters, by screen size of the light,
+    // and waiting faces slowly gain priority so that small lights are served too.
+    std::vector<Candidate> candidates;
+    for(std::uint32_t lightIndex = 0; lightIndex < _lights.size(); ++lightIndex)
+    {
+        const auto& light = _lights[lightIndex];
+        if(!light.visible)
+            continue;
+        for(std::uint32_t index = 0; index < light.faceCount(); ++index)
+        {
+            const auto& face = light.faces[index];
+            const bool shown = face.tile != InvalidTile && face.rendered;
+            const bool stale = face.tile != InvalidTile && (face.dirty || !face.rendered);
+            if(face.pendingTile == InvalidTile && !stale)
+                continue;
+
+            float priority = light.importance * (shown ? 1.f : 4.f) * (face.castersMoved ? 2.f : 1.f);
+            priority *= 1.f + 0.1f * float(_frame - std::min(face.dirtyFrame, _frame));
+            candidates.push_back({lightIndex, index, priority});
+        }
+    }
+
+    const auto renderCount = std::min<std::size_t>(candidates.size(), _settings.faceBudget);
+    std::partial_sort(candidates.begin(),
+        candidates.begin() + std::ptrdiff_t(renderCount),
+        candidates.end(),
+        [](const Candidate& a, const Candidate& b) { return a.priority > b.priority; });
+
+    _stats.renderedFaceCount = renderCount;
+    _stats.pendingFaceCount = candidates.size() - renderCount;
+    _stats.drawCount = 0;
+
+    if(renderCount)
+    {
+        if(profiler)
+            profiler->beginScope("shadow atlas");
+
+        GLint previousFramebuffer = 0;
+        glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
+        GLint viewport[4];
+        glGetIntegerv(GL_VIEWPORT, viewport);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, _framebuffer);
+        applyDepthState(false);
+        glDepthMask(GL_TRUE);
+        glEnable(GL_SCISSOR_TEST);
+        glEnable(GL_POLYGON_OFFSET_FILL);
+        glPolygonOffset(_settings.slopeBias, 1.f);
+
+        for(std::size_t candidate = 0; candidate < renderCount; ++candidate)
+        {
+            const auto lightIndex = candidates[candidate].light;
+            auto& face = _lights[lightIndex].faces[candidates[candidate].face];
+            const auto target = face.pendingTile != InvalidTile ? face.pendingTile : face.tile;
+            const auto& tile = _allocator.tile(target);
+
+            // Scissor limits the clear to the tile
+            glViewport(GLint(tile.x), GLint(tile.y), GLsizei(tile.size), GLsizei(tile.size));
+            glScissor(GLint(tile.x), GLint(tile.y), GLsizei(tile.size), GLsizei(tile.size));
+            glClear(GL_DEPTH_BUFFER_BIT);
+            for(const auto* shader: {_meshShader.get(), _instancedShader.get()})
+            {
+                shader->use();
+                shader->setMat4("lightViewProjection", glm::value_ptr(face.viewProjection));
+            }
+
+            ShadowCasterPass pass(*_meshShader, *_instancedShader, face.frustum, lightIndex * FacesPerLight + candidates[candidate].face);
+            drawCasters(pass);
+            _stats.drawCount += pass.drawCount();
+
+            if(face.pendingTile != InvalidTile)
+            {
+                if(face.tile != InvalidTile)
+                    _allocator.free(face.tile);
+                face.tile = face.pendingTile;
+                face.pendingTile = InvalidTile;
+                _allocator.setOwner(face.tile, tileOwner(lightIndex, candidates[candidate].face, false));
+            }
+            face.renderedViewProjection = face.viewProjection;
+            face.renderedPosition = _lights[lightIndex].position;
+            face.rendered = true;
+            face.dirty = false;
+            face.castersMoved = false;
+        }
+
+        glDisable(GL_POLYGON_OFFSET_FILL);
+        glDisable(GL_SCISSOR_TEST);
+        applyDepthState(_reverseZ);
+        glBindFramebuffer(GL_FRAMEBUFFER, GLuint(previousFramebuffer));
+        glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+
+        if(profiler)
+            profiler->endScope();
+    }
+
+    uploadFaces();
+}
+
+void ShadowAtlas::uploadFaces()
+{
+    _faceData.assign(std::max<std::size_t>(_lights.size(), 1) * FacesPerLight * TexelsPerFace, glm::vec4(0.f));
+    const float atlasSize = float(_settings.atlasSize);
+    const auto toTexture = glm::scale(glm::translate(glm::mat4(1.f), glm::vec3(0.5f)), glm::vec3(0.5f));
+    for(std::size_t lightIndex = 0; lightIndex < _lights.size(); ++lightIndex)
+    {
+        const auto& light = _lights[lightIndex];
+        for(std::uint32_t index = 0; index < FacesPerLight; ++index)
+        {
+            // Every slot of a spot light holds its single face, whichever the shader selects
+            const auto& face = light.faces[light.spot ? 0 : index];
+            auto* texels = &_faceData[(lightIndex * FacesPerLight + index) * TexelsPerFace];
+            texels[5] = glm::vec4(light.position, 0.f);
+            if(face.tile == InvalidTile || !face.rendered)
+                continue;
+
+            // Clip space to the tile, in atlas coordinates
+            const auto& tile = _allocator.tile(face.tile);
+            const glm::vec3 offset(float(tile.x) / atlasSize, float(tile.y) / atlasSize, 0.f);
+            const float scale = float(tile.size) / atlasSize;
+            const auto toTile = glm::scale(glm::translate(glm::mat4(1.f), offset), glm::vec3(scale, scale, 1.f));
+            const auto matrix = toTile * toTexture * face.renderedViewProjection;
+            for(int column = 0; column < 4; ++column) texels[column] = matrix[column];
+            texels[4] = glm::vec4(offset.x, offset.y, offset.x + scale, offset.y + scale);
+            // World size of a texel at unit distance
+            const float tangent = light.spot ? std::tan(std::min(light.halfAngle, glm::radians(85.f))) : 1.f;
+            texels[5] = glm::vec4(face.renderedPosition, 2.f * tangent / float(tile.size));
+        }
+    }
+
+    glBindBuffer(GL_TEXTURE_BUFFER, _faceBuffer);
+    glBufferData(GL_TEXTURE_BUFFER, GLsizeiptr(_faceData.size() * sizeof(glm::vec4)), _faceData.data(), GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
+
+void ShadowAtlas::bind(const Shader& shader, std::uint32_t atlasUnit, std::uint32_t facesUnit) const
+{
+    glActiveTexture(GL_TEXTURE0 + atlasUnit);
+    glBindTexture(GL_TEXTURE_2D, _texture);
+    glActiveTexture(GL_TEXTURE0 + facesUnit);
+    glBindTexture(GL_TEXTURE_BUFFER, _faceTexture);
+    glActiveTexture(GL_TEXTURE0);
+    shader.setInt("shadowAtlas", int(atlasUnit));
+    shader.setInt("shadowAtlasFaces", int(facesUnit));
+}
+
+}
@@ -0,0 +1,166 @@
+#ifndef __LEARNOPENGL_SHADOW_ATLAS_HPP__
+#define __LEARNOPENGL_SHADOW_ATLAS_HPP__
+
+#include <learnopengl/frustum.hpp>
+#include <learnopengl/shadowatlasallocator.hpp>
+#include <learnopengl/shadowcasterpass.hpp>
+
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <glm/mat4x4.hpp>
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace learnopengl {
+
+class Camera;
+class FrameProfiler;
+class PointLight;
+class Shader;
+class SpotLight;
+
+// Shadows of many point and spot lights in a single depth texture: each point light renders the 6 faces of a cube (90 degrees
+// perspectives), each spot light one face over its cone, into square tiles of the atlas (ShadowAtlasAllocator, least recently used
+// tiles are evicted). Tile sizes follow the projected size of the light on screen. Faces are cached: a budgeted number of faces is
+// rendered per frame, those of the lights whose shadow is missing, that moved or whose casters moved (invalidate), by priority of
+// their screen size. A face whose tile size changed keeps its previous tile until the new one is rendered.
+// Lit shaders include resources/shaders/shadowatlas.glsl.
+class ShadowAtlas
+{
+public:
+    static constexpr std::uint32_t FacesPerLight = 6;
+    // World to atlas coordinates matrix (4 texels) | tile bounds in atlas coordinates | light position, texel size per unit of distance
+    static constexpr std::uint32_t TexelsPerFace = 6;
+
+    struct Settings
+    {
+        // Width and height of the depth texture
+        std::uint32_t atlasSize = 4096;
+        std::uint32_t maxTileSize = 1024;
+        std::uint32_t minTileSize = 128;
+        // Faces rendered per frame at most
+        std::uint32_t faceBudget = 12;
+        // Tile size per pixel of projected light radius
+        float resolutionScale = 2.f;
+        // Lights whose range sphere is outside the camera frustum or farther than that cast no shadow
+        float maxDistance = 50.f;
+        // Near plane of the face projections
+        float near = 0.05f;
+        // Slope scaled depth bias of the shadow pass, receivers are also offset along their normal by shadowatlas.glsl
+        float slopeBias = 2.f;
+    };
+
+    struct Stats
+    {
+        // Lights in view within maxDistance
+        std::size_t shadowedLightCount = 0;
+        // By the last render
+        std::size_t renderedFaceCount = 0;
+        std::size_t drawCount = 0;
+        // Faces waiting for a render after the last render
+        std::size_t pendingFaceCount = 0;
+        // Faces left without tile, the atlas being full
+        std::size_t missingTileCount = 0;
+    };
+
+    // Draw the casters of a face, index is light * FacesPerLight + face
+    using DrawCasters = std::function<void(ShadowCasterPass& pass)>;
+
+public:
+    ShadowAtlas();
+    explicit ShadowAtlas(const Settings& settings);
+    ~ShadowAtlas();
+
+    ShadowAtlas(const ShadowAtlas&) = delete;
+    ShadowAtlas& operator=(const ShadowAtlas&) = delete;
+
+    // Lights are indexed by their position in pointLights, then spotLights, keep the same order between frames for caching.
+    // Select tile sizes, allocate tiles and mark the faces to render. Must be called each frame before render, viewportHeight in pixels.
+    void update(
+        const Camera& camera, int viewportHeight, std::span<const PointLight> pointLights, std::span<const SpotLight> spotLights = {});
+    // A caster moved, appeared or disappeared within bounds (world space, call with both the old and new bounds of a moving caster):
+    // the faces reaching it are rendered again, before the faces of lights that only got closer
+    void invalidate(const AABB& bounds);
+    void invalidate();
+
+    // Render up to faceBudget faces by priority, in a "shadow atlas" scope on profiler, and upload the face data.
+    // Framebuffer and viewport are restored, the depth state is the one of the camera of update (applyDepthState).
+    void render(const DrawCasters& drawCasters, FrameProfiler* profiler = nullptr);
+
+    // Bind the atlas and the face data on two texture units and set the uniforms of shadowatlas.glsl. The shader must be in use.
+    void bind(const Shader& shader, std::uint32_t atlasUnit, std::uint32_t facesUnit) const;
+
+    [[nodiscard]] const Settings& settings() const { return _settings; }
+    [[nodiscard]] const Stats& stats() const { return _stats; }
+    [[nodiscard]] const ShadowAtlasAllocator& allocator() const { return _allocator; }
+    [[nodiscard]] std::uint32_t texture() const { return _texture; }
+
+private:
+    struct Face
+    {
+        // Tile sampled by shaders, once rendered
+        std::uint32_t tile = ShadowAtlasAllocator::InvalidTile;
+        bool rendered = false;
+        // Tile of the new size, replaces tile once rendered
+        std::uint32_t pendingTile = ShadowAtlasAllocator::InvalidTile;
+        bool dirty = true;
+        bool castersMoved = false;
+        // Frame it got dirty, older faces go first at equal priority
+        std::uint64_t dirtyFrame = 0;
+        glm::mat4 viewProjection = glm::mat4(1.f);
+        Frustum frustum;
+        // Of the tile content, until the face is rendered again after its light moved
+        glm::mat4 renderedViewProjection = glm::mat4(1.f);
+        glm::vec3 renderedPosition = glm::vec3(0.f);
+    };
+
+    struct Light
+    {
+        glm::vec3 position = glm::vec3(0.f);
+        glm::vec3 direction = glm::vec3(0.f);
+        float range = 0.f;
+        // Spot lights: half angle of the projection
+        float halfAngle = 0.f;
+        bool spot = false;
+        bool visible = false;
+        // Projected radius in pixels
+        float importance = 0.f;
+        std::uint32_t tileSize = 0;
+        std::array<Face, FacesPerLight> faces;
+
+        [[nodiscard]] std::uint32_t faceCount() const { return spot ? 1 : FacesPerLight; }
+    };
+
+    void setup();
+    void setLight(std::size_t index, const glm::vec3& position, const glm::vec3& direction, float range, float halfAngle, bool spot);
+    // Give the faces of a light a tile of its tile size, or smaller ones when the atlas is full
+    void allocateTiles(std::uint32_t lightIndex);
+    void releaseTiles(Light& light);
+    void uploadFaces();
+
+    Settings _settings;
+    ShadowAtlasAllocator _allocator;
+    std::vector<Light> _lights;
+    std::uint64_t _frame = 0;
+    bool _reverseZ = false;
+
+    std::unique_ptr<Shader> _meshShader;
+    std::unique_ptr<Shader> _instancedShader;
+
+    std::uint32_t _texture = 0;
+    std::uint32_t _framebuffer = 0;
+    std::uint32_t _faceBuffer = 0;
+    std::uint32_t _faceTexture = 0;
+    std::vector<glm::vec4> _faceData;
+
+    Stats _stats;
+};
+
+}
+
+#endif
@@ -0,0 +1,158 @@
+#include <learnopengl/shadowatlasallocator.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
+namespace learnopengl {
+
+ShadowAtlasAllocator::ShadowAtlasAllocator(std::uint32_t atlasSize, std::uint32_t pageSize, std::uint32_t minTileSize)
+{
+    _atlasSize = std::bit_ceil(std::max(atlasSize, 1u));
+    _pageSize = std::min(std::bit_ceil(std::max(pageSize, 1u)), _atlasSize);
+    _minTileSize = std::min(std::bit_ceil(std::max(minTileSize, 1u)), _pageSize);
+
+    const auto pagesPerRow = _atlasSize / _pageSize;
+    _pages.resize(std::size_t(pagesPerRow) * pagesPerRow);
+    // Popped from the back: pages fill the atlas from the bottom left
+    for(auto page = std::uint32_t(_pages.size()); page-- > 0;) _freePages.push_back(page);
+    _freeTiles.resize(std::size_t(std::countr_zero(_pageSize / _minTileSize)) + 1);
+    _stats.pageCount = _pages.size();
+}
+
+std::uint32_t ShadowAtlasAllocator::tileSize(std::uint32_t size) const
+{
+    return std::clamp(std::bit_ceil(std::max(size, 1u)), _minTileSize, _pageSize);
+}
+
+std::uint32_t ShadowAtlasAllocator::sizeClass(std::uint32_t size) const
+{
+    return std::uint32_t(std::countr_zero(_pageSize / tileSize(size)));
+}
+
+std::uint32_t ShadowAtlasAllocator::allocate(std::uint32_t size, std::uint64_t frame, std::uint32_t owner, std::uint32_t* evictedOwner)
+{
+    if(evictedOwner)
+        *evictedOwner = InvalidTile;
+
+    size = tileSize(size);
+    auto& freeTiles = _freeTiles[sizeClass(size)];
+    if(freeTiles.empty() && !_freePages.empty())
+        splitPage(size);
+
+    std::uint32_t handle = InvalidTile;
+    if(!freeTiles.empty())
+    {
+        handle = freeTiles.back();
+        freeTiles.pop_back();
+        ++_pages[_tiles[handle].page].usedCount;
+        ++_stats.tileCount;
+    }
+    else
+    {
+        // Least recently used tile of the size, only among the tiles not used this frame
+        std::uint64_t oldest = frame;
+        for(std::uint32_t candidate = 0; candidate < _tiles.size(); ++candidate)
+        {
+            const auto& record = _tiles[candidate];
+            if(record.used && record.tile.size == size && record.lastUsed < oldest)
+            {
+                oldest = record.lastUsed;
+                handle = candidate;
+            }
+        }
+        if(handle == InvalidTile)
+            return InvalidTile;
+
+        if(evictedOwner)
+            *evictedOwner = _tiles[handle].owner;
+        ++_stats.evictionCount;
+    }
+
+    auto& record = _tiles[handle];
+    record.used = true;
+    record.owner = owner;
+    record.lastUsed = frame;
+    return handle;
+}
+
+void ShadowAtlasAllocator::touch(std::uint32_t tile, std::uint64_t frame)
+{
+    _tiles[tile].lastUsed = std::max(_tiles[tile].lastUsed, frame);
+}
+
+void ShadowAtlasAllocator::setOwner(std::uint32_t tile, std::uint32_t owner)
+{
+    assert(_tiles[tile].used);
+    _tiles[tile].owner = owner;
+}
+
+void ShadowAtlasAllocator::free(std::uint32_t tile)
+{
+    auto& record = _tiles[tile];
+    if(!record.used)
+        return;
+
+    record.used = false;
+    record.owner = InvalidTile;
+    --_stats.tileCount;
+
+    auto& page = _pages[record.page];
+    auto& freeTiles = _freeTiles[sizeClass(page.tileSize)];
+    if(--page.usedCount > 0)
+    {
+        freeTiles.push_back(tile);
+        return;
+    }
+
+    // Last tile of its page: the page can be split again for another size
+    const auto pageIndex = record.page;
+    std::erase_if(freeTiles, [&](std::uint32_t handle) { return _tiles[handle].page == pageIndex; });
+    _freeRecords.insert(_freeRecords.end(), page.tiles.begin(), page.tiles.end());
+    page.tiles.clear();
+    page.tileSize = 0;
+    _freePages.push_back(pageIndex);
+    --_stats.usedPageCount;
+}
+
+std::uint32_t ShadowAtlasAllocator::splitPage(std::uint32_t size)
+{
+    const auto pageIndex = _freePages.back();
+    _freePages.pop_back();
+    ++_stats.usedPageCount;
+
+    auto& page = _pages[pageIndex];
+    page.tileSize = size;
+    page.usedCount = 0;
+
+    const auto pagesPerRow = _atlasSize / _pageSize;
+    const auto pageX = pageIndex % pagesPerRow * _pageSize;
+    const auto pageY = pageIndex / pagesPerRow * _pageSize;
+    const auto tilesPerRow = _pageSize / size;
+    auto& freeTiles = _freeTiles[sizeClass(size)];
+    // Pushed in reverse so that tiles are handed out from the page corner
+    for(auto index = tilesPerRow * tilesPerRow; index-- > 0;)
+    {
+        std::uint32_t handle = 0;
+        if(!_freeRecords.empty())
+        {
+            handle = _freeRecords.back();
+            _freeRecords.pop_back();
+        }
+        else
+        {
+            handle = std::uint32_t(_tiles.size());
+            _tiles.emplace_back();
+        }
+
+        auto& record = _tiles[handle];
+        record = {};
+        record.tile = {pageX + index % tilesPerRow * size, pageY + index / tilesPerRow * size, size};
+        record.page = pageIndex;
+        page.tiles.push_back(handle);
+        freeTiles.push_back(handle);
+    }
+    return pageIndex;
+}
+
+}
@@ -0,0 +1,101 @@
+#ifndef __LEARNOPENGL_SHADOW_ATLAS_ALLOCATOR_HPP__
+#define __LEARNOPENGL_SHADOW_ATLAS_ALLOCATOR_HPP__
+
+#include <cstdint>
+#include <vector>
+
+namespace learnopengl {
+
+// Square tiles of power of two sizes in a square atlas, the tile allocator of ShadowAtlas.
+// The atlas is split in pages of the largest tile size. A page holds tiles of a single size from its first allocation, and goes back
+// to the free pages once all its tiles are freed. Tiles are used at a frame (touch), when neither a free tile nor a free page is left,
+// the least recently used tile of the size that was not used in the current frame is evicted for the new owner.
+class ShadowAtlasAllocator
+{
+public:
+    static constexpr std::uint32_t InvalidTile = ~0u;
+
+    struct Tile
+    {
+        // Texels, from the bottom left corner of the atlas
+        std::uint32_t x = 0;
+        std::uint32_t y = 0;
+        std::uint32_t size = 0;
+    };
+
+    struct Stats
+    {
+        std::size_t pageCount = 0;
+        std::size_t usedPageCount = 0;
+        std::size_t tileCount = 0;
+        // Since construction
+        std::size_t evictionCount = 0;
+    };
+
+public:
+    // Sizes are rounded to powers of two, pageSize is clamped to atlasSize and minTileSize to pageSize
+    ShadowAtlasAllocator(std::uint32_t atlasSize, std::uint32_t pageSize, std::uint32_t minTileSize);
+
+    // Tile of size (rounded up to a power of two in [minTileSize, pageSize]) for owner, used at frame.
+    // InvalidTile when every tile of that size was used at frame and no page is free. When a tile is evicted its owner is written
+    // to evictedOwner (InvalidTile otherwise), its handle is the one returned.
+    [[nodiscard]] std::uint32_t allocate(
+        std::uint32_t size, std::uint64_t frame, std::uint32_t owner, std::uint32_t* evictedOwner = nullptr);
+    void touch(std::uint32_t tile, std::uint64_t frame);
+    void free(std::uint32_t tile);
+    // Hand a used tile over to another owner, the one evictions then report
+    void setOwner(std::uint32_t tile, std::uint32_t owner);
+
+    [[nodiscard]] const Tile& tile(std::uint32_t tile) const { return _tiles[tile].tile; }
+    [[nodiscard]] std::uint32_t owner(std::uint32_t tile) const { return _tiles[tile].owner; }
+    [[nodiscard]] std::uint64_t lastUsed(std::uint32_t tile) const { return _tiles[tile].lastUsed; }
+
+    [[nodiscard]] std::uint32_t atlasSize() const { return _atlasSize; }
+    [[nodiscard]] std::uint32_t pageSize() const { return _pageSize; }
+    [[nodiscard]] std::uint32_t minTileSize() const { return _minTileSize; }
+    // Power of two in [minTileSize, pageSize]
+    [[nodiscard]] std::uint32_t tileSize(std::uint32_t size) const;
+
+    [[nodiscard]] const Stats& stats() const { return _stats; }
+
+private:
+    struct TileRecord
+    {
+        Tile tile;
+        std::uint32_t page = 0;
+        std::uint32_t owner = InvalidTile;
+        std::uint64_t lastUsed = 0;
+        bool used = false;
+    };
+
+    struct Page
+    {
+        // 0 while free
+        std::uint32_t tileSize = 0;
+        std::uint32_t usedCount = 0;
+        // Handles of the tiles of the page
+        std::vector<std::uint32_t> tiles;
+    };
+
+    // Split a free page in tiles of size, return the page
+    std::uint32_t splitPage(std::uint32_t size);
+    [[nodiscard]] std::uint32_t sizeClass(std::uint32_t size) const;
+
+    std::uint32_t _atlasSize = 0;
+    std::uint32_t _pageSize = 0;
+    std::uint32_t _minTileSize = 0;
+
+    std::vector<Page> _pages;
+    std::vector<std::uint32_t> _freePages;
+    std::vector<TileRecord> _tiles;
+    // Handles of the records of freed pages, reused by the next split
+    std::vector<std::uint32_t> _freeRecords;
+    // Free tiles of split pages, per size class (pageSize >> class)
+    std::vector<std::vector<std::uint32_t>> _freeTiles;
+
+    Stats _stats;
+};
+
+}
+
+#endif
@@ -0,0 +1,42 @@
+#include <learnopengl/shadowcasterpass.hpp>
+#include <learnopengl/frustum.hpp>
+#include <learnopengl/instancedmesh.hpp>
+#include <learnopengl/mesh.hpp>
+#include <learnopengl/shader.hpp>
+
+#include <glm/gtc/type_ptr.hpp>
+
+namespace learnopengl {
+
+ShadowCasterPass::ShadowCasterPass(const Shader& meshShader, const Shader& instancedShader, const Frustum& frustum, std::uint32_t index) :
+    _meshShader(meshShader), _instancedShader(instancedShader), _frustum(frustum), _index(index)
+{
+}
+
+void ShadowCasterPass::draw(const Mesh& mesh, const glm::mat4& model)
+{
+    if(!_frustum.intersects(mesh.bounds().transformed(model)))
+    {
+        ++_culledCount;
+        return;
+    }
+
+    _meshShader.use();
+    _meshShader.setMat4("model", glm::value_ptr(model));
+    mesh.drawPositions();
+    ++_drawCount;
+}
+
+void ShadowCasterPass::draw(InstancedMesh& instances, const AABB& bounds)
+{
+    if(instances.empty() || !_frustum.intersects(bounds))
+    {
+        ++_culledCount;
+        return;
+    }
+
+    instances.drawDepth(_instancedShader);
+    ++_drawCount;
+}
+
+}
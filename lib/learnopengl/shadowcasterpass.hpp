@@ -0,0 +1,48 @@
+#ifndef __LEARNOPENGL_SHADOW_CASTER_PASS_HPP__
+#define __LEARNOPENGL_SHADOW_CASTER_PASS_HPP__
+
+#include <learnopengl/boundingvolume.hpp>
+
+#include <glm/mat4x4.hpp>
+
+#include <cstdint>
+
+namespace learnopengl {
+
+class Frustum;
+class InstancedMesh;
+class Mesh;
+class Shader;
+
+// Shadow casters drawn depth only into one view of a shadow map (a ShadowMap cascade, a ShadowAtlas face) from position streams,
+// culled against the view volume. The shaders are resources/shaders/shadowdepth.vs and shadowdepthinstanced.vs with their
+// lightViewProjection set.
+class ShadowCasterPass
+{
+public:
+    ShadowCasterPass(const Shader& meshShader, const Shader& instancedShader, const Frustum& frustum, std::uint32_t index);
+
+    // Skipped when the mesh bounds transformed by model are outside the view
+    void draw(const Mesh& mesh, const glm::mat4& model);
+    // Every instance, skipped when bounds, in world space, are outside the view
+    void draw(InstancedMesh& instances, const AABB& bounds);
+
+    // Cascade or face rendered
+    [[nodiscard]] std::uint32_t index() const { return _index; }
+    [[nodiscard]] const Frustum& frustum() const { return _frustum; }
+
+    [[nodiscard]] std::size_t drawCount() const { return _drawCount; }
+    [[nodiscard]] std::size_t culledCount() const { return _culledCount; }
+
+private:
+    const Shader& _meshShader;
+    const Shader& _instancedShader;
+    const Frustum& _frustum;
+    std::uint32_t _index = 0;
+    std::size_t _drawCount = 0;
+    std::size_t _culledCount = 0;
+};
+
+}
+
+#endif
@@ -0,0 +1,258 @@
+#include <learnopengl/shadowmap.hpp>
+#include <learnopengl/camera.hpp>
+#include <learnopengl/depthstate.hpp>
+#include <learnopengl/directionlight.hpp>
+#include <learnopengl/frameprofiler.hpp>
+#include <learnopengl/shader.hpp>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+
+namespace learnopengl {
+
+ShadowMap::ShadowMap() : ShadowMap(Settings{}) {}
+
+ShadowMap::ShadowMap(const Settings& settings) : _settings(settings)
+{
+    _settings.cascadeCount = std::clamp<std::uint32_t>(_settings.cascadeCount, 1, MaxCascades);
+    _settings.resolution = std::max(_settings.resolution, 1);
+    setup();
+}
+
+ShadowMap::~ShadowMap()
+{
+    glDeleteFramebuffers(1, &_framebuffer);
+    glDeleteTextures(1, &_texture);
+}
+
+void ShadowMap::setup()
+{
+    _meshShader = std::make_unique<Shader>("resources/shaders/shadowdepth.vs", "resources/shaders/shadowdepth.fs");
+    _instancedShader = std::make_unique<Shader>("resources/shaders/shadowdepthinstanced.vs", "resources/shaders/shadowdepth.fs");
+
+    // One layer per cascade, compared in hardware: linear filtering gives 2x2 percentage closer filtering for free
+    glGenTextures(1, &_texture);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, _texture);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY,
+        0,
+        GL_DEPTH_COMPONENT32F,
+        _settings.resolution,
+        _settings.resolution,
+        GLsizei(_settings.cascadeCount),
+        0,
+        GL_DEPTH_COMPONENT,
+        GL_FLOAT,
+        nullptr);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    GLint previousFramebuffer = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
+    glGenFramebuffers(1, &_framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, _framebuffer);
+    glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, _texture, 0, 0);
+    glDrawBuffer(GL_NONE);
+    glReadBuffer(GL_NONE);
+    if(glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        std::cout << "ShadowMap framebuffer is incomplete" << std::endl;
+    glBindFramebuffer(GL_FRAMEBUFFER, GLuint(previousFramebuffer));
+}
+
+void ShadowMap::update(const Camera& camera, const DirectionLight& light)
+{
+    const auto direction = glm::normalize(light.direction());
+    const bool lightTurned = glm::dot(direction, _lightDirection) < 1.f - 1e-6f;
+    if(lightTurned)
+        _lightDirection = direction;
+
+    // Light space rotation, cascades are translated in it
+    const auto up = std::abs(direction.y) > 0.99f ? glm::vec3(0.f, 0.f, 1.f) : glm::vec3(0.f, 1.f, 0.f);
+    const auto lightView = glm::lookAt(glm::vec3(0.f), direction, up);
+
+    const auto front = camera.cameraFront();
+    const auto& cameraPos = camera.cameraPos();
+    _viewDepth = glm::vec4(front, -glm::dot(front, cameraPos));
+    _reverseZ = camera.reverseZ();
+
+    // Squared tangent of the half angle to the slice corners, from the projection scales (also with reverse-Z)
+    const auto& projection = camera.projectionMatrix();
+    const float cornerTangent2 = 1.f / (projection[0][0] * projection[0][0]) + 1.f / (projection[1][1] * projection[1][1]);
+
+    const float near = std::max(camera.near(), 1e-3f);
+    const float far = std::max(std::min(_settings.maxDistance, camera.far()), near * 1.01f);
+    const auto split = [&](std::uint32_t index)
+    {
+        const float t = float(index) / float(_settings.cascadeCount);
+        const float logarithmic = near * std::pow(far / near, t);
+        const float uniform = near + (far - near) * t;
+        return _settings.splitLambda * logarithmic + (1.f - _settings.splitLambda) * uniform;
+    };
+
+    const float margin = _settings.caching ? _settings.cacheMargin : 0.f;
+    for(std::uint32_t index = 0; index < _settings.cascadeCount; ++index)
+    {
+        auto& cascade = _cascades[index];
+        const float sliceNear = index == 0 ? near : split(index);
+        const float sliceFar = index + 1 == _settings.cascadeCount ? far : split(index + 1);
+        cascade.stats.splitDistance = sliceFar;
+
+        // Smallest sphere holding the slice: equidistant from its near and far corners, or around the far rectangle when
+        // that center would be past it
+        const float centerDistance = std::min((sliceFar + sliceNear) * (1.f + cornerTangent2) * 0.5f, sliceFar);
+        const float radius = std::sqrt((sliceFar - centerDistance) * (sliceFar - centerDistance) + sliceFar * sliceFar * cornerTangent2);
+        const auto center = cameraPos + front * centerDistance;
+
+        const bool resized = std::abs(radius - cascade.fitRadius) > radius * 1e-4f;
+        const bool contained = glm::length(center - cascade.center) + radius <= cascade.radius;
+        if(!lightTurned && !resized && contained && _settings.caching)
+            continue;
+
+        // Move the center by whole texels in light space: static casters land on the same texels. The projection is 4 texels larger
+        // than the covered sphere to still hold it after the move.
+        const float coveredRadius = radius * (1.f + margin);
+        const float halfSize = coveredRadius * (1.f + 4.f / float(_settings.resolution));
+        const float texelSize = 2.f * halfSize / float(_settings.resolution);
+        auto lightCenter = glm::vec3(lightView * glm::vec4(center, 1.f));
+        lightCenter.x = std::floor(lightCenter.x / texelSize) * texelSize;
+        lightCenter.y = std::floor(lightCenter.y / texelSize) * texelSize;
+
+        // Light looks along -z: the depth range extends toward the light (+z) for the casters in front of the slice
+        const auto view = glm::translate(glm::mat4(1.f), -lightCenter) * lightView;
+        const auto orthographic = glm::ortho(-halfSize, halfSize, -halfSize, halfSize, -(halfSize + _settings.casterDistance), halfSize);
+
+        cascade.center = center;
+        cascade.radius = coveredRadius;
+        cascade.fitRadius = radius;
+        cascade.viewProjection = orthographic * view;
+        cascade.frustum = Frustum(cascade.viewProjection);
+        cascade.dirty = true;
+        cascade.stats.texelSize = texelSize;
+    }
+}
+
+void ShadowMap::invalidate(const AABB& bounds)
+{
+    if(!bounds.valid())
+        return;
+
+    for(std::uint32_t index = 0; index < _settings.cascadeCount; ++index)
+    {
+        auto& cascade = _cascades[index];
+        if(!cascade.dirty && cascade.frustum.intersects(bounds))
+            cascade.dirty = true;
+    }
+}
+
+void ShadowMap::invalidate()
+{
+    for(auto& cascade: _cascades) cascade.dirty = true;
+}
+
+void ShadowMap::render(const DrawCasters& drawCasters, FrameProfiler* profiler)
+{
+    GLint previousFramebuffer = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+
+    bool bound = false;
+    for(std::uint32_t index = 0; index < _settings.cascadeCount; ++index)
+    {
+        auto& cascade = _cascades[index];
+        cascade.stats.rendered = false;
+        cascade.stats.drawCount = 0;
+        cascade.stats.culledCount = 0;
+        if(!cascade.dirty && _settings.caching)
+            continue;
+
+        // Standard depth whatever the camera uses. Depth clamp keeps the casters in front of the near plane.
+        if(!bound)
+        {
+            glBindFramebuffer(GL_FRAMEBUFFER, _framebuffer);
+            glViewport(0, 0, _settings.resolution, _settings.resolution);
+            applyDepthState(false);
+            glDepthMask(GL_TRUE);
+            glEnable(GL_DEPTH_CLAMP);
+            glEnable(GL_POLYGON_OFFSET_FILL);
+            glPolygonOffset(_settings.slopeBias, 1.f);
+            bound = true;
+        }
+
+        if(profiler)
+            profiler->beginScope(cascadeScopeName(index));
+
+        glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, _texture, 0, GLint(index));
+        glClear(GL_DEPTH_BUFFER_BIT);
+        for(const auto* shader: {_meshShader.get(), _instancedShader.get()})
+        {
+            shader->use();
+            shader->setMat4("lightViewProjection", glm::value_ptr(cascade.viewProjection));
+        }
+
+        ShadowCasterPass pass(*_meshShader, *_instancedShader, cascade.frustum, index);
+        drawCasters(pass);
+
+        if(profiler)
+            profiler->endScope();
+
+        cascade.dirty = false;
+        cascade.stats.rendered = true;
+        cascade.stats.drawCount = pass.drawCount();
+        cascade.stats.culledCount = pass.culledCount();
+        ++cascade.stats.renderCount;
+    }
+
+    if(!bound)
+        return;
+
+    glDisable(GL_POLYGON_OFFSET_FILL);
+    glDisable(GL_DEPTH_CLAMP);
+    applyDepthState(_reverseZ);
+    glBindFramebuffer(GL_FRAMEBUFFER, GLuint(previousFramebuffer));
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+}
+
+void ShadowMap::bind(const Shader& shader, std::uint32_t unit) const
+{
+    glActiveTexture(GL_TEXTURE0 + unit);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, _texture);
+    glActiveTexture(GL_TEXTURE0);
+    shader.setInt("shadowMap", int(unit));
+    shader.setInt("shadowCascadeCount", int(_settings.cascadeCount));
+
+    // Light clip space to texture coordinates and depth in [0, 1]
+    const auto toTexture = glm::scale(glm::translate(glm::mat4(1.f), glm::vec3(0.5f)), glm::vec3(0.5f));
+    glm::vec4 splits(0.f);
+    glm::vec4 texelSizes(0.f);
+    for(std::uint32_t index = 0; index < _settings.cascadeCount; ++index)
+    {
+        const auto& cascade = _cascades[index];
+        const auto matrix = toTexture * cascade.viewProjection;
+        shader.setMat4("shadowMatrices[" + std::to_string(index) + "]", glm::value_ptr(matrix));
+        splits[int(index)] = cascade.stats.splitDistance;
+        texelSizes[int(index)] = cascade.stats.texelSize;
+    }
+    shader.setVec4("shadowSplits", splits.x, splits.y, splits.z, splits.w);
+    shader.setVec4("shadowTexelSizes", texelSizes.x, texelSizes.y, texelSizes.z, texelSizes.w);
+    shader.setVec4("shadowViewDepth", _viewDepth.x, _viewDepth.y, _viewDepth.z, _viewDepth.w);
+}
+
+const char* ShadowMap::cascadeScopeName(std::uint32_t cascade)
+{
+    static constexpr const char* Names[MaxCascades] = {"shadow cascade 0", "shadow cascade 1", "shadow cascade 2", "shadow cascade 3"};
+    return Names[std::min(cascade, MaxCascades - 1)];
+}
+
+}
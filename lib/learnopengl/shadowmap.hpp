@@ -0,0 +1,138 @@
+#ifndef __LEARNOPENGL_SHADOW_MAP_HPP__
+#define __LEARNOPENGL_SHADOW_MAP_HPP__
+
+#include <learnopengl/boundingvolume.hpp>
+#include <learnopengl/frustum.hpp>
+#include <learnopengl/shadowcasterpass.hpp>
+
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <glm/mat4x4.hpp>
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace learnopengl {
+
+class Camera;
+class DirectionLight;
+class FrameProfiler;
+class Shader;
+
+// Cascaded shadow maps of a DirectionLight. The camera view range is split in slices (PSSM: a mix of logarithmic and uniform split
+// distances), each covered by an orthographic light projection rendered into a layer of a depth texture array.
+// A cascade is fitted to the bounding sphere of its slice, whose size does not change as the camera turns, snapped to shadow map texels
+// so that shadow edges do not shimmer, and covers a margin around it: it is only rendered again when the slice leaves the margin,
+// the light turns or a caster inside it changed (invalidate). Far cascades, with large texels, stay cached while the camera moves.
+// Casters are drawn depth only from position streams (Mesh::drawPositions). Lit shaders include resources/shaders/shadow.glsl.
+class ShadowMap
+{
+public:
+    static constexpr std::uint32_t MaxCascades = 4;
+
+    struct Settings
+    {
+        std::uint32_t cascadeCount = 4;
+        // Width and height of each cascade
+        int resolution = 2048;
+        // Shadows end there, or at the camera far distance when closer
+        float maxDistance = 100.f;
+        // Split distances from uniform (0) to logarithmic (1)
+        float splitLambda = 0.75f;
+        // Cascades cover their slice sphere radius times 1 + cacheMargin
+        float cacheMargin = 0.1f;
+        // Casters up to that distance toward the light from a cascade still cast into it
+        float casterDistance = 100.f;
+        // Render every cascade every frame when off, for comparison
+        bool caching = true;
+        // Slope scaled depth bias of the shadow pass, receivers are also offset along their normal by shadow.glsl
+        float slopeBias = 2.f;
+    };
+
+    struct CascadeStats
+    {
+        // View distance where the cascade ends
+        float splitDistance = 0.f;
+        // World size of a shadow map texel
+        float texelSize = 0.f;
+        // By the last render, counts are 0 when the cascade was cached
+        bool rendered = false;
+        std::size_t drawCount = 0;
+        std::size_t culledCount = 0;
+        // Renders since construction
+        std::size_t renderCount = 0;
+    };
+
+    // Casters of a cascade, its frustum is extended toward the light by Settings::casterDistance
+    using CasterPass = ShadowCasterPass;
+    // Draw the casters of a cascade, called once per rendered cascade
+    using DrawCasters = std::function<void(CasterPass& pass)>;
+
+public:
+    ShadowMap();
+    explicit ShadowMap(const Settings& settings);
+    ~ShadowMap();
+
+    ShadowMap(const ShadowMap&) = delete;
+    ShadowMap& operator=(const ShadowMap&) = delete;
+
+    // Fit the cascades to the camera view range. Must be called after the camera or the light changed and before render.
+    void update(const Camera& camera, const DirectionLight& light);
+    // A caster moved, appeared or disappeared within bounds (world space, call with both the old and new bounds of a moving caster):
+    // the cascades reaching it are rendered again
+    void invalidate(const AABB& bounds);
+    void invalidate();
+
+    // Render the cascades whose content changed, with a scope per cascade on profiler (see cascadeScopeName).
+    // Framebuffer and viewport are restored, the depth state is the one of the camera of update (applyDepthState).
+    void render(const DrawCasters& drawCasters, FrameProfiler* profiler = nullptr);
+
+    // Bind the depth texture array on a texture unit and set the uniforms of shadow.glsl. The shader must be in use.
+    void bind(const Shader& shader, std::uint32_t unit) const;
+
+    [[nodiscard]] const Settings& settings() const { return _settings; }
+    [[nodiscard]] std::uint32_t cascadeCount() const { return _settings.cascadeCount; }
+    [[nodiscard]] const CascadeStats& cascadeStats(std::uint32_t cascade) const { return _cascades[cascade].stats; }
+    // World to light clip space of a cascade
+    [[nodiscard]] const glm::mat4& viewProjection(std::uint32_t cascade) const { return _cascades[cascade].viewProjection; }
+    [[nodiscard]] std::uint32_t texture() const { return _texture; }
+
+    // "shadow cascade <cascade>", the profiler scope of a cascade render
+    [[nodiscard]] static const char* cascadeScopeName(std::uint32_t cascade);
+
+private:
+    struct Cascade
+    {
+        // Covered sphere, in world space
+        glm::vec3 center = glm::vec3(0.f);
+        float radius = 0.f;
+        // Radius of the slice sphere at the last fit
+        float fitRadius = 0.f;
+        glm::mat4 viewProjection = glm::mat4(1.f);
+        Frustum frustum;
+        bool dirty = true;
+        CascadeStats stats;
+    };
+
+    void setup();
+
+    Settings _settings;
+    std::array<Cascade, MaxCascades> _cascades;
+
+    glm::vec3 _lightDirection = glm::vec3(0.f);
+    // View distance of a world position p: dot(xyz, p) + w
+    glm::vec4 _viewDepth = glm::vec4(0.f);
+    bool _reverseZ = false;
+
+    std::unique_ptr<Shader> _meshShader;
+    std::unique_ptr<Shader> _instancedShader;
+
+    std::uint32_t _texture = 0;
+    std::uint32_t _framebuffer = 0;
+};
+
+}
+
+#endif
@@ -1,8 +1,14 @@
 #ifndef __LEARNOPENGL_SPOT_LIGHT_HPP__
 #define __LEARNOPENGL_SPOT_LIGHT_HPP__
 
+#include <learnopengl/boundingvolume.hpp>
+#include <learnopengl/lightrange.hpp>
+
+#include <glm/geometric.hpp>
 #include <glm/vec3.hpp>
 
+#include <algorithm>
+
 namespace learnopengl {
 
 class SpotLight
@@ -15,7 +21,11 @@ public:
     constexpr void setAmbient(const glm::vec3& ambient) { _ambient = ambient; }
 
     [[nodiscard]] constexpr const glm::vec3& diffuse() const { return _diffuse; }
-    constexpr void setDiffuse(const glm::vec3& diffuse) { _diffuse = diffuse; }
+    constexpr void setDiffuse(const glm::vec3& diffuse)
+    {
+        _diffuse = diffuse;
+        _rangeDirty = true;
+    }
 
     [[nodiscard]] constexpr const glm::vec3& specular() const { return _specular; }
     constexpr void setSpecular(const glm::vec3& specular) { _specular = specular; }
@@ -40,6 +50,49 @@ public:
         _attenuationConstant = constant;
         _attenuationLinear = linear;
         _attenuationQuadratic = quadratic;
+        _rangeDirty = true;
+    }
+
+    // Distance at which the brightest diffuse component falls under the threshold, cached until attenuation or diffuse change
+    [[nodiscard]] float range() const
+    {
+        if(_rangeDirty)
+        {
+            _range = lightRange(_attenuationConstant,
+                _attenuationLinear,
+                _attenuationQuadratic,
+                std::max({_diffuse.r, _diffuse.g, _diffuse.b}),
+                _rangeThreshold);
+            _rangeDirty = false;
+        }
+        return _range;
+    }
+
+    // Lit volume, half angle from the outer cut off. A zero direction gives the wide cone of the range sphere.
+    [[nodiscard]] BoundingCone boundingCone() const
+    {
+        if(glm::dot(_direction, _direction) == 0.f)
+            return {_position, glm::vec3(0.f, 0.f, -1.f), range(), -1.f};
+        return {_position, glm::normalize(_direction), range(), _outerCutOff};
+    }
+
+    // The ambient term is not limited to the cone
+    [[nodiscard]] BoundingSphere boundingSphere() const
+    {
+        if(_ambient == glm::vec3(0.f))
+        {
+            const auto cone = boundingCone();
+            if(cone.cosHalfAngle > 0.f)
+                return cone.boundingSphere();
+        }
+        return {_position, range()};
+    }
+
+    [[nodiscard]] constexpr float rangeThreshold() const { return _rangeThreshold; }
+    constexpr void setRangeThreshold(float threshold)
+    {
+        _rangeThreshold = threshold;
+        _rangeDirty = true;
     }
 
 private:
@@ -57,6 +110,11 @@ private:
     float _attenuationConstant = 1.f;
     float _attenuationLinear = 0.045f;
     float _attenuationQuadratic = 0.0075f;
+
+    float _rangeThreshold = LightRangeThreshold;
+    // Cache of range(), not thread safe on first read after a change
+    mutable float _range = 0.f;
+    mutable bool _rangeDirty = true;
 };
 
 }
@@ -1,5 +1,7 @@
 #include <learnopengl/texture.hpp>
 #include <learnopengl/fileinfo.hpp>
+#include <learnopengl/trace.hpp>
+#include <learnopengl/framepacing.hpp>
 
 #include <glad/glad.h>
 #include <stb_image.h>
@@ -14,6 +16,8 @@ class SharedTexture
 public:
     SharedTexture(const std::string& filePath, const Texture::Settings& settings = {}) : _path(filePath), _name(settings.name)
     {
+        LEARNOPENGL_TRACE_SCOPE("SharedTexture");
+        const FrameEventScope frameEvent(FrameEvent::TextureUpload);
         glGenTextures(1, &_id);
         glBindTexture(GL_TEXTURE_2D, _id);
         // set the texture wrapping/filtering options (on the currently bound texture object)
@@ -42,6 +46,7 @@ public:
         if(data)
         {
             std::cout << "Load Texture " << _path << std::endl;
+            LEARNOPENGL_TRACE_SCOPE("texture upload");
             glTexImage2D(GL_TEXTURE_2D,
                 0,
                 nrChannels == 3 ? GL_RGB : GL_RGBA,
@@ -0,0 +1,108 @@
+#include <learnopengl/threadpool.hpp>
+
+#include <algorithm>
+
+namespace learnopengl {
+
+ThreadPool::ThreadPool(std::size_t threadCount)
+{
+    if(threadCount == 0)
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+    _workers.reserve(threadCount - 1);
+    for(std::size_t i = 1; i < threadCount; ++i) _workers.emplace_back([this]() { workerLoop(); });
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        const std::lock_guard lock(_mutex);
+        _stop = true;
+    }
+    _wakeWorkers.notify_all();
+    for(auto& worker: _workers) worker.join();
+}
+
+ThreadPool& ThreadPool::global()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::runChunks(const Task& task, std::size_t count, std::size_t grainSize)
+{
+    for(;;)
+    {
+        // The loop was read under the mutex, chunks only need distinct indices
+        const auto begin = _nextIndex.fetch_add(grainSize, std::memory_order_relaxed);
+        if(begin >= count)
+            return;
+        task(begin, std::min(begin + grainSize, count));
+    }
+}
+
+void ThreadPool::workerLoop()
+{
+    std::size_t generation = 0;
+    for(;;)
+    {
+        const Task* task = nullptr;
+        std::size_t count = 0;
+        std::size_t grainSize = 1;
+        {
+            std::unique_lock lock(_mutex);
+            _wakeWorkers.wait(lock, [&]() { return _stop || _generation != generation; });
+            if(_stop)
+                return;
+            generation = _generation;
+            // Woken after the caller returned, the task is gone and _nextIndex may already belong to the next loop
+            if(!_task)
+                continue;
+            task = _task;
+            count = _count;
+            grainSize = _grainSize;
+            ++_activeWorkers;
+        }
+
+        runChunks(*task, count, grainSize);
+
+        {
+            const std::lock_guard lock(_mutex);
+            --_activeWorkers;
+        }
+        _jobDone.notify_one();
+    }
+}
+
+void ThreadPool::parallelFor(std::size_t count, std::size_t grainSize, const Task& task)
+{
+    if(count == 0)
+        return;
+
+    grainSize = std::max<std::size_t>(grainSize, 1);
+    // Not worth waking workers for a single chunk
+    if(_workers.empty() || count <= grainSize)
+    {
+        task(0, count);
+        return;
+    }
+
+    {
+        const std::lock_guard lock(_mutex);
+        _task = &task;
+        _count = count;
+        _grainSize = grainSize;
+        _nextIndex.store(0, std::memory_order_relaxed);
+        ++_generation;
+    }
+    _wakeWorkers.notify_all();
+
+    runChunks(task, count, grainSize);
+
+    // Workers that picked up this loop must be done before the task goes out of scope
+    std::unique_lock lock(_mutex);
+    _jobDone.wait(lock, [&]() { return _activeWorkers == 0; });
+    _task = nullptr;
+}
+
+}
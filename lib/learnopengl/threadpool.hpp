@@ -0,0 +1,63 @@
+#ifndef __LEARNOPENGL_THREAD_POOL_HPP__
+#define __LEARNOPENGL_THREAD_POOL_HPP__
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace learnopengl {
+
+// Fixed set of worker threads running one parallel loop at a time, the calling thread works too.
+// Work must not call OpenGL, only the thread owning the context can.
+class ThreadPool
+{
+public:
+    // Range [begin, end) of the loop
+    using Task = std::function<void(std::size_t begin, std::size_t end)>;
+
+public:
+    // 0 for one thread per hardware thread, the caller included
+    explicit ThreadPool(std::size_t threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Caller included
+    [[nodiscard]] std::size_t threadCount() const { return _workers.size() + 1; }
+
+    // Split [0, count) in chunks of grainSize indices, run them on every thread and return once all are done
+    void parallelFor(std::size_t count, std::size_t grainSize, const Task& task);
+
+    // Pool shared by library code, created on first use
+    [[nodiscard]] static ThreadPool& global();
+
+private:
+    void workerLoop();
+    // Loop read under the mutex by each thread
+    void runChunks(const Task& task, std::size_t count, std::size_t grainSize);
+
+    std::vector<std::thread> _workers;
+
+    std::mutex _mutex;
+    std::condition_variable _wakeWorkers;
+    std::condition_variable _jobDone;
+    bool _stop = false;
+    // Incremented for each loop so a worker runs it once
+    std::size_t _generation = 0;
+    std::size_t _activeWorkers = 0;
+
+    // Current loop, null once the caller returned so a late worker skips it
+    const Task* _task = nullptr;
+    std::size_t _count = 0;
+    std::size_t _grainSize = 1;
+    std::atomic<std::size_t> _nextIndex{0};
+};
+
+}
+
+#endif
@@ -0,0 +1,194 @@
+#include <learnopengl/trace.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace learnopengl {
+
+namespace {
+
+struct TraceEvent
+{
+    const char* name;
+    std::uint64_t begin;
+    std::uint64_t end;
+};
+
+// Events of one thread, written only by that thread. Chunks are never moved so the exporter can read them while the owner appends:
+// the owner publishes the event count with a release store after writing the event.
+struct ThreadBuffer
+{
+    static constexpr std::size_t ChunkSize = 16384;
+    static constexpr std::size_t MaxChunks = 1024;
+
+    explicit ThreadBuffer(int id, bool gpu) : id(id), gpu(gpu) {}
+
+    void append(const char* name, std::uint64_t begin, std::uint64_t end)
+    {
+        const auto index = count.load(std::memory_order_relaxed);
+        const auto chunk = index / ChunkSize;
+        if(chunk >= MaxChunks)
+            return;
+        if(!chunks[chunk])
+            chunks[chunk].reset(new TraceEvent[ChunkSize]);
+        chunks[chunk][index % ChunkSize] = {name, begin, end};
+        count.store(index + 1, std::memory_order_release);
+    }
+
+    const int id;
+    // Times in traceClockNs instead of traceTicks
+    const bool gpu;
+    std::array<std::unique_ptr<TraceEvent[]>, MaxChunks> chunks;
+    std::atomic<std::size_t> count{0};
+};
+
+// Buffers outlive their threads so events of finished threads are still exported
+struct TraceRegistry
+{
+    TraceRegistry() : ticksOrigin(traceTicks()), nsOrigin(traceClockNs()) {}
+
+    ThreadBuffer& add(bool gpu)
+    {
+        const std::lock_guard lock(mutex);
+        buffers.push_back(std::make_shared<ThreadBuffer>(int(buffers.size()) + 1, gpu));
+        return *buffers.back();
+    }
+
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    // Calibration of traceTicks against traceClockNs
+    const std::uint64_t ticksOrigin;
+    const std::uint64_t nsOrigin;
+};
+
+TraceRegistry& registry()
+{
+    static TraceRegistry registry;
+    return registry;
+}
+
+ThreadBuffer& threadBuffer()
+{
+    thread_local ThreadBuffer& buffer = registry().add(false);
+    return buffer;
+}
+
+ThreadBuffer& gpuBuffer()
+{
+    static ThreadBuffer& buffer = registry().add(true);
+    return buffer;
+}
+
+std::string tracePath;
+
+void writeTraceAtExit()
+{
+    if(writeChromeTrace(tracePath))
+        std::cout << "Trace written to " << tracePath << std::endl;
+}
+
+void writeJsonString(std::ostream& stream, const char* text)
+{
+    stream << '"';
+    for(; *text; ++text)
+    {
+        if(*text == '"' || *text == '\\')
+            stream << '\\';
+        stream << *text;
+    }
+    stream << '"';
+}
+
+}
+
+void setTracingEnabled(bool enabled)
+{
+    // Calibration starts before the first event
+    registry();
+    detail::tracingEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+void startTracingFromEnvironment()
+{
+    const char* path = std::getenv("LEARNOPENGL_TRACE");
+    if(!path || !*path || !tracePath.empty())
+        return;
+
+#ifndef LEARNOPENGL_TRACING
+    std::cout << "Trace: only frame profiler and GPU events are recorded, configure with LEARNOPENGL_TRACING=ON" << std::endl;
+#endif
+    tracePath = path;
+    setTracingEnabled(true);
+    std::atexit(writeTraceAtExit);
+}
+
+void recordTraceEvent(const char* name, std::uint64_t beginTicks, std::uint64_t endTicks) { threadBuffer().append(name, beginTicks, endTicks); }
+
+void recordGpuTraceEvent(const char* name, std::uint64_t beginNs, std::uint64_t endNs) { gpuBuffer().append(name, beginNs, endNs); }
+
+bool writeChromeTrace(const std::string& path)
+{
+    auto& traceRegistry = registry();
+
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    {
+        const std::lock_guard lock(traceRegistry.mutex);
+        buffers = traceRegistry.buffers;
+    }
+
+    // Ticks per nanosecond measured over the whole trace, exact when ticks are already nanoseconds
+    const auto ticks = traceTicks() - traceRegistry.ticksOrigin;
+    const auto ns = traceClockNs() - traceRegistry.nsOrigin;
+#ifdef LEARNOPENGL_TRACE_RDTSC
+    const double nsPerTick = ticks > 0 ? double(ns) / double(ticks) : 1.;
+#else
+    const double nsPerTick = 1.;
+#endif
+
+    std::ofstream file(path);
+    if(!file)
+    {
+        std::cerr << "Trace: can't write " << path << std::endl;
+        return false;
+    }
+
+    // Microseconds since the first event
+    const auto toMicroseconds = [&](const ThreadBuffer& buffer, std::uint64_t time)
+    {
+        if(buffer.gpu)
+            return (double(time) - double(traceRegistry.nsOrigin)) / 1000.;
+        return (double(time) - double(traceRegistry.ticksOrigin)) * nsPerTick / 1000.;
+    };
+
+    file << std::fixed << std::setprecision(3) << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+    bool first = true;
+    for(const auto& buffer: buffers)
+    {
+        file << (first ? "" : ",\n") << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << buffer->id
+             << ", \"args\": {\"name\": \"" << (buffer->gpu ? "GPU" : "CPU ") << (buffer->gpu ? "" : std::to_string(buffer->id)) << "\"}}";
+        first = false;
+
+        const auto count = buffer->count.load(std::memory_order_acquire);
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            const auto& event = buffer->chunks[i / ThreadBuffer::ChunkSize][i % ThreadBuffer::ChunkSize];
+            const auto begin = toMicroseconds(*buffer, event.begin);
+            const auto end = toMicroseconds(*buffer, event.end);
+            file << ",\n{\"name\": ";
+            writeJsonString(file, event.name);
+            file << ", \"ph\": \"X\", \"pid\": 1, \"tid\": " << buffer->id << ", \"ts\": " << begin << ", \"dur\": " << std::max(end - begin, 0.)
+                 << "}";
+        }
+    }
+    file << "\n]}\n";
+    return bool(file);
+}
+
+}
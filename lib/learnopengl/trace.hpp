@@ -0,0 +1,87 @@
+#ifndef __LEARNOPENGL_TRACE_HPP__
+#define __LEARNOPENGL_TRACE_HPP__
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#    define LEARNOPENGL_TRACE_RDTSC
+#    ifdef _MSC_VER
+#        include <intrin.h>
+#    else
+#        include <x86intrin.h>
+#    endif
+#endif
+
+// Instrumentation macros, removed at compile time unless LEARNOPENGL_TRACING is defined (CMake option LEARNOPENGL_TRACING).
+// Events are only recorded while tracing is enabled at runtime, see setTracingEnabled and LEARNOPENGL_TRACE.
+#ifdef LEARNOPENGL_TRACING
+#    define LEARNOPENGL_TRACE_CONCAT_IMPL(a, b) a##b
+#    define LEARNOPENGL_TRACE_CONCAT(a, b) LEARNOPENGL_TRACE_CONCAT_IMPL(a, b)
+#    define LEARNOPENGL_TRACE_SCOPE(name) const ::learnopengl::TraceScope LEARNOPENGL_TRACE_CONCAT(traceScope, __LINE__)(name)
+#else
+#    define LEARNOPENGL_TRACE_SCOPE(name) ((void)0)
+#endif
+
+namespace learnopengl {
+
+// Each thread appends events to its own buffer without locking. Buffers are merged by writeChromeTrace.
+// Event names must be string literals.
+
+namespace detail {
+inline std::atomic<bool> tracingEnabled{false};
+}
+
+inline bool tracingEnabled() { return detail::tracingEnabled.load(std::memory_order_relaxed); }
+void setTracingEnabled(bool enabled);
+
+// Enable tracing when LEARNOPENGL_TRACE is set, the trace is written to its path at exit
+void startTracingFromEnvironment();
+
+// CPU clock of trace events: time stamp counter when available, converted to nanoseconds on export
+inline std::uint64_t traceTicks()
+{
+#ifdef LEARNOPENGL_TRACE_RDTSC
+    return __rdtsc();
+#else
+    return std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+// Nanoseconds of std::chrono::steady_clock, the clock GPU events are expressed in
+inline std::uint64_t traceClockNs()
+{
+    return std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// Append a complete event to the calling thread buffer
+void recordTraceEvent(const char* name, std::uint64_t beginTicks, std::uint64_t endTicks);
+// Append an event to the GPU track, times already converted to traceClockNs. Calls must come from a single thread.
+void recordGpuTraceEvent(const char* name, std::uint64_t beginNs, std::uint64_t endNs);
+
+// Chrome trace event format (chrome://tracing, ui.perfetto.dev). Threads still recording are read up to their last complete event.
+bool writeChromeTrace(const std::string& path);
+
+class TraceScope
+{
+public:
+    explicit TraceScope(const char* name) : _name(tracingEnabled() ? name : nullptr), _begin(_name ? traceTicks() : 0) {}
+    ~TraceScope()
+    {
+        if(_name)
+            recordTraceEvent(_name, _begin, traceTicks());
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* _name;
+    std::uint64_t _begin;
+};
+
+}
+
+#endif
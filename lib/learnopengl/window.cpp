@@ -1,12 +1,47 @@
 #include <learnopengl/window.hpp>
+#include <learnopengl/benchmark.hpp>
+#include <learnopengl/trace.hpp>
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
+#include <array>
+#include <cstdlib>
 #include <iostream>
+#include <map>
 #include <sstream>
+#include <string>
 
 namespace learnopengl {
 
+namespace {
+
+ContextMode currentMode = ContextMode::Window;
+
+// Default render target of headless contexts, a surfaceless context has no default framebuffer
+struct OffscreenTarget
+{
+    std::uint32_t framebuffer = 0;
+    std::uint32_t color = 0;
+    std::uint32_t depthStencil = 0;
+    int width = 0;
+    int height = 0;
+} offscreenTarget;
+
+// Window sizes kept up to date by the size callback, glfwGetWindowSize is a round trip to the display server on X11
+std::map<GLFWwindow*, std::array<int, 2>> windowSizes;
+
+ContextMode contextModeFromEnvironment()
+{
+    const char* value = std::getenv("LEARNOPENGL_HEADLESS");
+    if(!value || !*value || std::string(value) == "0")
+        return ContextMode::Window;
+    if(std::string(value) == "osmesa")
+        return ContextMode::HeadlessOSMesa;
+    return ContextMode::HeadlessEGL;
+}
+
+}
+
 int initGLAD()
 {
     if(!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
@@ -17,13 +52,17 @@ int initGLAD()
     return 0;
 }
 
-int initGLFW()
+int initGLFW(ContextMode mode)
 {
-    glfwInit();
+    // Null platform: no display connection, only the context is created
+    if(mode != ContextMode::Window)
+        glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
 
-    // Use min OpenGL 3.3
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    if(!glfwInit())
+    {
+        std::cout << "Failed to initialize GLFW" << std::endl;
+        return -1;
+    }
 
     // Use OpenGL in Core Profile (vs old opengl, deprecated function are not available here)
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
@@ -31,14 +70,61 @@ int initGLFW()
     glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
 #endif
 
+    if(mode != ContextMode::Window)
+    {
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, mode == ContextMode::HeadlessOSMesa ? GLFW_OSMESA_CONTEXT_API : GLFW_EGL_CONTEXT_API);
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    }
+
     return 0;
 }
 
+void createOffscreenTarget(int width, int height)
+{
+    auto& target = offscreenTarget;
+    target.width = width;
+    target.height = height;
+
+    glGenRenderbuffers(1, &target.color);
+    glBindRenderbuffer(GL_RENDERBUFFER, target.color);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+
+    glGenRenderbuffers(1, &target.depthStencil);
+    glBindRenderbuffer(GL_RENDERBUFFER, target.depthStencil);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &target.framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, target.framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, target.color);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, target.depthStencil);
+    if(glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        std::cout << "Offscreen framebuffer is incomplete" << std::endl;
+
+    // Stay bound: demos render to it as if it was the window
+    glViewport(0, 0, width, height);
+}
+
 void framebufferSizeCallback(GLFWwindow* window, int width, int height) { glViewport(0, 0, width, height); }
 
+void windowSizeCallback(GLFWwindow* window, int width, int height) { windowSizes[window] = {width, height}; }
+
 GLFWwindow* createWindowContext(const char* title, int width = 800, int height = 600)
 {
-    GLFWwindow* window = glfwCreateWindow(width, height, title, nullptr, nullptr);
+    // Ask for the most recent context first (multi draw indirect, SSBO & compute require 4.3).
+    // Min OpenGL 3.3
+    constexpr int versions[][2] = {{4, 6}, {4, 5}, {4, 3}, {4, 1}, {3, 3}};
+
+    GLFWwindow* window = nullptr;
+    for(const auto& version: versions)
+    {
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, version[0]);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, version[1]);
+        window = glfwCreateWindow(width, height, title, nullptr, nullptr);
+        if(window)
+            break;
+    }
+
     if(window == nullptr)
     {
         std::cout << "Failed to create GLFW window" << std::endl;
@@ -47,18 +133,23 @@ GLFWwindow* createWindowContext(const char* title, int width = 800, int height =
     }
     glfwMakeContextCurrent(window);
     glfwSetFramebufferSizeCallback(window, framebufferSizeCallback);
+    glfwSetWindowSizeCallback(window, windowSizeCallback);
 
-    glfwSwapInterval(1);
+    // No display to synchronize with when headless
+    glfwSwapInterval(currentMode == ContextMode::Window ? 1 : 0);
 
     return window;
 }
-struct GLFWwindow* createWindow(int width, int height)
+GLFWwindow* createWindow(int width, int height) { return createWindow(width, height, contextModeFromEnvironment()); }
+
+GLFWwindow* createWindow(int width, int height, ContextMode mode)
 {
-    if(initGLFW() < 0)
+    currentMode = mode;
+    if(initGLFW(mode) < 0)
         return nullptr;
 
     // Create a valid openGl Context
-    auto* window = createWindowContext("LearnOpenGL");
+    auto* window = createWindowContext("LearnOpenGL", width, height);
     if(!window)
         return nullptr;
 
@@ -71,7 +162,40 @@ struct GLFWwindow* createWindow(int width, int height)
     std::cout << "GL Version : " << glGetString(GL_VERSION) << std::endl;
     std::cout << "Maximum nr of vertex attributes supported: " << nrAttributes << std::endl;
 
+    if(isHeadless())
+        createOffscreenTarget(width, height);
+
+    // Fixed workload when LEARNOPENGL_BENCHMARK is set
+    Benchmark::startFromEnvironment();
+    // Chrome trace written at exit when LEARNOPENGL_TRACE is set
+    startTracingFromEnvironment();
+
     return window;
 }
 
+ContextMode contextMode() { return currentMode; }
+
+bool isHeadless() { return currentMode != ContextMode::Window; }
+
+void getWindowSize(GLFWwindow* window, int* width, int* height)
+{
+    if(isHeadless())
+    {
+        *width = offscreenTarget.width;
+        *height = offscreenTarget.height;
+        return;
+    }
+    auto size = windowSizes.find(window);
+    if(size == windowSizes.end())
+    {
+        std::array<int, 2> windowSize = {};
+        glfwGetWindowSize(window, &windowSize[0], &windowSize[1]);
+        size = windowSizes.emplace(window, windowSize).first;
+    }
+    *width = size->second[0];
+    *height = size->second[1];
+}
+
+std::uint32_t defaultFramebuffer() { return offscreenTarget.framebuffer; }
+
 }
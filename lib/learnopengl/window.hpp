@@ -1,11 +1,36 @@
 #ifndef __LEARNOPENGL_WINDOW_HPP__
 #define __LEARNOPENGL_WINDOW_HPP__
 
+#include <cstdint>
+
 struct GLFWwindow;
 
 namespace learnopengl {
 
+enum class ContextMode
+{
+    // Visible window, vsync on
+    Window,
+    // No window system: surfaceless EGL context rendering into an offscreen framebuffer, vsync off
+    HeadlessEGL,
+    // Same with an OSMesa (llvmpipe) software context, for machines without GPU
+    HeadlessOSMesa,
+};
+
+// Mode is read from the LEARNOPENGL_HEADLESS environment variable:
+// unset, empty or "0" -> Window, "osmesa" -> HeadlessOSMesa, anything else -> HeadlessEGL
 GLFWwindow* createWindow(int width = 800, int height = 600);
+GLFWwindow* createWindow(int width, int height, ContextMode mode);
+
+// Mode of the last created window
+[[nodiscard]] ContextMode contextMode();
+[[nodiscard]] bool isHeadless();
+
+// Size of the render target: window size (cached, updated by the window size callback), or offscreen framebuffer size when headless
+void getWindowSize(GLFWwindow* window, int* width, int* height);
+
+// Framebuffer to bind to render "on screen": 0, or the offscreen framebuffer when headless
+[[nodiscard]] std::uint32_t defaultFramebuffer();
 
 }
 
@@ -0,0 +1,11 @@
+// Result of learnopengl::AmbientOcclusion for lighting passes of the same size, set by AmbientOcclusion::bind (unbind leaves
+// every pixel unoccluded). Include after #version: #include "/resources/shaders/ambientocclusion.glsl"
+
+uniform sampler2D ambientOcclusion;
+uniform bool ambientOcclusionEnabled;
+
+// Visibility of the ambient light at a pixel, from 0 occluded to 1
+float ambientVisibility(ivec2 pixel)
+{
+    return ambientOcclusionEnabled ? texelFetch(ambientOcclusion, pixel, 0).r : 1.0;
+}
@@ -0,0 +1,70 @@
+#version 330 core
+// Downsample of learnopengl::PostProcess mip chain bloom: 13 taps as 5 overlapping 2x2 box groups of the source level around the
+// destination pixel. The first level weights each group by 1 / (1 + luma), the Karis average that keeps single very bright
+// pixels from blinking, and leaves out the luminance below threshold.
+out vec4 FragColor;
+
+uniform sampler2D source;
+uniform vec2 inverseDestinationSize;
+uniform bool firstLevel;
+uniform float threshold;
+
+float luma(vec3 color)
+{
+    return dot(color, vec3(0.2126, 0.7152, 0.0722));
+}
+
+float karisWeight(vec3 color)
+{
+    return 1.0 / (1.0 + luma(color));
+}
+
+void main()
+{
+    vec2 uv = gl_FragCoord.xy * inverseDestinationSize;
+    vec2 texel = 1.0 / vec2(textureSize(source, 0));
+
+    // a . b . c
+    // . j . k .
+    // d . e . f
+    // . l . m .
+    // g . h . i
+    vec3 a = texture(source, uv + texel * vec2(-2.0, 2.0)).rgb;
+    vec3 b = texture(source, uv + texel * vec2(0.0, 2.0)).rgb;
+    vec3 c = texture(source, uv + texel * vec2(2.0, 2.0)).rgb;
+    vec3 d = texture(source, uv + texel * vec2(-2.0, 0.0)).rgb;
+    vec3 e = texture(source, uv).rgb;
+    vec3 f = texture(source, uv + texel * vec2(2.0, 0.0)).rgb;
+    vec3 g = texture(source, uv + texel * vec2(-2.0, -2.0)).rgb;
+    vec3 h = texture(source, uv + texel * vec2(0.0, -2.0)).rgb;
+    vec3 i = texture(source, uv + texel * vec2(2.0, -2.0)).rgb;
+    vec3 j = texture(source, uv + texel * vec2(-1.0, 1.0)).rgb;
+    vec3 k = texture(source, uv + texel * vec2(1.0, 1.0)).rgb;
+    vec3 l = texture(source, uv + texel * vec2(-1.0, -1.0)).rgb;
+    vec3 m = texture(source, uv + texel * vec2(1.0, -1.0)).rgb;
+
+    vec3 color;
+    if(firstLevel)
+    {
+        vec3 groups[5] = vec3[5]((j + k + l + m) * 0.25, (a + b + d + e) * 0.25, (b + c + e + f) * 0.25, (d + e + g + h) * 0.25,
+            (e + f + h + i) * 0.25);
+        float weights[5] = float[5](0.5, 0.125, 0.125, 0.125, 0.125);
+        color = vec3(0.0);
+        float weightSum = 0.0;
+        for(int group = 0; group < 5; ++group)
+        {
+            float weight = weights[group] * karisWeight(groups[group]);
+            color += groups[group] * weight;
+            weightSum += weight;
+        }
+        color /= weightSum;
+
+        float luminance = luma(color);
+        color *= max(luminance - threshold, 0.0) / max(luminance, 1e-4);
+    }
+    else
+    {
+        color = e * 0.125 + (a + c + g + i) * 0.03125 + (b + d + f + h) * 0.0625 + (j + k + l + m) * 0.125;
+    }
+    FragColor = vec4(max(color, vec3(0.0)), 1.0);
+}
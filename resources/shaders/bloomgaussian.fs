@@ -0,0 +1,34 @@
+#version 330 core
+// Full resolution gaussian bloom of learnopengl::PostProcess, the LearnOpenGL bloom chapter blur: one direction of a 9 taps
+// separable kernel per pass. The first pass reads the scene and leaves out the luminance below threshold.
+out vec4 FragColor;
+
+uniform sampler2D source;
+uniform bool horizontal;
+uniform bool firstPass;
+uniform float threshold;
+
+const float weights[5] = float[5](0.2270270270, 0.1945945946, 0.1216216216, 0.0540540541, 0.0162162162);
+
+vec3 fetch(vec2 uv)
+{
+    vec3 color = texture(source, uv).rgb;
+    if(firstPass)
+    {
+        float luminance = dot(color, vec3(0.2126, 0.7152, 0.0722));
+        color *= max(luminance - threshold, 0.0) / max(luminance, 1e-4);
+    }
+    return color;
+}
+
+void main()
+{
+    vec2 texel = 1.0 / vec2(textureSize(source, 0));
+    vec2 uv = gl_FragCoord.xy * texel;
+    vec2 direction = horizontal ? vec2(texel.x, 0.0) : vec2(0.0, texel.y);
+
+    vec3 color = fetch(uv) * weights[0];
+    for(int i = 1; i < 5; ++i)
+        color += (fetch(uv + direction * float(i)) + fetch(uv - direction * float(i))) * weights[i];
+    FragColor = vec4(color, 1.0);
+}
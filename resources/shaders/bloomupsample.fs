@@ -0,0 +1,20 @@
+#version 330 core
+// Upsample of learnopengl::PostProcess mip chain bloom: 3x3 tent filter of the smaller level, added by blending to the downsample of
+// the destination level.
+out vec4 FragColor;
+
+uniform sampler2D source;
+uniform vec2 inverseDestinationSize;
+
+void main()
+{
+    vec2 uv = gl_FragCoord.xy * inverseDestinationSize;
+    vec2 texel = 1.0 / vec2(textureSize(source, 0));
+
+    vec3 color = texture(source, uv).rgb * 4.0;
+    color += (texture(source, uv + vec2(-texel.x, 0.0)).rgb + texture(source, uv + vec2(texel.x, 0.0)).rgb
+        + texture(source, uv + vec2(0.0, -texel.y)).rgb + texture(source, uv + vec2(0.0, texel.y)).rgb) * 2.0;
+    color += texture(source, uv - texel).rgb + texture(source, uv + texel).rgb + texture(source, uv + vec2(-texel.x, texel.y)).rgb
+        + texture(source, uv + vec2(texel.x, -texel.y)).rgb;
+    FragColor = vec4(color / 16.0, 1.0);
+}
@@ -0,0 +1,39 @@
+// Clustered forward lighting, the buffers and uniforms are set by learnopengl::ClusteredLighting::bind.
+// Include in a fragment shader after #version: #include "/resources/shaders/clusteredlighting.glsl"
+
+#include "/resources/shaders/packedlights.glsl"
+
+// Lights packed by learnopengl::PackedLights
+uniform samplerBuffer clusterLightData;
+// Offset and count of the lights of each cluster in clusterLightIndices
+uniform usamplerBuffer clusterRanges;
+uniform usamplerBuffer clusterLightIndices;
+
+// Tile count in x and y, slice count
+uniform vec3 clusterGrid;
+// Slice scale and bias (slice = log(depth) * scale + bias), viewport size in pixels
+uniform vec4 clusterDepth;
+
+int clusterIndex()
+{
+    // With a perspective projection 1 / w is the view space depth
+    float depth = 1.0 / gl_FragCoord.w;
+    int slice = clamp(int(floor(log(depth) * clusterDepth.x + clusterDepth.y)), 0, int(clusterGrid.z) - 1);
+    ivec2 tile = clamp(ivec2(gl_FragCoord.xy / clusterDepth.zw * clusterGrid.xy), ivec2(0), ivec2(clusterGrid.xy) - 1);
+    return (slice * int(clusterGrid.y) + tile.y) * int(clusterGrid.x) + tile.x;
+}
+
+// Sum of the point and spot lights of the fragment cluster
+vec3 computeClusteredLights(vec3 diffuseColor, vec3 specularColor, float shininess, vec3 normal, vec3 fragPos, vec3 cameraPos)
+{
+    vec3 norm = normalize(normal);
+    uvec2 range = texelFetch(clusterRanges, clusterIndex()).xy;
+
+    vec3 result = vec3(0.0);
+    for(uint i = 0u; i < range.y; ++i)
+    {
+        int light = int(texelFetch(clusterLightIndices, int(range.x + i)).x);
+        result += computePackedLight(clusterLightData, light, diffuseColor, specularColor, shininess, norm, fragPos, cameraPos);
+    }
+    return result;
+}
@@ -0,0 +1,31 @@
+#version 330 core
+out vec4 FragColor;
+
+#include "/resources/shaders/gbuffer.glsl"
+#include "/resources/shaders/packedlights.glsl"
+#include "/resources/shaders/directionlight.glsl"
+
+uniform DirectionLight directionLight;
+uniform vec3 cameraPos;
+uniform float shininess;
+
+// Lights packed by learnopengl::PackedLights, all evaluated here in full screen mode (lightCount is 0 otherwise)
+uniform samplerBuffer lightData;
+uniform int lightCount;
+
+void main()
+{
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    vec4 albedoSpecular = texelFetch(gbufferAlbedoSpecular, pixel, 0);
+    vec3 normal = decodeNormal(texelFetch(gbufferNormal, pixel, 0));
+    vec3 fragPos = gbufferPosition(pixel, texelFetch(gbufferDepth, pixel, 0).r);
+
+    vec3 diffuseColor = albedoSpecular.rgb;
+    vec3 specularColor = vec3(albedoSpecular.a);
+
+    vec3 result = computeDirectionLight(directionLight, diffuseColor, specularColor, shininess, normal, fragPos, cameraPos);
+    for(int light = 0; light < lightCount; ++light)
+        result += computePackedLight(lightData, light, diffuseColor, specularColor, shininess, normal, fragPos, cameraPos);
+
+    FragColor = vec4(result, 1.0);
+}
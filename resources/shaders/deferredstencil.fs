@@ -0,0 +1,5 @@
+#version 330 core
+// Stencil only pass of the light volumes, no color is written
+void main()
+{
+}
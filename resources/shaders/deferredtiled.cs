@@ -0,0 +1,128 @@
+#version 430 core
+// Tiled deferred lighting of learnopengl::DeferredLighting::Mode::Tiled. One work group per 16x16 pixels screen tile bounds the view depth
+// of the tile geometry, lists in shared memory the lights whose bounding sphere reaches into the tile, then shades its pixels with the
+// direction light and the listed lights, reading the geometry buffer once. learnopengl::LightTileGrid is the CPU reference of the culling.
+layout (local_size_x = 16, local_size_y = 16) in;
+
+#include "/resources/shaders/gbuffer.glsl"
+#include "/resources/shaders/packedlights.glsl"
+#include "/resources/shaders/directionlight.glsl"
+
+// Light target of the geometry buffer, pixels without geometry are left as cleared
+uniform writeonly image2D lightImage;
+
+// Lights reaching each tile before the list is capped, tiles by rows from the bottom left
+layout (std430, binding = 0) writeonly buffer TileLightCounts
+{
+    uint tileLightCounts[];
+};
+
+uniform DirectionLight directionLight;
+uniform vec3 cameraPos;
+uniform float shininess;
+
+// Lights packed by learnopengl::PackedLights and their world space bounding sphere (center, radius)
+uniform samplerBuffer lightData;
+uniform samplerBuffer lightBounds;
+uniform int lightCount;
+
+uniform mat4 view;
+// projection[0][0], projection[1][1], projection[2][2], projection[3][2]
+uniform vec4 projectionScales;
+// Stored depth of the pixels without geometry
+uniform float clearDepth;
+
+// Same as learnopengl::LightTileGrid::MaxLightsPerTile
+const uint MaxLightsPerTile = 1024u;
+
+shared uint tileMinDepth;
+shared uint tileMaxDepth;
+shared uint tileLightCount;
+shared uint tileLights[MaxLightsPerTile];
+
+// View depth of a stored depth: ndc z = (projection[2][2] * z + projection[3][2]) / -z
+float viewDepth(float depth)
+{
+    float ndc = depth * gbufferDepthToNdc.x + gbufferDepthToNdc.y;
+    return projectionScales.w / (ndc + projectionScales.z);
+}
+
+void main()
+{
+    ivec2 size = ivec2(gbufferDepthToNdc.zw);
+    ivec2 pixel = ivec2(gl_GlobalInvocationID.xy);
+    bool inside = pixel.x < size.x && pixel.y < size.y;
+
+    if(gl_LocalInvocationIndex == 0u)
+    {
+        tileMinDepth = 0xFFFFFFFFu;
+        tileMaxDepth = 0u;
+        tileLightCount = 0u;
+    }
+    barrier();
+
+    // Depths are positive: their bits sort as the floats do
+    float depth = inside ? texelFetch(gbufferDepth, pixel, 0).r : clearDepth;
+    bool geometry = depth != clearDepth;
+    if(geometry)
+    {
+        atomicMin(tileMinDepth, floatBitsToUint(depth));
+        atomicMax(tileMaxDepth, floatBitsToUint(depth));
+    }
+    barrier();
+
+    // Tiles without geometry list no light
+    if(tileMinDepth <= tileMaxDepth)
+    {
+        float depth0 = viewDepth(uintBitsToFloat(tileMinDepth));
+        float depth1 = viewDepth(uintBitsToFloat(tileMaxDepth));
+        float minDepth = min(depth0, depth1);
+        float maxDepth = max(depth0, depth1);
+
+        // Side planes through the camera, normals pointing inside: ndc x = projection[0][0] * x / -z
+        vec2 tileMin = vec2(gl_WorkGroupID.xy * gl_WorkGroupSize.xy) / vec2(size) * 2.0 - 1.0;
+        vec2 tileMax = vec2(min((gl_WorkGroupID.xy + 1u) * gl_WorkGroupSize.xy, uvec2(size))) / vec2(size) * 2.0 - 1.0;
+        vec3 left = normalize(vec3(projectionScales.x, 0.0, tileMin.x));
+        vec3 right = normalize(vec3(-projectionScales.x, 0.0, -tileMax.x));
+        vec3 bottom = normalize(vec3(0.0, projectionScales.y, tileMin.y));
+        vec3 top = normalize(vec3(0.0, -projectionScales.y, -tileMax.y));
+
+        uint threadCount = gl_WorkGroupSize.x * gl_WorkGroupSize.y;
+        for(uint light = gl_LocalInvocationIndex; light < uint(lightCount); light += threadCount)
+        {
+            vec4 sphere = texelFetch(lightBounds, int(light));
+            vec3 center = (view * vec4(sphere.xyz, 1.0)).xyz;
+            float radius = sphere.w;
+            float centerDepth = -center.z;
+            if(centerDepth + radius < minDepth || centerDepth - radius > maxDepth || dot(left, center) < -radius
+               || dot(right, center) < -radius || dot(bottom, center) < -radius || dot(top, center) < -radius)
+                continue;
+
+            uint index = atomicAdd(tileLightCount, 1u);
+            if(index < MaxLightsPerTile)
+                tileLights[index] = light;
+        }
+    }
+    barrier();
+
+    uint tileCountX = gl_NumWorkGroups.x;
+    if(gl_LocalInvocationIndex == 0u)
+        tileLightCounts[gl_WorkGroupID.y * tileCountX + gl_WorkGroupID.x] = tileLightCount;
+
+    if(!inside || !geometry)
+        return;
+
+    vec4 albedoSpecular = texelFetch(gbufferAlbedoSpecular, pixel, 0);
+    vec3 normal = decodeNormal(texelFetch(gbufferNormal, pixel, 0));
+    vec3 fragPos = gbufferPosition(pixel, depth);
+
+    vec3 diffuseColor = albedoSpecular.rgb;
+    vec3 specularColor = vec3(albedoSpecular.a);
+
+    vec3 result = computeDirectionLight(directionLight, diffuseColor, specularColor, shininess, normal, fragPos, cameraPos);
+    uint count = min(tileLightCount, MaxLightsPerTile);
+    for(uint i = 0u; i < count; ++i)
+        result += computePackedLight(lightData, int(tileLights[i]), diffuseColor, specularColor, shininess, normal, fragPos, cameraPos);
+
+    imageStore(lightImage, pixel, vec4(result, 1.0));
+}
@@ -0,0 +1,23 @@
+#version 330 core
+out vec4 FragColor;
+
+flat in int lightIndex;
+
+#include "/resources/shaders/gbuffer.glsl"
+#include "/resources/shaders/packedlights.glsl"
+
+uniform vec3 cameraPos;
+uniform float shininess;
+uniform samplerBuffer lightData;
+
+// Contribution of one light, added to the light target by blending
+void main()
+{
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    vec4 albedoSpecular = texelFetch(gbufferAlbedoSpecular, pixel, 0);
+    vec3 normal = decodeNormal(texelFetch(gbufferNormal, pixel, 0));
+    vec3 fragPos = gbufferPosition(pixel, texelFetch(gbufferDepth, pixel, 0).r);
+
+    vec3 result = computePackedLight(lightData, lightIndex, albedoSpecular.rgb, vec3(albedoSpecular.a), shininess, normal, fragPos, cameraPos);
+    FragColor = vec4(result, 0.0);
+}
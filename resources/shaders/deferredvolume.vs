@@ -0,0 +1,17 @@
+#version 330 core
+// Unit sphere, scaled by volumeScale so that its faces hold the unit sphere
+layout (location = 0) in vec3 aPos;
+// Per instance bounding sphere of the light (center, radius), instance i is light i of lightData
+layout (location = 3) in vec4 aSphere;
+
+uniform mat4 view;
+uniform mat4 projection;
+uniform float volumeScale;
+
+flat out int lightIndex;
+
+void main()
+{
+    lightIndex = gl_InstanceID;
+    gl_Position = projection * view * vec4(aSphere.xyz + aPos * (aSphere.w * volumeScale), 1.0);
+}
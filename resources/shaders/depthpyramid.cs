@@ -0,0 +1,51 @@
+#version 430 core
+// One level of learnopengl::DepthPyramid: level 0 copies the depth texture, the next levels keep the farthest depth of the 2x2
+// texels of the level above. Mip levels round down, so the last row and column of an odd sized level also cover its last texel.
+layout (local_size_x = 8, local_size_y = 8) in;
+
+// Depth texture for level 0, the pyramid otherwise
+uniform sampler2D source;
+uniform int sourceLevel;
+uniform int sourceWidth;
+uniform int sourceHeight;
+uniform bool reduce;
+// Farthest is the smallest depth
+uniform bool reverseZ;
+
+layout (r32f) uniform writeonly image2D destination;
+
+float farthest(float a, float b)
+{
+    return reverseZ ? min(a, b) : max(a, b);
+}
+
+void main()
+{
+    ivec2 texel = ivec2(gl_GlobalInvocationID.xy);
+    ivec2 size = imageSize(destination);
+    if(texel.x >= size.x || texel.y >= size.y)
+        return;
+
+    if(!reduce)
+    {
+        imageStore(destination, texel, vec4(texelFetch(source, texel, 0).r));
+        return;
+    }
+
+    // Footprint in the level above, 3 texels wide on the last column (row) when the source width (height) is odd
+    ivec2 last = ivec2(sourceWidth, sourceHeight) - 1;
+    ivec2 texel0 = min(texel * 2, last);
+    ivec2 texel1 = min(texel * 2 + 1, last);
+    if(texel.x == size.x - 1)
+        texel1.x = last.x;
+    if(texel.y == size.y - 1)
+        texel1.y = last.y;
+
+    float depth = texelFetch(source, texel0, sourceLevel).r;
+    for(int y = texel0.y; y <= texel1.y; ++y)
+    {
+        for(int x = texel0.x; x <= texel1.x; ++x)
+            depth = farthest(depth, texelFetch(source, ivec2(x, y), sourceLevel).r);
+    }
+    imageStore(destination, texel, vec4(depth));
+}
@@ -0,0 +1,68 @@
+// Hi-Z occlusion test against learnopengl::DepthPyramid, uniforms set by learnopengl::DepthPyramid::bind.
+// Same test as learnopengl::OcclusionBuffer::occluded, in stored depth instead of 1 / w.
+
+uniform sampler2D depthPyramid;
+// 0 until the pyramid is built
+uniform int depthPyramidLevels;
+uniform int depthPyramidWidth;
+uniform int depthPyramidHeight;
+// Camera of the frame the pyramid was built from
+uniform mat4 depthPyramidViewProjection;
+uniform bool depthPyramidReverseZ;
+uniform bool depthPyramidZeroToOne;
+
+// World space box of center and extent behind the depth of the pyramid. False when the box crosses the near plane or is off screen.
+bool occludedByDepthPyramid(vec3 center, vec3 extent)
+{
+    if(depthPyramidLevels == 0)
+        return false;
+
+    vec2 size = vec2(depthPyramidWidth, depthPyramidHeight);
+    vec2 minScreen = size;
+    vec2 maxScreen = vec2(0.0);
+    float nearest = depthPyramidReverseZ ? 0.0 : 1.0;
+    for(int corner = 0; corner < 8; ++corner)
+    {
+        vec3 side = vec3((corner & 1) != 0 ? 1.0 : -1.0, (corner & 2) != 0 ? 1.0 : -1.0, (corner & 4) != 0 ? 1.0 : -1.0);
+        vec4 clip = depthPyramidViewProjection * vec4(center + side * extent, 1.0);
+        if(clip.w <= 0.0)
+            return false;
+
+        vec3 ndc = clip.xyz / clip.w;
+        float depth = depthPyramidZeroToOne ? ndc.z : ndc.z * 0.5 + 0.5;
+        // In front of the near plane
+        if(depth < 0.0 || depth > 1.0)
+            return false;
+
+        vec2 screen = (ndc.xy * 0.5 + 0.5) * size;
+        minScreen = min(minScreen, screen);
+        maxScreen = max(maxScreen, screen);
+        nearest = depthPyramidReverseZ ? max(nearest, depth) : min(nearest, depth);
+    }
+    if(maxScreen.x < 0.0 || maxScreen.y < 0.0 || minScreen.x >= size.x || minScreen.y >= size.y)
+        return false;
+
+    ivec2 lastTexel = ivec2(depthPyramidWidth, depthPyramidHeight) - 1;
+    ivec2 texel0 = clamp(ivec2(minScreen), ivec2(0), lastTexel);
+    ivec2 texel1 = clamp(ivec2(maxScreen), ivec2(0), lastTexel);
+
+    // Smallest level where the rectangle spans at most 2x2 texels
+    int span = max(texel1.x - texel0.x, texel1.y - texel0.y);
+    int level = max(findMSB(span), 0);
+    ivec2 levelTexels = (texel1 >> level) - (texel0 >> level);
+    if(levelTexels.x > 1 || levelTexels.y > 1)
+        ++level;
+    level = min(level, depthPyramidLevels - 1);
+
+    // Levels round down: the last row and column of odd sizes were folded in the last texel of the next level
+    ivec2 levelLastTexel = max(ivec2(depthPyramidWidth, depthPyramidHeight) >> level, ivec2(1)) - 1;
+    texel0 = min(texel0 >> level, levelLastTexel);
+    texel1 = min(texel1 >> level, levelLastTexel);
+    float depth00 = texelFetch(depthPyramid, texel0, level).r;
+    float depth10 = texelFetch(depthPyramid, ivec2(texel1.x, texel0.y), level).r;
+    float depth01 = texelFetch(depthPyramid, ivec2(texel0.x, texel1.y), level).r;
+    float depth11 = texelFetch(depthPyramid, texel1, level).r;
+    if(depthPyramidReverseZ)
+        return nearest < min(min(depth00, depth10), min(depth01, depth11));
+    return nearest > max(max(depth00, depth10), max(depth01, depth11));
+}
@@ -0,0 +1,34 @@
+// Direction light as set by learnopengl::Shader::setDirectionLight
+
+struct DirectionLight
+{
+    vec3 direction;
+
+    vec3 ambient;
+    vec3 diffuse;
+    vec3 specular;
+};
+
+// Phong lighting of a fragment, normal is normalized. Diffuse and specular are scaled by lit, e.g. from a shadow map.
+vec3 computeDirectionLight(DirectionLight light, vec3 diffuseColor, vec3 specularColor, float shininess, vec3 normal, vec3 fragPos,
+                           vec3 cameraPos, float lit)
+{
+    vec3 ambient = light.ambient * diffuseColor;
+
+    vec3 lightDir = normalize(-light.direction);
+    float diff = max(dot(normal, lightDir), 0.0);
+    vec3 diffuse = light.diffuse * (diff * diffuseColor);
+
+    vec3 viewDir = normalize(cameraPos - fragPos);
+    vec3 reflectDir = reflect(-lightDir, normal);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), shininess);
+    vec3 specular = light.specular * (spec * specularColor);
+
+    return ambient + (diffuse + specular) * lit;
+}
+
+vec3 computeDirectionLight(DirectionLight light, vec3 diffuseColor, vec3 specularColor, float shininess, vec3 normal, vec3 fragPos,
+                           vec3 cameraPos)
+{
+    return computeDirectionLight(light, diffuseColor, specularColor, shininess, normal, fragPos, cameraPos, 1.0);
+}
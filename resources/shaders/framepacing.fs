@@ -0,0 +1,10 @@
+#version 330 core
+
+flat in vec4 color;
+
+out vec4 fragColor;
+
+void main()
+{
+    fragColor = color;
+}
@@ -0,0 +1,31 @@
+#version 330 core
+
+// One bar per frame interval, instanced: the quad is built from gl_VertexID
+layout (location = 0) in float interval;
+
+// Graph rectangle in normalized device coordinates: x, y, width, height
+uniform vec4 rect;
+uniform int barCount;
+uniform float budgetMs;
+uniform float stutterMs;
+// Interval at the top of the graph
+uniform float scaleMs;
+
+flat out vec4 color;
+
+void main()
+{
+    vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);
+    float height = min(interval / scaleMs, 1.0);
+
+    float x = rect.x + (float(gl_InstanceID) + corner.x) * rect.z / float(barCount);
+    float y = rect.y + corner.y * height * rect.w;
+    gl_Position = vec4(x, y, 0.0, 1.0);
+
+    if(interval > stutterMs)
+        color = vec4(0.96, 0.26, 0.21, 0.9);
+    else if(interval > budgetMs)
+        color = vec4(1.0, 0.76, 0.03, 0.9);
+    else
+        color = vec4(0.55, 0.76, 0.29, 0.9);
+}
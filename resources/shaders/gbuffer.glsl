@@ -0,0 +1,52 @@
+// Geometry buffer of learnopengl::GBuffer: samplers and reconstruction uniforms are set by GBuffer::bind,
+// gbufferOctahedral by GBuffer::setEncoding in geometry pass shaders.
+// Include after #version: #include "/resources/shaders/gbuffer.glsl"
+
+// Albedo rgb, specular intensity a
+uniform sampler2D gbufferAlbedoSpecular;
+uniform sampler2D gbufferNormal;
+uniform sampler2D gbufferDepth;
+
+// Octahedral normal in two unsigned normalized channels, xyz otherwise
+uniform bool gbufferOctahedral;
+uniform mat4 gbufferInverseViewProjection;
+// Stored depth to clip depth scale and bias, size in pixels
+uniform vec4 gbufferDepthToNdc;
+
+vec2 octahedralWrap(vec2 v)
+{
+    return (1.0 - abs(v.yx)) * vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);
+}
+
+// Value of the normal target for a world space normal
+vec4 encodeNormal(vec3 normal)
+{
+    vec3 n = normalize(normal);
+    if(!gbufferOctahedral)
+        return vec4(n, 0.0);
+
+    // Project on the octahedron, fold the lower half over the upper one
+    n /= abs(n.x) + abs(n.y) + abs(n.z);
+    vec2 encoded = n.z >= 0.0 ? n.xy : octahedralWrap(n.xy);
+    return vec4(encoded * 0.5 + 0.5, 0.0, 0.0);
+}
+
+vec3 decodeNormal(vec4 texel)
+{
+    if(!gbufferOctahedral)
+        return normalize(texel.xyz);
+
+    vec2 f = texel.xy * 2.0 - 1.0;
+    vec3 n = vec3(f, 1.0 - abs(f.x) - abs(f.y));
+    float t = max(-n.z, 0.0);
+    n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);
+    return normalize(n);
+}
+
+// World space position of the pixel, from its stored depth
+vec3 gbufferPosition(ivec2 pixel, float depth)
+{
+    vec2 uv = (vec2(pixel) + 0.5) / gbufferDepthToNdc.zw;
+    vec4 world = gbufferInverseViewProjection * vec4(uv * 2.0 - 1.0, depth * gbufferDepthToNdc.x + gbufferDepthToNdc.y, 1.0);
+    return world.xyz / world.w;
+}
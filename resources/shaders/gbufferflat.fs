@@ -0,0 +1,14 @@
+#version 330 core
+// Geometry pass of white surfaces with full specular intensity, for benchmarks without textures
+layout (location = 0) out vec4 gAlbedoSpecular;
+layout (location = 1) out vec4 gNormal;
+
+in vec3 Normal;
+
+#include "/resources/shaders/gbuffer.glsl"
+
+void main()
+{
+    gAlbedoSpecular = vec4(1.0);
+    gNormal = encodeNormal(Normal);
+}
@@ -7,6 +7,8 @@ uniform mat4 viewMatrix;
 uniform mat4 viewProjectionMatrix;
 uniform float nearPlane;
 uniform float farPlane;
+// Clip depth is window depth with glClipControl zero to one
+uniform bool zeroToOneDepth;
 
 uniform vec4 lineColor;
 uniform vec4 backgroundColor;
@@ -50,7 +52,8 @@ vec4 grid(vec3 pos, vec3 color, float width, float size)
 float computeDepth(vec3 point)
 {
     vec4 clipPoint = viewProjectionMatrix * vec4(point.xyz, 1);
-    return (clipPoint.z / clipPoint.w)/2 + 0.5;
+    float depth = clipPoint.z / clipPoint.w;
+    return zeroToOneDepth ? depth : depth / 2 + 0.5;
 }
 
 void main()
@@ -3,6 +3,8 @@
 in vec2 vertexPosition;
 
 uniform mat4 inverseViewProjectionMatrix;
+uniform float nearPointDepth;
+uniform float farPointDepth;
 
 out vec3 nearPoint;
 out vec3 farPoint;
@@ -17,8 +19,8 @@ vec3 projectPoint(vec3 point, mat4 projectMatrix)
 void main()
 {
     // Compute nearPoint and farPoint in view space
-    nearPoint = projectPoint(vec3(vertexPosition, 0), inverseViewProjectionMatrix);
-    farPoint = projectPoint(vec3(vertexPosition, 1), inverseViewProjectionMatrix);
+    nearPoint = projectPoint(vec3(vertexPosition, nearPointDepth), inverseViewProjectionMatrix);
+    farPoint = projectPoint(vec3(vertexPosition, farPointDepth), inverseViewProjectionMatrix);
 
     // This geometry must fill the whole viewport
     gl_Position = vec4(vertexPosition, 0, 1);
@@ -0,0 +1,44 @@
+#version 430 core
+// Average of the learnopengl::PostProcess luminance histogram, bin 0 left out, then exponential adaptation of the luminance kept
+// in a 1x1 image. The bins are cleared for the next frame.
+layout (local_size_x = 256) in;
+
+layout (std430, binding = 0) buffer Histogram
+{
+    uint bins[256];
+};
+
+uniform float minLogLuminance;
+uniform float logRange;
+uniform int pixelCount;
+// 1 - exp(-deltaTime * rate), 1 to jump to the average
+uniform float adaptation;
+
+layout (r32f) uniform image2D adaptedLuminance;
+
+shared float weightedCounts[256];
+
+void main()
+{
+    uint bin = gl_LocalInvocationIndex;
+    uint count = bins[bin];
+    weightedCounts[bin] = float(count) * float(bin);
+    bins[bin] = 0u;
+    barrier();
+
+    for(uint stride = 128u; stride > 0u; stride >>= 1u)
+    {
+        if(bin < stride)
+            weightedCounts[bin] += weightedCounts[bin + stride];
+        barrier();
+    }
+
+    if(bin == 0u)
+    {
+        // count is the one of bin 0 here
+        float averageBin = weightedCounts[0] / max(float(pixelCount) - float(count), 1.0);
+        float average = exp2((averageBin - 1.0) / 254.0 * logRange + minLogLuminance);
+        float last = imageLoad(adaptedLuminance, ivec2(0)).r;
+        imageStore(adaptedLuminance, ivec2(0), vec4(last + (average - last) * adaptation));
+    }
+}
@@ -0,0 +1,40 @@
+#version 430 core
+// Log luminance histogram of learnopengl::PostProcess auto exposure: bin 0 counts the pixels darker than the range, the 255 others
+// split minLogLuminance to minLogLuminance + range. Each group counts in shared memory first, then adds to the buffer.
+layout (local_size_x = 16, local_size_y = 16) in;
+
+layout (std430, binding = 0) buffer Histogram
+{
+    uint bins[256];
+};
+
+uniform sampler2D scene;
+uniform float minLogLuminance;
+uniform float inverseLogRange;
+
+shared uint groupBins[256];
+
+uint binOf(vec3 color)
+{
+    float luminance = dot(color, vec3(0.2126, 0.7152, 0.0722));
+    if(luminance < 1e-5)
+        return 0u;
+    float position = clamp((log2(luminance) - minLogLuminance) * inverseLogRange, 0.0, 1.0);
+    return uint(position * 254.0 + 1.0);
+}
+
+void main()
+{
+    groupBins[gl_LocalInvocationIndex] = 0u;
+    barrier();
+
+    ivec2 pixel = ivec2(gl_GlobalInvocationID.xy);
+    ivec2 size = textureSize(scene, 0);
+    if(pixel.x < size.x && pixel.y < size.y)
+        atomicAdd(groupBins[binOf(texelFetch(scene, pixel, 0).rgb)], 1u);
+    barrier();
+
+    uint count = groupBins[gl_LocalInvocationIndex];
+    if(count != 0u)
+        atomicAdd(bins[gl_LocalInvocationIndex], count);
+}
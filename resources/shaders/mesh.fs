@@ -0,0 +1,22 @@
+#version 330 core
+out vec4 FragColor;
+
+in vec3 Normal;
+in vec3 FragPos;
+in vec2 TexCoord;
+
+struct Material
+{
+    sampler2D texture_diffuse1;
+};
+
+uniform Material material;
+
+// Fixed light from the top, enough to check geometry and textures
+void main()
+{
+    const vec3 lightDirection = normalize(vec3(0.2, 1.0, 0.3));
+    float diffuse = max(dot(normalize(Normal), lightDirection), 0.0);
+    vec3 color = texture(material.texture_diffuse1, TexCoord).rgb;
+    FragColor = vec4(color * (0.2 + 0.8 * diffuse), 1.0);
+}
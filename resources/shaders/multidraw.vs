@@ -0,0 +1,42 @@
+#version 430 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec2 aTexCoord;
+// Draw index, sourced by MultiDrawBatch through the command baseInstance
+layout (location = 3) in uint aDrawId;
+
+struct DrawData
+{
+    mat4 model;
+    mat4 normalModel;
+    uint materialIndex;
+};
+
+layout (std430, binding = 0) readonly buffer DrawDataBuffer
+{
+    DrawData draws[];
+};
+
+out vec3 FragPos;
+out vec3 Normal;
+out vec2 TexCoord;
+flat out uint MaterialIndex;
+
+uniform mat4 view;
+uniform mat4 projection;
+
+void main()
+{
+    DrawData draw = draws[aDrawId];
+
+    // Compute frag position in world position
+    FragPos = vec3(draw.model * vec4(aPos, 1.0));
+
+    // Compute normal after world translation/rotation/scale
+    Normal = mat3(draw.normalModel) * aNormal;
+
+    TexCoord = aTexCoord;
+    MaterialIndex = draw.materialIndex;
+
+    gl_Position = projection * view * vec4(FragPos, 1.0);
+}
@@ -0,0 +1,44 @@
+#version 430 core
+// Occlusion culling of learnopengl::OcclusionCuller: one invocation per command of a learnopengl::MultiDrawBatch sets its instance
+// count to 0 when its bounds are behind the depth pyramid, 1 otherwise.
+layout (local_size_x = 64) in;
+
+#include "/resources/shaders/depthpyramid.glsl"
+
+// learnopengl::MultiDrawBatch::DrawElementsIndirectCommand, 5 uints: count, instanceCount, firstIndex, baseVertex, baseInstance
+layout (std430, binding = 0) buffer Commands
+{
+    uint commands[];
+};
+
+// learnopengl::MultiDrawBatch::DrawBounds, center w is 0 without bounds
+struct DrawBounds
+{
+    vec4 center;
+    vec4 extent;
+};
+
+layout (std430, binding = 1) readonly buffer Bounds
+{
+    DrawBounds bounds[];
+};
+
+layout (std430, binding = 2) buffer Counter
+{
+    uint occludedCount;
+};
+
+uniform int drawCount;
+
+void main()
+{
+    uint draw = gl_GlobalInvocationID.x;
+    if(draw >= uint(drawCount))
+        return;
+
+    DrawBounds drawBounds = bounds[draw];
+    bool occluded = drawBounds.center.w != 0.0 && occludedByDepthPyramid(drawBounds.center.xyz, drawBounds.extent.xyz);
+    commands[draw * 5u + 1u] = occluded ? 0u : 1u;
+    if(occluded)
+        atomicAdd(occludedCount, 1u);
+}
@@ -0,0 +1,53 @@
+// Point and spot lights packed by learnopengl::PackedLights in a texture buffer, 6 texels per light:
+// position, range | direction, type (0 point, 1 spot) | ambient, constant | diffuse, linear | specular, quadratic | cutOff, outerCutOff
+
+// Phong lighting of a fragment by the light of index light, normal is normalized. Diffuse and specular are scaled by lit, e.g. from
+// a shadow atlas.
+vec3 computePackedLight(samplerBuffer lights, int light, vec3 diffuseColor, vec3 specularColor, float shininess, vec3 normal, vec3 fragPos,
+                        vec3 cameraPos, float lit)
+{
+    int texel = light * 6;
+    vec4 positionRange = texelFetch(lights, texel);
+    vec4 directionType = texelFetch(lights, texel + 1);
+    vec4 ambientConstant = texelFetch(lights, texel + 2);
+    vec4 diffuseLinear = texelFetch(lights, texel + 3);
+    vec4 specularQuadratic = texelFetch(lights, texel + 4);
+
+    vec3 toLight = positionRange.xyz - fragPos;
+    float lightDistance = length(toLight);
+    vec3 lightDir = toLight / max(lightDistance, 1e-5);
+
+    // Fade to 0 at the range so that the light volume borders do not show
+    float rangeRatio = lightDistance / positionRange.w;
+    float window = clamp(1.0 - rangeRatio * rangeRatio * rangeRatio * rangeRatio, 0.0, 1.0);
+    float attenuation = window * window
+                        / (ambientConstant.w + diffuseLinear.w * lightDistance + specularQuadratic.w * lightDistance * lightDistance);
+
+    float intensity = 1.0;
+    if(directionType.w > 0.5)
+    {
+        vec2 cutOffs = texelFetch(lights, texel + 5).xy;
+        float theta = dot(lightDir, -directionType.xyz);
+        intensity = clamp((theta - cutOffs.y) / max(cutOffs.x - cutOffs.y, 1e-4), 0.0, 1.0);
+    }
+
+    vec3 ambient = ambientConstant.rgb * diffuseColor;
+
+    // diffuse
+    float diff = max(dot(normal, lightDir), 0.0);
+    vec3 diffuse = diffuseLinear.rgb * (diff * diffuseColor);
+
+    // specular
+    vec3 viewDir = normalize(cameraPos - fragPos);
+    vec3 reflectDir = reflect(-lightDir, normal);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), shininess);
+    vec3 specular = specularQuadratic.rgb * (spec * specularColor);
+
+    return (ambient + (diffuse + specular) * (intensity * lit)) * attenuation;
+}
+
+vec3 computePackedLight(samplerBuffer lights, int light, vec3 diffuseColor, vec3 specularColor, float shininess, vec3 normal, vec3 fragPos,
+                        vec3 cameraPos)
+{
+    return computePackedLight(lights, light, diffuseColor, specularColor, shininess, normal, fragPos, cameraPos, 1.0);
+}
@@ -0,0 +1,45 @@
+// Cascaded shadow maps of learnopengl::ShadowMap, uniforms set by learnopengl::ShadowMap::bind
+
+uniform sampler2DArrayShadow shadowMap;
+uniform int shadowCascadeCount;
+// World position to shadow map coordinates and depth, per cascade
+uniform mat4 shadowMatrices[4];
+// View distance where each cascade ends
+uniform vec4 shadowSplits;
+// World size of a shadow map texel, per cascade
+uniform vec4 shadowTexelSizes;
+// View distance of a world position p: dot(xyz, p) + w
+uniform vec4 shadowViewDepth;
+
+// Cascade covering a world position, shadowCascadeCount past the last one
+int shadowCascade(vec3 fragPos)
+{
+    float depth = dot(shadowViewDepth.xyz, fragPos) + shadowViewDepth.w;
+    for(int i = 0; i < shadowCascadeCount; ++i)
+    {
+        if(depth <= shadowSplits[i])
+            return i;
+    }
+    return shadowCascadeCount;
+}
+
+// Lit fraction of a world position, normal is normalized. The position is offset along the normal by a texel of its cascade
+// against shadow acne, and 3x3 bilinear comparisons soften the edges. 1 past the last cascade.
+float computeShadow(vec3 fragPos, vec3 normal)
+{
+    int cascade = shadowCascade(fragPos);
+    if(cascade >= shadowCascadeCount)
+        return 1.0;
+
+    vec3 position = fragPos + normal * (shadowTexelSizes[cascade] * 1.5);
+    vec3 coords = (shadowMatrices[cascade] * vec4(position, 1.0)).xyz;
+    vec2 texelSize = 1.0 / vec2(textureSize(shadowMap, 0).xy);
+
+    float lit = 0.0;
+    for(int y = -1; y <= 1; ++y)
+    {
+        for(int x = -1; x <= 1; ++x)
+            lit += texture(shadowMap, vec4(coords.xy + vec2(x, y) * texelSize, float(cascade), coords.z));
+    }
+    return lit / 9.0;
+}
@@ -0,0 +1,53 @@
+// Point and spot light shadows of learnopengl::ShadowAtlas, uniforms set by learnopengl::ShadowAtlas::bind
+
+uniform sampler2DShadow shadowAtlas;
+// 6 faces per light, 6 texels per face: world to atlas coordinates matrix (4 texels) | tile bounds in atlas coordinates |
+// light position, world size of a texel at unit distance (0 while the face has no shadow)
+uniform samplerBuffer shadowAtlasFaces;
+
+// Cube face of a direction from the light: +x, -x, +y, -y, +z, -z. Spot lights repeat their face in all 6.
+int shadowAtlasFace(vec3 direction)
+{
+    vec3 magnitude = abs(direction);
+    if(magnitude.x >= magnitude.y && magnitude.x >= magnitude.z)
+        return direction.x > 0.0 ? 0 : 1;
+    if(magnitude.y >= magnitude.z)
+        return direction.y > 0.0 ? 2 : 3;
+    return direction.z > 0.0 ? 4 : 5;
+}
+
+// Lit fraction of a world position by the light of index light (order of ShadowAtlas::update), normal is normalized.
+// The position is offset along the normal by a texel at its distance against shadow acne, 2x2 bilinear comparisons soften the
+// edges. 1 while the light has no shadow.
+float computeAtlasShadow(int light, vec3 fragPos, vec3 normal)
+{
+    // Every face holds the light position
+    vec3 lightPosition = texelFetch(shadowAtlasFaces, light * 36 + 5).xyz;
+    int texel = (light * 6 + shadowAtlasFace(fragPos - lightPosition)) * 6;
+    // The faces of a light may be at different sizes or not rendered yet
+    vec4 info = texelFetch(shadowAtlasFaces, texel + 5);
+    if(info.w <= 0.0)
+        return 1.0;
+
+    // Light position as the face was rendered
+    vec3 position = fragPos + normal * (info.w * length(fragPos - info.xyz) * 1.5);
+    mat4 matrix = mat4(texelFetch(shadowAtlasFaces, texel),
+        texelFetch(shadowAtlasFaces, texel + 1),
+        texelFetch(shadowAtlasFaces, texel + 2),
+        texelFetch(shadowAtlasFaces, texel + 3));
+    vec4 bounds = texelFetch(shadowAtlasFaces, texel + 4);
+    vec4 projected = matrix * vec4(position, 1.0);
+    vec3 coords = projected.xyz / projected.w;
+
+    // Taps stay inside the tile
+    vec2 texelSize = 1.0 / vec2(textureSize(shadowAtlas, 0));
+    coords.xy = clamp(coords.xy, bounds.xy + texelSize, bounds.zw - texelSize);
+
+    float lit = 0.0;
+    for(int y = 0; y < 2; ++y)
+    {
+        for(int x = 0; x < 2; ++x)
+            lit += texture(shadowAtlas, vec3(coords.xy + (vec2(x, y) - 0.5) * texelSize, coords.z));
+    }
+    return lit * 0.25;
+}
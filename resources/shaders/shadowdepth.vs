@@ -0,0 +1,8 @@
+#version 330 core
+// Shadow casters of learnopengl::ShadowMap, positions only (learnopengl::Mesh::drawPositions)
+layout (location = 0) in vec3 aPos;
+
+uniform mat4 model;
+uniform mat4 lightViewProjection;
+
+void main() { gl_Position = lightViewProjection * model * vec4(aPos, 1.0); }
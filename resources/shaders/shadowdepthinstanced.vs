@@ -0,0 +1,8 @@
+#version 330 core
+// Instanced shadow casters of learnopengl::ShadowMap, positions and model matrices (learnopengl::InstancedMesh::drawDepth)
+layout (location = 0) in vec3 aPos;
+layout (location = 3) in mat4 aModel;
+
+uniform mat4 lightViewProjection;
+
+void main() { gl_Position = lightViewProjection * aModel * vec4(aPos, 1.0); }
@@ -0,0 +1,59 @@
+#version 330 core
+// Occlusion pass of learnopengl::AmbientOcclusion at the reduced resolution: hemisphere kernel around the view space normal,
+// rotated per pixel by interleaved gradient noise whose offset changes every frame for the temporal accumulation.
+layout (location = 0) out float occlusion;
+
+#include "/resources/shaders/ssao.glsl"
+
+uniform sampler2D reducedDepth;
+uniform sampler2D reducedNormal;
+
+// Tangent space samples, set once by AmbientOcclusion
+uniform vec3 samples[64];
+uniform int sampleCount;
+uniform float radius;
+uniform float bias;
+uniform float power;
+uniform int frameIndex;
+
+// Jorge Jimenez, Next Generation Post Processing in Call of Duty: Advanced Warfare
+float interleavedGradientNoise(vec2 pixel)
+{
+    return fract(52.9829189 * fract(dot(pixel, vec2(0.06711056, 0.00583715))));
+}
+
+void main()
+{
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    ivec2 size = textureSize(reducedDepth, 0);
+    float depth = texelFetch(reducedDepth, pixel, 0).r;
+    if(depth >= BackgroundDepth)
+    {
+        occlusion = 1.0;
+        return;
+    }
+
+    vec3 position = viewPosition((vec2(pixel) + 0.5) / vec2(size), depth);
+    vec3 normal = normalize(texelFetch(reducedNormal, pixel, 0).xyz * 2.0 - 1.0);
+
+    float angle = 6.28318531 * interleavedGradientNoise(vec2(pixel) + 5.588238 * float(frameIndex));
+    vec3 randomVec = vec3(cos(angle), sin(angle), 0.0);
+    vec3 tangent = normalize(randomVec - normal * dot(randomVec, normal));
+    vec3 bitangent = cross(normal, tangent);
+    mat3 tbn = mat3(tangent, bitangent, normal);
+
+    float occluded = 0.0;
+    for(int i = 0; i < sampleCount; ++i)
+    {
+        vec3 samplePosition = position + tbn * samples[i] * radius;
+        vec2 uv = projectView(samplePosition);
+        if(any(lessThan(uv, vec2(0.0))) || any(greaterThan(uv, vec2(1.0))))
+            continue;
+
+        float sceneDepth = texelFetch(reducedDepth, min(ivec2(uv * vec2(size)), size - 1), 0).r;
+        // Occluders far in front of the pixel fade out
+        float rangeCheck = smoothstep(0.0, 1.0, radius / abs(depth - sceneDepth));
+        occluded += (sceneDepth <= -samplePosition.z - bias ? 1.0 : 0.0) * rangeCheck;
+    }
+    occlusion = pow(1.0 - occluded / float(sampleCount), power);
+}
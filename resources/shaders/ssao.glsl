@@ -0,0 +1,33 @@
+// Depth helpers of the learnopengl::AmbientOcclusion passes, uniforms set by AmbientOcclusion::compute.
+// Include after #version: #include "/resources/shaders/ssao.glsl"
+
+uniform mat4 inverseProjection;
+// Stored depth to clip depth scale and bias
+uniform vec2 depthToNdc;
+uniform bool reverseZ;
+// x and y scale of the projection matrix
+uniform vec2 projectionScale;
+
+// Linear depth of pixels without geometry
+const float BackgroundDepth = 1e30;
+
+// Distance along the view direction of a stored depth
+float linearDepth(float depth)
+{
+    if(reverseZ ? depth <= 0.0 : depth >= 1.0)
+        return BackgroundDepth;
+    vec4 view = inverseProjection * vec4(0.0, 0.0, depth * depthToNdc.x + depthToNdc.y, 1.0);
+    return -view.z / view.w;
+}
+
+// View space position at uv in [0, 1] and linear depth
+vec3 viewPosition(vec2 uv, float depth)
+{
+    return vec3((uv * 2.0 - 1.0) * depth / projectionScale, -depth);
+}
+
+// uv in [0, 1] of a view space position
+vec2 projectView(vec3 position)
+{
+    return position.xy * projectionScale / -position.z * 0.5 + 0.5;
+}
@@ -0,0 +1,71 @@
+#version 330 core
+// Depth reduction of learnopengl::AmbientOcclusion: linear depth and view space normal of one full resolution texel per pixel,
+// the nearest of the 2x2 texels at the center of the footprint on even pixels and the farthest on odd ones (checkerboard).
+layout (location = 0) out float reducedDepth;
+layout (location = 1) out vec4 reducedNormal;
+
+#include "/resources/shaders/gbuffer.glsl"
+#include "/resources/shaders/ssao.glsl"
+
+uniform sampler2D sourceDepth;
+// Geometry buffer normals, unused when reconstructing them from depth
+uniform sampler2D sourceNormal;
+uniform bool reconstructNormals;
+uniform mat3 viewNormalMatrix;
+// Full resolution texels per pixel along each axis: 1, 2 or 4
+uniform int divisor;
+
+vec3 positionAt(ivec2 texel, vec2 size)
+{
+    return viewPosition((vec2(texel) + 0.5) / size, linearDepth(texelFetch(sourceDepth, texel, 0).r));
+}
+
+// Cross product of the position differences with the neighbors on the side of the smaller depth step, against silhouettes
+vec3 reconstructNormal(ivec2 texel, ivec2 last)
+{
+    vec2 size = vec2(last + 1);
+    vec3 center = positionAt(texel, size);
+    vec3 left = positionAt(max(texel - ivec2(1, 0), ivec2(0)), size);
+    vec3 right = positionAt(min(texel + ivec2(1, 0), last), size);
+    vec3 down = positionAt(max(texel - ivec2(0, 1), ivec2(0)), size);
+    vec3 up = positionAt(min(texel + ivec2(0, 1), last), size);
+
+    bool useRight = texel.x == 0 || (texel.x < last.x && abs(right.z - center.z) < abs(center.z - left.z));
+    bool useUp = texel.y == 0 || (texel.y < last.y && abs(up.z - center.z) < abs(center.z - down.z));
+    vec3 dx = useRight ? right - center : center - left;
+    vec3 dy = useUp ? up - center : center - down;
+    return normalize(cross(dx, dy));
+}
+
+void main()
+{
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    ivec2 last = textureSize(sourceDepth, 0) - 1;
+
+    ivec2 selected = min(pixel * divisor, last);
+    float depth = linearDepth(texelFetch(sourceDepth, selected, 0).r);
+    if(divisor > 1)
+    {
+        ivec2 first = pixel * divisor + divisor / 2 - 1;
+        bool nearest = ((pixel.x + pixel.y) & 1) == 0;
+        for(int i = 0; i < 4; ++i)
+        {
+            ivec2 texel = min(first + ivec2(i & 1, i >> 1), last);
+            float texelDepth = linearDepth(texelFetch(sourceDepth, texel, 0).r);
+            if(i == 0 || (nearest ? texelDepth < depth : texelDepth > depth))
+            {
+                depth = texelDepth;
+                selected = texel;
+            }
+        }
+    }
+
+    vec3 normal = vec3(0.0, 0.0, 1.0);
+    if(depth < BackgroundDepth && reconstructNormals)
+        normal = reconstructNormal(selected, last);
+    else if(depth < BackgroundDepth)
+        normal = normalize(viewNormalMatrix * decodeNormal(texelFetch(sourceNormal, selected, 0)));
+
+    reducedDepth = depth;
+    reducedNormal = vec4(normal * 0.5 + 0.5, 0.0);
+}
@@ -0,0 +1,41 @@
+#version 330 core
+// Temporal accumulation of learnopengl::AmbientOcclusion: the pixel is reprojected into the previous frame and blended with its
+// history when the depth found there matches, the history restarts from the current frame otherwise.
+layout (location = 0) out float accumulated;
+
+#include "/resources/shaders/ssao.glsl"
+
+uniform sampler2D currentOcclusion;
+uniform sampler2D currentDepth;
+uniform sampler2D history;
+uniform sampler2D historyDepth;
+// View space of this frame to clip space of the previous one
+uniform mat4 reprojection;
+uniform bool historyValid;
+// Weight of the current frame
+uniform float blend;
+
+void main()
+{
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    ivec2 size = textureSize(currentDepth, 0);
+    float occlusion = texelFetch(currentOcclusion, pixel, 0).r;
+    float depth = texelFetch(currentDepth, pixel, 0).r;
+    accumulated = occlusion;
+    if(!historyValid || depth >= BackgroundDepth)
+        return;
+
+    vec4 previous = reprojection * vec4(viewPosition((vec2(pixel) + 0.5) / vec2(size), depth), 1.0);
+    if(previous.w <= 0.0)
+        return;
+    vec2 uv = previous.xy / previous.w * 0.5 + 0.5;
+    if(any(lessThan(uv, vec2(0.0))) || any(greaterThan(uv, vec2(1.0))))
+        return;
+
+    // Clip w is the linear depth the point had in the previous frame, another surface was there when it differs
+    float previousDepth = texelFetch(historyDepth, min(ivec2(uv * vec2(size)), size - 1), 0).r;
+    if(abs(previousDepth - previous.w) > 0.05 * previous.w)
+        return;
+
+    accumulated = mix(texture(history, uv).r, occlusion, blend);
+}
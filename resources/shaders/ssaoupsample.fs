@@ -0,0 +1,56 @@
+#version 330 core
+// Bilateral upsample of learnopengl::AmbientOcclusion to full resolution: the 3x3 reduced pixels around the pixel are weighted
+// by distance and by how close their depth is to the full resolution one, so occlusion does not bleed across edges.
+// At full resolution it is a depth-aware 3x3 blur of the noise.
+layout (location = 0) out float result;
+
+#include "/resources/shaders/ssao.glsl"
+
+uniform sampler2D sourceDepth;
+uniform sampler2D reducedOcclusion;
+uniform sampler2D reducedDepth;
+uniform int divisor;
+
+// Relative depth difference dividing the weight by e
+const float DepthSigma = 0.02;
+
+void main()
+{
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    float depth = linearDepth(texelFetch(sourceDepth, pixel, 0).r);
+    if(depth >= BackgroundDepth)
+    {
+        result = 1.0;
+        return;
+    }
+
+    // Pixel center in reduced pixels
+    vec2 center = (vec2(pixel) + 0.5) / float(divisor) - 0.5;
+    ivec2 nearest = ivec2(floor(center + 0.5));
+    ivec2 last = textureSize(reducedDepth, 0) - 1;
+
+    float sum = 0.0;
+    float weightSum = 0.0;
+    // Fallback when every tap is on another surface
+    float closest = 1.0;
+    float closestDifference = BackgroundDepth;
+    for(int y = -1; y <= 1; ++y)
+    {
+        for(int x = -1; x <= 1; ++x)
+        {
+            ivec2 texel = clamp(nearest + ivec2(x, y), ivec2(0), last);
+            float tapOcclusion = texelFetch(reducedOcclusion, texel, 0).r;
+            float difference = abs(texelFetch(reducedDepth, texel, 0).r - depth);
+            vec2 offset = vec2(texel) - center;
+            float weight = exp(-dot(offset, offset)) * exp(-difference / (depth * DepthSigma));
+            sum += tapOcclusion * weight;
+            weightSum += weight;
+            if(difference < closestDifference)
+            {
+                closestDifference = difference;
+                closest = tapOcclusion;
+            }
+        }
+    }
+    result = weightSum > 1e-4 ? sum / weightSum : closest;
+}
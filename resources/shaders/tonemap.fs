@@ -0,0 +1,31 @@
+#version 330 core
+// Tone mapping of learnopengl::PostProcess: bloom mixed with the scene, exposure (relative to middle gray with auto exposure),
+// ACES filmic fit and gamma correction.
+out vec4 FragColor;
+
+uniform sampler2D scene;
+uniform sampler2D bloom;
+uniform sampler2D adaptedLuminance;
+uniform bool bloomEnabled;
+uniform float bloomStrength;
+uniform bool autoExposure;
+uniform float exposure;
+
+// Krzysztof Narkowicz fit of the ACES curve
+vec3 aces(vec3 color)
+{
+    return clamp((color * (2.51 * color + 0.03)) / (color * (2.43 * color + 0.59) + 0.14), 0.0, 1.0);
+}
+
+void main()
+{
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    vec3 color = texelFetch(scene, pixel, 0).rgb;
+    if(bloomEnabled)
+        color = mix(color, texture(bloom, gl_FragCoord.xy / vec2(textureSize(scene, 0))).rgb, bloomStrength);
+
+    float scale = exposure;
+    if(autoExposure)
+        scale *= 0.18 / max(texelFetch(adaptedLuminance, ivec2(0), 0).r, 1e-4);
+    FragColor = vec4(pow(aces(color * scale), vec3(1.0 / 2.2)), 1.0);
+}
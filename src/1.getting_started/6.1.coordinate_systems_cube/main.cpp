@@ -156,7 +156,7 @@ int main(int argc, char** argv)
             // Project from View Space (3D) to Clip Space (2D)
             glm::mat4 projection;
             int width, height;
-            glfwGetWindowSize(window, &width, &height);
+            learnopengl::getWindowSize(window, &width, &height);
             projection = glm::perspective(glm::radians(45.0f), float(width) / float(height), 0.1f, 100.0f);
 
             shaderProgram.setMat4("model", glm::value_ptr(model));
@@ -161,7 +161,7 @@ int main(int argc, char** argv)
 
         // Project from View Space (3D) to Clip Space (2D)
         int width, height;
-        glfwGetWindowSize(window, &width, &height);
+        learnopengl::getWindowSize(window, &width, &height);
         camera.setAspect(height ? float(width) / float(height) : 1.f);
         const auto& projection = camera.projectionMatrix();
 
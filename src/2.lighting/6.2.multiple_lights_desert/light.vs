@@ -1,11 +1,17 @@
 #version 330 core
 layout (location = 0) in vec3 aPos;
+// Per instance model matrix
+layout (location = 3) in mat4 aModel;
 
-uniform mat4 model;
+// One color per light cube instance
+uniform vec3 diffuseColors[4];
 uniform mat4 view;
 uniform mat4 projection;
 
+flat out vec3 diffuseColor;
+
 void main()
 {
-    gl_Position = projection * view * model * vec4(aPos, 1.0);
+    diffuseColor = diffuseColors[gl_InstanceID];
+    gl_Position = projection * view * aModel * vec4(aPos, 1.0);
 }
@@ -10,13 +10,16 @@
 #include <learnopengl/pointlight.hpp>
 #include <learnopengl/spotlight.hpp>
 #include <learnopengl/texture.hpp>
+#include <learnopengl/mesh.hpp>
+#include <learnopengl/instancedmesh.hpp>
+#include <learnopengl/primitives.hpp>
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
-#include <glm/gtc/matrix_inverse.hpp>
+#include <glm/gtc/matrix_transform.hpp>
 
 #include <cmath>
 
@@ -60,53 +63,9 @@ int main(int argc, char** argv)
 
     // VERTEX DATA
 
-    // Vertices of triangle shape in 3d. (x, y, z)
-    // clang-format off
-    float vertices[] = {
-        // positions          // normals           // texture coords
-        -0.5f, -0.5f, -0.5f, 0.0f, 0.0f, -1.0f, 0.0f, 0.0f,
-        0.5f, -0.5f, -0.5f, 0.0f, 0.0f, -1.0f, 1.0f, 0.0f,
-        0.5f, 0.5f, -0.5f, 0.0f, 0.0f, -1.0f, 1.0f, 1.0f,
-        0.5f, 0.5f, -0.5f, 0.0f, 0.0f, -1.0f, 1.0f, 1.0f,
-        -0.5f, 0.5f, -0.5f, 0.0f, 0.0f, -1.0f, 0.0f, 1.0f,
-        -0.5f, -0.5f, -0.5f, 0.0f, 0.0f, -1.0f, 0.0f, 0.0f,
-
-        -0.5f, -0.5f, 0.5f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f,
-        0.5f, -0.5f, 0.5f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f,
-        0.5f, 0.5f, 0.5f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f,
-        0.5f, 0.5f, 0.5f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f,
-        -0.5f, 0.5f, 0.5f, 0.0f, 0.0f, 1.0f, 0.0f, 1.0f,
-        -0.5f, -0.5f, 0.5f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f,
-
-        -0.5f, 0.5f, 0.5f, -1.0f, 0.0f, 0.0f, 1.0f, 0.0f,
-        -0.5f, 0.5f, -0.5f, -1.0f, 0.0f, 0.0f, 1.0f, 1.0f,
-        -0.5f, -0.5f, -0.5f, -1.0f, 0.0f, 0.0f, 0.0f, 1.0f,
-        -0.5f, -0.5f, -0.5f, -1.0f, 0.0f, 0.0f, 0.0f, 1.0f,
-        -0.5f, -0.5f, 0.5f, -1.0f, 0.0f, 0.0f, 0.0f, 0.0f,
-        -0.5f, 0.5f, 0.5f, -1.0f, 0.0f, 0.0f, 1.0f, 0.0f,
-
-        0.5f, 0.5f, 0.5f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f,
-        0.5f, 0.5f, -0.5f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f,
-        0.5f, -0.5f, -0.5f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f,
-        0.5f, -0.5f, -0.5f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f,
-        0.5f, -0.5f, 0.5f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f,
-        0.5f, 0.5f, 0.5f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f,
-
-        -0.5f, -0.5f, -0.5f, 0.0f, -1.0f, 0.0f, 0.0f, 1.0f,
-        0.5f, -0.5f, -0.5f, 0.0f, -1.0f, 0.0f, 1.0f, 1.0f,
-        0.5f, -0.5f, 0.5f, 0.0f, -1.0f, 0.0f, 1.0f, 0.0f,
-        0.5f, -0.5f, 0.5f, 0.0f, -1.0f, 0.0f, 1.0f, 0.0f,
-        -0.5f, -0.5f, 0.5f, 0.0f, -1.0f, 0.0f, 0.0f, 0.0f,
-        -0.5f, -0.5f, -0.5f, 0.0f, -1.0f, 0.0f, 0.0f, 1.0f,
-
-        -0.5f, 0.5f, -0.5f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f,
-        0.5f, 0.5f, -0.5f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f,
-        0.5f, 0.5f, 0.5f, 0.0f, 1.0f, 0.0f, 1.0f, 0.0f,
-        0.5f, 0.5f, 0.5f, 0.0f, 1.0f, 0.0f, 1.0f, 0.0f,
-        -0.5f, 0.5f, 0.5f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f,
-        -0.5f, 0.5f, -0.5f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f
-    };
-    // clang-format on
+    // Unit cube (position, normal, texture coords), shared by boxes and light cubes
+    const auto cube = learnopengl::createCube();
+    const learnopengl::Mesh cubeMesh(cube.vertices, cube.indices, {});
 
     glm::vec3 cubePositions[] = {glm::vec3(0.0f, 0.0f, 0.0f),
         glm::vec3(2.0f, 5.0f, -15.0f),
@@ -124,45 +83,32 @@ int main(int argc, char** argv)
         glm::vec3(-4.0f, 2.0f, -12.0f),
         glm::vec3(0.0f, 0.0f, -3.0f)};
 
-    // VAO: Vertex Array Object
-    // It's a list of vertex attribute pointer
-    // A vertex attribute pointer reference and describe a VBO
-    unsigned int VAO;
-    glGenVertexArrays(1, &VAO);
-    // bind Vertex Array Object
-    glBindVertexArray(VAO);
-
-    // VBO : Vertex Buffer Object (Allow to send data to GPU)
-    unsigned int VBO;
-    glGenBuffers(1, &VBO);
-    // Set the type of our VBO
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    // Copy our data to the buffer
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(0 * sizeof(float)));
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
-    glEnableVertexAttribArray(2);
-
-    // Unbind our VBO
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    // Unbind our VAO
-    glBindVertexArray(0);
-
-    unsigned int lightVAO;
+    // Boxes and light cubes never move: instances are uploaded once and each group is a single instanced draw
+    learnopengl::InstancedMesh boxes(cubeMesh);
     {
-        glGenVertexArrays(1, &lightVAO);
-        glBindVertexArray(lightVAO);
-        // we only need to bind to the VBO, the container's VBO's data already contains the data.
-        glBindBuffer(GL_ARRAY_BUFFER, VBO);
-        // set the vertex attribute
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
-        glEnableVertexAttribArray(0);
+        float angle = 0.f;
+        for(const auto& cubePosition: cubePositions)
+        {
+            angle += 20.f;
+
+            glm::mat4 model = glm::mat4(1.0f);
+            model = glm::translate(model, cubePosition);
+            model = glm::rotate(model, angle, glm::normalize(glm::vec3(0.1f, 0.3f, 0.4f)));
+            boxes.add(model);
+        }
+        boxes.upload();
     }
 
+    learnopengl::InstancedMesh lightCubes(cubeMesh);
+    for(const auto& pointLightPosition: pointLightPositions)
+    {
+        glm::mat4 model = glm::mat4(1.0f);
+        model = glm::translate(model, pointLightPosition);
+        model = glm::scale(model, glm::vec3(0.2f, 0.2f, 0.2f));
+        lightCubes.add(model);
+    }
+    lightCubes.upload();
+
     // Enable fragment depth testing
     glEnable(GL_DEPTH_TEST);
 
@@ -219,7 +165,7 @@ int main(int argc, char** argv)
 
         // Project from View Space (3D) to Clip Space (2D)
         int width, height;
-        glfwGetWindowSize(window, &width, &height);
+        learnopengl::getWindowSize(window, &width, &height);
         camera.setAspect(height ? float(width) / float(height) : 1.f);
         const auto& projection = camera.projectionMatrix();
 
@@ -250,40 +196,22 @@ int main(int argc, char** argv)
         shaderProgram.setDirectionLight("directionLight", directionLight);
         shaderProgram.setSpotLight("spotLight", spotLight);
 
-        // NormalMatrix/LightPosition is in modelView space
-        float angle = 0.f;
-        for(const auto& cube: cubePositions)
-        {
-            angle += 20.f;
-
-            glm::mat4 model = glm::mat4(1.0f);
-            model = glm::translate(model, cube);
-            model = glm::rotate(model, angle, glm::normalize(glm::vec3(0.1f, 0.3f, 0.4f)));
-            shaderProgram.setMat4("model", glm::value_ptr(model));
-
-            glm::mat3 normalModelMatrix = glm::mat3(glm::inverseTranspose(glm::mat3(model)));
-            shaderProgram.setMat3("normalModelMatrix", glm::value_ptr(normalModelMatrix));
-
-            glBindVertexArray(VAO);
-            glDrawArrays(GL_TRIANGLES, 0, 36);
-        }
+        boxes.draw(shaderProgram);
 
         lightShaderProgram.use();
-        for(const auto& pointLight: pointLights)
+        lightShaderProgram.setMat4("view", glm::value_ptr(view));
+        lightShaderProgram.setMat4("projection", glm::value_ptr(projection));
         {
-            glm::mat4 model = glm::mat4(1.0f);
-            model = glm::translate(model, pointLight.position());
-            model = glm::scale(model, glm::vec3(0.2f, 0.2f, 0.2f));
-
-            lightShaderProgram.setMat4("view", glm::value_ptr(view));
-            lightShaderProgram.setMat4("projection", glm::value_ptr(projection));
-            lightShaderProgram.setMat4("model", glm::value_ptr(model));
-
-            lightShaderProgram.setVec3("diffuseColor", pointLight.diffuse().r, pointLight.diffuse().g, pointLight.diffuse().b);
+            int index = 0;
 
-            glBindVertexArray(lightVAO);
-            glDrawArrays(GL_TRIANGLES, 0, 36);
+            for(const auto& pointLight: pointLights)
+            {
+                const auto& color = pointLight.diffuse();
+                lightShaderProgram.setVec3("diffuseColors[" + std::to_string(index) + "]", color.r, color.g, color.b);
+                ++index;
+            }
         }
+        lightCubes.draw(lightShaderProgram);
 
         // Show rendered buffer in screen
         glfwPollEvents();
@@ -292,10 +220,6 @@ int main(int argc, char** argv)
         learnopengl::showFPS(window);
     }
 
-    glDeleteVertexArrays(1, &VAO);
-    glDeleteVertexArrays(1, &lightVAO);
-    glDeleteBuffers(1, &VBO);
-
     glfwTerminate();
 
     return 0;
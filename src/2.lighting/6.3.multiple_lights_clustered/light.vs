@@ -0,0 +1,28 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+// Per instance model matrix, only the scale of the cube
+layout (location = 3) in mat4 aModel;
+
+// Light data of ClusteredLighting, 6 texels per light: position and color are read from it
+uniform samplerBuffer clusterLightData;
+// Lights left after frustum culling, the others instances are dropped
+uniform int lightCount;
+uniform mat4 view;
+uniform mat4 projection;
+
+flat out vec3 diffuseColor;
+
+void main()
+{
+    // Culled and spot lights: outside the clip volume
+    if(gl_InstanceID >= lightCount || texelFetch(clusterLightData, gl_InstanceID * 6 + 1).w > 0.5)
+    {
+        diffuseColor = vec3(0.0);
+        gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+        return;
+    }
+
+    vec3 lightPosition = texelFetch(clusterLightData, gl_InstanceID * 6).xyz;
+    diffuseColor = texelFetch(clusterLightData, gl_InstanceID * 6 + 3).rgb;
+    gl_Position = projection * view * vec4(lightPosition + vec3(aModel * vec4(aPos, 1.0)), 1.0);
+}
@@ -0,0 +1,262 @@
+// Scene of https://learnopengl.com/Lighting/Multiple-lights with thousands of moving point lights, shaded with clustered forward lighting.
+// LEARNOPENGL_LIGHT_COUNT=<count> sets the number of point lights (1024).
+
+#include <learnopengl/window.hpp>
+#include <learnopengl/shader.hpp>
+#include <learnopengl/camera.hpp>
+#include <learnopengl/cameracontroller.hpp>
+#include <learnopengl/fpscounter.hpp>
+#include <learnopengl/benchmark.hpp>
+#include <learnopengl/diffusespecularmaterial.hpp>
+#include <learnopengl/directionlight.hpp>
+#include <learnopengl/pointlight.hpp>
+#include <learnopengl/spotlight.hpp>
+#include <learnopengl/lightrange.hpp>
+#include <learnopengl/clusteredlighting.hpp>
+#include <learnopengl/texture.hpp>
+#include <learnopengl/mesh.hpp>
+#include <learnopengl/instancedmesh.hpp>
+#include <learnopengl/primitives.hpp>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+learnopengl::Camera camera;
+learnopengl::CameraController cameraController(&camera);
+
+void processInput(GLFWwindow* window)
+{
+    if(glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+    {
+        glfwSetWindowShouldClose(window, true);
+    }
+
+    cameraController.processInput(window);
+}
+
+void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods)
+{
+    cameraController.mouseButtonCallback(window, button, action, mods);
+}
+
+void mouseMoveCallback(GLFWwindow* window, double xpos, double ypos) { cameraController.mouseMoveCallback(window, float(xpos), float(ypos)); }
+
+void scrollCallback(GLFWwindow* window, double xoffset, double yoffset) { cameraController.scrollCallback(float(yoffset)); }
+
+struct MovingLight
+{
+    glm::vec3 center;
+    float phase = 0.f;
+    float speed = 1.f;
+};
+
+int main(int argc, char** argv)
+{
+    auto* window = learnopengl::createWindow();
+    if(!window)
+        return -1;
+
+    glfwSetCursorPosCallback(window, mouseMoveCallback);
+    glfwSetMouseButtonCallback(window, mouseButtonCallback);
+    glfwSetScrollCallback(window, scrollCallback);
+
+    std::size_t lightCount = 1024;
+    if(const char* value = std::getenv("LEARNOPENGL_LIGHT_COUNT"))
+        lightCount = std::size_t(std::max(std::atol(value), 1l));
+
+    // SHADER PROGRAM
+    auto shaderProgram = learnopengl::Shader("shader.vs", "shader.fs");
+    auto lightShaderProgram = learnopengl::Shader("light.vs", "light.fs");
+    auto diffuseTexture = learnopengl::Texture("/resources/textures/container2.png");
+    auto specularTexture = learnopengl::Texture("/resources/textures/container2_specular.png");
+
+    // VERTEX DATA
+
+    // Unit cube (position, normal, texture coords), shared by boxes, floor and light cubes
+    const auto cube = learnopengl::createCube();
+    const learnopengl::Mesh cubeMesh(cube.vertices, cube.indices, {});
+
+    glm::vec3 cubePositions[] = {glm::vec3(0.0f, 0.0f, 0.0f),
+        glm::vec3(2.0f, 5.0f, -15.0f),
+        glm::vec3(-1.5f, -2.2f, -2.5f),
+        glm::vec3(-3.8f, -2.0f, -12.3f),
+        glm::vec3(2.4f, -0.4f, -3.5f),
+        glm::vec3(-1.7f, 3.0f, -7.5f),
+        glm::vec3(1.3f, -2.0f, -2.5f),
+        glm::vec3(1.5f, 2.0f, -2.5f),
+        glm::vec3(1.5f, 0.2f, -1.5f),
+        glm::vec3(-1.3f, 1.0f, -1.5f)};
+
+    // Boxes of the multiple lights scene above a floor catching the light
+    learnopengl::InstancedMesh boxes(cubeMesh);
+    {
+        float angle = 0.f;
+        for(const auto& cubePosition: cubePositions)
+        {
+            angle += 20.f;
+
+            glm::mat4 model = glm::mat4(1.0f);
+            model = glm::translate(model, cubePosition);
+            model = glm::rotate(model, angle, glm::normalize(glm::vec3(0.1f, 0.3f, 0.4f)));
+            boxes.add(model);
+        }
+        boxes.add(glm::scale(glm::translate(glm::mat4(1.f), glm::vec3(0.f, -3.5f, -8.f)), glm::vec3(40.f, 0.5f, 40.f)));
+        boxes.upload();
+    }
+
+    // Lights move in small circles around random points of the scene volume
+    const glm::vec3 sceneMin(-15.f, -3.f, -25.f);
+    const glm::vec3 sceneMax(15.f, 6.f, 5.f);
+    std::mt19937 random(learnopengl::Benchmark::seed());
+    std::uniform_real_distribution<float> unit(0.f, 1.f);
+
+    std::vector<MovingLight> movingLights(lightCount);
+    std::vector<learnopengl::PointLight> pointLights(lightCount);
+
+    // About 32 lights reach each point of the scene whatever the light count: range shrinks as the count grows
+    const auto sceneSize = sceneMax - sceneMin;
+    const float range = std::cbrt(32.f * sceneSize.x * sceneSize.y * sceneSize.z / (float(lightCount) * 4.f / 3.f * glm::pi<float>()));
+    for(std::size_t i = 0; i < lightCount; ++i)
+    {
+        movingLights[i].center = sceneMin + sceneSize * glm::vec3(unit(random), unit(random), unit(random));
+        movingLights[i].phase = unit(random) * 2.f * glm::pi<float>();
+        movingLights[i].speed = 0.5f + unit(random);
+
+        // Saturated color of full intensity, quadratic attenuation reaching the light threshold at range
+        const auto hue = glm::vec3(unit(random), unit(random), unit(random));
+        auto& pointLight = pointLights[i];
+        pointLight.setAmbient(glm::vec3(0.f));
+        pointLight.setDiffuse(hue / std::max({hue.r, hue.g, hue.b, 1e-3f}));
+        pointLight.setAttenuation(1.f, 0.f, (1.f / learnopengl::LightRangeThreshold - 1.f) / (range * range));
+    }
+
+    // Light cubes are placed by the shader from the light data, instances only scale the cube
+    learnopengl::InstancedMesh lightCubes(cubeMesh);
+    lightCubes.reserve(lightCount);
+    for(std::size_t i = 0; i < lightCount; ++i) lightCubes.add(glm::scale(glm::mat4(1.f), glm::vec3(0.05f)));
+    lightCubes.upload();
+
+    // Enable fragment depth testing
+    glEnable(GL_DEPTH_TEST);
+
+    camera.setFovDegrees(70.f);
+
+    learnopengl::DirectionLight directionLight;
+    directionLight.setAmbient(glm::vec3(0.01f));
+    directionLight.setDiffuse(glm::vec3(0.07f, 0.04f, 0.03f));
+    directionLight.setDirection(glm::vec3(-0.2f, -1.0f, -0.3f));
+
+    learnopengl::SpotLight spotLight;
+    spotLight.setAmbient(glm::vec3(0.f));
+    spotLight.setDiffuse(glm::vec3(0.4f));
+    spotLight.setCutOff(glm::cos(glm::radians(12.5f)));
+    spotLight.setOuterCutOff(glm::cos(glm::radians(17.5f)));
+    spotLight.setAttenuation(1.f, 0.09f, 0.032f);
+
+    learnopengl::DiffuseSpecularMaterial diffuseSpecularMaterial;
+
+    learnopengl::ClusteredLighting clusteredLighting;
+    double binningMs = 0.;
+    double lightsPerCluster = 0.;
+    std::size_t culledLights = 0;
+    std::size_t frames = 0;
+
+    // Main window render loop
+    while(!glfwWindowShouldClose(window))
+    {
+        // Process input
+        processInput(window);
+
+        // Render
+        glClearColor(0.05f, 0.04f, 0.03f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        const auto& view = camera.viewMatrix();
+
+        // Project from View Space (3D) to Clip Space (2D)
+        int width, height;
+        learnopengl::getWindowSize(window, &width, &height);
+        camera.setAspect(height ? float(width) / float(height) : 1.f);
+        const auto& projection = camera.projectionMatrix();
+
+        // Bin the lights of this frame in the camera clusters
+        const auto time = float(glfwGetTime());
+        clusteredLighting.clear();
+        for(std::size_t i = 0; i < lightCount; ++i)
+        {
+            const auto& movingLight = movingLights[i];
+            const float angle = movingLight.phase + time * movingLight.speed;
+            pointLights[i].setPosition(movingLight.center + glm::vec3(std::cos(angle), 0.5f * std::sin(2.f * angle), std::sin(angle)));
+            clusteredLighting.add(pointLights[i]);
+        }
+
+        spotLight.setPosition(camera.cameraPos());
+        spotLight.setDirection(camera.cameraFront());
+        clusteredLighting.add(spotLight);
+        clusteredLighting.update(camera);
+
+        const auto& stats = clusteredLighting.stats();
+        binningMs += stats.binningMs;
+        culledLights += stats.culledLightCount;
+        if(stats.clusters.activeClusterCount)
+            lightsPerCluster += double(stats.clusters.indexCount) / double(stats.clusters.activeClusterCount);
+        ++frames;
+
+        // Tiles are in pixels of the render target
+        GLint viewport[4];
+        glGetIntegerv(GL_VIEWPORT, viewport);
+
+        shaderProgram.use();
+        shaderProgram.setMat4("projection", glm::value_ptr(projection));
+        shaderProgram.setMat4("view", glm::value_ptr(view));
+        shaderProgram.setVec3("cameraPos", camera.cameraPos().x, camera.cameraPos().y, camera.cameraPos().z);
+
+        // Use diffuse texture with unit 0
+        diffuseTexture.use(0);
+        specularTexture.use(1);
+        diffuseSpecularMaterial.setDiffuseTextureUnit(0);
+        diffuseSpecularMaterial.setSpecularTextureUnit(1);
+
+        shaderProgram.setDiffuseSpecularMaterial("material", diffuseSpecularMaterial);
+        shaderProgram.setDirectionLight("directionLight", directionLight);
+        // Cluster buffers after the material textures
+        clusteredLighting.bind(shaderProgram, 2, viewport[2], viewport[3]);
+
+        boxes.draw(shaderProgram);
+
+        lightShaderProgram.use();
+        lightShaderProgram.setMat4("view", glm::value_ptr(view));
+        lightShaderProgram.setMat4("projection", glm::value_ptr(projection));
+        clusteredLighting.bind(lightShaderProgram, 2, viewport[2], viewport[3]);
+        lightShaderProgram.setInt("lightCount", int(clusteredLighting.visibleLightCount()));
+        lightCubes.draw(lightShaderProgram);
+
+        // Show rendered buffer in screen
+        glfwPollEvents();
+        glfwSwapBuffers(window);
+
+        learnopengl::showFPS(window);
+    }
+
+    if(frames)
+    {
+        std::cout << "Clustered lighting: " << lightCount << " point lights of range " << range << ", binning "
+                  << binningMs / double(frames) << " ms, " << culledLights / frames << " lights culled per frame, "
+                  << lightsPerCluster / double(frames) << " lights per lit cluster" << std::endl;
+    }
+
+    glfwTerminate();
+
+    return 0;
+}
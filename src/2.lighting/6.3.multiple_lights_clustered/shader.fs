@@ -0,0 +1,63 @@
+#version 330 core
+out vec4 FragColor;
+
+in vec3 Normal;
+in vec3 FragPos;
+in vec2 TexCoord;
+
+uniform vec3 cameraPos;
+
+struct Material
+{
+    sampler2D diffuse;
+    sampler2D specular;
+    float shininess;
+};
+
+uniform Material material;
+
+struct DirectionLight
+{
+    vec3 direction;
+
+    vec3 ambient;
+    vec3 diffuse;
+    vec3 specular;
+};
+
+uniform DirectionLight directionLight;
+
+// Point and spot lights of the fragment cluster instead of a fixed array of lights
+#include "/resources/shaders/clusteredlighting.glsl"
+
+vec3 computeDirectionLight(DirectionLight light, vec3 diffuseColor, vec3 specularColor, float shininess, vec3 normal, vec3 fragPos, vec3 cameraPos)
+{
+    // ambient
+    vec3 ambient = light.ambient * diffuseColor;
+
+    vec3 lightDir = normalize(-light.direction);
+
+    // diffuse
+    vec3 norm = normalize(normal);
+    float diff = max(dot(norm, lightDir), 0.0);
+    vec3 diffuse = light.diffuse * (diff * diffuseColor);
+
+    // specular
+    vec3 viewDir = normalize(cameraPos - fragPos);
+    vec3 reflectDir = reflect(-lightDir, norm);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), shininess);
+    vec3 specular = light.specular * (spec * specularColor);
+
+    return ambient + diffuse + specular;
+}
+
+void main()
+{
+    vec3 diffuseColor = vec3(texture(material.diffuse, TexCoord));
+    vec3 specularColor = vec3(texture(material.specular, TexCoord));
+
+    vec3 result = computeDirectionLight(directionLight, diffuseColor, specularColor, material.shininess, Normal, FragPos, cameraPos);
+    result += computeClusteredLights(diffuseColor, specularColor, material.shininess, Normal, FragPos, cameraPos);
+
+    FragColor = vec4(result, 1.0);
+}
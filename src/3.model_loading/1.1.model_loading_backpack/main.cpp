@@ -91,7 +91,7 @@ int main(int argc, char** argv)
 
         // Project from View Space (3D) to Clip Space (2D)
         int width, height;
-        glfwGetWindowSize(window, &width, &height);
+        learnopengl::getWindowSize(window, &width, &height);
         camera.setAspect(height ? float(width) / float(height) : 1.f);
         const auto& projection = camera.projectionMatrix();
 
@@ -103,12 +103,8 @@ int main(int argc, char** argv)
         shaderProgram.setFloat("material.shininess", 32.f);
 
         glm::mat4 model = glm::mat4(1.0f);
-        shaderProgram.setMat4("model", glm::value_ptr(model));
 
-        glm::mat3 normalModelMatrix = glm::mat3(glm::inverseTranspose(glm::mat3(model)));
-        shaderProgram.setMat3("normalModelMatrix", glm::value_ptr(normalModelMatrix));
-
-        ourModel.draw(shaderProgram);
+        ourModel.draw(shaderProgram, model);
 
         // Show rendered buffer in screen
         glfwPollEvents();
@@ -91,7 +91,7 @@ int main(int argc, char** argv)
 
         // Project from View Space (3D) to Clip Space (2D)
         int width, height;
-        glfwGetWindowSize(window, &width, &height);
+        learnopengl::getWindowSize(window, &width, &height);
         camera.setAspect(height ? float(width) / float(height) : 1.f);
         const auto& projection = camera.projectionMatrix();
 
@@ -104,15 +104,11 @@ int main(int argc, char** argv)
 
         glm::mat4 model = glm::mat4(1.0f);
         model = glm::translate(model, glm::vec3(0.f, -1.f, 0.f));
-        model = glm::rotate(model, glm::radians(-90.f), glm::vec3(1.f, 0.f, 0.f));
-        model = glm::rotate(model, glm::radians(-90.f), glm::vec3(0.0f, 0.f, 1.f));
-        model = glm::scale(model, glm::vec3(0.25f));
-        shaderProgram.setMat4("model", glm::value_ptr(model));
+        // gltf root node already rotate the model y up and scale it
+        model = glm::rotate(model, glm::radians(-90.f), glm::vec3(0.f, 1.f, 0.f));
+        model = glm::scale(model, glm::vec3(0.078f));
 
-        glm::mat3 normalModelMatrix = glm::mat3(glm::inverseTranspose(glm::mat3(model)));
-        shaderProgram.setMat3("normalModelMatrix", glm::value_ptr(normalModelMatrix));
-
-        ourModel.draw(shaderProgram);
+        ourModel.draw(shaderProgram, model);
 
         // Show rendered buffer in screen
         glfwPollEvents();
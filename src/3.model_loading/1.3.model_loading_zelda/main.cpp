@@ -92,7 +92,7 @@ int main(int argc, char** argv)
 
         // Project from View Space (3D) to Clip Space (2D)
         int width, height;
-        glfwGetWindowSize(window, &width, &height);
+        learnopengl::getWindowSize(window, &width, &height);
         camera.setAspect(height ? float(width) / float(height) : 1.f);
         const auto& projection = camera.projectionMatrix();
 
@@ -108,12 +108,8 @@ int main(int argc, char** argv)
         //model = glm::rotate(model, glm::radians(-90.f), glm::vec3(1.f, 0.f, 0.f));
         //model = glm::rotate(model, glm::radians(-90.f), glm::vec3(0.0f, 0.f, 1.f));
         model = glm::scale(model, glm::vec3(0.015f));
-        shaderProgram.setMat4("model", glm::value_ptr(model));
 
-        glm::mat3 normalModelMatrix = glm::mat3(glm::inverseTranspose(glm::mat3(model)));
-        shaderProgram.setMat3("normalModelMatrix", glm::value_ptr(normalModelMatrix));
-
-        ourModel.draw(shaderProgram);
+        ourModel.draw(shaderProgram, model);
 
         // Show rendered buffer in screen
         glfwPollEvents();
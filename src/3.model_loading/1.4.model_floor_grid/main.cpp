@@ -5,11 +5,15 @@
 #include <learnopengl/camera.hpp>
 #include <learnopengl/cameracontroller.hpp>
 #include <learnopengl/fpscounter.hpp>
+#include <learnopengl/frameprofiler.hpp>
+#include <learnopengl/framepacing.hpp>
+#include <learnopengl/framepacingoverlay.hpp>
 #include <learnopengl/directionlight.hpp>
 #include <learnopengl/pointlight.hpp>
 #include <learnopengl/mesh.hpp>
 #include <learnopengl/model.hpp>
 #include <learnopengl/gridfloor.hpp>
+#include <learnopengl/depthstate.hpp>
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
@@ -18,9 +22,15 @@
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/gtc/matrix_inverse.hpp>
 
+#include <iostream>
+
 learnopengl::Camera camera;
 learnopengl::CameraController cameraController(&camera);
 
+// Frame interval graph, toggled with O
+bool showFramePacing = false;
+bool framePacingKeyDown = false;
+
 void processInput(GLFWwindow* window)
 {
     if(glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
@@ -28,6 +38,11 @@ void processInput(GLFWwindow* window)
         glfwSetWindowShouldClose(window, true);
     }
 
+    const bool framePacingKey = glfwGetKey(window, GLFW_KEY_O) == GLFW_PRESS;
+    if(framePacingKey && !framePacingKeyDown)
+        showFramePacing = !showFramePacing;
+    framePacingKeyDown = framePacingKey;
+
     cameraController.processInput(window);
 }
 
@@ -61,6 +76,8 @@ int main(int argc, char** argv)
     camera.setFovDegrees(70.f);
     camera.setCameraPos(glm::vec3(2.f, 2.f, 2.f));
     camera.setCameraFront(glm::normalize(glm::vec3(-1.f, -1.f, -1.f)));
+    // No far clipping of the grid, and depth precision kept far away
+    camera.setReverseZ(true);
 
     learnopengl::PointLight pointLight;
     pointLight.setAmbient(glm::vec3(0.01f));
@@ -75,6 +92,7 @@ int main(int argc, char** argv)
 
     // Enable fragment depth testing
     glEnable(GL_DEPTH_TEST);
+    learnopengl::applyDepthState(camera);
 
     // Enable blending
     glEnable(GL_BLEND);
@@ -82,6 +100,10 @@ int main(int argc, char** argv)
 
     learnopengl::GridFloor gridFloor;
 
+    auto& profiler = learnopengl::frameProfiler(window);
+    const auto& framePacing = learnopengl::framePacingMonitor(window);
+    learnopengl::FramePacingOverlay framePacingOverlay;
+
     // Main window render loop
     while(!glfwWindowShouldClose(window))
     {
@@ -98,7 +120,7 @@ int main(int argc, char** argv)
 
         // Project from View Space (3D) to Clip Space (2D)
         int width, height;
-        glfwGetWindowSize(window, &width, &height);
+        learnopengl::getWindowSize(window, &width, &height);
         camera.setAspect(height ? float(width) / float(height) : 1.f);
         const auto& projection = camera.projectionMatrix();
 
@@ -114,20 +136,28 @@ int main(int argc, char** argv)
         //model = glm::rotate(model, glm::radians(-90.f), glm::vec3(1.f, 0.f, 0.f));
         //model = glm::rotate(model, glm::radians(-90.f), glm::vec3(0.0f, 0.f, 1.f));
         model = glm::scale(model, glm::vec3(0.015f));
-        shaderProgram.setMat4("model", glm::value_ptr(model));
-
-        glm::mat3 normalModelMatrix = glm::mat3(glm::inverseTranspose(glm::mat3(model)));
-        shaderProgram.setMat3("normalModelMatrix", glm::value_ptr(normalModelMatrix));
 
         // Render first grid
-        gridFloor.draw(camera);
+        {
+            learnopengl::FrameProfiler::ScopeGuard scope(profiler, "grid");
+            gridFloor.draw(camera);
+        }
         glClear(GL_DEPTH_BUFFER_BIT);
 
-        // Then render model
-        ourModel.draw(shaderProgram);
+        // Then render model, skipping meshes outside of the camera frustum
+        {
+            learnopengl::FrameProfiler::ScopeGuard scope(profiler, "model");
+            ourModel.draw(shaderProgram, model, &camera.frustum());
+        }
 
         // And grid on top of model once again to have correct blen
-        gridFloor.draw(camera);
+        {
+            learnopengl::FrameProfiler::ScopeGuard scope(profiler, "grid");
+            gridFloor.draw(camera);
+        }
+
+        if(showFramePacing)
+            framePacingOverlay.draw(framePacing);
 
         // Show rendered buffer in screen
         glfwPollEvents();
@@ -136,6 +166,15 @@ int main(int argc, char** argv)
         learnopengl::showFPS(window);
     }
 
+    for(const auto* name: {"grid", "model"})
+    {
+        const auto cpu = profiler.scopeStatistics(name, learnopengl::FrameProfiler::Metric::Cpu);
+        const auto gpu = profiler.scopeStatistics(name, learnopengl::FrameProfiler::Metric::Gpu);
+        std::cout << name << ": cpu p50 " << cpu.p50 << " p99 " << cpu.p99 << " ms, gpu p50 " << gpu.p50 << " p99 " << gpu.p99 << " ms"
+                  << std::endl;
+    }
+    framePacing.write(std::cout);
+
     glfwTerminate();
 
     return 0;
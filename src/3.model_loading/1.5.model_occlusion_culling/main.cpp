@@ -0,0 +1,301 @@
+// https://learnopengl.com/Model-Loading/Model
+
+#include <learnopengl/window.hpp>
+#include <learnopengl/shader.hpp>
+#include <learnopengl/camera.hpp>
+#include <learnopengl/cameracontroller.hpp>
+#include <learnopengl/fpscounter.hpp>
+#include <learnopengl/frameprofiler.hpp>
+#include <learnopengl/framepacing.hpp>
+#include <learnopengl/depthstate.hpp>
+#include <learnopengl/geometrypool.hpp>
+#include <learnopengl/mesh.hpp>
+#include <learnopengl/model.hpp>
+#include <learnopengl/multidrawbatch.hpp>
+#include <learnopengl/primitives.hpp>
+#include <learnopengl/occlusionbuffer.hpp>
+#include <learnopengl/depthpyramid.hpp>
+#include <learnopengl/occlusionculler.hpp>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/matrix_inverse.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+learnopengl::Camera camera;
+learnopengl::CameraController cameraController(&camera);
+
+void processInput(GLFWwindow* window)
+{
+    if(glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+    {
+        glfwSetWindowShouldClose(window, true);
+    }
+
+    cameraController.processInput(window);
+}
+
+void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods)
+{
+    cameraController.mouseButtonCallback(window, button, action, mods);
+}
+
+void mouseMoveCallback(GLFWwindow* window, double xpos, double ypos)
+{
+    cameraController.mouseMoveCallback(window, float(xpos), float(ypos));
+}
+
+void scrollCallback(GLFWwindow* window, double xoffset, double yoffset) { cameraController.scrollCallback(float(yoffset)); }
+
+enum class OcclusionMode
+{
+    Off,
+    // OcclusionBuffer of the walls and large meshes of the frame, survivors drawn by Model::draw
+    Cpu,
+    // DepthPyramid of the previous frame, OcclusionCuller writing the indirect commands of Model::drawIndirect
+    Gpu,
+};
+
+// Scene color and a depth texture the pyramid is built from
+struct SceneTarget
+{
+    std::uint32_t framebuffer = 0;
+    std::uint32_t color = 0;
+    std::uint32_t depth = 0;
+    int width = 0;
+    int height = 0;
+};
+
+void resizeSceneTarget(SceneTarget& target, int width, int height)
+{
+    if(target.framebuffer)
+    {
+        glDeleteFramebuffers(1, &target.framebuffer);
+        glDeleteRenderbuffers(1, &target.color);
+        glDeleteTextures(1, &target.depth);
+    }
+    target.width = width;
+    target.height = height;
+
+    glGenRenderbuffers(1, &target.color);
+    glBindRenderbuffer(GL_RENDERBUFFER, target.color);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenTextures(1, &target.depth);
+    glBindTexture(GL_TEXTURE_2D, target.depth);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT32F, width, height, 0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glGenFramebuffers(1, &target.framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, target.framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, target.color);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, target.depth, 0);
+    if(glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        std::cerr << "Scene framebuffer is not complete" << std::endl;
+    glBindFramebuffer(GL_FRAMEBUFFER, learnopengl::defaultFramebuffer());
+}
+
+int main(int argc, char** argv)
+{
+    auto* window = learnopengl::createWindow();
+    if(!window)
+        return -1;
+
+    glfwSetCursorPosCallback(window, mouseMoveCallback);
+    glfwSetMouseButtonCallback(window, mouseButtonCallback);
+    glfwSetScrollCallback(window, scrollCallback);
+
+    // LEARNOPENGL_OCCLUSION=off|cpu|gpu, the GPU path needs OpenGL 4.3
+    auto mode = OcclusionMode::Cpu;
+    if(const char* value = std::getenv("LEARNOPENGL_OCCLUSION"))
+    {
+        if(std::strcmp(value, "off") == 0)
+            mode = OcclusionMode::Off;
+        else if(std::strcmp(value, "gpu") == 0)
+            mode = OcclusionMode::Gpu;
+    }
+    if(mode == OcclusionMode::Gpu && !(learnopengl::DepthPyramid::supported() && learnopengl::MultiDrawBatch::supported()))
+    {
+        std::cerr << "GPU occlusion culling needs OpenGL 4.3, using the CPU occlusion buffer" << std::endl;
+        mode = OcclusionMode::Cpu;
+    }
+
+    // SHADER PROGRAM
+    auto meshShader = learnopengl::Shader("resources/shaders/mesh.vs", "resources/shaders/mesh.fs");
+    std::unique_ptr<learnopengl::Shader> indirectShader;
+    if(mode == OcclusionMode::Gpu)
+        indirectShader = std::make_unique<learnopengl::Shader>("resources/shaders/multidraw.vs", "resources/shaders/mesh.fs");
+
+    // 6x6 copies of the model sharing their geometry: each keeps its own indirect commands
+    constexpr int CopyCount = 6;
+    constexpr float Spacing = 4.f;
+    learnopengl::GeometryPool geometryPool;
+    std::vector<std::unique_ptr<learnopengl::Model>> copies;
+    std::vector<glm::mat4> copyModels;
+    for(int x = 0; x < CopyCount; ++x)
+    {
+        for(int z = 0; z < CopyCount; ++z)
+        {
+            copies.push_back(std::make_unique<learnopengl::Model>("resources/objects/zelda/scene.gltf", false, &geometryPool));
+            const glm::vec3 position((float(x) - CopyCount * 0.5f + 0.5f) * Spacing, -1.f, -float(z) * Spacing);
+            copyModels.push_back(glm::scale(glm::translate(glm::mat4(1.f), position), glm::vec3(0.015f)));
+        }
+    }
+
+    // Walls between the rows of copies, alternating sides: the main occluders
+    const auto cube = learnopengl::createCube();
+    const learnopengl::Mesh wallMesh(cube.vertices,
+        cube.indices,
+        {learnopengl::Texture("resources/textures/container.jpg", {.name = "texture_diffuse"})},
+        &geometryPool);
+    std::vector<glm::mat4> wallModels;
+    for(int row = 0; row < CopyCount; ++row)
+    {
+        const float side = row % 2 ? 1.f : -1.f;
+        const glm::vec3 position(side * Spacing, 0.5f, 2.f - float(row) * Spacing);
+        wallModels.push_back(glm::scale(glm::translate(glm::mat4(1.f), position), glm::vec3(Spacing * 4.f, 3.f, 0.3f)));
+    }
+
+    camera.setFovDegrees(70.f);
+    camera.setCameraPos(glm::vec3(0.f, 0.5f, 8.f));
+    camera.setCameraFront(glm::vec3(0.f, 0.f, -1.f));
+
+    // Enable fragment depth testing
+    glEnable(GL_DEPTH_TEST);
+    learnopengl::applyDepthState(camera);
+
+    learnopengl::OcclusionBuffer occlusionBuffer;
+    std::unique_ptr<learnopengl::DepthPyramid> depthPyramid;
+    std::unique_ptr<learnopengl::OcclusionCuller> occlusionCuller;
+    if(mode == OcclusionMode::Gpu)
+    {
+        depthPyramid = std::make_unique<learnopengl::DepthPyramid>();
+        occlusionCuller = std::make_unique<learnopengl::OcclusionCuller>(*depthPyramid);
+    }
+    SceneTarget sceneTarget;
+
+    auto& profiler = learnopengl::frameProfiler(window);
+    const auto& framePacing = learnopengl::framePacingMonitor(window);
+
+    std::size_t frameCount = 0;
+    std::size_t testedMeshes = 0;
+    std::size_t occludedMeshes = 0;
+
+    // Main window render loop
+    while(!glfwWindowShouldClose(window))
+    {
+        // Process input
+        processInput(window);
+
+        // Project from View Space (3D) to Clip Space (2D)
+        int width, height;
+        learnopengl::getWindowSize(window, &width, &height);
+        camera.setAspect(height ? float(width) / float(height) : 1.f);
+        if(width > 0 && height > 0 && (width != sceneTarget.width || height != sceneTarget.height))
+            resizeSceneTarget(sceneTarget, width, height);
+
+        const auto& view = camera.viewMatrix();
+        const auto& projection = camera.projectionMatrix();
+        const auto& frustum = camera.frustum();
+
+        // Occluders of this frame, before the scene
+        if(mode == OcclusionMode::Cpu)
+        {
+            learnopengl::FrameProfiler::ScopeGuard scope(profiler, "occlusion", false);
+            occlusionBuffer.clear(projection * view, camera.near());
+            for(const auto& wallModel: wallModels) occlusionBuffer.rasterize(wallMesh, wallModel);
+            for(std::size_t i = 0; i < copies.size(); ++i) copies[i]->rasterizeOccluders(occlusionBuffer, copyModels[i], &frustum, 0.5f);
+            occlusionBuffer.finish();
+        }
+        if(occlusionCuller)
+            occlusionCuller->beginFrame();
+
+        // Render
+        glBindFramebuffer(GL_FRAMEBUFFER, sceneTarget.framebuffer);
+        glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        {
+            learnopengl::FrameProfiler::ScopeGuard scope(profiler, "scene");
+
+            meshShader.use();
+            meshShader.setMat4("projection", glm::value_ptr(projection));
+            meshShader.setMat4("view", glm::value_ptr(view));
+            for(const auto& wallModel: wallModels)
+            {
+                meshShader.setMat4("model", glm::value_ptr(wallModel));
+                const glm::mat3 normalModelMatrix = glm::inverseTranspose(glm::mat3(wallModel));
+                meshShader.setMat3("normalModelMatrix", glm::value_ptr(normalModelMatrix));
+                wallMesh.draw(meshShader);
+            }
+
+            if(indirectShader)
+            {
+                indirectShader->use();
+                indirectShader->setMat4("projection", glm::value_ptr(projection));
+                indirectShader->setMat4("view", glm::value_ptr(view));
+            }
+            for(std::size_t i = 0; i < copies.size(); ++i)
+            {
+                if(mode == OcclusionMode::Gpu)
+                    copies[i]->drawIndirect(*indirectShader, copyModels[i], &frustum, occlusionCuller.get());
+                else
+                    copies[i]->draw(meshShader, copyModels[i], &frustum, mode == OcclusionMode::Cpu ? &occlusionBuffer : nullptr);
+
+                const auto& stats = copies[i]->drawStats();
+                testedMeshes += stats.drawnMeshes + stats.occludedMeshes;
+                occludedMeshes += stats.occludedMeshes;
+            }
+        }
+
+        // Depth of this frame culls the next one
+        if(depthPyramid)
+        {
+            learnopengl::FrameProfiler::ScopeGuard scope(profiler, "occlusion");
+            depthPyramid->build(camera, sceneTarget.depth, sceneTarget.width, sceneTarget.height);
+            // Counted by the GPU 2 frames ago, of as many commands
+            occludedMeshes += occlusionCuller->stats().occludedCount;
+        }
+        ++frameCount;
+
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, sceneTarget.framebuffer);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, learnopengl::defaultFramebuffer());
+        glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+        glBindFramebuffer(GL_FRAMEBUFFER, learnopengl::defaultFramebuffer());
+
+        // Show rendered buffer in screen
+        glfwPollEvents();
+        glfwSwapBuffers(window);
+
+        learnopengl::showFPS(window);
+    }
+
+    const char* modeNames[] = {"off", "cpu", "gpu"};
+    std::cout << "occlusion " << modeNames[int(mode)] << ": " << (frameCount ? double(occludedMeshes) / double(frameCount) : 0.)
+              << " occluded of " << (frameCount ? double(testedMeshes) / double(frameCount) : 0.) << " meshes in the frustum per frame"
+              << std::endl;
+    for(const auto* name: {"occlusion", "scene"})
+    {
+        const auto cpu = profiler.scopeStatistics(name, learnopengl::FrameProfiler::Metric::Cpu);
+        const auto gpu = profiler.scopeStatistics(name, learnopengl::FrameProfiler::Metric::Gpu);
+        std::cout << name << ": cpu p50 " << cpu.p50 << " p99 " << cpu.p99 << " ms, gpu p50 " << gpu.p50 << " p99 " << gpu.p99 << " ms"
+                  << std::endl;
+    }
+    framePacing.write(std::cout);
+
+    glfwTerminate();
+
+    return 0;
+}
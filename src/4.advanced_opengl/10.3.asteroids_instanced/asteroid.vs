@@ -0,0 +1,18 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec2 aTexCoord;
+// Per instance model and normal matrices, see learnopengl::InstancedMesh
+layout (location = 3) in mat4 aModel;
+layout (location = 7) in mat3 aNormalModelMatrix;
+
+out vec3 Normal;
+
+uniform mat4 view;
+uniform mat4 projection;
+
+void main()
+{
+    Normal = aNormalModelMatrix * aNormal;
+    gl_Position = projection * view * aModel * vec4(aPos, 1.0);
+}
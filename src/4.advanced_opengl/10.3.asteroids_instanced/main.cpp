@@ -0,0 +1,227 @@
+// https://learnopengl.com/Advanced-OpenGL/Instancing
+// Asteroid field around a planet in a single instanced draw call, with every rock orbiting: transforms are generated each frame in
+// parallel and written to a persistently mapped instance buffer (learnopengl::InstancedMesh).
+// LEARNOPENGL_INSTANCE_COUNT=<count> sets the number of rocks (100000, up to 1M). Rock and planet are procedural meshes.
+// LEARNOPENGL_PERSISTENT_MAPPING=0 uploads with glBufferSubData instead (also without OpenGL 4.4).
+// Prints the CPU time of the update, the CPU time to submit the draw, its GPU time and the triangle throughput at exit.
+
+#include <learnopengl/window.hpp>
+#include <learnopengl/shader.hpp>
+#include <learnopengl/camera.hpp>
+#include <learnopengl/cameracontroller.hpp>
+#include <learnopengl/fpscounter.hpp>
+#include <learnopengl/frameprofiler.hpp>
+#include <learnopengl/benchmark.hpp>
+#include <learnopengl/directionlight.hpp>
+#include <learnopengl/mesh.hpp>
+#include <learnopengl/instancedmesh.hpp>
+#include <learnopengl/primitives.hpp>
+#include <learnopengl/threadpool.hpp>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+learnopengl::Camera camera;
+learnopengl::CameraController cameraController(&camera);
+
+void processInput(GLFWwindow* window)
+{
+    if(glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+    {
+        glfwSetWindowShouldClose(window, true);
+    }
+
+    cameraController.processInput(window);
+}
+
+void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods)
+{
+    cameraController.mouseButtonCallback(window, button, action, mods);
+}
+
+void mouseMoveCallback(GLFWwindow* window, double xpos, double ypos)
+{
+    cameraController.mouseMoveCallback(window, float(xpos), float(ypos));
+}
+
+void scrollCallback(GLFWwindow* window, double xoffset, double yoffset) { cameraController.scrollCallback(float(yoffset)); }
+
+// Uniform in [0, 1) from an instance index: instances are generated in any order by the thread pool, with the same result
+float hashUnit(std::uint32_t index, std::uint32_t seed, std::uint32_t stream)
+{
+    std::uint32_t h = index * 0x9E3779B9u ^ seed * 0x85EBCA6Bu ^ stream * 0xC2B2AE35u;
+    h ^= h >> 16;
+    h *= 0x7FEB352Du;
+    h ^= h >> 15;
+    h *= 0x846CA68Bu;
+    h ^= h >> 16;
+    return float(h >> 8) / float(1u << 24);
+}
+
+// Rock i of count on a ring around the planet, as in the tutorial
+glm::mat4 asteroidModel(std::uint32_t i, std::uint32_t count, std::uint32_t seed)
+{
+    constexpr float Radius = 150.f;
+    constexpr float Offset = 25.f;
+
+    const float angle = float(i) / float(count) * 2.f * glm::pi<float>();
+    const auto displacement = [&](std::uint32_t stream) { return (hashUnit(i, seed, stream) * 2.f - 1.f) * Offset; };
+    const float x = std::sin(angle) * Radius + displacement(0);
+    // Flatter field along y
+    const float y = displacement(1) * 0.4f;
+    const float z = std::cos(angle) * Radius + displacement(2);
+
+    glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(x, y, z));
+    model = glm::scale(model, glm::vec3(0.05f + hashUnit(i, seed, 3) * 0.2f));
+    return glm::rotate(model, hashUnit(i, seed, 4) * 2.f * glm::pi<float>(), glm::vec3(0.4f, 0.6f, 0.8f));
+}
+
+int main(int argc, char** argv)
+{
+    auto* window = learnopengl::createWindow();
+    if(!window)
+        return -1;
+
+    glfwSetCursorPosCallback(window, mouseMoveCallback);
+    glfwSetMouseButtonCallback(window, mouseButtonCallback);
+    glfwSetScrollCallback(window, scrollCallback);
+
+    std::uint32_t asteroidCount = 100'000;
+    if(const char* value = std::getenv("LEARNOPENGL_INSTANCE_COUNT"))
+        asteroidCount = std::uint32_t(std::clamp(std::atol(value), 1l, 1'000'000l));
+
+    learnopengl::InstancedMesh::Settings instanceSettings;
+    const char* persistentValue = std::getenv("LEARNOPENGL_PERSISTENT_MAPPING");
+    instanceSettings.persistentMapping = !persistentValue || std::atoi(persistentValue) != 0;
+
+    // SHADER PROGRAM
+    auto planetShaderProgram = learnopengl::Shader("planet.vs", "shader.fs");
+    auto asteroidShaderProgram = learnopengl::Shader("asteroid.vs", "shader.fs");
+
+    // VERTEX DATA
+    const auto rock = learnopengl::createRock(learnopengl::Benchmark::seed());
+    const learnopengl::Mesh rockMesh(rock.vertices, rock.indices, {});
+    const auto planet = learnopengl::createSphere(64, 32);
+    const learnopengl::Mesh planetMesh(planet.vertices, planet.indices, {});
+
+    // Rock transforms at rest, the orbit rotates them around the planet axis
+    std::vector<glm::mat4> restModels(asteroidCount);
+    const auto seed = learnopengl::Benchmark::seed();
+    learnopengl::ThreadPool::global().parallelFor(asteroidCount,
+        4096,
+        [&](std::size_t begin, std::size_t end)
+        {
+            for(auto i = begin; i < end; ++i) restModels[i] = asteroidModel(std::uint32_t(i), asteroidCount, seed);
+        });
+
+    learnopengl::InstancedMesh asteroids(rockMesh, instanceSettings);
+    asteroids.resize(asteroidCount);
+
+    // Enable fragment depth testing
+    glEnable(GL_DEPTH_TEST);
+    glEnable(GL_CULL_FACE);
+
+    camera.setFovDegrees(45.f);
+    camera.setFar(1000.f);
+    camera.setCameraPos(glm::vec3(0.f, 40.f, 220.f));
+    camera.setCameraFront(glm::normalize(glm::vec3(0.f, -0.15f, -1.f)));
+
+    learnopengl::DirectionLight directionLight;
+    directionLight.setAmbient(glm::vec3(0.05f));
+    directionLight.setDiffuse(glm::vec3(0.9f));
+    directionLight.setDirection(glm::vec3(-1.f, -0.3f, -0.2f));
+
+    auto& profiler = learnopengl::frameProfiler(window);
+
+    // Main window render loop
+    while(!glfwWindowShouldClose(window))
+    {
+        // Process input
+        processInput(window);
+
+        // Render
+        glClearColor(0.05f, 0.05f, 0.05f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        // Project from View Space (3D) to Clip Space (2D)
+        int width, height;
+        learnopengl::getWindowSize(window, &width, &height);
+        camera.setAspect(height ? float(width) / float(height) : 1.f);
+
+        // Orbit: inner rocks turn faster. Transforms in parallel, normal matrices and upload by the instanced mesh.
+        {
+            learnopengl::FrameProfiler::ScopeGuard scope(profiler, "update", false);
+            const auto time = float(glfwGetTime());
+            auto& models = asteroids.models();
+            learnopengl::ThreadPool::global().parallelFor(asteroidCount,
+                4096,
+                [&](std::size_t begin, std::size_t end)
+                {
+                    for(auto i = begin; i < end; ++i)
+                    {
+                        const auto& rest = restModels[i];
+                        const float radius = glm::length(glm::vec2(rest[3].x, rest[3].z));
+                        const float angle = time * 20.f / std::max(radius, 1.f);
+                        models[i] = glm::rotate(glm::mat4(1.f), angle, glm::vec3(0.f, 1.f, 0.f)) * rest;
+                    }
+                });
+            asteroids.upload();
+        }
+
+        for(const auto* shaderProgram: {&planetShaderProgram, &asteroidShaderProgram})
+        {
+            shaderProgram->use();
+            shaderProgram->setMat4("projection", glm::value_ptr(camera.projectionMatrix()));
+            shaderProgram->setMat4("view", glm::value_ptr(camera.viewMatrix()));
+            shaderProgram->setDirectionLight("directionLight", directionLight);
+        }
+
+        // Planet
+        const auto planetModel = glm::scale(glm::translate(glm::mat4(1.0f), glm::vec3(0.f, -3.f, 0.f)), glm::vec3(40.f));
+        const auto planetNormalMatrix = glm::mat3(1.f);
+        planetShaderProgram.use();
+        planetShaderProgram.setMat4("model", glm::value_ptr(planetModel));
+        planetShaderProgram.setMat3("normalModelMatrix", glm::value_ptr(planetNormalMatrix));
+        planetShaderProgram.setVec3("color", 0.8f, 0.55f, 0.35f);
+        planetMesh.draw(planetShaderProgram);
+
+        // Rocks, one draw call
+        {
+            learnopengl::FrameProfiler::ScopeGuard scope(profiler, "asteroids");
+            asteroidShaderProgram.use();
+            asteroidShaderProgram.setVec3("color", 0.5f, 0.5f, 0.5f);
+            asteroids.draw(asteroidShaderProgram);
+        }
+
+        // Show rendered buffer in screen
+        glfwPollEvents();
+        glfwSwapBuffers(window);
+
+        learnopengl::showFPS(window);
+    }
+
+    // Submit time is the CPU time of the scope, triangle rate comes from its GPU time
+    const auto update = profiler.scopeStatistics("update", learnopengl::FrameProfiler::Metric::Cpu);
+    const auto cpu = profiler.scopeStatistics("asteroids", learnopengl::FrameProfiler::Metric::Cpu);
+    const auto gpu = profiler.scopeStatistics("asteroids", learnopengl::FrameProfiler::Metric::Gpu);
+    const double triangles = double(asteroidCount) * double(rockMesh.indexCount() / 3);
+    std::cout << asteroidCount << " asteroids of " << rockMesh.indexCount() / 3 << " triangles, 1 draw call, "
+              << (asteroids.persistentlyMapped() ? "persistently mapped" : "glBufferSubData") << " instance buffer" << std::endl;
+    std::cout << "update: cpu p50 " << update.p50 << " p99 " << update.p99 << " ms" << std::endl;
+    std::cout << "asteroids: submit cpu p50 " << cpu.p50 << " p99 " << cpu.p99 << " ms, gpu p50 " << gpu.p50 << " p99 " << gpu.p99
+              << " ms, " << (gpu.p50 > 0. ? triangles / (gpu.p50 * 1e-3) * 1e-6 : 0.) << " Mtriangles/s" << std::endl;
+
+    glfwTerminate();
+
+    return 0;
+}
@@ -0,0 +1,24 @@
+#version 330 core
+out vec4 FragColor;
+
+in vec3 Normal;
+
+struct DirectionLight
+{
+    vec3 direction;
+
+    vec3 ambient;
+    vec3 diffuse;
+    vec3 specular;
+};
+
+uniform DirectionLight directionLight;
+uniform vec3 color;
+
+void main()
+{
+    // Diffuse only, the rocks are dull
+    vec3 lightDir = normalize(-directionLight.direction);
+    float diff = max(dot(normalize(Normal), lightDir), 0.0);
+    FragColor = vec4((directionLight.ambient + directionLight.diffuse * diff) * color, 1.0);
+}
@@ -0,0 +1,252 @@
+// https://learnopengl.com/Advanced-Lighting/Shadows/Shadow-Mapping
+// Sun shadows over a 256 m field of boxes with learnopengl::ShadowMap cascades, while a few boxes orbit in the middle.
+// Static boxes are instanced by chunks culled against each cascade, orbiting boxes invalidate the cascades they cross.
+// LEARNOPENGL_SHADOW_CASCADES=<count> (4), LEARNOPENGL_SHADOW_RESOLUTION=<pixels> (2048), LEARNOPENGL_SHADOW_CACHING=0 renders every
+// cascade every frame. Prints per cascade the renders, shadow draw calls and GPU time at exit.
+
+#include <learnopengl/window.hpp>
+#include <learnopengl/shader.hpp>
+#include <learnopengl/camera.hpp>
+#include <learnopengl/cameracontroller.hpp>
+#include <learnopengl/fpscounter.hpp>
+#include <learnopengl/frameprofiler.hpp>
+#include <learnopengl/directionlight.hpp>
+#include <learnopengl/shadowmap.hpp>
+#include <learnopengl/mesh.hpp>
+#include <learnopengl/instancedmesh.hpp>
+#include <learnopengl/primitives.hpp>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+learnopengl::Camera camera;
+learnopengl::CameraController cameraController(&camera);
+
+void processInput(GLFWwindow* window)
+{
+    if(glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+    {
+        glfwSetWindowShouldClose(window, true);
+    }
+
+    cameraController.processInput(window);
+}
+
+void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods)
+{
+    cameraController.mouseButtonCallback(window, button, action, mods);
+}
+
+void mouseMoveCallback(GLFWwindow* window, double xpos, double ypos) { cameraController.mouseMoveCallback(window, float(xpos), float(ypos)); }
+
+void scrollCallback(GLFWwindow* window, double xoffset, double yoffset) { cameraController.scrollCallback(float(yoffset)); }
+
+// Boxes of one chunk of the field, drawn with a single instanced call
+struct Chunk
+{
+    std::unique_ptr<learnopengl::InstancedMesh> boxes;
+    learnopengl::AABB bounds;
+};
+
+int main(int argc, char** argv)
+{
+    auto* window = learnopengl::createWindow();
+    if(!window)
+        return -1;
+
+    glfwSetCursorPosCallback(window, mouseMoveCallback);
+    glfwSetMouseButtonCallback(window, mouseButtonCallback);
+    glfwSetScrollCallback(window, scrollCallback);
+
+    learnopengl::ShadowMap::Settings shadowSettings;
+    shadowSettings.maxDistance = 150.f;
+    if(const char* value = std::getenv("LEARNOPENGL_SHADOW_CASCADES"))
+        shadowSettings.cascadeCount = std::uint32_t(std::clamp(std::atoi(value), 1, int(learnopengl::ShadowMap::MaxCascades)));
+    if(const char* value = std::getenv("LEARNOPENGL_SHADOW_RESOLUTION"))
+        shadowSettings.resolution = std::clamp(std::atoi(value), 256, 8192);
+    if(const char* value = std::getenv("LEARNOPENGL_SHADOW_CACHING"))
+        shadowSettings.caching = std::atoi(value) != 0;
+
+    // SHADER PROGRAM
+    auto shaderProgram = learnopengl::Shader("shader.vs", "shader.fs");
+
+    // VERTEX DATA
+    const auto cube = learnopengl::createCube();
+    const learnopengl::Mesh cubeMesh(cube.vertices, cube.indices, {});
+
+    // 64x64 boxes of random heights in 8x8 chunks
+    constexpr int ChunkCount = 8;
+    constexpr int ChunkBoxes = 8;
+    constexpr float Spacing = 4.f;
+    std::vector<Chunk> chunks;
+    for(int chunkX = 0; chunkX < ChunkCount; ++chunkX)
+    {
+        for(int chunkZ = 0; chunkZ < ChunkCount; ++chunkZ)
+        {
+            auto& chunk = chunks.emplace_back();
+            chunk.boxes = std::make_unique<learnopengl::InstancedMesh>(cubeMesh);
+            for(int x = 0; x < ChunkBoxes; ++x)
+            {
+                for(int z = 0; z < ChunkBoxes; ++z)
+                {
+                    const int boxX = chunkX * ChunkBoxes + x;
+                    const int boxZ = chunkZ * ChunkBoxes + z;
+                    const float height = 1.f + float((boxX * 7 + boxZ * 13) % 5);
+                    constexpr float Half = ChunkCount * ChunkBoxes * 0.5f;
+                    const glm::vec3 position((float(boxX) - Half) * Spacing, height * 0.5f, (float(boxZ) - Half) * Spacing);
+                    auto model = glm::translate(glm::mat4(1.f), position);
+                    model = glm::rotate(model, glm::radians(float((boxX * 31 + boxZ * 17) % 90)), glm::vec3(0.f, 1.f, 0.f));
+                    model = glm::scale(model, glm::vec3(1.5f, height, 1.5f));
+                    chunk.boxes->add(model);
+
+                    const auto bounds = cubeMesh.bounds().transformed(model);
+                    chunk.bounds.expand(bounds.min);
+                    chunk.bounds.expand(bounds.max);
+                }
+            }
+            chunk.boxes->upload();
+        }
+    }
+
+    // Receives shadows only
+    learnopengl::InstancedMesh floor(cubeMesh);
+    floor.add(glm::scale(glm::translate(glm::mat4(1.f), glm::vec3(0.f, -0.5f, 0.f)), glm::vec3(300.f, 1.f, 300.f)));
+    floor.upload();
+
+    // Orbiting boxes, drawn one by one in the shadow pass
+    constexpr std::size_t OrbiterCount = 16;
+    learnopengl::InstancedMesh orbiters(cubeMesh);
+    orbiters.resize(OrbiterCount);
+    std::vector<learnopengl::AABB> orbiterBounds(OrbiterCount);
+
+    // Enable fragment depth testing
+    glEnable(GL_DEPTH_TEST);
+    glEnable(GL_CULL_FACE);
+
+    camera.setFovDegrees(60.f);
+    camera.setFar(200.f);
+    camera.setCameraPos(glm::vec3(0.f, 20.f, 40.f));
+    camera.setCameraFront(glm::normalize(glm::vec3(0.f, -0.4f, -1.f)));
+
+    learnopengl::DirectionLight directionLight;
+    directionLight.setAmbient(glm::vec3(0.15f));
+    directionLight.setDiffuse(glm::vec3(0.85f));
+    directionLight.setSpecular(glm::vec3(0.3f));
+    directionLight.setDirection(glm::vec3(-0.4f, -1.0f, -0.3f));
+
+    learnopengl::ShadowMap shadowMap(shadowSettings);
+
+    auto& profiler = learnopengl::frameProfiler(window);
+
+    std::size_t frameCount = 0;
+    std::size_t drawCounts[learnopengl::ShadowMap::MaxCascades] = {};
+    std::size_t culledCounts[learnopengl::ShadowMap::MaxCascades] = {};
+
+    // Main window render loop
+    while(!glfwWindowShouldClose(window))
+    {
+        // Process input
+        processInput(window);
+
+        // Project from View Space (3D) to Clip Space (2D)
+        int width, height;
+        learnopengl::getWindowSize(window, &width, &height);
+        camera.setAspect(height ? float(width) / float(height) : 1.f);
+
+        // Orbiters invalidate the cascades around their previous and new place
+        const auto time = float(glfwGetTime());
+        auto& orbiterModels = orbiters.models();
+        for(std::size_t i = 0; i < OrbiterCount; ++i)
+        {
+            const float angle = time * 0.5f + float(i) * glm::two_pi<float>() / float(OrbiterCount);
+            const glm::vec3 position(std::cos(angle) * 12.f, 3.f + std::sin(time + float(i)) * 1.5f, std::sin(angle) * 12.f);
+            orbiterModels[i] = glm::rotate(glm::translate(glm::mat4(1.f), position), time + float(i), glm::vec3(0.3f, 1.f, 0.f));
+
+            shadowMap.invalidate(orbiterBounds[i]);
+            orbiterBounds[i] = cubeMesh.bounds().transformed(orbiterModels[i]);
+            shadowMap.invalidate(orbiterBounds[i]);
+        }
+        orbiters.upload();
+
+        shadowMap.update(camera, directionLight);
+        {
+            learnopengl::FrameProfiler::ScopeGuard scope(profiler, "shadows");
+            shadowMap.render(
+                [&](learnopengl::ShadowMap::CasterPass& pass)
+                {
+                    for(auto& chunk: chunks) pass.draw(*chunk.boxes, chunk.bounds);
+                    for(const auto& model: orbiterModels) pass.draw(cubeMesh, model);
+                },
+                &profiler);
+        }
+        for(std::uint32_t cascade = 0; cascade < shadowMap.cascadeCount(); ++cascade)
+        {
+            drawCounts[cascade] += shadowMap.cascadeStats(cascade).drawCount;
+            culledCounts[cascade] += shadowMap.cascadeStats(cascade).culledCount;
+        }
+        ++frameCount;
+
+        // Render
+        glClearColor(0.55f, 0.7f, 0.9f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        {
+            learnopengl::FrameProfiler::ScopeGuard scope(profiler, "scene");
+            const auto& cameraPos = camera.cameraPos();
+            shaderProgram.use();
+            shaderProgram.setMat4("projection", glm::value_ptr(camera.projectionMatrix()));
+            shaderProgram.setMat4("view", glm::value_ptr(camera.viewMatrix()));
+            shaderProgram.setVec3("cameraPos", cameraPos.x, cameraPos.y, cameraPos.z);
+            shaderProgram.setDirectionLight("directionLight", directionLight);
+            shadowMap.bind(shaderProgram, 0);
+
+            shaderProgram.setVec3("color", 0.6f, 0.6f, 0.55f);
+            floor.draw(shaderProgram);
+            shaderProgram.setVec3("color", 0.8f, 0.45f, 0.3f);
+            for(auto& chunk: chunks) chunk.boxes->draw(shaderProgram);
+            shaderProgram.setVec3("color", 0.3f, 0.5f, 0.9f);
+            orbiters.draw(shaderProgram);
+        }
+
+        // Show rendered buffer in screen
+        glfwPollEvents();
+        glfwSwapBuffers(window);
+
+        learnopengl::showFPS(window);
+    }
+
+    // GPU time of a cascade is over the frames it was rendered
+    for(std::uint32_t cascade = 0; cascade < shadowMap.cascadeCount(); ++cascade)
+    {
+        const auto& stats = shadowMap.cascadeStats(cascade);
+        const auto* scopeName = learnopengl::ShadowMap::cascadeScopeName(cascade);
+        const auto gpu = profiler.scopeStatistics(scopeName, learnopengl::FrameProfiler::Metric::Gpu);
+        const double renders = double(std::max<std::size_t>(stats.renderCount, 1));
+        std::cout << "cascade " << cascade << ": up to " << stats.splitDistance << " m, texel " << stats.texelSize << " m, rendered "
+                  << stats.renderCount << " of " << frameCount << " frames, " << double(drawCounts[cascade]) / renders << " draws and "
+                  << double(culledCounts[cascade]) / renders << " culled per render, gpu p50 " << gpu.p50 << " p99 " << gpu.p99 << " ms"
+                  << std::endl;
+    }
+    for(const auto* name: {"shadows", "scene"})
+    {
+        const auto cpu = profiler.scopeStatistics(name, learnopengl::FrameProfiler::Metric::Cpu);
+        const auto gpu = profiler.scopeStatistics(name, learnopengl::FrameProfiler::Metric::Gpu);
+        std::cout << name << ": cpu p50 " << cpu.p50 << " p99 " << cpu.p99 << " ms, gpu p50 " << gpu.p50 << " p99 " << gpu.p99 << " ms"
+                  << std::endl;
+    }
+
+    glfwTerminate();
+
+    return 0;
+}
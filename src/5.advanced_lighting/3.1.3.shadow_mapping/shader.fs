@@ -0,0 +1,20 @@
+#version 330 core
+out vec4 FragColor;
+
+in vec3 FragPos;
+in vec3 Normal;
+
+#include "/resources/shaders/directionlight.glsl"
+#include "/resources/shaders/shadow.glsl"
+
+uniform DirectionLight directionLight;
+uniform vec3 cameraPos;
+uniform vec3 color;
+
+void main()
+{
+    vec3 normal = normalize(Normal);
+    float lit = computeShadow(FragPos, normal);
+    vec3 result = computeDirectionLight(directionLight, color, vec3(0.3), 32.0, normal, FragPos, cameraPos, lit);
+    FragColor = vec4(result, 1.0);
+}
@@ -0,0 +1,309 @@
+// https://learnopengl.com/Advanced-Lighting/Shadows/Point-Shadows
+// Shadows of many point lights and a few spot lights over a field of pillars with learnopengl::ShadowAtlas. A quarter of the lights
+// wander and a few boxes orbit, invalidating the faces they cross: only a budget of cube faces is rendered per frame.
+// LEARNOPENGL_LIGHT_COUNT=<point lights> (32), LEARNOPENGL_SHADOW_FACE_BUDGET=<faces per frame> (12),
+// LEARNOPENGL_SHADOW_ATLAS_SIZE=<pixels> (4096). Prints the faces rendered per frame, the atlas use and GPU times at exit.
+
+#include <learnopengl/window.hpp>
+#include <learnopengl/shader.hpp>
+#include <learnopengl/camera.hpp>
+#include <learnopengl/cameracontroller.hpp>
+#include <learnopengl/benchmark.hpp>
+#include <learnopengl/fpscounter.hpp>
+#include <learnopengl/frameprofiler.hpp>
+#include <learnopengl/lightrange.hpp>
+#include <learnopengl/packedlights.hpp>
+#include <learnopengl/pointlight.hpp>
+#include <learnopengl/spotlight.hpp>
+#include <learnopengl/shadowatlas.hpp>
+#include <learnopengl/mesh.hpp>
+#include <learnopengl/instancedmesh.hpp>
+#include <learnopengl/primitives.hpp>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+learnopengl::Camera camera;
+learnopengl::CameraController cameraController(&camera);
+
+void processInput(GLFWwindow* window)
+{
+    if(glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+    {
+        glfwSetWindowShouldClose(window, true);
+    }
+
+    cameraController.processInput(window);
+}
+
+void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods)
+{
+    cameraController.mouseButtonCallback(window, button, action, mods);
+}
+
+void mouseMoveCallback(GLFWwindow* window, double xpos, double ypos) { cameraController.mouseMoveCallback(window, float(xpos), float(ypos)); }
+
+void scrollCallback(GLFWwindow* window, double xoffset, double yoffset) { cameraController.scrollCallback(float(yoffset)); }
+
+// Point light wandering around its resting place, still when radius is 0
+struct LightPath
+{
+    glm::vec3 center = glm::vec3(0.f);
+    float radius = 0.f;
+    float phase = 0.f;
+};
+
+int main(int argc, char** argv)
+{
+    auto* window = learnopengl::createWindow();
+    if(!window)
+        return -1;
+
+    glfwSetCursorPosCallback(window, mouseMoveCallback);
+    glfwSetMouseButtonCallback(window, mouseButtonCallback);
+    glfwSetScrollCallback(window, scrollCallback);
+
+    std::size_t lightCount = 32;
+    if(const char* value = std::getenv("LEARNOPENGL_LIGHT_COUNT"))
+        lightCount = std::size_t(std::clamp(std::atoi(value), 1, 1024));
+    learnopengl::ShadowAtlas::Settings atlasSettings;
+    if(const char* value = std::getenv("LEARNOPENGL_SHADOW_FACE_BUDGET"))
+        atlasSettings.faceBudget = std::uint32_t(std::clamp(std::atoi(value), 1, 6 * 1024));
+    if(const char* value = std::getenv("LEARNOPENGL_SHADOW_ATLAS_SIZE"))
+        atlasSettings.atlasSize = std::uint32_t(std::clamp(std::atoi(value), 1024, 16384));
+
+    // SHADER PROGRAM
+    auto shaderProgram = learnopengl::Shader("shader.vs", "shader.fs");
+
+    // VERTEX DATA
+    const auto cube = learnopengl::createCube();
+    const learnopengl::Mesh cubeMesh(cube.vertices, cube.indices, {});
+
+    // 16x16 pillars over a 64 m floor, a single instanced draw culled against each face
+    constexpr int PillarCount = 16;
+    constexpr float Spacing = 4.f;
+    learnopengl::InstancedMesh pillars(cubeMesh);
+    learnopengl::AABB pillarBounds;
+    for(int x = 0; x < PillarCount; ++x)
+    {
+        for(int z = 0; z < PillarCount; ++z)
+        {
+            const float height = 1.f + float((x * 5 + z * 3) % 4);
+            constexpr float Half = PillarCount * 0.5f - 0.5f;
+            const glm::vec3 position((float(x) - Half) * Spacing, height * 0.5f, (float(z) - Half) * Spacing);
+            const auto model = glm::scale(glm::translate(glm::mat4(1.f), position), glm::vec3(0.6f, height, 0.6f));
+            pillars.add(model);
+
+            const auto bounds = cubeMesh.bounds().transformed(model);
+            pillarBounds.expand(bounds.min);
+            pillarBounds.expand(bounds.max);
+        }
+    }
+    pillars.upload();
+
+    // Receives shadows only
+    learnopengl::InstancedMesh floor(cubeMesh);
+    floor.add(glm::scale(glm::translate(glm::mat4(1.f), glm::vec3(0.f, -0.5f, 0.f)), glm::vec3(80.f, 1.f, 80.f)));
+    floor.upload();
+
+    // Orbiting boxes, drawn one by one in the shadow pass
+    constexpr std::size_t OrbiterCount = 8;
+    learnopengl::InstancedMesh orbiters(cubeMesh);
+    orbiters.resize(OrbiterCount);
+    std::vector<learnopengl::AABB> orbiterBounds(OrbiterCount);
+
+    // Point lights between the pillars, quadratic attenuation reaching the light threshold at 8 m
+    constexpr float LightRange = 8.f;
+    std::mt19937 random(learnopengl::Benchmark::seed());
+    std::uniform_real_distribution<float> unit(0.f, 1.f);
+    std::vector<learnopengl::PointLight> pointLights(lightCount);
+    std::vector<LightPath> lightPaths(lightCount);
+    for(std::size_t i = 0; i < lightCount; ++i)
+    {
+        const float extent = PillarCount * Spacing * 0.5f;
+        const float x = (unit(random) * 2.f - 1.f) * extent;
+        const float z = (unit(random) * 2.f - 1.f) * extent;
+        lightPaths[i].center = glm::vec3(x, 1.f + unit(random) * 2.5f, z);
+        lightPaths[i].radius = i % 4 == 0 ? 1.5f : 0.f;
+        lightPaths[i].phase = unit(random) * glm::two_pi<float>();
+
+        const auto hue = glm::vec3(unit(random), unit(random), unit(random));
+        auto& pointLight = pointLights[i];
+        pointLight.setAmbient(glm::vec3(0.f));
+        pointLight.setDiffuse(hue / std::max({hue.r, hue.g, hue.b, 1e-3f}));
+        pointLight.setSpecular(glm::vec3(0.5f));
+        pointLight.setAttenuation(1.f, 0.f, (1.f / learnopengl::LightRangeThreshold - 1.f) / (LightRange * LightRange));
+        pointLight.setPosition(lightPaths[i].center);
+    }
+
+    // Spot lights looking down on the middle of the field
+    std::vector<learnopengl::SpotLight> spotLights(4);
+    for(std::size_t i = 0; i < spotLights.size(); ++i)
+    {
+        const float angle = float(i) * glm::half_pi<float>();
+        auto& spotLight = spotLights[i];
+        spotLight.setAmbient(glm::vec3(0.f));
+        spotLight.setDiffuse(glm::vec3(1.f, 0.9f, 0.7f));
+        spotLight.setSpecular(glm::vec3(0.5f));
+        spotLight.setCutOff(glm::cos(glm::radians(20.f)));
+        spotLight.setOuterCutOff(glm::cos(glm::radians(25.f)));
+        spotLight.setAttenuation(1.f, 0.f, (1.f / learnopengl::LightRangeThreshold - 1.f) / 400.f);
+        spotLight.setPosition(glm::vec3(std::cos(angle) * 10.f, 9.f, std::sin(angle) * 10.f));
+        spotLight.setDirection(glm::normalize(glm::vec3(-std::cos(angle), -2.f, -std::sin(angle))));
+    }
+
+    // Lights read by the shader from a texture buffer, in the order of the atlas: point lights then spot lights
+    learnopengl::PackedLights packedLights;
+    GLuint lightBuffer = 0;
+    GLuint lightTexture = 0;
+    glGenBuffers(1, &lightBuffer);
+    glGenTextures(1, &lightTexture);
+    glBindBuffer(GL_TEXTURE_BUFFER, lightBuffer);
+    glBufferData(GL_TEXTURE_BUFFER,
+        GLsizeiptr((lightCount + spotLights.size()) * learnopengl::PackedLights::TexelsPerLight * sizeof(glm::vec4)),
+        nullptr,
+        GL_STREAM_DRAW);
+    glBindTexture(GL_TEXTURE_BUFFER, lightTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, lightBuffer);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+    // Enable fragment depth testing
+    glEnable(GL_DEPTH_TEST);
+    glEnable(GL_CULL_FACE);
+
+    camera.setFovDegrees(60.f);
+    camera.setFar(150.f);
+    camera.setCameraPos(glm::vec3(0.f, 12.f, 30.f));
+    camera.setCameraFront(glm::normalize(glm::vec3(0.f, -0.45f, -1.f)));
+
+    learnopengl::ShadowAtlas shadowAtlas(atlasSettings);
+
+    auto& profiler = learnopengl::frameProfiler(window);
+
+    std::size_t frameCount = 0;
+    std::size_t renderedFaces = 0;
+    std::size_t pendingFaces = 0;
+    std::size_t missingTiles = 0;
+
+    // Main window render loop
+    while(!glfwWindowShouldClose(window))
+    {
+        // Process input
+        processInput(window);
+
+        // Project from View Space (3D) to Clip Space (2D)
+        int width, height;
+        learnopengl::getWindowSize(window, &width, &height);
+        camera.setAspect(height ? float(width) / float(height) : 1.f);
+
+        const auto time = float(glfwGetTime());
+        for(std::size_t i = 0; i < lightCount; ++i)
+        {
+            const auto& path = lightPaths[i];
+            const float angle = time * 0.7f + path.phase;
+            pointLights[i].setPosition(path.center + glm::vec3(std::cos(angle), 0.f, std::sin(angle)) * path.radius);
+        }
+
+        // Orbiters invalidate the faces around their previous and new place
+        auto& orbiterModels = orbiters.models();
+        for(std::size_t i = 0; i < OrbiterCount; ++i)
+        {
+            const float angle = time * 0.4f + float(i) * glm::two_pi<float>() / float(OrbiterCount);
+            const glm::vec3 position(std::cos(angle) * 14.f, 1.5f + std::sin(time + float(i)) * 0.5f, std::sin(angle) * 14.f);
+            orbiterModels[i] = glm::rotate(glm::translate(glm::mat4(1.f), position), time + float(i), glm::vec3(0.3f, 1.f, 0.f));
+
+            shadowAtlas.invalidate(orbiterBounds[i]);
+            orbiterBounds[i] = cubeMesh.bounds().transformed(orbiterModels[i]);
+            shadowAtlas.invalidate(orbiterBounds[i]);
+        }
+        orbiters.upload();
+
+        shadowAtlas.update(camera, height, pointLights, spotLights);
+        {
+            learnopengl::FrameProfiler::ScopeGuard scope(profiler, "shadows");
+            shadowAtlas.render(
+                [&](learnopengl::ShadowCasterPass& pass)
+                {
+                    pass.draw(pillars, pillarBounds);
+                    for(const auto& model: orbiterModels) pass.draw(cubeMesh, model);
+                },
+                &profiler);
+        }
+        const auto& stats = shadowAtlas.stats();
+        renderedFaces += stats.renderedFaceCount;
+        pendingFaces += stats.pendingFaceCount;
+        missingTiles += stats.missingTileCount;
+        ++frameCount;
+
+        packedLights.clear();
+        for(const auto& pointLight: pointLights) packedLights.add(pointLight);
+        for(const auto& spotLight: spotLights) packedLights.add(spotLight);
+        glBindBuffer(GL_TEXTURE_BUFFER, lightBuffer);
+        glBufferSubData(GL_TEXTURE_BUFFER, 0, GLsizeiptr(packedLights.data().size() * sizeof(glm::vec4)), packedLights.data().data());
+        glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+        // Render
+        glClearColor(0.02f, 0.02f, 0.03f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        {
+            learnopengl::FrameProfiler::ScopeGuard scope(profiler, "scene");
+            const auto& cameraPos = camera.cameraPos();
+            shaderProgram.use();
+            shaderProgram.setMat4("projection", glm::value_ptr(camera.projectionMatrix()));
+            shaderProgram.setMat4("view", glm::value_ptr(camera.viewMatrix()));
+            shaderProgram.setVec3("cameraPos", cameraPos.x, cameraPos.y, cameraPos.z);
+            shaderProgram.setInt("lightCount", int(packedLights.size()));
+            glActiveTexture(GL_TEXTURE2);
+            glBindTexture(GL_TEXTURE_BUFFER, lightTexture);
+            glActiveTexture(GL_TEXTURE0);
+            shaderProgram.setInt("lights", 2);
+            shadowAtlas.bind(shaderProgram, 0, 1);
+
+            shaderProgram.setVec3("color", 0.6f, 0.6f, 0.55f);
+            floor.draw(shaderProgram);
+            shaderProgram.setVec3("color", 0.8f, 0.8f, 0.8f);
+            pillars.draw(shaderProgram);
+            shaderProgram.setVec3("color", 0.3f, 0.5f, 0.9f);
+            orbiters.draw(shaderProgram);
+        }
+
+        // Show rendered buffer in screen
+        glfwPollEvents();
+        glfwSwapBuffers(window);
+
+        learnopengl::showFPS(window);
+    }
+
+    const double frames = double(std::max<std::size_t>(frameCount, 1));
+    const auto& allocatorStats = shadowAtlas.allocator().stats();
+    std::cout << "shadow atlas: " << double(renderedFaces) / frames << " faces rendered and " << double(pendingFaces) / frames
+              << " waiting per frame (budget " << shadowAtlas.settings().faceBudget << "), " << double(missingTiles) / frames
+              << " faces without tile, " << allocatorStats.tileCount << " tiles in " << allocatorStats.usedPageCount << " of "
+              << allocatorStats.pageCount << " pages, " << allocatorStats.evictionCount << " evictions" << std::endl;
+    for(const auto* name: {"shadow atlas", "shadows", "scene"})
+    {
+        const auto cpu = profiler.scopeStatistics(name, learnopengl::FrameProfiler::Metric::Cpu);
+        const auto gpu = profiler.scopeStatistics(name, learnopengl::FrameProfiler::Metric::Gpu);
+        std::cout << name << ": cpu p50 " << cpu.p50 << " p99 " << cpu.p99 << " ms, gpu p50 " << gpu.p50 << " p99 " << gpu.p99 << " ms"
+                  << std::endl;
+    }
+
+    glDeleteTextures(1, &lightTexture);
+    glDeleteBuffers(1, &lightBuffer);
+    glfwTerminate();
+
+    return 0;
+}
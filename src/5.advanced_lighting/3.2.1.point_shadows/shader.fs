@@ -0,0 +1,26 @@
+#version 330 core
+out vec4 FragColor;
+
+in vec3 FragPos;
+in vec3 Normal;
+
+#include "/resources/shaders/packedlights.glsl"
+#include "/resources/shaders/shadowatlas.glsl"
+
+// Point lights then spot lights, in the order of ShadowAtlas::update
+uniform samplerBuffer lights;
+uniform int lightCount;
+uniform vec3 cameraPos;
+uniform vec3 color;
+
+void main()
+{
+    vec3 normal = normalize(Normal);
+    vec3 result = color * 0.02;
+    for(int i = 0; i < lightCount; ++i)
+    {
+        float lit = computeAtlasShadow(i, FragPos, normal);
+        result += computePackedLight(lights, i, color, vec3(0.3), 32.0, normal, FragPos, cameraPos, lit);
+    }
+    FragColor = vec4(result, 1.0);
+}
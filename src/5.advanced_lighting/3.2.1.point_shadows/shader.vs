@@ -0,0 +1,19 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+// Per instance, see InstancedMesh
+layout (location = 3) in mat4 aModel;
+layout (location = 7) in mat3 aNormalModelMatrix;
+
+out vec3 FragPos;
+out vec3 Normal;
+
+uniform mat4 view;
+uniform mat4 projection;
+
+void main()
+{
+    FragPos = vec3(aModel * vec4(aPos, 1.0));
+    Normal = aNormalModelMatrix * aNormal;
+    gl_Position = projection * view * vec4(FragPos, 1.0);
+}
@@ -0,0 +1,163 @@
+// https://learnopengl.com/Advanced-Lighting/HDR
+// Tunnel of the chapter lit by a very bright light at its end, rendered in an RGBA16F target and tone mapped by
+// learnopengl::PostProcess (bloom off): the exposure adapts to the average luminance from a histogram while walking down the tunnel.
+// LEARNOPENGL_AUTO_EXPOSURE=0 for a fixed exposure, LEARNOPENGL_EXPOSURE=<exposure> (1). Prints GPU times per stage at exit.
+
+#include <learnopengl/window.hpp>
+#include <learnopengl/shader.hpp>
+#include <learnopengl/camera.hpp>
+#include <learnopengl/cameracontroller.hpp>
+#include <learnopengl/fpscounter.hpp>
+#include <learnopengl/frameprofiler.hpp>
+#include <learnopengl/postprocess.hpp>
+#include <learnopengl/texture.hpp>
+#include <learnopengl/mesh.hpp>
+#include <learnopengl/instancedmesh.hpp>
+#include <learnopengl/primitives.hpp>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+learnopengl::Camera camera;
+learnopengl::CameraController cameraController(&camera);
+
+void processInput(GLFWwindow* window)
+{
+    if(glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+    {
+        glfwSetWindowShouldClose(window, true);
+    }
+
+    cameraController.processInput(window);
+}
+
+void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods)
+{
+    cameraController.mouseButtonCallback(window, button, action, mods);
+}
+
+void mouseMoveCallback(GLFWwindow* window, double xpos, double ypos) { cameraController.mouseMoveCallback(window, float(xpos), float(ypos)); }
+
+void scrollCallback(GLFWwindow* window, double xoffset, double yoffset) { cameraController.scrollCallback(float(yoffset)); }
+
+int main(int argc, char** argv)
+{
+    auto* window = learnopengl::createWindow();
+    if(!window)
+        return -1;
+
+    glfwSetCursorPosCallback(window, mouseMoveCallback);
+    glfwSetMouseButtonCallback(window, mouseButtonCallback);
+    glfwSetScrollCallback(window, scrollCallback);
+
+    learnopengl::PostProcess::Settings postProcessSettings;
+    postProcessSettings.bloom = learnopengl::PostProcess::Bloom::Off;
+    if(const char* value = std::getenv("LEARNOPENGL_AUTO_EXPOSURE"))
+        postProcessSettings.autoExposure = std::string(value) != "0";
+    if(const char* value = std::getenv("LEARNOPENGL_EXPOSURE"))
+        postProcessSettings.exposure = float(std::atof(value));
+    if(postProcessSettings.autoExposure && !learnopengl::PostProcess::autoExposureSupported())
+        std::cerr << "Auto exposure needs OpenGL 4.3, fixed exposure" << std::endl;
+
+    // SHADER PROGRAM
+    auto shaderProgram = learnopengl::Shader("shader.vs", "shader.fs");
+    auto diffuseTexture = learnopengl::Texture("/resources/textures/container.jpg");
+
+    // VERTEX DATA
+
+    // Long box seen from inside
+    const auto cube = learnopengl::createCube();
+    const learnopengl::Mesh cubeMesh(cube.vertices, cube.indices, {});
+    learnopengl::InstancedMesh tunnel(cubeMesh);
+    tunnel.add(glm::scale(glm::translate(glm::mat4(1.f), glm::vec3(0.f, 0.f, 25.f)), glm::vec3(2.5f, 2.5f, 27.5f)));
+    tunnel.upload();
+
+    // The light at the end is 1000 times brighter than the dim colored ones along the walls
+    const glm::vec3 lightPositions[] = {
+        glm::vec3(0.f, 0.f, 49.5f), glm::vec3(-1.4f, -1.9f, 9.f), glm::vec3(0.f, -1.8f, 4.f), glm::vec3(0.8f, -1.7f, 6.f)};
+    const glm::vec3 lightColors[] = {
+        glm::vec3(200.f, 200.f, 200.f), glm::vec3(0.1f, 0.f, 0.f), glm::vec3(0.f, 0.f, 0.2f), glm::vec3(0.f, 0.1f, 0.f)};
+
+    // Enable fragment depth testing
+    glEnable(GL_DEPTH_TEST);
+
+    camera.setFovDegrees(60.f);
+    camera.setCameraPos(glm::vec3(0.f, 0.f, 2.f));
+    camera.setCameraFront(glm::vec3(0.f, 0.f, 1.f));
+
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    learnopengl::PostProcess postProcess(viewport[2], viewport[3], postProcessSettings);
+
+    auto& profiler = learnopengl::frameProfiler(window);
+
+    double lastTime = glfwGetTime();
+
+    // Main window render loop
+    while(!glfwWindowShouldClose(window))
+    {
+        // Process input
+        processInput(window);
+
+        const double currentTime = glfwGetTime();
+        const auto deltaTime = float(currentTime - lastTime);
+        lastTime = currentTime;
+
+        const auto& view = camera.viewMatrix();
+
+        // Project from View Space (3D) to Clip Space (2D)
+        int width, height;
+        learnopengl::getWindowSize(window, &width, &height);
+        camera.setAspect(height ? float(width) / float(height) : 1.f);
+        const auto& projection = camera.projectionMatrix();
+
+        // Scene target in pixels of the render target
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        postProcess.resize(viewport[2], viewport[3]);
+
+        {
+            learnopengl::FrameProfiler::ScopeGuard scope(profiler, "scene");
+            postProcess.beginScene();
+
+            shaderProgram.use();
+            shaderProgram.setMat4("projection", glm::value_ptr(projection));
+            shaderProgram.setMat4("view", glm::value_ptr(view));
+            shaderProgram.setBool("inverseNormals", true);
+            diffuseTexture.use(0);
+            shaderProgram.setInt("diffuseTexture", 0);
+            for(int i = 0; i < 4; ++i)
+            {
+                const auto index = "[" + std::to_string(i) + "]";
+                shaderProgram.setVec3("lightPositions" + index, lightPositions[i].x, lightPositions[i].y, lightPositions[i].z);
+                shaderProgram.setVec3("lightColors" + index, lightColors[i].x, lightColors[i].y, lightColors[i].z);
+            }
+            tunnel.draw(shaderProgram);
+        }
+
+        postProcess.apply(learnopengl::defaultFramebuffer(), deltaTime, &profiler);
+
+        // Show rendered buffer in screen
+        glfwPollEvents();
+        glfwSwapBuffers(window);
+
+        learnopengl::showFPS(window);
+    }
+
+    for(const auto* name: {"scene", learnopengl::PostProcess::ExposureScope, learnopengl::PostProcess::ToneMappingScope})
+    {
+        const auto gpu = profiler.scopeStatistics(name, learnopengl::FrameProfiler::Metric::Gpu);
+        std::cout << name << ": gpu p50 " << gpu.p50 << " p99 " << gpu.p99 << " ms" << std::endl;
+    }
+
+    glfwTerminate();
+
+    return 0;
+}
@@ -0,0 +1,28 @@
+#version 330 core
+out vec4 FragColor;
+
+in vec3 FragPos;
+in vec3 Normal;
+in vec2 TexCoord;
+
+uniform sampler2D diffuseTexture;
+// Colors far above 1, kept by the RGBA16F scene target
+uniform vec3 lightPositions[4];
+uniform vec3 lightColors[4];
+
+void main()
+{
+    vec3 color = texture(diffuseTexture, TexCoord).rgb;
+    vec3 normal = normalize(Normal);
+
+    vec3 lighting = vec3(0.0);
+    for(int i = 0; i < 4; ++i)
+    {
+        vec3 lightDir = normalize(lightPositions[i] - FragPos);
+        float lightDistance = length(FragPos - lightPositions[i]);
+        float diff = max(dot(lightDir, normal), 0.0);
+        // Quadratic attenuation, as with gamma correction
+        lighting += lightColors[i] * diff * color / (lightDistance * lightDistance);
+    }
+    FragColor = vec4(lighting, 1.0);
+}
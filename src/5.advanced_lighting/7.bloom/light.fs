@@ -0,0 +1,12 @@
+#version 330 core
+out vec4 FragColor;
+
+flat in int lightIndex;
+
+uniform vec3 lightColors[4];
+
+void main()
+{
+    // Emissive, well above 1: these are what blooms
+    FragColor = vec4(lightColors[lightIndex], 1.0);
+}
@@ -0,0 +1,15 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+// Per instance, see InstancedMesh
+layout (location = 3) in mat4 aModel;
+
+flat out int lightIndex;
+
+uniform mat4 view;
+uniform mat4 projection;
+
+void main()
+{
+    lightIndex = gl_InstanceID;
+    gl_Position = projection * view * aModel * vec4(aPos, 1.0);
+}
@@ -0,0 +1,207 @@
+// https://learnopengl.com/Advanced-Lighting/Bloom
+// Boxes lit by 4 emissive light cubes, bloomed by learnopengl::PostProcess. The chapter blurs the bright parts at full resolution
+// with 10 gaussian passes; the mip chain downsamples and upsamples them from half resolution, wider for a fraction of the cost.
+// LEARNOPENGL_BLOOM=mip|gaussian|off (mip), LEARNOPENGL_BLOOM_THRESHOLD=<luminance> (0). Prints GPU times per stage at exit.
+
+#include <learnopengl/window.hpp>
+#include <learnopengl/shader.hpp>
+#include <learnopengl/camera.hpp>
+#include <learnopengl/cameracontroller.hpp>
+#include <learnopengl/fpscounter.hpp>
+#include <learnopengl/frameprofiler.hpp>
+#include <learnopengl/postprocess.hpp>
+#include <learnopengl/texture.hpp>
+#include <learnopengl/mesh.hpp>
+#include <learnopengl/instancedmesh.hpp>
+#include <learnopengl/primitives.hpp>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+learnopengl::Camera camera;
+learnopengl::CameraController cameraController(&camera);
+
+void processInput(GLFWwindow* window)
+{
+    if(glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+    {
+        glfwSetWindowShouldClose(window, true);
+    }
+
+    cameraController.processInput(window);
+}
+
+void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods)
+{
+    cameraController.mouseButtonCallback(window, button, action, mods);
+}
+
+void mouseMoveCallback(GLFWwindow* window, double xpos, double ypos) { cameraController.mouseMoveCallback(window, float(xpos), float(ypos)); }
+
+void scrollCallback(GLFWwindow* window, double xoffset, double yoffset) { cameraController.scrollCallback(float(yoffset)); }
+
+int main(int argc, char** argv)
+{
+    auto* window = learnopengl::createWindow();
+    if(!window)
+        return -1;
+
+    glfwSetCursorPosCallback(window, mouseMoveCallback);
+    glfwSetMouseButtonCallback(window, mouseButtonCallback);
+    glfwSetScrollCallback(window, scrollCallback);
+
+    learnopengl::PostProcess::Settings postProcessSettings;
+    if(const char* value = std::getenv("LEARNOPENGL_BLOOM"))
+    {
+        const std::string bloom = value;
+        if(bloom == "gaussian")
+            postProcessSettings.bloom = learnopengl::PostProcess::Bloom::Gaussian;
+        else if(bloom == "off")
+            postProcessSettings.bloom = learnopengl::PostProcess::Bloom::Off;
+    }
+    if(const char* value = std::getenv("LEARNOPENGL_BLOOM_THRESHOLD"))
+        postProcessSettings.bloomThreshold = float(std::atof(value));
+    // The gaussian blur is narrow, it needs more of it to show
+    if(postProcessSettings.bloom == learnopengl::PostProcess::Bloom::Gaussian)
+        postProcessSettings.bloomStrength = 0.2f;
+
+    // SHADER PROGRAM
+    auto shaderProgram = learnopengl::Shader("shader.vs", "shader.fs");
+    auto lightShaderProgram = learnopengl::Shader("light.vs", "light.fs");
+    auto floorTexture = learnopengl::Texture("/resources/textures/container.jpg");
+    auto boxTexture = learnopengl::Texture("/resources/textures/container2.png");
+
+    // VERTEX DATA
+
+    // Unit cube (position, normal, texture coords), shared by floor, boxes and light cubes
+    const auto cube = learnopengl::createCube();
+    const learnopengl::Mesh cubeMesh(cube.vertices, cube.indices, {});
+
+    learnopengl::InstancedMesh floor(cubeMesh);
+    floor.add(glm::scale(glm::translate(glm::mat4(1.f), glm::vec3(0.f, -1.f, 0.f)), glm::vec3(25.f, 1.f, 25.f)));
+    floor.upload();
+
+    // Boxes of the chapter
+    learnopengl::InstancedMesh boxes(cubeMesh);
+    boxes.add(glm::translate(glm::mat4(1.f), glm::vec3(0.f, 1.5f, 0.f)));
+    boxes.add(glm::translate(glm::mat4(1.f), glm::vec3(2.f, 0.f, 1.f)));
+    boxes.add(glm::scale(glm::translate(glm::mat4(1.f), glm::vec3(-1.f, -1.f, 2.f)), glm::vec3(2.f)));
+    boxes.add(glm::scale(glm::rotate(glm::translate(glm::mat4(1.f), glm::vec3(0.f, 2.7f, 4.f)), glm::radians(23.f),
+                             glm::normalize(glm::vec3(1.f, 0.f, 1.f))),
+        glm::vec3(2.5f)));
+    boxes.add(glm::scale(glm::rotate(glm::translate(glm::mat4(1.f), glm::vec3(-2.f, 1.f, -3.f)), glm::radians(124.f),
+                             glm::normalize(glm::vec3(1.f, 0.f, 1.f))),
+        glm::vec3(2.f)));
+    boxes.add(glm::translate(glm::mat4(1.f), glm::vec3(-3.f, 0.f, 0.f)));
+    boxes.upload();
+
+    const glm::vec3 lightPositions[] = {
+        glm::vec3(0.f, 0.5f, 1.5f), glm::vec3(-4.f, 0.5f, -3.f), glm::vec3(3.f, 0.5f, 1.f), glm::vec3(-0.8f, 2.4f, -1.f)};
+    const glm::vec3 lightColors[] = {
+        glm::vec3(5.f, 5.f, 5.f), glm::vec3(10.f, 0.f, 0.f), glm::vec3(0.f, 0.f, 15.f), glm::vec3(0.f, 5.f, 0.f)};
+
+    // Light cube instances in the order of the lights, the shader colors them by instance
+    learnopengl::InstancedMesh lightCubes(cubeMesh);
+    for(const auto& position: lightPositions) lightCubes.add(glm::scale(glm::translate(glm::mat4(1.f), position), glm::vec3(0.25f)));
+    lightCubes.upload();
+
+    // Enable fragment depth testing
+    glEnable(GL_DEPTH_TEST);
+
+    camera.setFovDegrees(60.f);
+    camera.setCameraPos(glm::vec3(0.f, 2.f, 9.f));
+    camera.setCameraFront(glm::normalize(glm::vec3(0.f, -0.2f, -1.f)));
+
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    learnopengl::PostProcess postProcess(viewport[2], viewport[3], postProcessSettings);
+
+    auto& profiler = learnopengl::frameProfiler(window);
+
+    double lastTime = glfwGetTime();
+
+    // Main window render loop
+    while(!glfwWindowShouldClose(window))
+    {
+        // Process input
+        processInput(window);
+
+        const double currentTime = glfwGetTime();
+        const auto deltaTime = float(currentTime - lastTime);
+        lastTime = currentTime;
+
+        const auto& view = camera.viewMatrix();
+
+        // Project from View Space (3D) to Clip Space (2D)
+        int width, height;
+        learnopengl::getWindowSize(window, &width, &height);
+        camera.setAspect(height ? float(width) / float(height) : 1.f);
+        const auto& projection = camera.projectionMatrix();
+
+        // Scene target in pixels of the render target
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        postProcess.resize(viewport[2], viewport[3]);
+
+        {
+            learnopengl::FrameProfiler::ScopeGuard scope(profiler, "scene");
+            postProcess.beginScene();
+
+            shaderProgram.use();
+            shaderProgram.setMat4("projection", glm::value_ptr(projection));
+            shaderProgram.setMat4("view", glm::value_ptr(view));
+            const auto& cameraPos = camera.cameraPos();
+            shaderProgram.setVec3("cameraPos", cameraPos.x, cameraPos.y, cameraPos.z);
+            shaderProgram.setInt("diffuseTexture", 0);
+            for(int i = 0; i < 4; ++i)
+            {
+                const auto index = "[" + std::to_string(i) + "]";
+                shaderProgram.setVec3("lightPositions" + index, lightPositions[i].x, lightPositions[i].y, lightPositions[i].z);
+                shaderProgram.setVec3("lightColors" + index, lightColors[i].x, lightColors[i].y, lightColors[i].z);
+            }
+            floorTexture.use(0);
+            floor.draw(shaderProgram);
+            boxTexture.use(0);
+            boxes.draw(shaderProgram);
+
+            lightShaderProgram.use();
+            lightShaderProgram.setMat4("projection", glm::value_ptr(projection));
+            lightShaderProgram.setMat4("view", glm::value_ptr(view));
+            for(int i = 0; i < 4; ++i)
+            {
+                const auto& color = lightColors[i];
+                lightShaderProgram.setVec3("lightColors[" + std::to_string(i) + "]", color.x, color.y, color.z);
+            }
+            lightCubes.draw(lightShaderProgram);
+        }
+
+        postProcess.apply(learnopengl::defaultFramebuffer(), deltaTime, &profiler);
+
+        // Show rendered buffer in screen
+        glfwPollEvents();
+        glfwSwapBuffers(window);
+
+        learnopengl::showFPS(window);
+    }
+
+    std::cout << "bloom targets " << postProcess.bloomBytes() / 1024 << " KiB" << std::endl;
+    for(const auto* name: {"scene",
+            learnopengl::PostProcess::BloomScope,
+            learnopengl::PostProcess::ExposureScope,
+            learnopengl::PostProcess::ToneMappingScope})
+    {
+        const auto gpu = profiler.scopeStatistics(name, learnopengl::FrameProfiler::Metric::Gpu);
+        std::cout << name << ": gpu p50 " << gpu.p50 << " p99 " << gpu.p99 << " ms" << std::endl;
+    }
+
+    glfwTerminate();
+
+    return 0;
+}
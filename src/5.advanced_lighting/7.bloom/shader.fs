@@ -0,0 +1,30 @@
+#version 330 core
+out vec4 FragColor;
+
+in vec3 FragPos;
+in vec3 Normal;
+in vec2 TexCoord;
+
+uniform sampler2D diffuseTexture;
+uniform vec3 lightPositions[4];
+uniform vec3 lightColors[4];
+uniform vec3 cameraPos;
+
+void main()
+{
+    vec3 color = texture(diffuseTexture, TexCoord).rgb;
+    vec3 normal = normalize(Normal);
+    vec3 viewDir = normalize(cameraPos - FragPos);
+
+    vec3 lighting = 0.02 * color;
+    for(int i = 0; i < 4; ++i)
+    {
+        vec3 lightDir = normalize(lightPositions[i] - FragPos);
+        float lightDistance = length(FragPos - lightPositions[i]);
+        float diff = max(dot(lightDir, normal), 0.0);
+        vec3 halfwayDir = normalize(lightDir + viewDir);
+        float spec = pow(max(dot(normal, halfwayDir), 0.0), 32.0);
+        lighting += lightColors[i] * (diff * color + spec * 0.3) / (lightDistance * lightDistance);
+    }
+    FragColor = vec4(lighting, 1.0);
+}
@@ -0,0 +1,24 @@
+#version 330 core
+// Geometry pass: material and normal of the visible surface, lighting comes later from the geometry buffer
+layout (location = 0) out vec4 gAlbedoSpecular;
+layout (location = 1) out vec4 gNormal;
+
+in vec3 Normal;
+in vec2 TexCoord;
+
+#include "/resources/shaders/gbuffer.glsl"
+
+struct Material
+{
+    sampler2D diffuse;
+    sampler2D specular;
+    float shininess;
+};
+
+uniform Material material;
+
+void main()
+{
+    gAlbedoSpecular = vec4(texture(material.diffuse, TexCoord).rgb, texture(material.specular, TexCoord).r);
+    gNormal = encodeNormal(Normal);
+}
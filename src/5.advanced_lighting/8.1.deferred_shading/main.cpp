@@ -0,0 +1,213 @@
+// https://learnopengl.com/Advanced-Lighting/Deferred-Shading
+// 32 point lights over a grid of boxes: geometry pass into a GBuffer, then one full screen pass evaluating every light per pixel.
+
+#include <learnopengl/window.hpp>
+#include <learnopengl/shader.hpp>
+#include <learnopengl/camera.hpp>
+#include <learnopengl/cameracontroller.hpp>
+#include <learnopengl/fpscounter.hpp>
+#include <learnopengl/frameprofiler.hpp>
+#include <learnopengl/benchmark.hpp>
+#include <learnopengl/diffusespecularmaterial.hpp>
+#include <learnopengl/directionlight.hpp>
+#include <learnopengl/pointlight.hpp>
+#include <learnopengl/gbuffer.hpp>
+#include <learnopengl/deferredlighting.hpp>
+#include <learnopengl/texture.hpp>
+#include <learnopengl/mesh.hpp>
+#include <learnopengl/instancedmesh.hpp>
+#include <learnopengl/primitives.hpp>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+learnopengl::Camera camera;
+learnopengl::CameraController cameraController(&camera);
+
+void processInput(GLFWwindow* window)
+{
+    if(glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+    {
+        glfwSetWindowShouldClose(window, true);
+    }
+
+    cameraController.processInput(window);
+}
+
+void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods)
+{
+    cameraController.mouseButtonCallback(window, button, action, mods);
+}
+
+void mouseMoveCallback(GLFWwindow* window, double xpos, double ypos) { cameraController.mouseMoveCallback(window, float(xpos), float(ypos)); }
+
+void scrollCallback(GLFWwindow* window, double xoffset, double yoffset) { cameraController.scrollCallback(float(yoffset)); }
+
+int main(int argc, char** argv)
+{
+    auto* window = learnopengl::createWindow();
+    if(!window)
+        return -1;
+
+    glfwSetCursorPosCallback(window, mouseMoveCallback);
+    glfwSetMouseButtonCallback(window, mouseButtonCallback);
+    glfwSetScrollCallback(window, scrollCallback);
+
+    // SHADER PROGRAM
+    auto geometryShaderProgram = learnopengl::Shader("gbuffer.vs", "gbuffer.fs");
+    auto lightShaderProgram = learnopengl::Shader("light.vs", "light.fs");
+    auto diffuseTexture = learnopengl::Texture("/resources/textures/container2.png");
+    auto specularTexture = learnopengl::Texture("/resources/textures/container2_specular.png");
+
+    // VERTEX DATA
+
+    // Unit cube (position, normal, texture coords), shared by boxes, floor and light cubes
+    const auto cube = learnopengl::createCube();
+    const learnopengl::Mesh cubeMesh(cube.vertices, cube.indices, {});
+
+    // 3x3 boxes, as the backpacks of the chapter, on a floor
+    learnopengl::InstancedMesh boxes(cubeMesh);
+    for(int x = -1; x <= 1; ++x)
+    {
+        for(int z = -1; z <= 1; ++z)
+        {
+            glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(3.f * float(x), -0.5f, 3.f * float(z)));
+            model = glm::rotate(model, glm::radians(-45.f * float(x + z)), glm::vec3(0.f, 1.f, 0.f));
+            boxes.add(model);
+        }
+    }
+    boxes.add(glm::scale(glm::translate(glm::mat4(1.f), glm::vec3(0.f, -1.5f, 0.f)), glm::vec3(12.f, 1.f, 12.f)));
+    boxes.upload();
+
+    // Random lights of the chapter, attenuation 1 + 0.7 d + 1.8 d²
+    constexpr std::size_t lightCount = 32;
+    std::mt19937 random(learnopengl::Benchmark::seed());
+    std::uniform_real_distribution<float> unit(0.f, 1.f);
+    std::vector<learnopengl::PointLight> pointLights(lightCount);
+    for(auto& pointLight: pointLights)
+    {
+        pointLight.setPosition(glm::vec3(unit(random) * 6.f - 3.f, unit(random) * 6.f - 4.f, unit(random) * 6.f - 3.f));
+        pointLight.setAmbient(glm::vec3(0.f));
+        pointLight.setDiffuse(glm::vec3(0.5f) + 0.5f * glm::vec3(unit(random), unit(random), unit(random)));
+        pointLight.setAttenuation(1.f, 0.7f, 1.8f);
+    }
+
+    // Light cubes are placed by the shader from the light data, instances only scale the cube
+    learnopengl::InstancedMesh lightCubes(cubeMesh);
+    lightCubes.reserve(lightCount);
+    for(std::size_t i = 0; i < lightCount; ++i) lightCubes.add(glm::scale(glm::mat4(1.f), glm::vec3(0.125f)));
+    lightCubes.upload();
+
+    // Enable fragment depth testing
+    glEnable(GL_DEPTH_TEST);
+
+    camera.setFovDegrees(70.f);
+    camera.setCameraPos(glm::vec3(0.f, 3.f, 8.f));
+    camera.setCameraFront(glm::normalize(glm::vec3(0.f, -0.4f, -1.f)));
+
+    learnopengl::DirectionLight directionLight;
+    directionLight.setAmbient(glm::vec3(0.01f));
+    directionLight.setDiffuse(glm::vec3(0.07f, 0.04f, 0.03f));
+    directionLight.setSpecular(glm::vec3(0.f));
+    directionLight.setDirection(glm::vec3(-0.2f, -1.0f, -0.3f));
+
+    learnopengl::DiffuseSpecularMaterial diffuseSpecularMaterial;
+
+    // Lights are static, culled against the camera each frame
+    learnopengl::DeferredLighting::Settings lightingSettings;
+    lightingSettings.mode = learnopengl::DeferredLighting::Mode::FullScreen;
+    learnopengl::DeferredLighting deferredLighting(lightingSettings);
+    deferredLighting.setDirectionLight(directionLight);
+    for(const auto& pointLight: pointLights) deferredLighting.add(pointLight);
+
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    learnopengl::GBuffer gbuffer(viewport[2], viewport[3]);
+
+    auto& profiler = learnopengl::frameProfiler(window);
+
+    // Main window render loop
+    while(!glfwWindowShouldClose(window))
+    {
+        // Process input
+        processInput(window);
+
+        const auto& view = camera.viewMatrix();
+
+        // Project from View Space (3D) to Clip Space (2D)
+        int width, height;
+        learnopengl::getWindowSize(window, &width, &height);
+        camera.setAspect(height ? float(width) / float(height) : 1.f);
+        const auto& projection = camera.projectionMatrix();
+
+        // Geometry buffer in pixels of the render target
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        gbuffer.resize(viewport[2], viewport[3]);
+
+        deferredLighting.update(camera);
+
+        // Geometry pass
+        {
+            learnopengl::FrameProfiler::ScopeGuard scope(profiler, "geometry");
+            gbuffer.beginGeometryPass();
+
+            geometryShaderProgram.use();
+            geometryShaderProgram.setMat4("projection", glm::value_ptr(projection));
+            geometryShaderProgram.setMat4("view", glm::value_ptr(view));
+            gbuffer.setEncoding(geometryShaderProgram);
+
+            diffuseTexture.use(0);
+            specularTexture.use(1);
+            diffuseSpecularMaterial.setDiffuseTextureUnit(0);
+            diffuseSpecularMaterial.setSpecularTextureUnit(1);
+            geometryShaderProgram.setDiffuseSpecularMaterial("material", diffuseSpecularMaterial);
+
+            boxes.draw(geometryShaderProgram);
+        }
+
+        // Lighting pass
+        {
+            learnopengl::FrameProfiler::ScopeGuard scope(profiler, "lighting");
+            gbuffer.beginLightingPass();
+            deferredLighting.draw(gbuffer, camera);
+        }
+
+        // Light cubes forward shaded in the light target, depth tested against the geometry buffer
+        lightShaderProgram.use();
+        lightShaderProgram.setMat4("view", glm::value_ptr(view));
+        lightShaderProgram.setMat4("projection", glm::value_ptr(projection));
+        deferredLighting.bindLightData(lightShaderProgram, 0);
+        lightShaderProgram.setInt("lightCount", int(deferredLighting.visibleLightCount()));
+        lightCubes.draw(lightShaderProgram);
+
+        gbuffer.blitLighting(learnopengl::defaultFramebuffer(), viewport[2], viewport[3]);
+
+        // Show rendered buffer in screen
+        glfwPollEvents();
+        glfwSwapBuffers(window);
+
+        learnopengl::showFPS(window);
+    }
+
+    for(const auto* name: {"geometry", "lighting"})
+    {
+        const auto cpu = profiler.scopeStatistics(name, learnopengl::FrameProfiler::Metric::Cpu);
+        const auto gpu = profiler.scopeStatistics(name, learnopengl::FrameProfiler::Metric::Gpu);
+        std::cout << name << ": cpu p50 " << cpu.p50 << " p99 " << cpu.p99 << " ms, gpu p50 " << gpu.p50 << " p99 " << gpu.p99 << " ms"
+                  << std::endl;
+    }
+
+    glfwTerminate();
+
+    return 0;
+}
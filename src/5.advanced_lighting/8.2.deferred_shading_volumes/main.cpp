@@ -0,0 +1,304 @@
+// https://learnopengl.com/Advanced-Lighting/Deferred-Shading with thousands of moving point lights, each drawn as an instanced
+// light volume sphere tested against the scene with the stencil buffer.
+// LEARNOPENGL_LIGHT_COUNT=<count> sets the number of point lights (1024),
+// LEARNOPENGL_DEFERRED_MODE=fullscreen|volumes|stencil|tiled the lighting passes (stencil, see DeferredLighting::Mode),
+// LEARNOPENGL_RESOLUTION=<width>x<height> the window and geometry buffer size (800x600).
+
+#include <learnopengl/window.hpp>
+#include <learnopengl/shader.hpp>
+#include <learnopengl/camera.hpp>
+#include <learnopengl/cameracontroller.hpp>
+#include <learnopengl/fpscounter.hpp>
+#include <learnopengl/frameprofiler.hpp>
+#include <learnopengl/benchmark.hpp>
+#include <learnopengl/diffusespecularmaterial.hpp>
+#include <learnopengl/directionlight.hpp>
+#include <learnopengl/pointlight.hpp>
+#include <learnopengl/spotlight.hpp>
+#include <learnopengl/lightrange.hpp>
+#include <learnopengl/gbuffer.hpp>
+#include <learnopengl/deferredlighting.hpp>
+#include <learnopengl/texture.hpp>
+#include <learnopengl/mesh.hpp>
+#include <learnopengl/instancedmesh.hpp>
+#include <learnopengl/primitives.hpp>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+learnopengl::Camera camera;
+learnopengl::CameraController cameraController(&camera);
+
+void processInput(GLFWwindow* window)
+{
+    if(glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+    {
+        glfwSetWindowShouldClose(window, true);
+    }
+
+    cameraController.processInput(window);
+}
+
+void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods)
+{
+    cameraController.mouseButtonCallback(window, button, action, mods);
+}
+
+void mouseMoveCallback(GLFWwindow* window, double xpos, double ypos) { cameraController.mouseMoveCallback(window, float(xpos), float(ypos)); }
+
+void scrollCallback(GLFWwindow* window, double xoffset, double yoffset) { cameraController.scrollCallback(float(yoffset)); }
+
+struct MovingLight
+{
+    glm::vec3 center;
+    float phase = 0.f;
+    float speed = 1.f;
+};
+
+learnopengl::DeferredLighting::Mode modeFromEnvironment()
+{
+    using Mode = learnopengl::DeferredLighting::Mode;
+    const char* value = std::getenv("LEARNOPENGL_DEFERRED_MODE");
+    if(value && std::strcmp(value, "fullscreen") == 0)
+        return Mode::FullScreen;
+    if(value && std::strcmp(value, "volumes") == 0)
+        return Mode::Volumes;
+    if(value && std::strcmp(value, "tiled") == 0)
+        return Mode::Tiled;
+    return Mode::StencilVolumes;
+}
+
+int main(int argc, char** argv)
+{
+    int windowWidth = 800;
+    int windowHeight = 600;
+    if(const char* value = std::getenv("LEARNOPENGL_RESOLUTION"))
+    {
+        int width = 0;
+        int height = 0;
+        if(std::sscanf(value, "%dx%d", &width, &height) == 2 && width > 0 && height > 0)
+        {
+            windowWidth = width;
+            windowHeight = height;
+        }
+    }
+
+    auto* window = learnopengl::createWindow(windowWidth, windowHeight);
+    if(!window)
+        return -1;
+
+    glfwSetCursorPosCallback(window, mouseMoveCallback);
+    glfwSetMouseButtonCallback(window, mouseButtonCallback);
+    glfwSetScrollCallback(window, scrollCallback);
+
+    std::size_t lightCount = 1024;
+    if(const char* value = std::getenv("LEARNOPENGL_LIGHT_COUNT"))
+        lightCount = std::size_t(std::max(std::atol(value), 1l));
+
+    // SHADER PROGRAM
+    auto geometryShaderProgram = learnopengl::Shader("gbuffer.vs", "gbuffer.fs");
+    auto lightShaderProgram = learnopengl::Shader("light.vs", "light.fs");
+    auto diffuseTexture = learnopengl::Texture("/resources/textures/container2.png");
+    auto specularTexture = learnopengl::Texture("/resources/textures/container2_specular.png");
+
+    // VERTEX DATA
+
+    // Unit cube (position, normal, texture coords), shared by boxes, floor and light cubes
+    const auto cube = learnopengl::createCube();
+    const learnopengl::Mesh cubeMesh(cube.vertices, cube.indices, {});
+
+    // Grid of rotated boxes on a floor
+    learnopengl::InstancedMesh boxes(cubeMesh);
+    {
+        std::mt19937 random(learnopengl::Benchmark::seed());
+        std::uniform_real_distribution<float> angle(0.f, 2.f * glm::pi<float>());
+        for(int x = -5; x <= 5; ++x)
+        {
+            for(int z = -10; z <= 0; ++z)
+            {
+                glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(2.5f * float(x), -2.f, 2.5f * float(z)));
+                model = glm::rotate(model, angle(random), glm::normalize(glm::vec3(0.1f, 1.f, 0.2f)));
+                boxes.add(model);
+            }
+        }
+        boxes.add(glm::scale(glm::translate(glm::mat4(1.f), glm::vec3(0.f, -3.f, -12.5f)), glm::vec3(40.f, 1.f, 40.f)));
+        boxes.upload();
+    }
+
+    // Lights move in small circles around random points above the floor
+    const glm::vec3 sceneMin(-15.f, -2.5f, -27.f);
+    const glm::vec3 sceneMax(15.f, 1.f, 2.f);
+    std::mt19937 random(learnopengl::Benchmark::seed());
+    std::uniform_real_distribution<float> unit(0.f, 1.f);
+
+    std::vector<MovingLight> movingLights(lightCount);
+    std::vector<learnopengl::PointLight> pointLights(lightCount);
+
+    // About 16 lights reach each point of the scene whatever the light count: range shrinks as the count grows
+    const auto sceneSize = sceneMax - sceneMin;
+    const float range = std::cbrt(16.f * sceneSize.x * sceneSize.y * sceneSize.z / (float(lightCount) * 4.f / 3.f * glm::pi<float>()));
+    for(std::size_t i = 0; i < lightCount; ++i)
+    {
+        movingLights[i].center = sceneMin + sceneSize * glm::vec3(unit(random), unit(random), unit(random));
+        movingLights[i].phase = unit(random) * 2.f * glm::pi<float>();
+        movingLights[i].speed = 0.5f + unit(random);
+
+        // Saturated color of full intensity, quadratic attenuation reaching the light threshold at range
+        const auto hue = glm::vec3(unit(random), unit(random), unit(random));
+        auto& pointLight = pointLights[i];
+        pointLight.setAmbient(glm::vec3(0.f));
+        pointLight.setDiffuse(hue / std::max({hue.r, hue.g, hue.b, 1e-3f}));
+        pointLight.setAttenuation(1.f, 0.f, (1.f / learnopengl::LightRangeThreshold - 1.f) / (range * range));
+    }
+
+    // Light cubes are placed by the shader from the light data, instances only scale the cube
+    learnopengl::InstancedMesh lightCubes(cubeMesh);
+    lightCubes.reserve(lightCount);
+    for(std::size_t i = 0; i < lightCount; ++i) lightCubes.add(glm::scale(glm::mat4(1.f), glm::vec3(0.05f)));
+    lightCubes.upload();
+
+    // Enable fragment depth testing
+    glEnable(GL_DEPTH_TEST);
+
+    camera.setFovDegrees(70.f);
+    camera.setCameraPos(glm::vec3(0.f, 2.f, 6.f));
+    camera.setCameraFront(glm::normalize(glm::vec3(0.f, -0.3f, -1.f)));
+
+    learnopengl::DirectionLight directionLight;
+    directionLight.setAmbient(glm::vec3(0.01f));
+    directionLight.setDiffuse(glm::vec3(0.07f, 0.04f, 0.03f));
+    directionLight.setSpecular(glm::vec3(0.f));
+    directionLight.setDirection(glm::vec3(-0.2f, -1.0f, -0.3f));
+
+    learnopengl::SpotLight spotLight;
+    spotLight.setAmbient(glm::vec3(0.f));
+    spotLight.setDiffuse(glm::vec3(0.4f));
+    spotLight.setCutOff(glm::cos(glm::radians(12.5f)));
+    spotLight.setOuterCutOff(glm::cos(glm::radians(17.5f)));
+    spotLight.setAttenuation(1.f, 0.09f, 0.032f);
+
+    learnopengl::DiffuseSpecularMaterial diffuseSpecularMaterial;
+
+    learnopengl::DeferredLighting::Settings lightingSettings;
+    lightingSettings.mode = modeFromEnvironment();
+    learnopengl::DeferredLighting deferredLighting(lightingSettings);
+    deferredLighting.setDirectionLight(directionLight);
+
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    learnopengl::GBuffer gbuffer(viewport[2], viewport[3]);
+
+    auto& profiler = learnopengl::frameProfiler(window);
+    std::size_t culledLights = 0;
+    std::size_t frames = 0;
+
+    // Main window render loop
+    while(!glfwWindowShouldClose(window))
+    {
+        // Process input
+        processInput(window);
+
+        const auto& view = camera.viewMatrix();
+
+        // Project from View Space (3D) to Clip Space (2D)
+        int width, height;
+        learnopengl::getWindowSize(window, &width, &height);
+        camera.setAspect(height ? float(width) / float(height) : 1.f);
+        const auto& projection = camera.projectionMatrix();
+
+        // Geometry buffer in pixels of the render target
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        gbuffer.resize(viewport[2], viewport[3]);
+
+        // Move lights, cull them and upload
+        const auto time = float(glfwGetTime());
+        deferredLighting.clear();
+        for(std::size_t i = 0; i < lightCount; ++i)
+        {
+            const auto& movingLight = movingLights[i];
+            const float angle = movingLight.phase + time * movingLight.speed;
+            pointLights[i].setPosition(movingLight.center + glm::vec3(std::cos(angle), 0.5f * std::sin(2.f * angle), std::sin(angle)));
+            deferredLighting.add(pointLights[i]);
+        }
+
+        spotLight.setPosition(camera.cameraPos());
+        spotLight.setDirection(camera.cameraFront());
+        deferredLighting.add(spotLight);
+        deferredLighting.update(camera);
+        culledLights += deferredLighting.stats().culledLightCount;
+        ++frames;
+
+        // Geometry pass
+        {
+            learnopengl::FrameProfiler::ScopeGuard scope(profiler, "geometry");
+            gbuffer.beginGeometryPass();
+
+            geometryShaderProgram.use();
+            geometryShaderProgram.setMat4("projection", glm::value_ptr(projection));
+            geometryShaderProgram.setMat4("view", glm::value_ptr(view));
+            gbuffer.setEncoding(geometryShaderProgram);
+
+            diffuseTexture.use(0);
+            specularTexture.use(1);
+            diffuseSpecularMaterial.setDiffuseTextureUnit(0);
+            diffuseSpecularMaterial.setSpecularTextureUnit(1);
+            geometryShaderProgram.setDiffuseSpecularMaterial("material", diffuseSpecularMaterial);
+
+            boxes.draw(geometryShaderProgram);
+        }
+
+        // Lighting passes
+        {
+            learnopengl::FrameProfiler::ScopeGuard scope(profiler, "lighting");
+            gbuffer.beginLightingPass();
+            deferredLighting.draw(gbuffer, camera);
+        }
+
+        // Light cubes forward shaded in the light target, depth tested against the geometry buffer
+        lightShaderProgram.use();
+        lightShaderProgram.setMat4("view", glm::value_ptr(view));
+        lightShaderProgram.setMat4("projection", glm::value_ptr(projection));
+        deferredLighting.bindLightData(lightShaderProgram, 0);
+        lightShaderProgram.setInt("lightCount", int(deferredLighting.visibleLightCount()));
+        lightCubes.draw(lightShaderProgram);
+
+        gbuffer.blitLighting(learnopengl::defaultFramebuffer(), viewport[2], viewport[3]);
+
+        // Show rendered buffer in screen
+        glfwPollEvents();
+        glfwSwapBuffers(window);
+
+        learnopengl::showFPS(window);
+    }
+
+    if(frames)
+    {
+        std::cout << "Deferred shading: " << lightCount << " point lights of range " << range << ", " << culledLights / frames
+                  << " lights culled per frame, geometry buffer " << gbuffer.width() << "x" << gbuffer.height() << " of "
+                  << gbuffer.geometryBytesPerPixel() << " bytes per pixel" << std::endl;
+    }
+    for(const auto* name: {"geometry", "lighting"})
+    {
+        const auto cpu = profiler.scopeStatistics(name, learnopengl::FrameProfiler::Metric::Cpu);
+        const auto gpu = profiler.scopeStatistics(name, learnopengl::FrameProfiler::Metric::Gpu);
+        std::cout << name << ": cpu p50 " << cpu.p50 << " p99 " << cpu.p99 << " ms, gpu p50 " << gpu.p50 << " p99 " << gpu.p99 << " ms"
+                  << std::endl;
+    }
+
+    glfwTerminate();
+
+    return 0;
+}
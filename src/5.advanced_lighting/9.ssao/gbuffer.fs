@@ -0,0 +1,17 @@
+#version 330 core
+// Geometry pass: albedo and normal of the visible surface, ambient occlusion and lighting come from the geometry buffer
+layout (location = 0) out vec4 gAlbedoSpecular;
+layout (location = 1) out vec4 gNormal;
+
+in vec3 Normal;
+in vec2 TexCoord;
+
+#include "/resources/shaders/gbuffer.glsl"
+
+uniform sampler2D diffuseTexture;
+
+void main()
+{
+    gAlbedoSpecular = vec4(texture(diffuseTexture, TexCoord).rgb, 0.2);
+    gNormal = encodeNormal(Normal);
+}
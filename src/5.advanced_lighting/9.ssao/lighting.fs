@@ -0,0 +1,33 @@
+#version 330 core
+out vec4 FragColor;
+
+#include "/resources/shaders/gbuffer.glsl"
+#include "/resources/shaders/directionlight.glsl"
+#include "/resources/shaders/ambientocclusion.glsl"
+
+// Without ambient, which is occluded here
+uniform DirectionLight directionLight;
+uniform vec3 ambient;
+uniform vec3 cameraPos;
+// Show the ambient visibility only
+uniform bool occlusionOnly;
+
+void main()
+{
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    float visibility = ambientVisibility(pixel);
+    if(occlusionOnly)
+    {
+        FragColor = vec4(vec3(visibility), 1.0);
+        return;
+    }
+
+    float depth = texelFetch(gbufferDepth, pixel, 0).r;
+    vec4 albedoSpecular = texelFetch(gbufferAlbedoSpecular, pixel, 0);
+    vec3 normal = decodeNormal(texelFetch(gbufferNormal, pixel, 0));
+    vec3 fragPos = gbufferPosition(pixel, depth);
+
+    vec3 result = ambient * albedoSpecular.rgb * visibility;
+    result += computeDirectionLight(directionLight, albedoSpecular.rgb, vec3(albedoSpecular.a), 32.0, normal, fragPos, cameraPos);
+    FragColor = vec4(result, 1.0);
+}
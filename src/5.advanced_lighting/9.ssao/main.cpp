@@ -0,0 +1,253 @@
+// https://learnopengl.com/Advanced-Lighting/SSAO
+// Boxes and spheres in a room, shaded from a geometry buffer whose ambient light is occluded by learnopengl::AmbientOcclusion,
+// computed at half resolution by default with temporal accumulation and upsampled to full resolution along depth edges.
+// LEARNOPENGL_SSAO=off, LEARNOPENGL_SSAO_RESOLUTION=full|half|quarter (half), LEARNOPENGL_SSAO_TEMPORAL=0,
+// LEARNOPENGL_SSAO_SAMPLES=<samples> (16), LEARNOPENGL_SSAO_INPUT=gbuffer|depth (depth reconstructs normals as for a forward
+// depth prepass), LEARNOPENGL_SSAO_VIEW=1 shows the occlusion only. Prints GPU times per pass at exit.
+
+#include <learnopengl/window.hpp>
+#include <learnopengl/shader.hpp>
+#include <learnopengl/camera.hpp>
+#include <learnopengl/cameracontroller.hpp>
+#include <learnopengl/fpscounter.hpp>
+#include <learnopengl/frameprofiler.hpp>
+#include <learnopengl/directionlight.hpp>
+#include <learnopengl/gbuffer.hpp>
+#include <learnopengl/ambientocclusion.hpp>
+#include <learnopengl/texture.hpp>
+#include <learnopengl/mesh.hpp>
+#include <learnopengl/instancedmesh.hpp>
+#include <learnopengl/primitives.hpp>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+learnopengl::Camera camera;
+learnopengl::CameraController cameraController(&camera);
+
+void processInput(GLFWwindow* window)
+{
+    if(glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+    {
+        glfwSetWindowShouldClose(window, true);
+    }
+
+    cameraController.processInput(window);
+}
+
+void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods)
+{
+    cameraController.mouseButtonCallback(window, button, action, mods);
+}
+
+void mouseMoveCallback(GLFWwindow* window, double xpos, double ypos) { cameraController.mouseMoveCallback(window, float(xpos), float(ypos)); }
+
+void scrollCallback(GLFWwindow* window, double xoffset, double yoffset) { cameraController.scrollCallback(float(yoffset)); }
+
+int main(int argc, char** argv)
+{
+    auto* window = learnopengl::createWindow();
+    if(!window)
+        return -1;
+
+    glfwSetCursorPosCallback(window, mouseMoveCallback);
+    glfwSetMouseButtonCallback(window, mouseButtonCallback);
+    glfwSetScrollCallback(window, scrollCallback);
+
+    bool ambientOcclusionEnabled = true;
+    if(const char* value = std::getenv("LEARNOPENGL_SSAO"))
+        ambientOcclusionEnabled = std::string(value) != "off";
+    learnopengl::AmbientOcclusion::Settings occlusionSettings;
+    if(const char* value = std::getenv("LEARNOPENGL_SSAO_RESOLUTION"))
+    {
+        const std::string resolution = value;
+        if(resolution == "full")
+            occlusionSettings.resolution = learnopengl::AmbientOcclusion::Resolution::Full;
+        else if(resolution == "quarter")
+            occlusionSettings.resolution = learnopengl::AmbientOcclusion::Resolution::Quarter;
+    }
+    if(const char* value = std::getenv("LEARNOPENGL_SSAO_TEMPORAL"))
+        occlusionSettings.temporal = std::string(value) != "0";
+    if(const char* value = std::getenv("LEARNOPENGL_SSAO_SAMPLES"))
+        occlusionSettings.sampleCount = std::uint32_t(std::clamp(std::atoi(value), 1, int(learnopengl::AmbientOcclusion::MaxSampleCount)));
+    bool reconstructNormals = false;
+    if(const char* value = std::getenv("LEARNOPENGL_SSAO_INPUT"))
+        reconstructNormals = std::string(value) == "depth";
+    bool occlusionOnly = false;
+    if(const char* value = std::getenv("LEARNOPENGL_SSAO_VIEW"))
+        occlusionOnly = std::string(value) == "1";
+
+    // SHADER PROGRAM
+    auto geometryShaderProgram = learnopengl::Shader("gbuffer.vs", "gbuffer.fs");
+    auto lightingShaderProgram = learnopengl::Shader("resources/shaders/deferredfullscreen.vs", "lighting.fs");
+    auto wallTexture = learnopengl::Texture("/resources/textures/container.jpg");
+    auto objectTexture = learnopengl::Texture("/resources/textures/container2.png");
+
+    // VERTEX DATA
+
+    const auto cube = learnopengl::createCube();
+    const learnopengl::Mesh cubeMesh(cube.vertices, cube.indices, {});
+    const auto sphere = learnopengl::createSphere(48, 24);
+    const learnopengl::Mesh sphereMesh(sphere.vertices, sphere.indices, {});
+
+    // Floor and 3 walls: creases all around
+    learnopengl::InstancedMesh room(cubeMesh);
+    room.add(glm::scale(glm::translate(glm::mat4(1.f), glm::vec3(0.f, -0.5f, 0.f)), glm::vec3(16.f, 1.f, 16.f)));
+    room.add(glm::scale(glm::translate(glm::mat4(1.f), glm::vec3(0.f, 4.f, -8.5f)), glm::vec3(16.f, 10.f, 1.f)));
+    room.add(glm::scale(glm::translate(glm::mat4(1.f), glm::vec3(-8.5f, 4.f, 0.f)), glm::vec3(1.f, 10.f, 16.f)));
+    room.add(glm::scale(glm::translate(glm::mat4(1.f), glm::vec3(8.5f, 4.f, 0.f)), glm::vec3(1.f, 10.f, 16.f)));
+    room.upload();
+
+    // Stacked and leaning boxes against the back wall, spheres resting on the floor
+    learnopengl::InstancedMesh boxes(cubeMesh);
+    for(int x = -3; x <= 3; ++x)
+    {
+        for(int y = 0; y < 4 - std::abs(x) / 2; ++y)
+        {
+            const glm::vec3 position(1.1f * float(x), 0.5f + float(y), -7.4f + 0.15f * float(y % 2));
+            boxes.add(glm::rotate(glm::translate(glm::mat4(1.f), position), glm::radians(7.f * float(x + y)), glm::vec3(0.f, 1.f, 0.f)));
+        }
+    }
+    boxes.add(glm::scale(glm::translate(glm::mat4(1.f), glm::vec3(-5.f, 2.f, -3.f)), glm::vec3(1.f, 4.f, 1.f)));
+    boxes.add(glm::scale(glm::translate(glm::mat4(1.f), glm::vec3(5.f, 2.f, -3.f)), glm::vec3(1.f, 4.f, 1.f)));
+    boxes.upload();
+
+    learnopengl::InstancedMesh spheres(sphereMesh);
+    for(int i = 0; i < 5; ++i)
+    {
+        const float radius = 0.4f + 0.2f * float(i);
+        spheres.add(glm::scale(glm::translate(glm::mat4(1.f), glm::vec3(-4.f + 2.f * float(i), radius, -1.f - 0.5f * float(i % 2))),
+            glm::vec3(radius)));
+    }
+    spheres.upload();
+
+    // Enable fragment depth testing
+    glEnable(GL_DEPTH_TEST);
+
+    camera.setFovDegrees(60.f);
+    camera.setCameraPos(glm::vec3(0.f, 3.f, 7.f));
+    camera.setCameraFront(glm::normalize(glm::vec3(0.f, -0.3f, -1.f)));
+
+    // Dim ambient, the occlusion shows where the direction light does not reach
+    learnopengl::DirectionLight directionLight;
+    directionLight.setAmbient(glm::vec3(0.f));
+    directionLight.setDiffuse(glm::vec3(0.35f, 0.33f, 0.3f));
+    directionLight.setSpecular(glm::vec3(0.2f));
+    directionLight.setDirection(glm::vec3(0.4f, -1.0f, -0.5f));
+    const glm::vec3 ambient(0.5f);
+
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    learnopengl::GBuffer gbuffer(viewport[2], viewport[3]);
+    learnopengl::AmbientOcclusion ambientOcclusion(viewport[2], viewport[3], occlusionSettings);
+
+    // Full screen triangle from gl_VertexID
+    GLuint emptyVao = 0;
+    glGenVertexArrays(1, &emptyVao);
+
+    auto& profiler = learnopengl::frameProfiler(window);
+
+    // Main window render loop
+    while(!glfwWindowShouldClose(window))
+    {
+        // Process input
+        processInput(window);
+
+        const auto& view = camera.viewMatrix();
+
+        // Project from View Space (3D) to Clip Space (2D)
+        int width, height;
+        learnopengl::getWindowSize(window, &width, &height);
+        camera.setAspect(height ? float(width) / float(height) : 1.f);
+        const auto& projection = camera.projectionMatrix();
+
+        // Geometry buffer and occlusion in pixels of the render target
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        gbuffer.resize(viewport[2], viewport[3]);
+        ambientOcclusion.resize(viewport[2], viewport[3]);
+
+        // Geometry pass
+        {
+            learnopengl::FrameProfiler::ScopeGuard scope(profiler, "geometry");
+            gbuffer.beginGeometryPass();
+
+            geometryShaderProgram.use();
+            geometryShaderProgram.setMat4("projection", glm::value_ptr(projection));
+            geometryShaderProgram.setMat4("view", glm::value_ptr(view));
+            gbuffer.setEncoding(geometryShaderProgram);
+            geometryShaderProgram.setInt("diffuseTexture", 0);
+
+            wallTexture.use(0);
+            room.draw(geometryShaderProgram);
+            objectTexture.use(0);
+            boxes.draw(geometryShaderProgram);
+            spheres.draw(geometryShaderProgram);
+        }
+
+        if(ambientOcclusionEnabled)
+        {
+            if(reconstructNormals)
+                ambientOcclusion.compute(gbuffer.depthStencilTexture(), camera, &profiler);
+            else
+                ambientOcclusion.compute(gbuffer, camera, &profiler);
+        }
+
+        // Lighting pass
+        {
+            learnopengl::FrameProfiler::ScopeGuard scope(profiler, "lighting");
+            gbuffer.beginLightingPass();
+            glDisable(GL_DEPTH_TEST);
+
+            lightingShaderProgram.use();
+            gbuffer.bind(lightingShaderProgram, 0, camera);
+            if(ambientOcclusionEnabled)
+                ambientOcclusion.bind(lightingShaderProgram, 3);
+            else
+                learnopengl::AmbientOcclusion::unbind(lightingShaderProgram);
+            lightingShaderProgram.setDirectionLight("directionLight", directionLight);
+            lightingShaderProgram.setVec3("ambient", ambient.x, ambient.y, ambient.z);
+            const auto& cameraPos = camera.cameraPos();
+            lightingShaderProgram.setVec3("cameraPos", cameraPos.x, cameraPos.y, cameraPos.z);
+            lightingShaderProgram.setBool("occlusionOnly", occlusionOnly && ambientOcclusionEnabled);
+
+            glBindVertexArray(emptyVao);
+            glDrawArrays(GL_TRIANGLES, 0, 3);
+            glBindVertexArray(0);
+            glEnable(GL_DEPTH_TEST);
+        }
+
+        gbuffer.blitLighting(learnopengl::defaultFramebuffer(), viewport[2], viewport[3]);
+
+        // Show rendered buffer in screen
+        glfwPollEvents();
+        glfwSwapBuffers(window);
+
+        learnopengl::showFPS(window);
+    }
+
+    std::cout << "occlusion " << ambientOcclusion.reducedWidth() << "x" << ambientOcclusion.reducedHeight() << std::endl;
+    for(const auto* name: {"geometry",
+            learnopengl::AmbientOcclusion::DownsampleScope,
+            learnopengl::AmbientOcclusion::OcclusionScope,
+            learnopengl::AmbientOcclusion::TemporalScope,
+            learnopengl::AmbientOcclusion::UpsampleScope,
+            "lighting"})
+    {
+        const auto gpu = profiler.scopeStatistics(name, learnopengl::FrameProfiler::Metric::Gpu);
+        std::cout << name << ": gpu p50 " << gpu.p50 << " p99 " << gpu.p99 << " ms" << std::endl;
+    }
+
+    glDeleteVertexArrays(1, &emptyVao);
+    glfwTerminate();
+
+    return 0;
+}